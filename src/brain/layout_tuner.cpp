@@ -15,7 +15,11 @@
 
 #include "catalog/schema.h"
 #include "common/logger.h"
+#include "concurrency/transaction_manager_factory.h"
 #include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+#include "storage/zone_map.h"
 
 namespace peloton {
 namespace brain {
@@ -74,6 +78,64 @@ void LayoutTuner::UpdateDefaultPartition(storage::DataTable* table) {
 
 }
 
+void LayoutTuner::TransformColdTileGroup(storage::DataTable* table) {
+
+  // Limit the transformation rate to not disturb the transactions
+  auto now = std::chrono::steady_clock::now();
+  if (now - last_transformation_time <
+      std::chrono::microseconds(transformation_interval)) {
+    return;
+  }
+
+  auto tile_group_count = table->GetTileGroupCount();
+  if (tile_group_count == 0) {
+    return;
+  }
+
+  // Go over the tile groups of the table round-robin
+  auto &tile_group_offset = tile_group_cursors[table];
+  tile_group_offset = (tile_group_offset + 1) % tile_group_count;
+
+  auto tile_group = table->GetTileGroup(tile_group_offset);
+  if (tile_group == nullptr) {
+    return;
+  }
+
+  // Only transform tile groups that have not been written for a while
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  cid_t current_cid = txn_manager.GetCurrentCommitId();
+  cid_t cold_cid = txn_manager.GetMaxCommittedCid();
+  if (current_cid < cold_cid_distance) {
+    return;
+  }
+  cold_cid = std::min(cold_cid, current_cid - cold_cid_distance);
+
+  if (tile_group->GetHeader()->IsFrozen(cold_cid) == false) {
+    return;
+  }
+
+  // Cold tile groups that already have the default layout get compressed
+  auto diff = tile_group->GetSchemaDifference(table->GetDefaultLayout());
+  if (diff > 0) {
+    if (table->TransformTileGroup(tile_group_offset, theta) != nullptr) {
+      last_transformation_time = now;
+    }
+    return;
+  }
+
+  if (compress_cold_tile_groups == true &&
+      table->CompressTileGroup(tile_group_offset) != nullptr) {
+    last_transformation_time = now;
+    return;
+  }
+
+  // Tighten the zone map if versions were removed from the tile group
+  if (tile_group->GetZoneMap()->IsStale() == true) {
+    tile_group->RebuildZoneMap();
+  }
+
+}
+
 void LayoutTuner::Tune(){
 
 
@@ -84,10 +146,7 @@ void LayoutTuner::Tune(){
     for(auto table : tables) {
 
       // Transform
-      auto tile_group_count = table->GetTileGroupCount();
-      auto tile_group_offset = rand() % tile_group_count;
-
-      table->TransformTileGroup(tile_group_offset, theta);
+      TransformColdTileGroup(table);
 
       // Update partitioning periodically
       UpdateDefaultPartition(table);
@@ -123,6 +182,7 @@ void LayoutTuner::ClearTables() {
   {
     std::lock_guard<std::mutex> lock(layout_tuner_mutex);
     tables.clear();
+    tile_group_cursors.clear();
   }
 }
 
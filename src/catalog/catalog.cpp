@@ -37,6 +37,8 @@ Catalog::Catalog() {
   InitializeFunctions();
 }
 
+// The metric tables are virtual, the stats aggregator keeps their rows in
+// stats::MetricSeries and scans read them from there
 void Catalog::CreateMetricsCatalog() {
   auto default_db = GetDatabaseWithName(CATALOG_DATABASE_NAME);
   auto default_db_oid = default_db->GetOid();
@@ -60,6 +62,16 @@ void Catalog::CreateMetricsCatalog() {
   auto query_metrics_catalog =
       CreateMetricsCatalog(default_db_oid, QUERY_METRIC_NAME);
   default_db->AddTable(query_metrics_catalog.release());
+
+  // Create table for wait metrics
+  auto wait_metrics_catalog =
+      CreateMetricsCatalog(default_db_oid, WAIT_METRIC_NAME);
+  default_db->AddTable(wait_metrics_catalog.release());
+
+  // Create table for query execution pool metrics
+  auto execution_metrics_catalog =
+      CreateMetricsCatalog(default_db_oid, EXECUTION_METRIC_NAME);
+  default_db->AddTable(execution_metrics_catalog.release());
   LOG_DEBUG("Metrics tables created");
 }
 
@@ -74,7 +86,7 @@ void Catalog::CreateCatalogDatabase() {
   auto table_catalog = CreateTableCatalog(START_OID, TABLE_CATALOG_NAME);
   storage::DataTable *tables_table = table_catalog.release();
   database->AddTable(tables_table);
-  databases_.push_back(database);
+  databases_.Add(database, database->GetDBName(), database->GetOid());
   LOG_DEBUG("Catalog database created");
 }
 
@@ -82,16 +94,14 @@ void Catalog::CreateCatalogDatabase() {
 Result Catalog::CreateDatabase(std::string database_name,
                                concurrency::Transaction *txn) {
   // Check if a database with the same name exists
-  for (auto database : databases_) {
-    if (database->GetDBName() == database_name) {
-      LOG_TRACE("Database already exists. Returning RESULT_FAILURE.");
-      return Result::RESULT_FAILURE;
-    }
+  if (databases_.GetWithName(database_name) != nullptr) {
+    LOG_TRACE("Database already exists. Returning RESULT_FAILURE.");
+    return Result::RESULT_FAILURE;
   }
   oid_t database_id = GetNextOid();
   storage::Database *database = new storage::Database(database_id);
   database->setDBName(database_name);
-  databases_.push_back(database);
+  databases_.Add(database, database_name, database_id);
 
   InsertDatabaseIntoCatalogDatabase(database_id, database_name, txn);
 
@@ -100,7 +110,7 @@ Result Catalog::CreateDatabase(std::string database_name,
 }
 
 void Catalog::AddDatabase(storage::Database *database) {
-  databases_.push_back(database);
+  databases_.Add(database, database->GetDBName(), database->GetOid());
   std::string database_name;
   InsertDatabaseIntoCatalogDatabase(database->GetOid(), database_name, nullptr);
 }
@@ -109,14 +119,11 @@ void Catalog::InsertDatabaseIntoCatalogDatabase(oid_t database_id,
                                                 std::string &database_name,
                                                 concurrency::Transaction *txn) {
   // Update catalog_db with this database info
-  auto tuple =
-      GetDatabaseCatalogTuple(databases_[START_OID]
-                                  ->GetTableWithName(DATABASE_CATALOG_NAME)
-                                  ->GetSchema(),
-                              database_id, database_name, pool_);
-  catalog::InsertTuple(
-      databases_[START_OID]->GetTableWithName(DATABASE_CATALOG_NAME),
-      std::move(tuple), txn);
+  auto database_catalog = GetDatabaseWithOid(START_OID)
+                              ->GetTableWithName(DATABASE_CATALOG_NAME);
+  auto tuple = GetDatabaseCatalogTuple(database_catalog->GetSchema(),
+                                       database_id, database_name, pool_);
+  catalog::InsertTuple(database_catalog, std::move(tuple), txn);
 }
 
 // Create a table in a database
@@ -156,15 +163,13 @@ Result Catalog::CreateTable(std::string database_name, std::string table_name,
         CreatePrimaryIndex(database_name, table_name);
 
       // Update catalog_table with this table info
-      auto tuple = GetTableCatalogTuple(
-          databases_[START_OID]
-              ->GetTableWithName(TABLE_CATALOG_NAME)
-              ->GetSchema(),
-          table_id, table_name, database_id, database->GetDBName(), pool_);
+      auto table_catalog = GetDatabaseWithOid(START_OID)
+                               ->GetTableWithName(TABLE_CATALOG_NAME);
+      auto tuple = GetTableCatalogTuple(table_catalog->GetSchema(), table_id,
+                                        table_name, database_id,
+                                        database->GetDBName(), pool_);
       // Another way of insertion using transaction manager
-      catalog::InsertTuple(
-          databases_[START_OID]->GetTableWithName(TABLE_CATALOG_NAME),
-          std::move(tuple), txn);
+      catalog::InsertTuple(table_catalog, std::move(tuple), txn);
       return Result::RESULT_SUCCESS;
     }
   }
@@ -215,6 +220,7 @@ Result Catalog::CreatePrimaryIndex(const std::string &database_name,
     std::shared_ptr<index::Index> pkey_index(
         index::IndexFactory::GetInstance(index_metadata));
     table->AddIndex(pkey_index);
+    IncrementCatalogVersion();
 
     LOG_TRACE("Successfully add primary key index for table %s",
               table->GetName().c_str());
@@ -283,6 +289,7 @@ Result Catalog::CreateIndex(const std::string &database_name,
     std::shared_ptr<index::Index> key_index(
         index::IndexFactory::GetInstance(index_metadata));
     table->AddIndex(key_index);
+    IncrementCatalogVersion();
 
     LOG_TRACE("Successfully add index for table %s", table->GetName().c_str());
     return Result::RESULT_SUCCESS;
@@ -318,19 +325,9 @@ Result Catalog::DropDatabaseWithName(std::string database_name,
     catalog::DeleteTuple(GetDatabaseWithName(CATALOG_DATABASE_NAME)
                              ->GetTableWithName(DATABASE_CATALOG_NAME),
                          database->GetOid(), txn);
-    oid_t database_offset = 0;
-    for (auto database : databases_) {
-      if (database->GetDBName() == database_name) {
-        LOG_TRACE("Deleting database object in database vector");
-        delete database;
-        break;
-      }
-      database_offset++;
-    }
-    PL_ASSERT(database_offset < databases_.size());
     // Drop the database
-    LOG_TRACE("Deleting database from database vector");
-    databases_.erase(databases_.begin() + database_offset);
+    LOG_TRACE("Deleting database object");
+    delete databases_.Remove(database->GetOid());
   }
   catch (CatalogException &e) {
     LOG_TRACE("Database is not found!");
@@ -349,19 +346,9 @@ void Catalog::DropDatabaseWithOid(const oid_t database_oid) {
     catalog::DeleteTuple(GetDatabaseWithName(CATALOG_DATABASE_NAME)
                              ->GetTableWithName(DATABASE_CATALOG_NAME),
                          database_oid, nullptr);
-    oid_t database_offset = 0;
-    for (auto database : databases_) {
-      if (database->GetOid() == database_oid) {
-        LOG_TRACE("Deleting database object in database vector");
-        delete database;
-        break;
-      }
-      database_offset++;
-    }
-    PL_ASSERT(database_offset < databases_.size());
     // Drop the database
-    LOG_TRACE("Deleting database from database vector");
-    databases_.erase(databases_.begin() + database_offset);
+    LOG_TRACE("Deleting database object");
+    delete databases_.Remove(database_oid);
   }
   catch (CatalogException &e) {
     LOG_TRACE("Database is not found!");
@@ -401,8 +388,8 @@ Result Catalog::DropTable(std::string database_name, std::string table_name,
 
 // Find a database using its id
 storage::Database *Catalog::GetDatabaseWithOid(const oid_t db_oid) const {
-  for (auto database : databases_)
-    if (database->GetOid() == db_oid) return database;
+  auto database = databases_.GetWithOid(db_oid);
+  if (database != nullptr) return database;
   throw CatalogException("Database with oid = " + std::to_string(db_oid) +
                          " is not found");
   return nullptr;
@@ -411,18 +398,16 @@ storage::Database *Catalog::GetDatabaseWithOid(const oid_t db_oid) const {
 // Find a database using its name
 storage::Database *Catalog::GetDatabaseWithName(const std::string database_name)
     const {
-  for (auto database : databases_) {
-    if (database != nullptr && database->GetDBName() == database_name)
-      return database;
-  }
+  auto database = databases_.GetWithName(database_name);
+  if (database != nullptr) return database;
   throw CatalogException("Database " + database_name + " is not found");
   return nullptr;
 }
 
 storage::Database *Catalog::GetDatabaseWithOffset(const oid_t database_offset)
     const {
-  PL_ASSERT(database_offset < databases_.size());
-  auto database = databases_.at(database_offset);
+  PL_ASSERT(database_offset < databases_.GetSize());
+  auto database = databases_.GetWithOffset(database_offset);
   return database;
 }
 
@@ -509,6 +494,10 @@ std::unique_ptr<storage::DataTable> Catalog::CreateMetricsCatalog(
     schema = InitializeDatabaseMetricsSchema().release();
   } else if (table_name == INDEX_METRIC_NAME) {
     schema = InitializeIndexMetricsSchema().release();
+  } else if (table_name == WAIT_METRIC_NAME) {
+    schema = InitializeWaitMetricsSchema().release();
+  } else if (table_name == EXECUTION_METRIC_NAME) {
+    schema = InitializeExecutionMetricsSchema().release();
   }
 
   std::unique_ptr<storage::DataTable> table(storage::TableFactory::GetDataTable(
@@ -729,18 +718,96 @@ std::unique_ptr<catalog::Schema> Catalog::InitializeQueryMetricsSchema() {
       catalog::Column(integer_type, integer_type_size, "time_stamp", true);
   timestamp_column.AddConstraint(not_null_constraint);
 
+  // The plan annotated with the runtime statistics of its executors
+  auto operator_profile_column = catalog::Column(
+      common::Type::VARCHAR, common::Type::GetTypeSize(common::Type::VARCHAR),
+      "operator_profile", false);
+
   std::unique_ptr<catalog::Schema> database_schema(new catalog::Schema(
       {name_column,       database_id_column,  num_param_column,
        param_type_column, param_format_column, param_val_column,
        reads_column,      updates_column,      deletes_column,
        inserts_column,    latency_column,      cpu_time_column,
-       timestamp_column}));
+       timestamp_column,  operator_profile_column}));
+  return database_schema;
+}
+
+// Initialize wait catalog schema
+std::unique_ptr<catalog::Schema> Catalog::InitializeWaitMetricsSchema() {
+  const std::string not_null_constraint_name = "not_null";
+  catalog::Constraint not_null_constraint(CONSTRAINT_TYPE_NOTNULL,
+                                          not_null_constraint_name);
+  oid_t integer_type_size = common::Type::GetTypeSize(common::Type::INTEGER);
+  common::Type::TypeId integer_type = common::Type::INTEGER;
+
+  auto wait_class_column = catalog::Column(
+      common::Type::VARCHAR, common::Type::GetTypeSize(common::Type::VARCHAR),
+      "wait_class", false);
+  wait_class_column.AddConstraint(not_null_constraint);
+
+  // Waits since the previous aggregation, the time is in microseconds
+  auto wait_count_column =
+      catalog::Column(integer_type, integer_type_size, "wait_count", true);
+  wait_count_column.AddConstraint(not_null_constraint);
+  auto wait_time_column =
+      catalog::Column(integer_type, integer_type_size, "wait_time", true);
+  wait_time_column.AddConstraint(not_null_constraint);
+
+  auto timestamp_column =
+      catalog::Column(integer_type, integer_type_size, "time_stamp", true);
+  timestamp_column.AddConstraint(not_null_constraint);
+
+  std::unique_ptr<catalog::Schema> database_schema(
+      new catalog::Schema({wait_class_column, wait_count_column,
+                           wait_time_column, timestamp_column}));
+  return database_schema;
+}
+
+// Initialize query execution pool catalog schema
+std::unique_ptr<catalog::Schema> Catalog::InitializeExecutionMetricsSchema() {
+  const std::string not_null_constraint_name = "not_null";
+  catalog::Constraint not_null_constraint(CONSTRAINT_TYPE_NOTNULL,
+                                          not_null_constraint_name);
+  oid_t integer_type_size = common::Type::GetTypeSize(common::Type::INTEGER);
+  common::Type::TypeId integer_type = common::Type::INTEGER;
+
+  auto stage_column = catalog::Column(
+      common::Type::VARCHAR, common::Type::GetTypeSize(common::Type::VARCHAR),
+      "stage", false);
+  stage_column.AddConstraint(not_null_constraint);
+
+  // Connections through the stage since the previous aggregation, and their
+  // average and total latency in microseconds
+  auto stage_count_column =
+      catalog::Column(integer_type, integer_type_size, "stage_count", true);
+  stage_count_column.AddConstraint(not_null_constraint);
+  auto avg_latency_column =
+      catalog::Column(integer_type, integer_type_size, "avg_latency", true);
+  avg_latency_column.AddConstraint(not_null_constraint);
+  auto total_latency_column =
+      catalog::Column(integer_type, integer_type_size, "total_latency", true);
+  total_latency_column.AddConstraint(not_null_constraint);
+
+  // Connections in the stage at the time of the aggregation
+  auto depth_column =
+      catalog::Column(integer_type, integer_type_size, "depth", true);
+  depth_column.AddConstraint(not_null_constraint);
+
+  auto timestamp_column =
+      catalog::Column(integer_type, integer_type_size, "time_stamp", true);
+  timestamp_column.AddConstraint(not_null_constraint);
+
+  std::unique_ptr<catalog::Schema> database_schema(new catalog::Schema(
+      {stage_column, stage_count_column, avg_latency_column,
+       total_latency_column, depth_column, timestamp_column}));
   return database_schema;
 }
 
 void Catalog::PrintCatalogs() {}
 
-oid_t Catalog::GetDatabaseCount() { return databases_.size(); }
+oid_t Catalog::GetDatabaseCount() { return databases_.GetSize(); }
+
+uint64_t Catalog::GetVersion() const { return GetCatalogVersion(); }
 
 oid_t Catalog::GetNextOid() { return oid_++; }
 
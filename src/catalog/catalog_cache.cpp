@@ -0,0 +1,27 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// catalog_cache.cpp
+//
+// Identification: src/catalog/catalog_cache.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <atomic>
+
+#include "catalog/catalog_cache.h"
+
+namespace peloton {
+namespace catalog {
+
+static std::atomic<uint64_t> catalog_version(0);
+
+uint64_t GetCatalogVersion() { return catalog_version.load(); }
+
+void IncrementCatalogVersion() { catalog_version++; }
+
+}  // End catalog namespace
+}  // End peloton namespace
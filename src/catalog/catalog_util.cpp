@@ -195,7 +195,8 @@ std::unique_ptr<storage::Tuple> GetQueryMetricsCatalogTuple(
     stats::QueryMetric::QueryParamBuf format_buf,
     stats::QueryMetric::QueryParamBuf val_buf, int64_t reads, int64_t updates,
     int64_t deletes, int64_t inserts, int64_t latency, int64_t cpu_time,
-    int64_t time_stamp, common::VarlenPool *pool) {
+    int64_t time_stamp, const std::string &operator_profile,
+    common::VarlenPool *pool) {
 
   std::unique_ptr<storage::Tuple> tuple(new storage::Tuple(schema, true));
 
@@ -227,6 +228,13 @@ std::unique_ptr<storage::Tuple> GetQueryMetricsCatalogTuple(
   auto val12 = common::ValueFactory::GetIntegerValue(cpu_time);
   auto val13 = common::ValueFactory::GetIntegerValue(time_stamp);
 
+  // Only the profiled queries have an operator profile
+  common::Value val14 =
+      common::ValueFactory::GetNullValueByType(common::Type::VARCHAR);
+  if (operator_profile.empty() == false) {
+    val14 = common::ValueFactory::GetVarcharValue(operator_profile, nullptr);
+  }
+
   tuple->SetValue(0, val1, pool);
   tuple->SetValue(1, val2, nullptr);
   tuple->SetValue(2, val3, nullptr);
@@ -242,7 +250,58 @@ std::unique_ptr<storage::Tuple> GetQueryMetricsCatalogTuple(
   tuple->SetValue(10, val11, nullptr);
   tuple->SetValue(11, val12, nullptr);
   tuple->SetValue(12, val13, nullptr);
+  tuple->SetValue(13, val14, pool);
+
+  return std::move(tuple);
+}
+
+/**
+ * Generate a wait metric tuple
+ * Input: The table schema, the wait class, the number of waits and their time
+ * since the previous aggregation, the timestamp
+ * Returns: The generated tuple
+ */
+std::unique_ptr<storage::Tuple> GetWaitMetricsCatalogTuple(
+    catalog::Schema *schema, std::string wait_class, int64_t wait_count,
+    int64_t wait_time, int64_t time_stamp, common::VarlenPool *pool) {
+  std::unique_ptr<storage::Tuple> tuple(new storage::Tuple(schema, true));
+  auto val1 = common::ValueFactory::GetVarcharValue(wait_class, nullptr);
+  auto val2 = common::ValueFactory::GetIntegerValue(wait_count);
+  auto val3 = common::ValueFactory::GetIntegerValue(wait_time);
+  auto val4 = common::ValueFactory::GetIntegerValue(time_stamp);
+
+  tuple->SetValue(0, val1, pool);
+  tuple->SetValue(1, val2, nullptr);
+  tuple->SetValue(2, val3, nullptr);
+  tuple->SetValue(3, val4, nullptr);
+  return std::move(tuple);
+}
+
+/**
+ * Generate a query execution pool metric tuple
+ * Input: The table schema, the stage, the number of connections through the
+ * stage since the previous aggregation and their latency, the connections in
+ * the stage, the timestamp
+ * Returns: The generated tuple
+ */
+std::unique_ptr<storage::Tuple> GetExecutionMetricsCatalogTuple(
+    catalog::Schema *schema, std::string stage, int64_t stage_count,
+    int64_t avg_latency, int64_t total_latency, int64_t depth,
+    int64_t time_stamp, common::VarlenPool *pool) {
+  std::unique_ptr<storage::Tuple> tuple(new storage::Tuple(schema, true));
+  auto val1 = common::ValueFactory::GetVarcharValue(stage, nullptr);
+  auto val2 = common::ValueFactory::GetIntegerValue(stage_count);
+  auto val3 = common::ValueFactory::GetIntegerValue(avg_latency);
+  auto val4 = common::ValueFactory::GetIntegerValue(total_latency);
+  auto val5 = common::ValueFactory::GetIntegerValue(depth);
+  auto val6 = common::ValueFactory::GetIntegerValue(time_stamp);
 
+  tuple->SetValue(0, val1, pool);
+  tuple->SetValue(1, val2, nullptr);
+  tuple->SetValue(2, val3, nullptr);
+  tuple->SetValue(3, val4, nullptr);
+  tuple->SetValue(4, val5, nullptr);
+  tuple->SetValue(5, val6, nullptr);
   return std::move(tuple);
 }
 
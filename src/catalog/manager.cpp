@@ -16,6 +16,7 @@
 #include "catalog/foreign_key.h"
 #include "storage/database.h"
 #include "storage/data_table.h"
+#include "concurrency/epoch_manager_factory.h"
 #include "concurrency/transaction_manager_factory.h"
 
 namespace peloton {
@@ -37,14 +38,30 @@ Manager &Manager::GetInstance() {
 void Manager::AddTileGroup(const oid_t oid,
                            std::shared_ptr<storage::TileGroup> location) {
 
+  auto old_location = tile_group_locator_.Find(oid);
+
   // add/update the catalog reference to the tile group
   tile_group_locator_.Update(oid, location);
+  tile_group_ptr_locator_.Update(oid, location.get());
+
+  // the replaced tile group may still be referenced by running transactions
+  if (old_location != nullptr && old_location != location) {
+    concurrency::EpochManagerFactory::GetInstance().RetireTileGroup(
+        old_location);
+  }
 }
 
 void Manager::DropTileGroup(const oid_t oid) {
-  
+  auto old_location = tile_group_locator_.Find(oid);
+
   // drop the catalog reference to the tile group
+  tile_group_ptr_locator_.Erase(oid, nullptr);
   tile_group_locator_.Erase(oid, empty_tile_group_);
+
+  if (old_location != nullptr) {
+    concurrency::EpochManagerFactory::GetInstance().RetireTileGroup(
+        old_location);
+  }
 }
 
 std::shared_ptr<storage::TileGroup> Manager::GetTileGroup(const oid_t oid) {
@@ -55,9 +72,18 @@ std::shared_ptr<storage::TileGroup> Manager::GetTileGroup(const oid_t oid) {
   return location;
 }
 
+storage::TileGroupHeader *Manager::GetTileGroupHeader(const oid_t oid) {
+  auto tile_group = tile_group_ptr_locator_.Find(oid);
+  if (tile_group == nullptr) {
+    return nullptr;
+  }
+  return tile_group->GetHeader();
+}
+
 // used for logging test
 void Manager::ClearTileGroup() {
 
+  tile_group_ptr_locator_.Clear(nullptr);
   tile_group_locator_.Clear(empty_tile_group_);
 }
 
@@ -0,0 +1,118 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// arena.cpp
+//
+// Identification: src/common/arena.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/arena.h"
+
+namespace peloton {
+namespace common {
+
+//===--------------------------------------------------------------------===//
+// Arena Chunk Cache
+//===--------------------------------------------------------------------===//
+
+ArenaChunkCache &ArenaChunkCache::GetInstance() {
+  static ArenaChunkCache chunk_cache;
+  return chunk_cache;
+}
+
+ArenaChunkCache::~ArenaChunkCache() {
+  for (auto chunk : chunks_) {
+    delete[] chunk;
+  }
+}
+
+char *ArenaChunkCache::Get() {
+  char *chunk = nullptr;
+
+  chunks_lock_.Lock();
+  if (chunks_.empty() == false) {
+    chunk = chunks_.back();
+    chunks_.pop_back();
+  }
+  chunks_lock_.Unlock();
+
+  if (chunk == nullptr) {
+    chunk = new char[ARENA_CHUNK_SIZE];
+  }
+  return chunk;
+}
+
+void ArenaChunkCache::Put(char *chunk) {
+  chunks_lock_.Lock();
+  if (chunks_.size() < ARENA_MAX_CACHED_CHUNKS) {
+    chunks_.push_back(chunk);
+    chunk = nullptr;
+  }
+  chunks_lock_.Unlock();
+
+  delete[] chunk;
+}
+
+size_t ArenaChunkCache::GetSize() const {
+  chunks_lock_.Lock();
+  auto size = chunks_.size();
+  chunks_lock_.Unlock();
+  return size;
+}
+
+//===--------------------------------------------------------------------===//
+// Arena
+//===--------------------------------------------------------------------===//
+
+Arena::~Arena() { Reset(); }
+
+void *Arena::Allocate(size_t size) {
+  // Round up so that the next allocation is aligned too
+  size = (size + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+  if (size == 0) {
+    size = ARENA_ALIGNMENT;
+  }
+  allocated_size_ += size;
+
+  if (size > ARENA_MAX_SMALL_SIZE) {
+    auto block = new char[size];
+    large_blocks_.push_back(block);
+    return block;
+  }
+
+  // The rest of the last chunk is wasted
+  if (size > chunk_remaining_) {
+    chunk_head_ = ArenaChunkCache::GetInstance().Get();
+    chunk_remaining_ = ARENA_CHUNK_SIZE;
+    chunks_.push_back(chunk_head_);
+  }
+
+  auto location = chunk_head_;
+  chunk_head_ += size;
+  chunk_remaining_ -= size;
+  return location;
+}
+
+void Arena::Reset() {
+  auto &chunk_cache = ArenaChunkCache::GetInstance();
+  for (auto chunk : chunks_) {
+    chunk_cache.Put(chunk);
+  }
+  chunks_.clear();
+
+  for (auto block : large_blocks_) {
+    delete[] block;
+  }
+  large_blocks_.clear();
+
+  chunk_head_ = nullptr;
+  chunk_remaining_ = 0;
+  allocated_size_ = 0;
+}
+
+}  // namespace common
+}  // namespace peloton
@@ -20,7 +20,67 @@ DEFINE_uint64(max_connections, 64,
 
 DEFINE_string(socket_family, "AF_INET", "Socket family (AF_UNIX, AF_INET)");
 
+DEFINE_bool(reuse_port, false,
+            "Accept connections on a listening socket per worker thread with "
+            "SO_REUSEPORT (default: false)");
+
+DEFINE_string(dispatch_mode, "round_robin",
+              "Dispatch of accepted connections to the worker threads "
+              "(round_robin, least_loaded)");
+
 DEFINE_uint64(stats_mode, peloton::STATS_TYPE_INVALID,
               "Enable statistics collection (default: STATS_TYPE_INVALID)");
 
+DEFINE_uint64(stats_series_size, 10000,
+              "Number of rows kept per metric table, the oldest rows are "
+              "dropped first (default: 10000)");
+
+DEFINE_uint64(parallelism, 1,
+              "Default degree of parallelism of a query (default: 1)");
+
+DEFINE_uint64(max_parallelism, 0,
+              "Maximum degree of parallelism of a query, 0 for the number of "
+              "cores (default: 0)");
+
+DEFINE_uint64(execution_threads, 0,
+              "Number of threads that execute the queries of the clients, 0 "
+              "for the number of cores (default: 0)");
+
+DEFINE_bool(profile_cycles, false,
+            "Count the CPU cycles spent in each executor of a profiled query "
+            "(default: false)");
+
+DEFINE_bool(compile_expressions, true,
+            "Evaluate the scan predicates with compiled programs instead of "
+            "interpreting the expression trees (default: true)");
+
+DEFINE_uint64(pipeline_compile_threshold, 2,
+              "Number of executions of a prepared statement after which its "
+              "plan runs as a compiled pipeline, 0 to never compile "
+              "(default: 2)");
+
+DEFINE_uint64(executor_tree_pool_size, 4,
+              "Number of idle executor trees kept per prepared statement to "
+              "be reused by its next executions, 0 to build a tree per "
+              "execution (default: 4)");
+
+DEFINE_bool(fast_path_parser, true,
+            "Parse the simple single table statements with a hand written "
+            "recognizer, the others go through the full parser "
+            "(default: true)");
+
+DEFINE_string(version_storage, "newest_to_oldest",
+              "Order of the version chains of the new tables, updates either "
+              "prepend the new version or append it behind the older ones "
+              "(newest_to_oldest, oldest_to_newest)");
+
+DEFINE_uint64(version_retention, 0,
+              "Seconds for which the gc keeps the expired versions of the new "
+              "tables, so that AS OF queries can read them (default: 0)");
+
+DEFINE_bool(shared_scans, true,
+            "Let a sequential scan start at the tile group the running scans "
+            "of the table read and wrap around, so that they share the reads "
+            "from memory (default: true)");
+
 DEFINE_bool(h, false, "Show help");
@@ -17,7 +17,9 @@
 
 #include "gc/gc_manager_factory.h"
 #include "concurrency/epoch_manager_factory.h"
+#include "executor/task_scheduler.h"
 #include "storage/data_table.h"
+#include "storage/tile_group_preallocator.h"
 
 #include "libcds/cds/init.h"
 
@@ -42,20 +44,39 @@ void PelotonInit::Initialize() {
   // set max thread number.
   thread_pool.Initialize(0, std::thread::hardware_concurrency() + 3);
 
+  // every query thread inserts into its own tile group.
+  storage::DataTable::SetActiveTileGroupCount(QUERY_THREAD_COUNT);
+
   int parallelism = (std::thread::hardware_concurrency() + 1) / 2;
-  storage::DataTable::SetActiveTileGroupCount(parallelism);
   storage::DataTable::SetActiveIndirectionArrayCount(parallelism);
 
   // start epoch.
   concurrency::EpochManagerFactory::GetInstance().StartEpoch();
   // start GC.
   gc::GCManagerFactory::GetInstance().StartGC();
+  // start tile group preallocation.
+  storage::TileGroupPreallocator::GetInstance().StartPreallocation();
+  // start the workers of parallel queries. the thread that runs a query is
+  // one of its workers.
+  size_t max_parallelism = FLAGS_max_parallelism;
+  if (max_parallelism == 0) {
+    max_parallelism = std::thread::hardware_concurrency();
+  }
+  if (max_parallelism > 1) {
+    executor::TaskScheduler::GetInstance().StartScheduler(max_parallelism - 1);
+  }
   // initialize the catalog so we don't do this on the first query
   catalog::Catalog::GetInstance();
 }
 
 void PelotonInit::Shutdown() {
 
+  // shut down the workers of parallel queries.
+  executor::TaskScheduler::GetInstance().StopScheduler();
+
+  // shut down tile group preallocation.
+  storage::TileGroupPreallocator::GetInstance().StopPreallocation();
+
   // shut down GC.
   gc::GCManagerFactory::GetInstance().StopGC();
   // shut down epoch.
@@ -0,0 +1,105 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// rcu.cpp
+//
+// Identification: src/common/rcu.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <limits>
+#include <vector>
+
+#include "common/rcu.h"
+
+namespace peloton {
+
+// the slots of all the threads that have read so far. they are never freed,
+// threads may still read while the process exits.
+static std::mutex slots_lock;
+static std::vector<RCUReaderSlot *> &GetAllSlots() {
+  static auto all_slots = new std::vector<RCUReaderSlot *>();
+  return *all_slots;
+}
+
+RCU &RCU::GetInstance() {
+  static RCU rcu;
+  return rcu;
+}
+
+RCUReaderSlot &RCU::GetThreadSlot() {
+  static thread_local RCUReaderSlot *slot = nullptr;
+  if (slot == nullptr) {
+    auto new_slot = new RCUReaderSlot();
+    new_slot->epoch = 0;
+    new_slot->depth = 0;
+
+    std::lock_guard<std::mutex> lock(slots_lock);
+    GetAllSlots().push_back(new_slot);
+    slot = new_slot;
+  }
+  return *slot;
+}
+
+void RCU::ReadLock() {
+  auto &slot = GetThreadSlot();
+  if (slot.depth++ == 0) {
+    // sequentially consistent, so that the snapshot is loaded after the
+    // writers can see the epoch
+    slot.epoch.store(epoch_.load());
+  }
+}
+
+void RCU::ReadUnlock() {
+  auto &slot = GetThreadSlot();
+  if (--slot.depth == 0) {
+    slot.epoch.store(0, std::memory_order_release);
+  }
+}
+
+void RCU::Retire(std::function<void()> &&deleter) {
+  {
+    // readers of the old copy are in this epoch or in an older one
+    std::lock_guard<std::mutex> lock(retired_lock_);
+    retired_.emplace_back(epoch_.fetch_add(1), std::move(deleter));
+  }
+  Reclaim();
+}
+
+uint64_t RCU::GetMinReaderEpoch() {
+  uint64_t min_epoch = std::numeric_limits<uint64_t>::max();
+  std::lock_guard<std::mutex> lock(slots_lock);
+  for (auto slot : GetAllSlots()) {
+    auto epoch = slot->epoch.load();
+    if (epoch != 0 && epoch < min_epoch) {
+      min_epoch = epoch;
+    }
+  }
+  return min_epoch;
+}
+
+void RCU::Reclaim() {
+  std::vector<std::function<void()>> deleters;
+  {
+    std::lock_guard<std::mutex> lock(retired_lock_);
+    uint64_t min_epoch = GetMinReaderEpoch();
+    while (retired_.empty() == false && retired_.front().first < min_epoch) {
+      deleters.push_back(std::move(retired_.front().second));
+      retired_.pop_front();
+    }
+  }
+
+  for (auto &deleter : deleters) {
+    deleter();
+  }
+}
+
+size_t RCU::GetRetiredCount() {
+  std::lock_guard<std::mutex> lock(retired_lock_);
+  return retired_.size();
+}
+
+}  // End peloton namespace
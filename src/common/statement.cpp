@@ -11,7 +11,9 @@
 //===----------------------------------------------------------------------===//
 
 #include "common/statement.h"
+#include "common/config.h"
 #include "common/logger.h"
+#include "executor/executor_tree_pool.h"
 #include "planner/abstract_plan.h"
 
 namespace peloton {
@@ -57,10 +59,62 @@ void Statement::SetTupleDescriptor(
 
 void Statement::SetPlanTree(std::shared_ptr<planner::AbstractPlan> plan_tree_) {
   plan_tree = std::move(plan_tree_);
+
+  // the pipeline refers to the old plan tree
+  execution_count = 0;
+  compiled_pipeline.reset();
+  pipeline_compiled = false;
+
+  // the executor trees refer to the old plan tree too
+  executor_tree_pool.reset();
 }
 
 const std::shared_ptr<planner::AbstractPlan>& Statement::GetPlanTree() const {
   return plan_tree;
 }
 
+void Statement::SetExplainAnalyze(const bool explain_analyze_) {
+  explain_analyze = explain_analyze_;
+}
+
+bool Statement::IsExplainAnalyze() const { return explain_analyze; }
+
+void Statement::SetCatalogVersion(const uint64_t catalog_version_) {
+  catalog_version = catalog_version_;
+}
+
+uint64_t Statement::GetCatalogVersion() const { return catalog_version; }
+
+void Statement::SetSnapshotCid(const cid_t snapshot_cid_) {
+  snapshot_cid = snapshot_cid_;
+}
+
+cid_t Statement::GetSnapshotCid() const { return snapshot_cid; }
+
+uint64_t Statement::IncrementExecutionCount() { return ++execution_count; }
+
+void Statement::SetCompiledPipeline(
+    std::shared_ptr<executor::CompiledPipeline> compiled_pipeline_) {
+  compiled_pipeline = std::move(compiled_pipeline_);
+  pipeline_compiled = true;
+}
+
+const std::shared_ptr<executor::CompiledPipeline>&
+Statement::GetCompiledPipeline() const {
+  return compiled_pipeline;
+}
+
+bool Statement::IsPipelineCompiled() const { return pipeline_compiled; }
+
+const std::shared_ptr<executor::ExecutorTreePool>&
+Statement::GetExecutorTreePool() {
+  if (executor_tree_pool == nullptr && plan_tree != nullptr &&
+      FLAGS_executor_tree_pool_size > 0 &&
+      executor::ExecutorTreePool::IsReusable(plan_tree.get())) {
+    executor_tree_pool.reset(
+        new executor::ExecutorTreePool(FLAGS_executor_tree_pool_size));
+  }
+  return executor_tree_pool;
+}
+
 }  // namespace peloton
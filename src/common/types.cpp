@@ -158,6 +158,30 @@ BackendType StringToBackendType(std::string str) {
   return BACKEND_TYPE_INVALID;
 }
 
+//===--------------------------------------------------------------------===//
+// VersionStorageType <--> String Utilities
+//===--------------------------------------------------------------------===//
+
+std::string VersionStorageTypeToString(VersionStorageType type) {
+  switch (type) {
+    case VERSION_STORAGE_TYPE_NEWEST_TO_OLDEST:
+      return "newest_to_oldest";
+    case VERSION_STORAGE_TYPE_OLDEST_TO_NEWEST:
+      return "oldest_to_newest";
+    default:
+      return "invalid";
+  }
+}
+
+VersionStorageType StringToVersionStorageType(const std::string &str) {
+  if (str == "newest_to_oldest") {
+    return VERSION_STORAGE_TYPE_NEWEST_TO_OLDEST;
+  } else if (str == "oldest_to_newest") {
+    return VERSION_STORAGE_TYPE_OLDEST_TO_NEWEST;
+  }
+  return VERSION_STORAGE_TYPE_INVALID;
+}
+
 //===--------------------------------------------------------------------===//
 // Value <--> String Utilities
 //===--------------------------------------------------------------------===//
@@ -275,6 +299,19 @@ bool AtomicUpdateItemPointer(ItemPointer* src_ptr, const ItemPointer& value) {
                                       *cast_value_ptr);
 }
 
+bool CompareAndSwapItemPointer(ItemPointer* src_ptr,
+                               const ItemPointer& expected,
+                               const ItemPointer& value) {
+  PL_ASSERT(sizeof(ItemPointer) == sizeof(int64_t));
+  int64_t* cast_src_ptr = reinterpret_cast<int64_t*>((void*)src_ptr);
+  const int64_t* cast_expected_ptr =
+      reinterpret_cast<const int64_t*>((const void*)&expected);
+  const int64_t* cast_value_ptr =
+      reinterpret_cast<const int64_t*>((const void*)&value);
+  return __sync_bool_compare_and_swap(cast_src_ptr, *cast_expected_ptr,
+                                      *cast_value_ptr);
+}
+
 //===--------------------------------------------------------------------===//
 // Statement - String Utilities
 //===--------------------------------------------------------------------===//
@@ -1251,6 +1288,30 @@ std::string LogRecordTypeToString(LogRecordType type) {
   return "INVALID";
 }
 
+std::string ResultToString(Result result) {
+  switch (result) {
+    case RESULT_INVALID: {
+      return "INVALID";
+    }
+    case RESULT_SUCCESS: {
+      return "SUCCESS";
+    }
+    case RESULT_FAILURE: {
+      return "FAILURE";
+    }
+    case RESULT_ABORTED: {
+      return "ABORTED";
+    }
+    case RESULT_NOOP: {
+      return "NOOP";
+    }
+    case RESULT_UNKNOWN: {
+      return "UNKNOWN";
+    }
+  }
+  return "INVALID";
+}
+
 common::Type::TypeId PostgresValueTypeToPelotonValueType(
     PostgresValueType PostgresValType) {
   switch (PostgresValType) {
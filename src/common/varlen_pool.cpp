@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "common/varlen_pool.h"
+#include "common/arena.h"
 
 namespace peloton {
 namespace common {
@@ -40,6 +41,8 @@ VarlenPool::VarlenPool(BackendType backend_type UNUSED_ATTRIBUTE) { Init(); };
 
 VarlenPool::VarlenPool() { Init(); };
 
+VarlenPool::VarlenPool(Arena *arena) : arena_(arena) { Init(); };
+
 // Destroy this pool, and all memory it owns.
 VarlenPool::~VarlenPool() {
   for (size_t i = 0; i < MAX_LIST_NUM; i++) {
@@ -64,6 +67,10 @@ void VarlenPool::Init() {
 // null pointer will be returned.
 // TODO: Provide good error codes for failure cases.
 void *VarlenPool::Allocate(size_t size) {
+  if (arena_ != nullptr) {
+    return arena_->Allocate(size);
+  }
+
   // Allocate a large block.
   if (size > BUFFER_SIZE) {
     // Lock the corresponding list
@@ -79,7 +86,7 @@ void *VarlenPool::Allocate(size_t size) {
     buffer.allocated_cnt_ = 1;
     buffer.bitmap_[0] = 1;
 
-    list_lock_[LARGE_LIST_ID].Lock();
+    list_lock_[LARGE_LIST_ID].Lock(WAIT_CLASS_VARLEN_POOL_LOCK);
     buf_list_[LARGE_LIST_ID].push_back(buffer);
     list_lock_[LARGE_LIST_ID].Unlock();
     return buffer.buf_begin_.get();
@@ -92,7 +99,7 @@ void *VarlenPool::Allocate(size_t size) {
     list_id = GetAlign(size) - 4;
 
   // Lock the corresponding list
-  list_lock_[list_id].Lock();
+  list_lock_[list_id].Lock(WAIT_CLASS_VARLEN_POOL_LOCK);
 
   // Find a buffer that is not full
   size_t block_num = (MAX_BLOCK_NUM >> list_id);
@@ -134,10 +141,14 @@ void *VarlenPool::Allocate(size_t size) {
 
 // Returns the provided chunk of memory back into the pool
 void VarlenPool::Free(void *ptr) {
+  if (arena_ != nullptr) {
+    return;
+  }
+
   bool freed = 0;
   // Find the buffer where the ptr is allocated
   for (size_t i = 0; i < MAX_LIST_NUM; i++) {
-    list_lock_[i].Lock();
+    list_lock_[i].Lock(WAIT_CLASS_VARLEN_POOL_LOCK);
     std::list<Buffer>::iterator it;
     for (it = buf_list_[i].begin(); it != buf_list_[i].end(); it++) {
       int offset = reinterpret_cast<char *>(ptr) -
@@ -165,9 +176,13 @@ void VarlenPool::Free(void *ptr) {
 
 // Get the total number of bytes that have been allocated by this pool.
 uint64_t VarlenPool::GetTotalAllocatedSpace() {
+  if (arena_ != nullptr) {
+    return arena_->GetAllocatedSize();
+  }
+
   uint64_t total_size = 0;
   for (size_t i = 0; i < MAX_LIST_NUM; i++) {
-    list_lock_[i].Lock();
+    list_lock_[i].Lock(WAIT_CLASS_VARLEN_POOL_LOCK);
     std::list<Buffer>::const_iterator it;
     for (it = buf_list_[i].begin(); it != buf_list_[i].end(); it++) {
       total_size += it->blk_size_ * it->allocated_cnt_;
@@ -0,0 +1,99 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// wait_event.cpp
+//
+// Identification: src/common/wait_event.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <mutex>
+#include <vector>
+
+#include "common/wait_event.h"
+
+namespace peloton {
+
+// the counters of all the threads that have waited so far. the counters of
+// exited threads are kept, so that the totals never decrease. they are never
+// freed, threads may still wait while the process exits.
+static std::mutex counters_lock;
+static std::vector<WaitEventCounters *> &GetAllCounters() {
+  static auto all_counters = new std::vector<WaitEventCounters *>();
+  return *all_counters;
+}
+
+WaitEventCounters &WaitEvents::GetThreadCounters() {
+  static thread_local WaitEventCounters *counters = nullptr;
+  if (counters == nullptr) {
+    auto new_counters = new WaitEventCounters();
+    for (int wait_class = 0; wait_class < WAIT_CLASS_COUNT; wait_class++) {
+      new_counters->wait_count[wait_class] = 0;
+      new_counters->wait_time_ns[wait_class] = 0;
+    }
+
+    std::lock_guard<std::mutex> lock(counters_lock);
+    GetAllCounters().push_back(new_counters);
+    counters = new_counters;
+  }
+  return *counters;
+}
+
+void WaitEvents::RecordWait(const WaitClass &wait_class,
+                            const uint64_t &wait_time_ns) {
+  auto &counters = GetThreadCounters();
+
+  // single writer, so a plain load and store is enough
+  auto &wait_count = counters.wait_count[wait_class];
+  wait_count.store(wait_count.load(std::memory_order_relaxed) + 1,
+                   std::memory_order_relaxed);
+  if (wait_time_ns != 0) {
+    auto &wait_time = counters.wait_time_ns[wait_class];
+    wait_time.store(wait_time.load(std::memory_order_relaxed) + wait_time_ns,
+                    std::memory_order_relaxed);
+  }
+}
+
+uint64_t WaitEvents::GetWaitCount(const WaitClass &wait_class) {
+  uint64_t wait_count = 0;
+  std::lock_guard<std::mutex> lock(counters_lock);
+  for (auto counters : GetAllCounters()) {
+    wait_count += counters->wait_count[wait_class].load();
+  }
+  return wait_count;
+}
+
+uint64_t WaitEvents::GetWaitTime(const WaitClass &wait_class) {
+  uint64_t wait_time_ns = 0;
+  std::lock_guard<std::mutex> lock(counters_lock);
+  for (auto counters : GetAllCounters()) {
+    wait_time_ns += counters->wait_time_ns[wait_class].load();
+  }
+  return wait_time_ns;
+}
+
+std::string WaitEvents::WaitClassToString(const WaitClass &wait_class) {
+  switch (wait_class) {
+    case WAIT_CLASS_SPINLOCK:
+      return "SPINLOCK";
+    case WAIT_CLASS_TUPLE_LOCK:
+      return "TUPLE_LOCK";
+    case WAIT_CLASS_DATA_FILE_LOCK:
+      return "DATA_FILE_LOCK";
+    case WAIT_CLASS_VARLEN_POOL_LOCK:
+      return "VARLEN_POOL_LOCK";
+    case WAIT_CLASS_EPOCH:
+      return "EPOCH";
+    case WAIT_CLASS_LOG_FLUSH:
+      return "LOG_FLUSH";
+    case WAIT_CLASS_TUPLE_SLOT:
+      return "TUPLE_SLOT";
+    default:
+      return "INVALID";
+  }
+}
+
+}  // End peloton namespace
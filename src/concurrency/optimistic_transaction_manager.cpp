@@ -0,0 +1,181 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// optimistic_transaction_manager.cpp
+//
+// Identification: src/concurrency/optimistic_transaction_manager.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "concurrency/optimistic_transaction_manager.h"
+
+#include "catalog/manager.h"
+#include "common/logger.h"
+#include "concurrency/transaction.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "logging/log_manager.h"
+
+namespace peloton {
+namespace concurrency {
+
+OptimisticTransactionManager &OptimisticTransactionManager::GetInstance() {
+  static OptimisticTransactionManager txn_manager;
+  return txn_manager;
+}
+
+Transaction *OptimisticTransactionManager::BeginTransaction() {
+  auto &log_manager = logging::LogManager::GetInstance();
+  log_manager.PrepareLogging();
+
+  // read the snapshot of the last installed commit. the transaction gets its
+  // commit id when it commits.
+  txn_id_t txn_id = GetNextTransactionId();
+  cid_t begin_cid = last_committed_cid_.load();
+  Transaction *txn = new Transaction(txn_id, begin_cid);
+
+  auto eid = EpochManagerFactory::GetInstance().EnterEpoch(begin_cid);
+  txn->SetEpochId(eid);
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()
+        ->GetTxnLatencyMetric()
+        .StartTimer();
+  }
+
+  return txn;
+}
+
+// the tuple is not owned by any transaction, and no newer version has been
+// committed.
+bool OptimisticTransactionManager::IsOwnable(
+    UNUSED_ATTRIBUTE Transaction *const current_txn,
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id) {
+  auto tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
+  auto tuple_end_cid = tile_group_header->GetEndCommitId(tuple_id);
+  return tuple_txn_id == INITIAL_TXN_ID && tuple_end_cid == MAX_CID;
+}
+
+bool OptimisticTransactionManager::AcquireOwnership(
+    Transaction *const current_txn,
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id) {
+  auto txn_id = current_txn->GetTransactionId();
+
+  if (tile_group_header->SetAtomicTransactionId(tuple_id, txn_id) == false) {
+    return false;
+  }
+
+  // a concurrent transaction may have committed a newer version after we
+  // checked that the tuple is ownable.
+  if (tile_group_header->GetEndCommitId(tuple_id) != MAX_CID) {
+    tile_group_header->SetTransactionId(tuple_id, INITIAL_TXN_ID);
+    return false;
+  }
+
+  return true;
+}
+
+bool OptimisticTransactionManager::PerformRead(Transaction *const current_txn,
+                                               const ItemPointer &location,
+                                               bool acquire_ownership) {
+  if (current_txn->IsDeclaredReadOnly() == true) {
+    // Ignore read validation for all readonly transactions
+    return true;
+  }
+
+  LOG_TRACE("PerformRead (%u, %u)\n", location.block, location.offset);
+
+  // select for update
+  if (acquire_ownership == true) {
+    auto tile_group_header =
+        catalog::Manager::GetInstance().GetTileGroupHeader(location.block);
+    auto tuple_id = location.offset;
+
+    if (IsOwner(current_txn, tile_group_header, tuple_id) == false) {
+      if (IsOwnable(current_txn, tile_group_header, tuple_id) == false) {
+        return false;
+      }
+      if (AcquireOwnership(current_txn, tile_group_header, tuple_id) ==
+          false) {
+        return false;
+      }
+      // Promote to RW_TYPE_READ_OWN
+      current_txn->RecordReadOwn(location);
+    }
+  } else {
+    // only recorded locally, the read is validated at commit time
+    current_txn->RecordRead(location);
+  }
+
+  // Increment table read op stats
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementTableReads(
+        location.block);
+  }
+
+  return true;
+}
+
+bool OptimisticTransactionManager::ValidateReadSet(
+    Transaction *const current_txn) {
+  auto &manager = catalog::Manager::GetInstance();
+  auto &rw_set = current_txn->GetReadWriteSet();
+
+  for (auto &rw_entry : rw_set) {
+    if (rw_entry.type != RW_TYPE_READ) {
+      continue;
+    }
+    auto &location = rw_entry.location;
+    auto tile_group_header = manager.GetTileGroupHeader(location.block);
+    // a newer version has been committed since the version was read
+    if (tile_group_header->GetEndCommitId(location.offset) != MAX_CID) {
+      LOG_TRACE("Validation failed on (%u, %u)", location.block,
+                location.offset);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+Result OptimisticTransactionManager::CommitTransaction(
+    Transaction *const current_txn) {
+  LOG_TRACE("Committing peloton txn : %lu ", current_txn->GetTransactionId());
+
+  if (current_txn->IsDeclaredReadOnly() == true) {
+    EndReadonlyTransaction(current_txn);
+    return RESULT_SUCCESS;
+  }
+
+  // a transaction without writes has read a consistent snapshot, so it is
+  // serializable at its begin commit id.
+  if (current_txn->IsReadOnly() == true) {
+    return CommitWriteSet(current_txn, current_txn->GetBeginCommitId());
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(commit_mutex_);
+
+    auto isolation_level = TransactionManagerFactory::GetIsolationLevel();
+    if (isolation_level == ISOLATION_LEVEL_TYPE_SNAPSHOT ||
+        ValidateReadSet(current_txn) == true) {
+      cid_t end_commit_id = GetNextCommitId();
+      Result result = CommitWriteSet(current_txn, end_commit_id);
+
+      // the new versions are all installed, make them visible to new
+      // transactions.
+      last_committed_cid_ = end_commit_id;
+      return result;
+    }
+  }
+
+  LOG_TRACE("Read set validation failed");
+  return AbortTransaction(current_txn);
+}
+
+}  // End concurrency namespace
+}  // End peloton namespace
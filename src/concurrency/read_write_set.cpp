@@ -0,0 +1,105 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// read_write_set.cpp
+//
+// Identification: src/concurrency/read_write_set.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "concurrency/read_write_set.h"
+
+
+namespace peloton {
+namespace concurrency {
+
+namespace {
+
+const size_t INITIAL_BUFFER_CAPACITY = 64;
+
+// larger buffers are released instead of being cached
+const size_t MAX_POOLED_BUFFER_CAPACITY = 4096;
+
+const size_t MAX_POOLED_BUFFER_COUNT = 16;
+
+// buffers of the read write sets destroyed by a thread, handed out again to
+// the sets it fills. the gc sets are destroyed by the gc threads, which never
+// fill a set and so have no pool, their buffers are freed there.
+struct BufferPool {
+  BufferPool() { available = true; }
+
+  ~BufferPool() { available = false; }
+
+  std::vector<std::vector<ReadWriteEntry>> buffers;
+
+  // the pool may already be destroyed when static objects release their sets
+  static thread_local bool available;
+};
+
+thread_local bool BufferPool::available = false;
+
+thread_local BufferPool buffer_pool;
+
+}  // End anonymous namespace
+
+ReadWriteSet::ReadWriteSet() : indexed_count_(0) {}
+
+ReadWriteSet::~ReadWriteSet() {
+  if (BufferPool::available == false ||
+      entries_.capacity() > MAX_POOLED_BUFFER_CAPACITY) {
+    return;
+  }
+
+  auto &buffers = buffer_pool.buffers;
+  if (buffers.size() < MAX_POOLED_BUFFER_COUNT) {
+    entries_.clear();
+    buffers.push_back(std::move(entries_));
+  }
+}
+
+RWType *ReadWriteSet::Find(const ItemPointer &location) {
+  auto entry_count = entries_.size();
+  if (entry_count <= linear_search_limit_) {
+    for (auto &entry : entries_) {
+      if (entry.location.block == location.block &&
+          entry.location.offset == location.offset) {
+        return &entry.type;
+      }
+    }
+    return nullptr;
+  }
+
+  // index the entries appended since the last lookup
+  for (; indexed_count_ < entry_count; indexed_count_++) {
+    index_[GetKey(entries_[indexed_count_].location)] = indexed_count_;
+  }
+
+  auto itr = index_.find(GetKey(location));
+  if (itr == index_.end()) {
+    return nullptr;
+  }
+  return &entries_[itr->second].type;
+}
+
+void ReadWriteSet::Insert(const ItemPointer &location, const RWType &type) {
+  if (entries_.capacity() == 0) {
+    ReserveBuffer();
+  }
+  entries_.emplace_back(location, type);
+}
+
+void ReadWriteSet::ReserveBuffer() {
+  auto &buffers = buffer_pool.buffers;
+  if (buffers.empty() == false) {
+    entries_.swap(buffers.back());
+    buffers.pop_back();
+  } else {
+    entries_.reserve(INITIAL_BUFFER_CAPACITY);
+  }
+}
+
+}  // End concurrency namespace
+}  // End peloton namespace
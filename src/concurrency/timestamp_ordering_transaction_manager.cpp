@@ -20,10 +20,22 @@
 #include "common/exception.h"
 #include "common/logger.h"
 #include "gc/gc_manager_factory.h"
+#include "storage/data_table.h"
 
 namespace peloton {
 namespace concurrency {
 
+// in the oldest-to-newest version chains, the indirection points to the oldest
+// version. it is left alone by the updates and moved by the gc only.
+static bool IsOldestToNewest(
+    const storage::TileGroupHeader *const tile_group_header) {
+  auto table = static_cast<storage::DataTable *>(
+      tile_group_header->GetTileGroup()->GetAbstractTable());
+  return table != nullptr &&
+         table->GetVersionStorageType() ==
+             VERSION_STORAGE_TYPE_OLDEST_TO_NEWEST;
+}
+
 // timestamp ordering requires a spinlock field for protecting the atomic access
 // to txn_id field and last_reader_cid field.
 Spinlock *TimestampOrderingTransactionManager::GetSpinlockField(
@@ -53,7 +65,7 @@ bool TimestampOrderingTransactionManager::SetLastReaderCommitId(
 
   // cid_t current_cid = current_txn->GetBeginCommitId();
 
-  GetSpinlockField(tile_group_header, tuple_id)->Lock();
+  GetSpinlockField(tile_group_header, tuple_id)->Lock(WAIT_CLASS_TUPLE_LOCK);
 
   txn_id_t tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
 
@@ -124,16 +136,40 @@ Transaction *TimestampOrderingTransactionManager::BeginReadonlyTransaction() {
     return txn;
 }
 
+Transaction *TimestampOrderingTransactionManager::BeginHistoricalTransaction(
+    const cid_t &snapshot_cid) {
+  auto &epoch_manager = EpochManagerFactory::GetInstance();
+
+  // the snapshot must not change anymore, as for the read-only transactions
+  if (snapshot_cid > epoch_manager.GetReadOnlyTxnCid()) {
+    return nullptr;
+  }
+
+  RegisterSnapshot(snapshot_cid);
+  Transaction *txn = new Transaction(READONLY_TXN_ID, snapshot_cid, true);
+  txn->SetHistorical(true);
+
+  auto eid = epoch_manager.EnterReadOnlyEpoch(snapshot_cid);
+  txn->SetEpochId(eid);
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()
+      ->GetTxnLatencyMetric()
+      .StartTimer();
+  }
+
+  return txn;
+}
+
 void TimestampOrderingTransactionManager::EndTransaction(Transaction *current_txn) {
   EpochManagerFactory::GetInstance().ExitEpoch(current_txn->GetEpochId());
   auto &log_manager = logging::LogManager::GetInstance();
 
   if (current_txn->GetResult() == RESULT_SUCCESS) {
     gc::GCManagerFactory::GetInstance().
-        RecycleTransaction(current_txn->GetGCSetPtr(), current_txn->GetBeginCommitId(), GC_SET_TYPE_COMMITTED);
+        RecycleTransaction(current_txn->GetGCSetPtr(), current_txn->GetEndCommitId(), GC_SET_TYPE_COMMITTED);
         // Log the transaction's commit
-        // For time stamp ordering, every transaction only has one timestamp
-        log_manager.LogCommitTransaction(current_txn->GetBeginCommitId());
+        log_manager.LogCommitTransaction(current_txn->GetEndCommitId());
   } else {
     gc::GCManagerFactory::GetInstance().
         RecycleTransaction(current_txn->GetGCSetPtr(), GetNextCommitId(), GC_SET_TYPE_ABORTED);
@@ -153,6 +189,9 @@ void TimestampOrderingTransactionManager::EndTransaction(Transaction *current_tx
 void TimestampOrderingTransactionManager::EndReadonlyTransaction(Transaction *current_txn) {
   PL_ASSERT(current_txn->IsDeclaredReadOnly() == true);
   EpochManagerFactory::GetInstance().ExitReadOnlyEpoch(current_txn->GetEpochId());
+  if (current_txn->IsHistorical() == true) {
+    ReleaseSnapshot(current_txn->GetBeginCommitId());
+  }
 
   delete current_txn;
   current_txn = nullptr;
@@ -175,10 +214,30 @@ TimestampOrderingTransactionManager &TimestampOrderingTransactionManager::GetIns
 bool TimestampOrderingTransactionManager::IsOccupied(
     Transaction *const current_txn, 
     const void *position_ptr) {
-  ItemPointer &position = *((ItemPointer*)position_ptr);
+  ItemPointer position = *((ItemPointer*)position_ptr);
 
-  auto tile_group_header =
-      catalog::Manager::GetInstance().GetTileGroup(position.block)->GetHeader();
+  auto &manager = catalog::Manager::GetInstance();
+  auto tile_group_header = manager.GetTileGroupHeader(position.block);
+
+  // the newest version decides, skip the versions older than it
+  if (IsOldestToNewest(tile_group_header) == true) {
+    while (true) {
+      auto newer_position =
+          tile_group_header->GetPrevItemPointer(position.offset);
+      if (newer_position.IsNull() == true) {
+        break;
+      }
+      auto newer_tile_group_header =
+          manager.GetTileGroupHeader(newer_position.block);
+      // a version being installed or aborted
+      if (newer_tile_group_header->GetTransactionId(newer_position.offset) ==
+          INVALID_TXN_ID) {
+        break;
+      }
+      position = newer_position;
+      tile_group_header = newer_tile_group_header;
+    }
+  }
   auto tuple_id = position.offset;
 
   txn_id_t tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
@@ -356,7 +415,7 @@ bool TimestampOrderingTransactionManager::AcquireOwnership(
   // to acquire the ownership, we must guarantee that no other transactions that
   // has read
   // the tuple has a larger timestamp than the current transaction.
-  GetSpinlockField(tile_group_header, tuple_id)->Lock();
+  GetSpinlockField(tile_group_header, tuple_id)->Lock(WAIT_CLASS_TUPLE_LOCK);
   // change timestamp
   cid_t last_reader_cid = GetLastReaderCommitId(tile_group_header, tuple_id);
 
@@ -391,7 +450,7 @@ void TimestampOrderingTransactionManager::YieldOwnership(
     const oid_t &tuple_id) {
 
   auto &manager = catalog::Manager::GetInstance();
-  auto tile_group_header = manager.GetTileGroup(tile_group_id)->GetHeader();
+  auto tile_group_header = manager.GetTileGroupHeader(tile_group_id);
   PL_ASSERT(IsOwner(current_txn, tile_group_header, tuple_id));
   tile_group_header->SetTransactionId(tuple_id, INITIAL_TXN_ID);
 }
@@ -409,8 +468,7 @@ bool TimestampOrderingTransactionManager::PerformRead(
 
   LOG_TRACE("PerformRead (%u, %u)\n", location.block, location.offset);
   auto &manager = catalog::Manager::GetInstance();
-  auto tile_group = manager.GetTileGroup(tile_group_id);
-  auto tile_group_header = tile_group->GetHeader();
+  auto tile_group_header = manager.GetTileGroupHeader(tile_group_id);
 
   // Check if it's select for update before we check the ownership and modify the
   // last reader tid
@@ -469,7 +527,7 @@ void TimestampOrderingTransactionManager::PerformInsert(
   oid_t tuple_id = location.offset;
 
   auto &manager = catalog::Manager::GetInstance();
-  auto tile_group_header = manager.GetTileGroup(tile_group_id)->GetHeader();
+  auto tile_group_header = manager.GetTileGroupHeader(tile_group_id);
   auto transaction_id = current_txn->GetTransactionId();
 
   // check MVCC info
@@ -508,12 +566,10 @@ void TimestampOrderingTransactionManager::PerformUpdate(
   LOG_TRACE("Performing Write new tuple %u %u", new_location.block,
             new_location.offset);
 
-  auto tile_group_header = catalog::Manager::GetInstance()
-                               .GetTileGroup(old_location.block)
-                               ->GetHeader();
-  auto new_tile_group_header = catalog::Manager::GetInstance()
-                                   .GetTileGroup(new_location.block)
-                                   ->GetHeader();
+  auto tile_group_header =
+      catalog::Manager::GetInstance().GetTileGroupHeader(old_location.block);
+  auto new_tile_group_header =
+      catalog::Manager::GetInstance().GetTileGroupHeader(new_location.block);
 
   auto transaction_id = current_txn->GetTransactionId();
   // if we can perform update, then we must have already locked the older
@@ -534,8 +590,6 @@ void TimestampOrderingTransactionManager::PerformUpdate(
 
   auto old_prev = tile_group_header->GetPrevItemPointer(old_location.offset);
 
-  tile_group_header->SetPrevItemPointer(old_location.offset, new_location);
-
   new_tile_group_header->SetPrevItemPointer(new_location.offset, old_prev);
 
   new_tile_group_header->SetNextItemPointer(new_location.offset, old_location);
@@ -546,10 +600,12 @@ void TimestampOrderingTransactionManager::PerformUpdate(
   // newer version to older version.
   COMPILER_MEMORY_FENCE;
 
+  // the oldest-to-newest chains are traversed through this link
+  tile_group_header->SetPrevItemPointer(old_location.offset, new_location);
+
   if (old_prev.IsNull() == false) {
-    auto old_prev_tile_group_header = catalog::Manager::GetInstance()
-                                          .GetTileGroup(old_prev.block)
-                                          ->GetHeader();
+    auto old_prev_tile_group_header =
+        catalog::Manager::GetInstance().GetTileGroupHeader(old_prev.block);
 
 
     // once everything is set, we can allow traversing the new version.
@@ -561,7 +617,12 @@ void TimestampOrderingTransactionManager::PerformUpdate(
 
   // if the transaction is not updating the latest version,
   // then do not change item pointer header.
-  if (old_prev.IsNull() == true) {
+  if (IsOldestToNewest(tile_group_header) == true) {
+    // the new version is appended, the index still points to the oldest one
+    new_tile_group_header->SetIndirection(
+        new_location.offset,
+        tile_group_header->GetIndirection(old_location.offset));
+  } else if (old_prev.IsNull() == true) {
     // if we are updating the latest version.
     // Set the header information for the new version
     ItemPointer *index_entry_ptr =
@@ -602,7 +663,7 @@ void TimestampOrderingTransactionManager::PerformUpdate(
   oid_t tuple_id = location.offset;
 
   auto &manager = catalog::Manager::GetInstance();
-  auto tile_group_header = manager.GetTileGroup(tile_group_id)->GetHeader();
+  auto tile_group_header = manager.GetTileGroupHeader(tile_group_id);
 
   PL_ASSERT(tile_group_header->GetTransactionId(tuple_id) ==
             current_txn->GetTransactionId());
@@ -630,12 +691,10 @@ void TimestampOrderingTransactionManager::PerformDelete(
 
   LOG_TRACE("Performing Delete");
 
-  auto tile_group_header = catalog::Manager::GetInstance()
-                               .GetTileGroup(old_location.block)
-                               ->GetHeader();
-  auto new_tile_group_header = catalog::Manager::GetInstance()
-                                   .GetTileGroup(new_location.block)
-                                   ->GetHeader();
+  auto tile_group_header =
+      catalog::Manager::GetInstance().GetTileGroupHeader(old_location.block);
+  auto new_tile_group_header =
+      catalog::Manager::GetInstance().GetTileGroupHeader(new_location.block);
 
   auto transaction_id = current_txn->GetTransactionId();
 
@@ -655,8 +714,6 @@ void TimestampOrderingTransactionManager::PerformDelete(
 
   auto old_prev = tile_group_header->GetPrevItemPointer(old_location.offset);
 
-  tile_group_header->SetPrevItemPointer(old_location.offset, new_location);
-
   new_tile_group_header->SetPrevItemPointer(new_location.offset, old_prev);
 
   new_tile_group_header->SetNextItemPointer(new_location.offset, old_location);
@@ -669,10 +726,12 @@ void TimestampOrderingTransactionManager::PerformDelete(
   // newer version to older version.
   COMPILER_MEMORY_FENCE;
 
+  // the oldest-to-newest chains are traversed through this link
+  tile_group_header->SetPrevItemPointer(old_location.offset, new_location);
+
   if (old_prev.IsNull() == false) {
-    auto old_prev_tile_group_header = catalog::Manager::GetInstance()
-                                          .GetTileGroup(old_prev.block)
-                                          ->GetHeader();
+    auto old_prev_tile_group_header =
+        catalog::Manager::GetInstance().GetTileGroupHeader(old_prev.block);
 
     old_prev_tile_group_header->SetNextItemPointer(old_prev.offset,
                                                    new_location);
@@ -682,7 +741,12 @@ void TimestampOrderingTransactionManager::PerformDelete(
 
   // if the transaction is not deleting the latest version,
   // then do not change item pointer header.
-  if (old_prev.IsNull() == true) {
+  if (IsOldestToNewest(tile_group_header) == true) {
+    // the empty version is appended, the index still points to the oldest one
+    new_tile_group_header->SetIndirection(
+        new_location.offset,
+        tile_group_header->GetIndirection(old_location.offset));
+  } else if (old_prev.IsNull() == true) {
     // if we are deleting the latest version.
     // Set the header information for the new version
     ItemPointer *index_entry_ptr =
@@ -723,7 +787,7 @@ void TimestampOrderingTransactionManager::PerformDelete(
   oid_t tuple_id = location.offset;
 
   auto &manager = catalog::Manager::GetInstance();
-  auto tile_group_header = manager.GetTileGroup(tile_group_id)->GetHeader();
+  auto tile_group_header = manager.GetTileGroupHeader(tile_group_id);
 
   PL_ASSERT(tile_group_header->GetTransactionId(tuple_id) ==
             current_txn->GetTransactionId());
@@ -757,11 +821,18 @@ Result TimestampOrderingTransactionManager::CommitTransaction(
     return RESULT_SUCCESS;
   }
 
+  // for time stamp ordering, every transaction only has one timestamp
+  return CommitWriteSet(current_txn, current_txn->GetBeginCommitId());
+}
+
+// install the versions of the write set with the given commit id, and end
+// the transaction.
+Result TimestampOrderingTransactionManager::CommitWriteSet(
+    Transaction *const current_txn, const cid_t &end_commit_id) {
   auto &manager = catalog::Manager::GetInstance();
   auto &log_manager = logging::LogManager::GetInstance();
 
-  // generate transaction id.
-  cid_t end_commit_id = current_txn->GetBeginCommitId();
+  current_txn->SetEndCommitId(end_commit_id);
   log_manager.LogBeginTransaction(end_commit_id);
 
   auto &rw_set = current_txn->GetReadWriteSet();
@@ -771,8 +842,8 @@ Result TimestampOrderingTransactionManager::CommitTransaction(
   oid_t database_id = 0;
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
     if (!rw_set.empty()) {
-      database_id =
-          manager.GetTileGroup(rw_set.begin()->first)->GetDatabaseId();
+      database_id = manager.GetTileGroupPtr(rw_set.begin()->location.block)
+                        ->GetDatabaseId();
     }
   }
 
@@ -780,113 +851,115 @@ Result TimestampOrderingTransactionManager::CommitTransaction(
   // 1. install a new version for update operations;
   // 2. install an empty version for delete operations;
   // 3. install a new tuple for insert operations.
-  for (auto &tile_group_entry : rw_set) {
-    oid_t tile_group_id = tile_group_entry.first;
-    auto tile_group = manager.GetTileGroup(tile_group_id);
-    auto tile_group_header = tile_group->GetHeader();
-    for (auto &tuple_entry : tile_group_entry.second) {
-      auto tuple_slot = tuple_entry.first;
-      if (tuple_entry.second == RW_TYPE_READ_OWN) {
-        // A read operation has acquired ownership but hasn't done any further update/delete yet
-        // Yield the ownership
-        YieldOwnership(current_txn, tile_group_id, tuple_slot);
-      } else if (tuple_entry.second == RW_TYPE_UPDATE) {
-        // we must guarantee that, at any time point, only one version is
-        // visible.
-        ItemPointer new_version =
-            tile_group_header->GetPrevItemPointer(tuple_slot);
+  oid_t tile_group_id = INVALID_OID;
+  storage::TileGroupHeader *tile_group_header = nullptr;
+  for (auto &rw_entry : rw_set) {
+    // consecutive entries are mostly in the same tile group
+    if (rw_entry.location.block != tile_group_id) {
+      tile_group_id = rw_entry.location.block;
+      tile_group_header = manager.GetTileGroupHeader(tile_group_id);
+    }
+    auto tuple_slot = rw_entry.location.offset;
+    if (rw_entry.type == RW_TYPE_READ_OWN) {
+      // A read operation has acquired ownership but hasn't done any further update/delete yet
+      // Yield the ownership
+      YieldOwnership(current_txn, tile_group_id, tuple_slot);
+    } else if (rw_entry.type == RW_TYPE_UPDATE) {
+      // we must guarantee that, at any time point, only one version is
+      // visible.
+      ItemPointer new_version =
+          tile_group_header->GetPrevItemPointer(tuple_slot);
 
-        PL_ASSERT(new_version.IsNull() == false);
+      PL_ASSERT(new_version.IsNull() == false);
 
-        auto cid = tile_group_header->GetEndCommitId(tuple_slot);
-        PL_ASSERT(cid > end_commit_id);
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
-        new_tile_group_header->SetBeginCommitId(new_version.offset,
-                                                end_commit_id);
-        new_tile_group_header->SetEndCommitId(new_version.offset, cid);
+      auto cid = tile_group_header->GetEndCommitId(tuple_slot);
+      PL_ASSERT(cid > end_commit_id);
+      auto new_tile_group_header =
+          manager.GetTileGroupHeader(new_version.block);
+      new_tile_group_header->SetBeginCommitId(new_version.offset,
+                                              end_commit_id);
+      new_tile_group_header->SetEndCommitId(new_version.offset, cid);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
+      tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INITIAL_TXN_ID);
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INITIAL_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
-        // add to gc set.
-        gc_set->operator[](tile_group_id)[tuple_slot] = RW_TYPE_UPDATE;
+      // add to gc set.
+      gc_set->Insert(ItemPointer(tile_group_id, tuple_slot), RW_TYPE_UPDATE);
 
-        // add to log manager
-        log_manager.LogUpdate(end_commit_id, ItemPointer(tile_group_id, tuple_slot), new_version);
+      // add to log manager
+      log_manager.LogUpdate(end_commit_id, ItemPointer(tile_group_id, tuple_slot), new_version);
 
-      } else if (tuple_entry.second == RW_TYPE_DELETE) {
-        ItemPointer new_version =
-            tile_group_header->GetPrevItemPointer(tuple_slot);
+    } else if (rw_entry.type == RW_TYPE_DELETE) {
+      ItemPointer new_version =
+          tile_group_header->GetPrevItemPointer(tuple_slot);
 
-        auto cid = tile_group_header->GetEndCommitId(tuple_slot);
-        PL_ASSERT(cid > end_commit_id);
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
-        new_tile_group_header->SetBeginCommitId(new_version.offset,
-                                                end_commit_id);
-        new_tile_group_header->SetEndCommitId(new_version.offset, cid);
+      auto cid = tile_group_header->GetEndCommitId(tuple_slot);
+      PL_ASSERT(cid > end_commit_id);
+      auto new_tile_group_header =
+          manager.GetTileGroupHeader(new_version.block);
+      new_tile_group_header->SetBeginCommitId(new_version.offset,
+                                              end_commit_id);
+      new_tile_group_header->SetEndCommitId(new_version.offset, cid);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
+      tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INVALID_TXN_ID);
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INVALID_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
-        // add to gc set.
-        gc_set->operator[](tile_group_id)[tuple_slot] = RW_TYPE_DELETE;
+      // add to gc set.
+      gc_set->Insert(ItemPointer(tile_group_id, tuple_slot), RW_TYPE_DELETE);
 
-        // add to log manager
-        log_manager.LogDelete(end_commit_id, ItemPointer(tile_group_id, tuple_slot));
+      // add to log manager
+      log_manager.LogDelete(end_commit_id, ItemPointer(tile_group_id, tuple_slot));
 
-      } else if (tuple_entry.second == RW_TYPE_INSERT) {
-        PL_ASSERT(tile_group_header->GetTransactionId(tuple_slot) ==
-                  current_txn->GetTransactionId());
-        // set the begin commit id to persist insert
-        tile_group_header->SetBeginCommitId(tuple_slot, end_commit_id);
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+    } else if (rw_entry.type == RW_TYPE_INSERT) {
+      PL_ASSERT(tile_group_header->GetTransactionId(tuple_slot) ==
+                current_txn->GetTransactionId());
+      // set the begin commit id to persist insert
+      tile_group_header->SetBeginCommitId(tuple_slot, end_commit_id);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
-        // nothing to be added to gc set.
+      // nothing to be added to gc set.
 
-        // add to log manager
-        log_manager.LogInsert(end_commit_id, ItemPointer(tile_group_id, tuple_slot));
+      // add to log manager
+      log_manager.LogInsert(end_commit_id, ItemPointer(tile_group_id, tuple_slot));
 
-      } else if (tuple_entry.second == RW_TYPE_INS_DEL) {
-        PL_ASSERT(tile_group_header->GetTransactionId(tuple_slot) ==
-                  current_txn->GetTransactionId());
+    } else if (rw_entry.type == RW_TYPE_INS_DEL) {
+      PL_ASSERT(tile_group_header->GetTransactionId(tuple_slot) ==
+                current_txn->GetTransactionId());
 
-        tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        // set the begin commit id to persist insert
-        tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
+      // set the begin commit id to persist insert
+      tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
 
-        // add to gc set.
-        gc_set->operator[](tile_group_id)[tuple_slot] = RW_TYPE_INS_DEL;
+      // add to gc set.
+      gc_set->Insert(ItemPointer(tile_group_id, tuple_slot), RW_TYPE_INS_DEL);
 
-        // no log is needed for this case
-      }
+      // no log is needed for this case
     }
   }
 
@@ -918,158 +991,161 @@ Result TimestampOrderingTransactionManager::AbortTransaction(
   oid_t database_id = 0;
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
     if (!rw_set.empty()) {
-      database_id =
-          manager.GetTileGroup(rw_set.begin()->first)->GetDatabaseId();
+      database_id = manager.GetTileGroupPtr(rw_set.begin()->location.block)
+                        ->GetDatabaseId();
     }
   }
 
-  for (auto &tile_group_entry : rw_set) {
-    oid_t tile_group_id = tile_group_entry.first;
-    auto tile_group = manager.GetTileGroup(tile_group_id);
-    auto tile_group_header = tile_group->GetHeader();
-
-    for (auto &tuple_entry : tile_group_entry.second) {
-      auto tuple_slot = tuple_entry.first;
-      if (tuple_entry.second == RW_TYPE_READ_OWN) {
-        // A read operation has acquired ownership but hasn't done any further update/delete yet
-        // Yield the ownership
-        YieldOwnership(current_txn, tile_group_id, tuple_slot);
-      } else if (tuple_entry.second == RW_TYPE_UPDATE) {
-        ItemPointer new_version =
-            tile_group_header->GetPrevItemPointer(tuple_slot);
-
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
-
-        // these two fields can be set at any time.
-        new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
-        new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
-
-        COMPILER_MEMORY_FENCE;
-
-        // as the aborted version has already been placed in the version chain,
-        // we need to unlink it by resetting the item pointers.
-        auto old_prev =
-            new_tile_group_header->GetPrevItemPointer(new_version.offset);
-
-        // check whether the previous version exists.
-        if (old_prev.IsNull() == true) {
-          PL_ASSERT(tile_group_header->GetEndCommitId(tuple_slot) == MAX_CID);
-          // if we updated the latest version.
-          // We must first adjust the head pointer
-          // before we unlink the aborted version from version list
-          ItemPointer *index_entry_ptr =
-              tile_group_header->GetIndirection(tuple_slot);
-          UNUSED_ATTRIBUTE auto res = AtomicUpdateItemPointer(
-              index_entry_ptr, ItemPointer(tile_group_id, tuple_slot));
-          PL_ASSERT(res == true);
-        }
-        //////////////////////////////////////////////////
+  oid_t tile_group_id = INVALID_OID;
+  storage::TileGroupHeader *tile_group_header = nullptr;
+  for (auto &rw_entry : rw_set) {
+    // consecutive entries are mostly in the same tile group
+    if (rw_entry.location.block != tile_group_id) {
+      tile_group_id = rw_entry.location.block;
+      tile_group_header = manager.GetTileGroupHeader(tile_group_id);
+    }
+    auto tuple_slot = rw_entry.location.offset;
+    if (rw_entry.type == RW_TYPE_READ_OWN) {
+      // A read operation has acquired ownership but hasn't done any further update/delete yet
+      // Yield the ownership
+      YieldOwnership(current_txn, tile_group_id, tuple_slot);
+    } else if (rw_entry.type == RW_TYPE_UPDATE) {
+      ItemPointer new_version =
+          tile_group_header->GetPrevItemPointer(tuple_slot);
+
+      auto new_tile_group_header =
+          manager.GetTileGroupHeader(new_version.block);
+
+      // these two fields can be set at any time.
+      new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
+      new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
+
+      COMPILER_MEMORY_FENCE;
+
+      // as the aborted version has already been placed in the version chain,
+      // we need to unlink it by resetting the item pointers.
+      auto old_prev =
+          new_tile_group_header->GetPrevItemPointer(new_version.offset);
+
+      // check whether the previous version exists. the index never pointed
+      // to the appended versions of the oldest-to-newest chains.
+      if (old_prev.IsNull() == true &&
+          IsOldestToNewest(tile_group_header) == false) {
+        PL_ASSERT(tile_group_header->GetEndCommitId(tuple_slot) == MAX_CID);
+        // if we updated the latest version.
+        // We must first adjust the head pointer
+        // before we unlink the aborted version from version list
+        ItemPointer *index_entry_ptr =
+            tile_group_header->GetIndirection(tuple_slot);
+        UNUSED_ATTRIBUTE auto res = AtomicUpdateItemPointer(
+            index_entry_ptr, ItemPointer(tile_group_id, tuple_slot));
+        PL_ASSERT(res == true);
+      }
+      //////////////////////////////////////////////////
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INVALID_TXN_ID);
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INVALID_TXN_ID);
 
-        if (old_prev.IsNull() == false) {
-          auto old_prev_tile_group_header = catalog::Manager::GetInstance()
-                                                .GetTileGroup(old_prev.block)
-                                                ->GetHeader();
-          old_prev_tile_group_header->SetNextItemPointer(
-              old_prev.offset, ItemPointer(tile_group_id, tuple_slot));
-          tile_group_header->SetPrevItemPointer(tuple_slot, old_prev);
-        } else {
-          tile_group_header->SetPrevItemPointer(tuple_slot, INVALID_ITEMPOINTER);
-        }
+      if (old_prev.IsNull() == false) {
+        auto old_prev_tile_group_header =
+            manager.GetTileGroupHeader(old_prev.block);
+        old_prev_tile_group_header->SetNextItemPointer(
+            old_prev.offset, ItemPointer(tile_group_id, tuple_slot));
+        tile_group_header->SetPrevItemPointer(tuple_slot, old_prev);
+      } else {
+        tile_group_header->SetPrevItemPointer(tuple_slot, INVALID_ITEMPOINTER);
+      }
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
-        // add to gc set.
-        gc_set->operator[](new_version.block)[new_version.offset] = RW_TYPE_UPDATE;
+      // add to gc set.
+      gc_set->Insert(new_version, RW_TYPE_UPDATE);
 
-      } else if (tuple_entry.second == RW_TYPE_DELETE) {
+    } else if (rw_entry.type == RW_TYPE_DELETE) {
 
-        ItemPointer new_version =
-            tile_group_header->GetPrevItemPointer(tuple_slot);
+      ItemPointer new_version =
+          tile_group_header->GetPrevItemPointer(tuple_slot);
 
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
+      auto new_tile_group_header =
+          manager.GetTileGroupHeader(new_version.block);
 
-        new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
-        new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
+      new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
+      new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        // as the aborted version has already been placed in the version chain,
-        // we need to unlink it by resetting the item pointers.
-        auto old_prev =
-            new_tile_group_header->GetPrevItemPointer(new_version.offset);
+      // as the aborted version has already been placed in the version chain,
+      // we need to unlink it by resetting the item pointers.
+      auto old_prev =
+          new_tile_group_header->GetPrevItemPointer(new_version.offset);
 
-        // check whether the previous version exists.
-        if (old_prev.IsNull() == true) {
-          // if we updated the latest version.
-          // We must first adjust the head pointer
-          // before we unlink the aborted version from version list
-          ItemPointer *index_entry_ptr =
-              tile_group_header->GetIndirection(tuple_slot);
-          UNUSED_ATTRIBUTE auto res = AtomicUpdateItemPointer(
-              index_entry_ptr, ItemPointer(tile_group_id, tuple_slot));
-          PL_ASSERT(res == true);
-        }
-        //////////////////////////////////////////////////
+      // check whether the previous version exists. the index never pointed
+      // to the appended versions of the oldest-to-newest chains.
+      if (old_prev.IsNull() == true &&
+          IsOldestToNewest(tile_group_header) == false) {
+        // if we updated the latest version.
+        // We must first adjust the head pointer
+        // before we unlink the aborted version from version list
+        ItemPointer *index_entry_ptr =
+            tile_group_header->GetIndirection(tuple_slot);
+        UNUSED_ATTRIBUTE auto res = AtomicUpdateItemPointer(
+            index_entry_ptr, ItemPointer(tile_group_id, tuple_slot));
+        PL_ASSERT(res == true);
+      }
+      //////////////////////////////////////////////////
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INVALID_TXN_ID);
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INVALID_TXN_ID);
 
-        if (old_prev.IsNull() == false) {
-          auto old_prev_tile_group_header = catalog::Manager::GetInstance()
-                                                .GetTileGroup(old_prev.block)
-                                                ->GetHeader();
-          old_prev_tile_group_header->SetNextItemPointer(
-              old_prev.offset, ItemPointer(tile_group_id, tuple_slot));
-        }
+      if (old_prev.IsNull() == false) {
+        auto old_prev_tile_group_header =
+            manager.GetTileGroupHeader(old_prev.block);
+        old_prev_tile_group_header->SetNextItemPointer(
+            old_prev.offset, ItemPointer(tile_group_id, tuple_slot));
+      }
 
-        tile_group_header->SetPrevItemPointer(tuple_slot, old_prev);
+      tile_group_header->SetPrevItemPointer(tuple_slot, old_prev);
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
-        // add to gc set.
-        gc_set->operator[](new_version.block)[new_version.offset] = RW_TYPE_DELETE;
+      // add to gc set.
+      gc_set->Insert(new_version, RW_TYPE_DELETE);
 
-      } else if (tuple_entry.second == RW_TYPE_INSERT) {
-        tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+    } else if (rw_entry.type == RW_TYPE_INSERT) {
+      tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
 
-        // add to gc set.
-        gc_set->operator[](tile_group_id)[tuple_slot] = RW_TYPE_INSERT;
+      // add to gc set.
+      gc_set->Insert(ItemPointer(tile_group_id, tuple_slot), RW_TYPE_INSERT);
 
-      } else if (tuple_entry.second == RW_TYPE_INS_DEL) {
-        tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+    } else if (rw_entry.type == RW_TYPE_INS_DEL) {
+      tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
 
-        // add to gc set.
-        gc_set->operator[](tile_group_id)[tuple_slot] = RW_TYPE_INS_DEL;
-      }
+      // add to gc set.
+      gc_set->Insert(ItemPointer(tile_group_id, tuple_slot), RW_TYPE_INS_DEL);
     }
   }
 
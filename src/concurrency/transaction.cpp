@@ -46,78 +46,59 @@ namespace concurrency {
  *    i: insert
  */
 
+// the lookup may build the index of the set, while the workers of a parallel
+// pipeline insert into it
 RWType Transaction::GetRWType(const ItemPointer &location) {
-  oid_t tile_group_id = location.block;
-  oid_t tuple_id = location.offset;
-  auto itr = rw_set_.find(tile_group_id);
-  if (itr == rw_set_.end()) {
-    return RW_TYPE_INVALID;
-  }
-
-  auto inner_itr = itr->second.find(tuple_id);
-  if (inner_itr == itr->second.end()) {
-    return RW_TYPE_INVALID;
-  }
+  rw_set_lock_.Lock();
+  auto type = rw_set_.Find(location);
+  auto rw_type = (type == nullptr) ? RW_TYPE_INVALID : *type;
+  rw_set_lock_.Unlock();
 
-  return inner_itr->second;
+  return rw_type;
 }
 
 void Transaction::RecordRead(const ItemPointer &location) {
-  oid_t tile_group_id = location.block;
-  oid_t tuple_id = location.offset;
-
-  if (rw_set_.find(tile_group_id) != rw_set_.end() &&
-      rw_set_.at(tile_group_id).find(tuple_id) !=
-          rw_set_.at(tile_group_id).end()) {
-    PL_ASSERT(rw_set_.at(tile_group_id).at(tuple_id) != RW_TYPE_DELETE &&
-              rw_set_.at(tile_group_id).at(tuple_id) != RW_TYPE_INS_DEL);
-    return;
+  rw_set_lock_.Lock();
+  auto type = rw_set_.Find(location);
+  if (type != nullptr) {
+    PL_ASSERT(*type != RW_TYPE_DELETE && *type != RW_TYPE_INS_DEL);
   } else {
-    rw_set_[tile_group_id][tuple_id] = RW_TYPE_READ;
+    rw_set_.Insert(location, RW_TYPE_READ);
   }
+  rw_set_lock_.Unlock();
 }
 
 void Transaction::RecordReadOwn(const ItemPointer &location) {
-  oid_t tile_group_id = location.block;
-  oid_t tuple_id = location.offset;
-
-  if (rw_set_.find(tile_group_id) != rw_set_.end() &&
-      rw_set_.at(tile_group_id).find(tuple_id) !=
-      rw_set_.at(tile_group_id).end()) {
-    RWType &type = rw_set_.at(tile_group_id).at(tuple_id);
-    if (type == RW_TYPE_READ) {
-      type = RW_TYPE_READ_OWN;
-      // record write.
-      return;
+  rw_set_lock_.Lock();
+  auto type = rw_set_.Find(location);
+  if (type != nullptr) {
+    if (*type == RW_TYPE_READ) {
+      *type = RW_TYPE_READ_OWN;
     }
-    PL_ASSERT(type != RW_TYPE_DELETE && type != RW_TYPE_INS_DEL);
+    PL_ASSERT(*type != RW_TYPE_DELETE && *type != RW_TYPE_INS_DEL);
   } else {
-    rw_set_[tile_group_id][tuple_id] = RW_TYPE_READ_OWN;
+    rw_set_.Insert(location, RW_TYPE_READ_OWN);
   }
+  rw_set_lock_.Unlock();
 }
 
 void Transaction::RecordUpdate(const ItemPointer &location) {
-  oid_t tile_group_id = location.block;
-  oid_t tuple_id = location.offset;
-
-  if (rw_set_.find(tile_group_id) != rw_set_.end() &&
-      rw_set_.at(tile_group_id).find(tuple_id) !=
-          rw_set_.at(tile_group_id).end()) {
-    RWType &type = rw_set_.at(tile_group_id).at(tuple_id);
-    if (type == RW_TYPE_READ || type == RW_TYPE_READ_OWN) {
-      type = RW_TYPE_UPDATE;
+  auto type = rw_set_.Find(location);
+  if (type != nullptr) {
+    if (*type == RW_TYPE_READ || *type == RW_TYPE_READ_OWN) {
+      *type = RW_TYPE_UPDATE;
       // record write.
       is_written_ = true;
 
       return;
     }
-    if (type == RW_TYPE_UPDATE) {
+    if (*type == RW_TYPE_UPDATE) {
       return;
     }
-    if (type == RW_TYPE_INSERT) {
+    if (*type == RW_TYPE_INSERT) {
       return;
     }
-    if (type == RW_TYPE_DELETE) {
+    if (*type == RW_TYPE_DELETE) {
       PL_ASSERT(false);
       return;
     }
@@ -126,47 +107,36 @@ void Transaction::RecordUpdate(const ItemPointer &location) {
 }
 
 void Transaction::RecordInsert(const ItemPointer &location) {
-  oid_t tile_group_id = location.block;
-  oid_t tuple_id = location.offset;
-
-  if (rw_set_.find(tile_group_id) != rw_set_.end() &&
-      rw_set_.at(tile_group_id).find(tuple_id) !=
-          rw_set_.at(tile_group_id).end()) {
+  if (rw_set_.Find(location) != nullptr) {
     PL_ASSERT(false);
   } else {
-    rw_set_[tile_group_id][tuple_id] = RW_TYPE_INSERT;
+    rw_set_.Insert(location, RW_TYPE_INSERT);
     ++insert_count_;
-
   }
 }
 
 bool Transaction::RecordDelete(const ItemPointer &location) {
-  oid_t tile_group_id = location.block;
-  oid_t tuple_id = location.offset;
-
-  if (rw_set_.find(tile_group_id) != rw_set_.end() &&
-      rw_set_.at(tile_group_id).find(tuple_id) !=
-          rw_set_.at(tile_group_id).end()) {
-    RWType &type = rw_set_.at(tile_group_id).at(tuple_id);
-    if (type == RW_TYPE_READ || type == RW_TYPE_READ_OWN) {
-      type = RW_TYPE_DELETE;
+  auto type = rw_set_.Find(location);
+  if (type != nullptr) {
+    if (*type == RW_TYPE_READ || *type == RW_TYPE_READ_OWN) {
+      *type = RW_TYPE_DELETE;
       // record write.
       is_written_ = true;
 
       return false;
     }
-    if (type == RW_TYPE_UPDATE) {
-      type = RW_TYPE_DELETE;
+    if (*type == RW_TYPE_UPDATE) {
+      *type = RW_TYPE_DELETE;
 
       return false;
     }
-    if (type == RW_TYPE_INSERT) {
-      type = RW_TYPE_INS_DEL;
+    if (*type == RW_TYPE_INSERT) {
+      *type = RW_TYPE_INS_DEL;
       --insert_count_;
 
       return true;
     }
-    if (type == RW_TYPE_DELETE) {
+    if (*type == RW_TYPE_DELETE) {
       PL_ASSERT(false);
       return false;
     }
@@ -11,6 +11,12 @@
 //===----------------------------------------------------------------------===//
 
 
+#include <chrono>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "common/config.h"
 #include "common/value.h"
 #include "common/logger.h"
 #include "executor/abstract_executor.h"
@@ -20,6 +26,14 @@
 namespace peloton {
 namespace executor {
 
+static inline uint64_t ReadCycleCounter() {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
 /**
  * @brief Constructor for AbstractExecutor.
  * @param node Abstract plan node corresponding to this executor.
@@ -76,6 +90,13 @@ bool AbstractExecutor::Init() {
     return false;
   }
 
+  // Executors may be initialized more than once, keep their statistics
+  if (executor_context_ != nullptr && executor_context_->IsProfiling() &&
+      profile_ == nullptr) {
+    profile_.reset(new ExecutorProfile());
+    profile_cycles_ = FLAGS_profile_cycles;
+  }
+
   return true;
 }
 
@@ -91,8 +112,32 @@ bool AbstractExecutor::Execute() {
   // TODO In the future, we might want to pass some kind of executor state to
   // GetNextTile. e.g. params for prepared plans.
 
+  // Profiling is off for almost all queries, keep that path to one branch
+  if (profile_ == nullptr) {
+    return DExecute();
+  }
+
+  return ProfiledExecute();
+}
+
+bool AbstractExecutor::ProfiledExecute() {
+  uint64_t start_cycles = profile_cycles_ ? ReadCycleCounter() : 0;
+  auto start_time = std::chrono::steady_clock::now();
+
   bool status = DExecute();
 
+  auto elapsed = std::chrono::steady_clock::now() - start_time;
+  profile_->wall_time_ns +=
+      std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+  if (profile_cycles_) {
+    profile_->cycles += ReadCycleCounter() - start_cycles;
+  }
+  profile_->calls++;
+  if (output != nullptr) {
+    profile_->tiles_out++;
+    profile_->rows_out += output->GetTupleCount();
+  }
+
   return status;
 }
 
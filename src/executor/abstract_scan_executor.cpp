@@ -17,13 +17,20 @@
 #include <utility>
 #include <vector>
 
+#include "common/exception.h"
 #include "common/types.h"
+#include "concurrency/transaction.h"
+#include "executor/executor_context.h"
 #include "executor/logical_tile.h"
 #include "executor/logical_tile_factory.h"
 #include "expression/abstract_expression.h"
+#include "expression/constant_value_expression.h"
+#include "expression/tuple_value_expression.h"
 #include "common/container_tuple.h"
+#include "storage/compressed_column.h"
 #include "storage/data_table.h"
 #include "storage/tile_group.h"
+#include "storage/zone_map.h"
 
 #include "common/logger.h"
 
@@ -54,8 +61,139 @@ bool AbstractScanExecutor::DInit() {
 
   column_ids_ = std::move(node.GetColumnIds());
 
+  column_predicates_.clear();
+  if (predicate_ != nullptr) {
+    GetColumnPredicates(predicate_, column_predicates_);
+  }
+
+  // The gc may have unlinked versions visible at the snapshot of a historical
+  // transaction, once the retention of the table ended
+  auto current_txn = executor_context_->GetTransaction();
+  auto table = node.GetTable();
+  if (current_txn->IsHistorical() == true && table != nullptr &&
+      table->IsSnapshotRetained(current_txn->GetBeginCommitId()) == false) {
+    throw ExecutorException("The versions of table " + table->GetName() +
+                            " at commit id " +
+                            std::to_string(current_txn->GetBeginCommitId()) +
+                            " are no longer retained");
+  }
+
   return true;
 }
 
+void AbstractScanExecutor::GetColumnPredicates(
+    const expression::AbstractExpression *expression,
+    std::vector<ColumnPredicate> &column_predicates) {
+  auto expression_type = expression->GetExpressionType();
+
+  if (expression_type == EXPRESSION_TYPE_CONJUNCTION_AND) {
+    for (size_t child_itr = 0; child_itr < expression->GetChildrenSize();
+         child_itr++) {
+      GetColumnPredicates(expression->GetChild(child_itr), column_predicates);
+    }
+    return;
+  }
+
+  switch (expression_type) {
+    case EXPRESSION_TYPE_COMPARE_EQUAL:
+    case EXPRESSION_TYPE_COMPARE_NOTEQUAL:
+    case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+    case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+    case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+    case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+      break;
+    default:
+      return;
+  }
+
+  auto left = expression->GetChild(0);
+  auto right = expression->GetChild(1);
+  if (left == nullptr || right == nullptr) {
+    return;
+  }
+
+  // "constant <comparison> column" is "column <mirrored comparison> constant"
+  if (left->GetExpressionType() == EXPRESSION_TYPE_VALUE_CONSTANT &&
+      right->GetExpressionType() == EXPRESSION_TYPE_VALUE_TUPLE) {
+    std::swap(left, right);
+    switch (expression_type) {
+      case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+        expression_type = EXPRESSION_TYPE_COMPARE_GREATERTHAN;
+        break;
+      case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+        expression_type = EXPRESSION_TYPE_COMPARE_LESSTHAN;
+        break;
+      case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+        expression_type = EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO;
+        break;
+      case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+        expression_type = EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO;
+        break;
+      default:
+        break;
+    }
+  }
+
+  if (left->GetExpressionType() != EXPRESSION_TYPE_VALUE_TUPLE ||
+      right->GetExpressionType() != EXPRESSION_TYPE_VALUE_CONSTANT) {
+    return;
+  }
+
+  auto tuple_value =
+      static_cast<const expression::TupleValueExpression *>(left);
+  auto constant_value =
+      static_cast<const expression::ConstantValueExpression *>(right);
+  if (tuple_value->GetTupleId() != 0 || tuple_value->GetColumnId() < 0) {
+    return;
+  }
+
+  column_predicates.push_back({(oid_t)tuple_value->GetColumnId(),
+                               expression_type, constant_value->GetValue()});
+}
+
+// a tile group can be skipped if its zone map rules out some conjunct of the
+// predicate
+bool AbstractScanExecutor::CanSkipTileGroup(
+    const std::vector<ColumnPredicate> &column_predicates,
+    storage::TileGroup *tile_group) {
+  auto zone_map = tile_group->GetZoneMap();
+  for (auto &column_predicate : column_predicates) {
+    if (zone_map->MightSatisfy(column_predicate.column_id,
+                               column_predicate.comparison_type,
+                               column_predicate.constant) == false) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool AbstractScanExecutor::EvaluateCompressedPredicates(
+    const std::vector<ColumnPredicate> &column_predicates,
+    storage::TileGroup *tile_group, const oid_t &tuple_count,
+    std::vector<bool> &matches) {
+  if (column_predicates.empty() == true ||
+      tile_group->IsCompressed() == false) {
+    return false;
+  }
+
+  bool evaluated = false;
+  for (auto &column_predicate : column_predicates) {
+    auto compressed_column =
+        tile_group->GetCompressedColumn(column_predicate.column_id);
+    if (compressed_column == nullptr) {
+      continue;
+    }
+
+    if (evaluated == false) {
+      matches.assign(tuple_count, true);
+      evaluated = true;
+    }
+    compressed_column->Evaluate(column_predicate.comparison_type,
+                                column_predicate.constant, matches);
+  }
+
+  return evaluated;
+}
+
 }  // namespace executor
 }  // namespace peloton
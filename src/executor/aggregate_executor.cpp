@@ -173,8 +173,7 @@ bool AggregateExecutor::DExecute() {
       PL_ASSERT(location.block != INVALID_OID);
 
       auto &manager = catalog::Manager::GetInstance();
-      auto tile_group_header =
-          manager.GetTileGroup(location.block)->GetHeader();
+      auto tile_group_header = manager.GetTileGroupHeader(location.block);
       tile_group_header->SetTransactionId(location.offset, INITIAL_TXN_ID);
 
     } else {
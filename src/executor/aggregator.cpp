@@ -141,7 +141,7 @@ bool Helper(const planner::AggregatePlan *node, Agg **aggregates,
     return false;
   } else {
     auto &manager = catalog::Manager::GetInstance();
-    auto tile_group_header = manager.GetTileGroup(location.block)->GetHeader();
+    auto tile_group_header = manager.GetTileGroupHeader(location.block);
     tile_group_header->SetTransactionId(location.offset, INITIAL_TXN_ID);
   }
   return true;
@@ -0,0 +1,327 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compiled_pipeline.cpp
+//
+// Identification: src/executor/compiled_pipeline.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <numeric>
+#include <vector>
+
+#include "catalog/manager.h"
+#include "common/config.h"
+#include "common/container_tuple.h"
+#include "common/logger.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/abstract_scan_executor.h"
+#include "executor/aggregator.h"
+#include "executor/compiled_pipeline.h"
+#include "executor/executor_context.h"
+#include "executor/logical_tile.h"
+#include "executor/logical_tile_factory.h"
+#include "expression/compiled_expression.h"
+#include "planner/aggregate_plan.h"
+#include "planner/projection_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "statistics/metric_series.h"
+#include "storage/data_table.h"
+#include "storage/shared_scan.h"
+#include "storage/table_factory.h"
+#include "storage/tile.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+
+namespace peloton {
+namespace executor {
+
+std::unique_ptr<CompiledPipeline> CompiledPipeline::Compile(
+    const planner::AbstractPlan *plan) {
+  std::unique_ptr<CompiledPipeline> pipeline(new CompiledPipeline());
+
+  // Walk down from the root, the operators in the order they are fused
+  if (plan != nullptr &&
+      plan->GetPlanNodeType() == PLAN_NODE_TYPE_AGGREGATE_V2) {
+    auto aggregate_plan = static_cast<const planner::AggregatePlan *>(plan);
+    // the scan is not sorted on the group by columns
+    if (aggregate_plan->GetAggregateStrategy() != AGGREGATE_TYPE_HASH &&
+        aggregate_plan->GetAggregateStrategy() != AGGREGATE_TYPE_PLAIN) {
+      return nullptr;
+    }
+    pipeline->aggregate_plan_ = aggregate_plan;
+    plan = (plan->GetChildren().size() == 1) ? plan->GetChildren()[0].get()
+                                             : nullptr;
+  }
+
+  if (plan != nullptr && plan->GetPlanNodeType() == PLAN_NODE_TYPE_PROJECTION) {
+    pipeline->projection_plan_ =
+        static_cast<const planner::ProjectionPlan *>(plan);
+    plan = (plan->GetChildren().size() == 1) ? plan->GetChildren()[0].get()
+                                             : nullptr;
+  }
+
+  if (plan == nullptr || plan->GetPlanNodeType() != PLAN_NODE_TYPE_SEQSCAN ||
+      plan->GetChildren().empty() == false) {
+    return nullptr;
+  }
+
+  // The rows of the metric tables are not in the table
+  auto scan_plan = static_cast<const planner::SeqScanPlan *>(plan);
+  if (scan_plan->GetTable() == nullptr ||
+      stats::MetricSeries::GetInstance(scan_plan->GetTable()) != nullptr) {
+    return nullptr;
+  }
+  pipeline->scan_plan_ = scan_plan;
+
+  LOG_TRACE("Compiled a pipeline of %s", scan_plan->GetInfo().c_str());
+  return pipeline;
+}
+
+bool CompiledPipeline::Execute(ExecutorContext *executor_context,
+                               const OutputConsumer &consumer) const {
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  auto current_txn = executor_context->GetTransaction();
+  bool acquire_owner = scan_plan_->IsForUpdate();
+  auto target_table = scan_plan_->GetTable();
+
+  std::vector<oid_t> column_ids = scan_plan_->GetColumnIds();
+  if (column_ids.empty()) {
+    column_ids.resize(target_table->GetSchema()->GetColumnCount());
+    std::iota(column_ids.begin(), column_ids.end(), 0);
+  }
+
+  // The predicate is re-bound to the parameters of this execution
+  auto predicate = scan_plan_->GetPredicate();
+  std::unique_ptr<expression::CompiledExpressionEvaluator> compiled_predicate;
+  if (predicate != nullptr && FLAGS_compile_expressions == true) {
+    auto compiled_expression =
+        scan_plan_->GetCompiledPredicate(executor_context->GetParams());
+    if (compiled_expression != nullptr &&
+        compiled_expression->GetValueType() == common::Type::BOOLEAN) {
+      compiled_predicate.reset(new expression::CompiledExpressionEvaluator(
+          compiled_expression, executor_context));
+    }
+  }
+
+  // The conjuncts checked against the zone maps and compressed columns
+  std::vector<AbstractScanExecutor::ColumnPredicate> column_predicates;
+  if (predicate != nullptr) {
+    AbstractScanExecutor::GetColumnPredicates(predicate, column_predicates);
+  }
+
+  // A single buffer for the projected tuples
+  const planner::ProjectInfo *project_info = nullptr;
+  const catalog::Schema *projection_schema = nullptr;
+  std::unique_ptr<storage::Tuple> projected_tuple;
+  if (projection_plan_ != nullptr) {
+    project_info = projection_plan_->GetProjectInfo();
+    projection_schema = projection_plan_->GetSchema();
+    projected_tuple.reset(new storage::Tuple(projection_schema, true));
+  }
+
+  // The aggregates are kept in a temporary table, as by the executor
+  std::unique_ptr<storage::DataTable> output_table;
+  std::unique_ptr<AbstractAggregator> aggregator;
+  if (aggregate_plan_ != nullptr) {
+    bool own_schema = false;
+    bool adapt_table = false;
+    output_table.reset(storage::TableFactory::GetDataTable(
+        INVALID_OID, INVALID_OID,
+        const_cast<catalog::Schema *>(aggregate_plan_->GetOutputSchema()),
+        "aggregate_temp_table", DEFAULT_TUPLES_PER_TILEGROUP, own_schema,
+        adapt_table));
+  }
+  size_t input_column_count = (projection_schema != nullptr)
+                                  ? projection_schema->GetColumnCount()
+                                  : column_ids.size();
+  bool has_input = false;
+
+  // Join the scans running over the table, as the sequential scan executor
+  auto tile_group_count = target_table->GetTileGroupCount();
+  storage::SharedScanGuard shared_scan_guard;
+  oid_t scan_start_offset = START_OID;
+  if (tile_group_count > 1 && FLAGS_shared_scans == true) {
+    scan_start_offset = shared_scan_guard.Attach(
+        &target_table->GetSharedScan(), tile_group_count);
+  }
+  auto shared_scan = shared_scan_guard.GetSharedScan();
+
+  std::vector<oid_t> position_list;
+  std::vector<bool> matches;
+  for (oid_t scanned_count = 0; scanned_count < tile_group_count;
+       scanned_count++) {
+    auto tile_group_offset =
+        (scan_start_offset + scanned_count) % tile_group_count;
+    if (shared_scan != nullptr) {
+      shared_scan->SetPosition(tile_group_offset);
+    }
+    auto tile_group = target_table->GetTileGroup(tile_group_offset);
+
+    // Skip tile groups that can not hold any qualifying tuple
+    if (AbstractScanExecutor::CanSkipTileGroup(column_predicates,
+                                               tile_group.get()) == true) {
+      continue;
+    }
+
+    auto tile_group_header = tile_group->GetHeader();
+    oid_t active_tuple_count = tile_group->GetNextTupleSlot();
+
+    // Filter compressed tile groups without decompressing the values
+    bool prefiltered = AbstractScanExecutor::EvaluateCompressedPredicates(
+        column_predicates, tile_group.get(), active_tuple_count, matches);
+
+    // Scan
+    position_list.clear();
+    for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+      if (prefiltered == true && matches[tuple_id] == false) {
+        continue;
+      }
+      if (transaction_manager.IsVisible(current_txn, tile_group_header,
+                                        tuple_id) == VISIBILITY_OK) {
+        position_list.push_back(tuple_id);
+      }
+    }
+
+    // Filter
+    if (predicate != nullptr) {
+      if (compiled_predicate != nullptr &&
+          compiled_predicate->SetTileGroup(tile_group.get()) == true) {
+        compiled_predicate->Filter(position_list);
+      } else {
+        size_t match_count = 0;
+        for (auto tuple_id : position_list) {
+          expression::ContainerTuple<storage::TileGroup> tuple(
+              tile_group.get(), tuple_id);
+          if (predicate->Evaluate(&tuple, nullptr, executor_context)
+                  .IsTrue()) {
+            position_list[match_count++] = tuple_id;
+          }
+        }
+        position_list.resize(match_count);
+      }
+    }
+
+    if (position_list.empty() == true) {
+      continue;
+    }
+
+    for (auto tuple_id : position_list) {
+      ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
+      if (transaction_manager.PerformRead(current_txn, location,
+                                          acquire_owner) == false) {
+        transaction_manager.SetTransactionResult(current_txn, RESULT_FAILURE);
+        return false;
+      }
+    }
+
+    // Without a projection or an aggregation, the scanned tile is the output
+    if (project_info == nullptr && aggregate_plan_ == nullptr) {
+      std::unique_ptr<LogicalTile> logical_tile(LogicalTileFactory::GetTile());
+      logical_tile->AddColumns(tile_group, column_ids);
+      logical_tile->AddPositionList(std::move(position_list));
+      consumer(logical_tile.get());
+      position_list = std::vector<oid_t>();
+      continue;
+    }
+
+    // Project and aggregate, tuple at a time
+    std::shared_ptr<storage::Tile> projected_tile;
+    if (project_info != nullptr && aggregate_plan_ == nullptr) {
+      projected_tile.reset(storage::TileFactory::GetTempTile(
+          *projection_schema, position_list.size()));
+    }
+
+    oid_t projected_tuple_id = 0;
+    for (auto tuple_id : position_list) {
+      expression::ContainerTuple<storage::TileGroup> scanned_tuple(
+          tile_group.get(), tuple_id, &column_ids);
+      AbstractTuple *tuple = &scanned_tuple;
+      if (project_info != nullptr) {
+        project_info->Evaluate(projected_tuple.get(), &scanned_tuple, nullptr,
+                               executor_context);
+        tuple = projected_tuple.get();
+      }
+
+      if (aggregate_plan_ == nullptr) {
+        projected_tile->InsertTuple(projected_tuple_id++,
+                                    projected_tuple.get());
+        continue;
+      }
+
+      if (aggregator == nullptr) {
+        if (aggregate_plan_->GetAggregateStrategy() == AGGREGATE_TYPE_HASH) {
+          aggregator.reset(new HashAggregator(aggregate_plan_,
+                                              output_table.get(),
+                                              executor_context,
+                                              input_column_count));
+        } else {
+          aggregator.reset(new PlainAggregator(
+              aggregate_plan_, output_table.get(), executor_context));
+        }
+      }
+      if (aggregator->Advance(tuple) == false) {
+        return false;
+      }
+      has_input = true;
+    }
+
+    if (projected_tile != nullptr) {
+      std::unique_ptr<LogicalTile> logical_tile(
+          LogicalTileFactory::WrapTiles({projected_tile}));
+      consumer(logical_tile.get());
+    }
+  }
+  shared_scan_guard.Detach();
+
+  if (aggregate_plan_ == nullptr) {
+    return true;
+  }
+
+  // Finalize as the aggregate executor does
+  if (has_input == true) {
+    if (aggregator->Finalize() == false) {
+      return false;
+    }
+  } else {
+    if (aggregate_plan_->GetGroupbyColIds().empty() == false) {
+      return true;
+    }
+
+    // Without input and group by, a single row of zero counts or nulls
+    bool all_count_aggs = true;
+    for (auto &agg_term : aggregate_plan_->GetUniqueAggTerms()) {
+      if (agg_term.aggtype != EXPRESSION_TYPE_AGGREGATE_COUNT &&
+          agg_term.aggtype != EXPRESSION_TYPE_AGGREGATE_COUNT_STAR) {
+        all_count_aggs = false;
+      }
+    }
+    std::unique_ptr<storage::Tuple> tuple(
+        new storage::Tuple(output_table->GetSchema(), true));
+    if (all_count_aggs == true) {
+      tuple->SetAllZeros();
+    } else {
+      tuple->SetAllNulls();
+    }
+    auto location = output_table->InsertTuple(tuple.get());
+    PL_ASSERT(location.block != INVALID_OID);
+    auto tile_group_header =
+        catalog::Manager::GetInstance().GetTileGroupHeader(location.block);
+    tile_group_header->SetTransactionId(location.offset, INITIAL_TXN_ID);
+  }
+
+  for (oid_t tile_group_itr = 0;
+       tile_group_itr < output_table->GetTileGroupCount(); tile_group_itr++) {
+    std::unique_ptr<LogicalTile> logical_tile(LogicalTileFactory::WrapTileGroup(
+        output_table->GetTileGroup(tile_group_itr)));
+    consumer(logical_tile.get());
+  }
+  return true;
+}
+
+}  // End executor namespace
+}  // End peloton namespace
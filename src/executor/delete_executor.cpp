@@ -46,8 +46,6 @@ bool DeleteExecutor::DInit() {
   PL_ASSERT(children_.size() == 1);
   PL_ASSERT(executor_context_);
 
-  PL_ASSERT(target_table_ == nullptr);
-
   // Delete tuples in logical tile
   LOG_TRACE("Delete executor :: 1 child ");
 
@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 
+#include "common/config.h"
 #include "common/value.h"
 #include "executor/executor_context.h"
 #include "concurrency/transaction.h"
@@ -19,12 +20,13 @@ namespace peloton {
 namespace executor {
 
 ExecutorContext::ExecutorContext(concurrency::Transaction *transaction)
-    : transaction_(transaction) {}
+    : transaction_(transaction), degree_of_parallelism_(FLAGS_parallelism) {}
 
 ExecutorContext::ExecutorContext(concurrency::Transaction *transaction,
                                  const std::vector<common::Value> &params)
     : transaction_(transaction),
-      params_(params) {}
+      params_(params),
+      degree_of_parallelism_(FLAGS_parallelism) {}
 
 ExecutorContext::~ExecutorContext() {
   // params will be freed automatically
@@ -46,9 +48,20 @@ void ExecutorContext::ClearParams() {
   params_.clear();
 }
 
+void ExecutorContext::Rebind(concurrency::Transaction *transaction,
+                             const std::vector<common::Value> &params) {
+  transaction_ = transaction;
+  params_ = params;
+  num_processed = 0;
+
+  // the varlen values of the last execution are not referred to anymore
+  pool_.reset();
+  arena_.Reset();
+}
+
 common::VarlenPool *ExecutorContext::GetExecutorContextPool() {
   // construct pool if needed
-  if (pool_.get() == nullptr) pool_.reset(new common::VarlenPool(BACKEND_TYPE_MM));
+  if (pool_.get() == nullptr) pool_.reset(new common::VarlenPool(&arena_));
 
   // return pool
   return pool_.get();
@@ -0,0 +1,103 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// executor_tree_pool.cpp
+//
+// Identification: src/executor/executor_tree_pool.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "executor/executor_tree_pool.h"
+#include "executor/abstract_executor.h"
+#include "executor/executor_context.h"
+#include "planner/abstract_plan.h"
+
+namespace peloton {
+namespace executor {
+
+static void DeleteChildren(AbstractExecutor *executor) {
+  for (auto child : executor->GetChildren()) {
+    DeleteChildren(child);
+    delete child;
+  }
+}
+
+// drop what the executors kept of the last execution
+static void ResetExecutors(AbstractExecutor *executor) {
+  executor->ResetState();
+  for (auto child : executor->GetChildren()) {
+    ResetExecutors(child);
+  }
+}
+
+ExecutorTree::ExecutorTree(ExecutorContext *context, AbstractExecutor *root)
+    : context(context), root(root) {}
+
+ExecutorTree::~ExecutorTree() {
+  if (root != nullptr) {
+    DeleteChildren(root.get());
+  }
+}
+
+bool ExecutorTreePool::IsReusable(const planner::AbstractPlan *plan) {
+  switch (plan->GetPlanNodeType()) {
+    // The executors that set up all their state in DInit()
+    case PLAN_NODE_TYPE_SEQSCAN:
+    case PLAN_NODE_TYPE_INDEXSCAN:
+    case PLAN_NODE_TYPE_PROJECTION:
+    case PLAN_NODE_TYPE_MATERIALIZE:
+    case PLAN_NODE_TYPE_LIMIT:
+    case PLAN_NODE_TYPE_INSERT:
+    case PLAN_NODE_TYPE_UPDATE:
+    case PLAN_NODE_TYPE_DELETE:
+      break;
+
+    default:
+      return false;
+  }
+
+  for (auto &child : plan->GetChildren()) {
+    if (IsReusable(child.get()) == false) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::unique_ptr<ExecutorTree> ExecutorTreePool::Acquire() {
+  std::unique_ptr<ExecutorTree> tree;
+
+  trees_lock_.Lock();
+  if (trees_.empty() == false) {
+    tree = std::move(trees_.back());
+    trees_.pop_back();
+  }
+  trees_lock_.Unlock();
+
+  return tree;
+}
+
+void ExecutorTreePool::Release(std::unique_ptr<ExecutorTree> tree) {
+  ResetExecutors(tree->root.get());
+
+  trees_lock_.Lock();
+  if (trees_.size() < max_size_) {
+    trees_.push_back(std::move(tree));
+  }
+  trees_lock_.Unlock();
+
+  // Freed out of the lock if the pool is full
+}
+
+size_t ExecutorTreePool::GetSize() const {
+  trees_lock_.Lock();
+  auto size = trees_.size();
+  trees_lock_.Unlock();
+  return size;
+}
+
+}  // End executor namespace
+}  // End peloton namespace
@@ -0,0 +1,72 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// gather_executor.cpp
+//
+// Identification: src/executor/gather_executor.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "executor/gather_executor.h"
+
+#include "common/logger.h"
+#include "executor/executor_context.h"
+#include "executor/task_scheduler.h"
+
+namespace peloton {
+namespace executor {
+
+/**
+ * @brief Constructor
+ * @param node  Root plan node of the pipeline
+ */
+GatherExecutor::GatherExecutor(const planner::AbstractPlan *node,
+                               ExecutorContext *executor_context)
+    : AbstractExecutor(node, executor_context) {}
+
+/**
+ * @brief Set up the pipeline with the degree of parallelism of the query.
+ * @return true on success, false otherwise.
+ */
+bool GatherExecutor::DInit() {
+  PL_ASSERT(children_.size() == 0);
+
+  auto degree_of_parallelism = TaskScheduler::GetInstance().GetParallelism(
+      executor_context_->GetDegreeOfParallelism());
+  pipeline_.reset(
+      new Pipeline(GetRawNode(), executor_context_, degree_of_parallelism));
+
+  done_ = false;
+  result_tiles_.clear();
+  result_tile_itr_ = 0;
+
+  return true;
+}
+
+/**
+ * @brief Runs the pipeline on the first call, then returns its output tiles
+ * one at a time.
+ * @return true on success, false otherwise.
+ */
+bool GatherExecutor::DExecute() {
+  if (done_ == false) {
+    LOG_TRACE("Gather executor :: running pipeline");
+    done_ = true;
+    if (pipeline_->Execute(result_tiles_) == false) {
+      return false;
+    }
+  }
+
+  if (result_tile_itr_ < result_tiles_.size()) {
+    SetOutput(result_tiles_[result_tile_itr_++].release());
+    return true;
+  }
+
+  return false;
+}
+
+}  // namespace executor
+}  // namespace peloton
@@ -32,6 +32,7 @@
 #include "common/container_tuple.h"
 #include "planner/hybrid_scan_plan.h"
 #include "executor/hybrid_scan_executor.h"
+#include "executor/index_scan_executor.h"
 #include "storage/data_table.h"
 #include "storage/tile_group_header.h"
 #include "storage/tile.h"
@@ -192,6 +193,12 @@ bool HybridScanExecutor::SeqScanUtil() {
   while (current_tile_group_offset_ < table_tile_group_count_) {
     LOG_TRACE("Current tile group offset : %u", current_tile_group_offset_);
     auto tile_group = table_->GetTileGroup(current_tile_group_offset_++);
+
+    // Skip tile groups that can not hold any qualifying tuple
+    if (CanSkipTileGroup(tile_group.get()) == true) {
+      continue;
+    }
+
     auto tile_group_header = tile_group->GetHeader();
 
     oid_t active_tuple_count = tile_group->GetNextTupleSlot();
@@ -385,9 +392,31 @@ bool HybridScanExecutor::ExecPrimaryIndexLookup() {
       item_pointers_.insert(tuple_location);
     }
 
+    // the oldest-to-newest chains are traversed as in the index scans
+    if (table_->GetVersionStorageType() ==
+        VERSION_STORAGE_TYPE_OLDEST_TO_NEWEST) {
+      ItemPointer visible_location;
+      if (IndexScanExecutor::GetVisibleVersion(current_txn, tuple_location,
+                                               visible_location) == false) {
+        return false;
+      }
+      if (visible_location.IsNull()) {
+        continue;
+      }
+
+      visible_tuples[visible_location.block].push_back(visible_location.offset);
+      auto res = transaction_manager.PerformRead(current_txn, visible_location,
+                                                 acquire_owner);
+      if (!res) {
+        transaction_manager.SetTransactionResult(current_txn, RESULT_FAILURE);
+        return res;
+      }
+      continue;
+    }
+
     auto &manager = catalog::Manager::GetInstance();
-    auto tile_group = manager.GetTileGroup(tuple_location.block);
-    auto tile_group_header = tile_group.get()->GetHeader();
+    auto tile_group = manager.GetTileGroupPtr(tuple_location.block);
+    auto tile_group_header = tile_group->GetHeader();
 
     // perform transaction read
     size_t chain_length = 0;
@@ -429,8 +458,8 @@ bool HybridScanExecutor::ExecPrimaryIndexLookup() {
           }
         }
 
-        tile_group = manager.GetTileGroup(tuple_location.block);
-        tile_group_header = tile_group.get()->GetHeader();
+        tile_group = manager.GetTileGroupPtr(tuple_location.block);
+        tile_group_header = tile_group->GetHeader();
       }
     }
   }
@@ -0,0 +1,273 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_nested_loop_join_executor.cpp
+//
+// Identification: src/executor/index_nested_loop_join_executor.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include "catalog/manager.h"
+#include "common/container_tuple.h"
+#include "common/logger.h"
+#include "common/types.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/executor_context.h"
+#include "executor/index_nested_loop_join_executor.h"
+#include "executor/index_scan_executor.h"
+#include "executor/logical_tile_factory.h"
+#include "expression/abstract_expression.h"
+#include "index/index.h"
+#include "planner/index_nested_loop_join_plan.h"
+#include "storage/tile_group.h"
+#include "storage/tuple.h"
+
+namespace peloton {
+namespace executor {
+
+/**
+ * @brief Constructor for index nested loop join executor.
+ * @param node Index nested loop join node corresponding to this executor.
+ */
+IndexNestedLoopJoinExecutor::IndexNestedLoopJoinExecutor(
+    const planner::AbstractPlan *node, ExecutorContext *executor_context)
+    : AbstractJoinExecutor(node, executor_context) {}
+
+/**
+ * @brief Do some basic checks and grab the index from the plan.
+ * @return true on success, false otherwise.
+ */
+bool IndexNestedLoopJoinExecutor::DInit() {
+  // the inner side is the index, there is only the outer child
+  PL_ASSERT(children_.size() == 1);
+
+  const planner::IndexNestedLoopJoinPlan &node =
+      GetPlanNode<planner::IndexNestedLoopJoinPlan>();
+
+  // NOTE: predicate can be null if the index key is the join condition
+  predicate_ = node.GetPredicate();
+  proj_info_ = node.GetProjInfo();
+  join_type_ = node.GetJoinType();
+  proj_schema_ = node.GetSchema();
+
+  // every outer tuple is looked up, so inner tuples without a match are not
+  // seen at all
+  PL_ASSERT(join_type_ == JOIN_TYPE_INNER || join_type_ == JOIN_TYPE_LEFT);
+
+  index_ = node.GetIndex();
+  outer_key_column_ids_ = node.GetOuterKeyColumnIds();
+  inner_column_ids_ = node.GetInnerColumnIds();
+
+  output_tiles_.clear();
+  output_tile_itr_ = 0;
+
+  return true;
+}
+
+/**
+ * @brief Joins the next tile of the outer child with the inner table.
+ * @return true on success, false otherwise.
+ */
+bool IndexNestedLoopJoinExecutor::DExecute() {
+  LOG_TRACE("********** Index Nested Loop %s Join executor :: 1 child ",
+            GetJoinTypeString());
+
+  for (;;) {
+    // Return the join tiles of the last outer tile first
+    if (output_tile_itr_ < output_tiles_.size()) {
+      SetOutput(output_tiles_[output_tile_itr_].release());
+      output_tile_itr_++;
+      return true;
+    }
+    output_tiles_.clear();
+    output_tile_itr_ = 0;
+
+    if (left_child_done_ == true) {
+      return BuildOuterJoinOutput();
+    }
+
+    if (children_[0]->Execute() == false) {
+      LOG_TRACE("Outer child is exhausted.");
+      left_child_done_ = true;
+      continue;
+    }
+
+    BufferLeftTile(children_[0]->GetOutput());
+    if (JoinOuterTile(left_result_tiles_.size() - 1) == false) {
+      return false;
+    }
+  }
+}
+
+/**
+ * @brief Looks up the join keys of an outer tile in the index with a single
+ * batched probe and builds a join tile per inner tile group.
+ * @return false if the transaction has to abort, true otherwise.
+ */
+bool IndexNestedLoopJoinExecutor::JoinOuterTile(size_t outer_tile_idx) {
+  auto outer_tile = left_result_tiles_[outer_tile_idx].get();
+
+  //===--------------------------------------------------------------------===//
+  // Build the join keys of the outer tuples
+  //===--------------------------------------------------------------------===//
+
+  std::vector<std::unique_ptr<storage::Tuple>> key_tuples;
+  std::vector<oid_t> key_outer_rows;
+  for (auto outer_row_itr : *outer_tile) {
+    expression::ContainerTuple<LogicalTile> outer_tuple(outer_tile,
+                                                        outer_row_itr);
+    std::unique_ptr<storage::Tuple> key_tuple(
+        new storage::Tuple(index_->GetKeySchema(), true));
+
+    bool has_null = false;
+    for (oid_t key_column_itr = 0;
+         key_column_itr < outer_key_column_ids_.size(); key_column_itr++) {
+      auto value = outer_tuple.GetValue(outer_key_column_ids_[key_column_itr]);
+      if (value.IsNull()) {
+        has_null = true;
+        break;
+      }
+      key_tuple->SetValue(key_column_itr, value, index_->GetPool());
+    }
+
+    // a null key never joins
+    if (has_null == false) {
+      key_tuples.push_back(std::move(key_tuple));
+      key_outer_rows.push_back(outer_row_itr);
+    }
+  }
+
+  // Sort the keys so that neighbouring keys share the index traversal, and
+  // probe each distinct key once for all outer rows that have it
+  std::vector<size_t> key_order(key_tuples.size());
+  for (size_t key_itr = 0; key_itr < key_order.size(); key_itr++) {
+    key_order[key_itr] = key_itr;
+  }
+  std::sort(key_order.begin(), key_order.end(),
+            [&key_tuples](size_t lhs, size_t rhs) {
+              return key_tuples[lhs]->Compare(*key_tuples[rhs]) < 0;
+            });
+
+  std::vector<const storage::Tuple *> keys;
+  std::vector<std::vector<oid_t>> outer_rows;
+  for (auto key_itr : key_order) {
+    if (keys.empty() || keys.back()->Compare(*key_tuples[key_itr]) != 0) {
+      keys.push_back(key_tuples[key_itr].get());
+      outer_rows.emplace_back();
+    }
+    outer_rows.back().push_back(key_outer_rows[key_itr]);
+  }
+
+  std::vector<ItemPointer *> tuple_location_ptrs;
+  std::vector<size_t> key_offsets;
+  index_->ScanKeys(keys, tuple_location_ptrs, key_offsets);
+
+  //===--------------------------------------------------------------------===//
+  // Find the visible inner tuples that join
+  //===--------------------------------------------------------------------===//
+
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  auto &manager = catalog::Manager::GetInstance();
+  auto current_txn = executor_context_->GetTransaction();
+  bool check_key = (index_->GetIndexType() != INDEX_CONSTRAINT_TYPE_PRIMARY_KEY);
+
+  // inner tile group -> (outer row, inner offset) pairs
+  std::map<oid_t, std::vector<std::pair<oid_t, oid_t>>> join_pairs;
+
+  for (size_t key_itr = 0; key_itr < keys.size(); key_itr++) {
+    for (size_t location_itr = key_offsets[key_itr];
+         location_itr < key_offsets[key_itr + 1]; location_itr++) {
+      ItemPointer tuple_location;
+      if (IndexScanExecutor::GetVisibleVersion(
+              current_txn, *tuple_location_ptrs[location_itr],
+              tuple_location) == false) {
+        return false;
+      }
+      // the tuple is deleted
+      if (tuple_location.IsNull()) {
+        continue;
+      }
+
+      auto tile_group = manager.GetTileGroupPtr(tuple_location.block);
+      if (check_key == true &&
+          IndexScanExecutor::HasIndexKey(index_.get(), tile_group,
+                                         tuple_location.offset,
+                                         *keys[key_itr]) == false) {
+        continue;
+      }
+
+      bool is_read = false;
+      for (auto outer_row_itr : outer_rows[key_itr]) {
+        if (predicate_ != nullptr) {
+          expression::ContainerTuple<LogicalTile> outer_tuple(outer_tile,
+                                                              outer_row_itr);
+          expression::ContainerTuple<storage::TileGroup> inner_tuple(
+              tile_group, tuple_location.offset);
+          auto eval =
+              predicate_->Evaluate(&outer_tuple, &inner_tuple, executor_context_);
+          if (eval.IsFalse()) {
+            continue;
+          }
+        }
+
+        if (is_read == false) {
+          auto res = transaction_manager.PerformRead(current_txn,
+                                                     tuple_location, false);
+          if (!res) {
+            transaction_manager.SetTransactionResult(current_txn,
+                                                     RESULT_FAILURE);
+            return res;
+          }
+          is_read = true;
+        }
+
+        RecordMatchedLeftRow(outer_tile_idx, outer_row_itr);
+        join_pairs[tuple_location.block].push_back(
+            std::make_pair(outer_row_itr, oid_t(tuple_location.offset)));
+      }
+    }
+  }
+
+  //===--------------------------------------------------------------------===//
+  // Build a join tile per inner tile group
+  //===--------------------------------------------------------------------===//
+
+  for (auto &pairs : join_pairs) {
+    std::vector<oid_t> inner_positions;
+    for (auto &join_pair : pairs.second) {
+      inner_positions.push_back(join_pair.second);
+    }
+
+    // the inner tile has a row per join pair
+    std::unique_ptr<LogicalTile> inner_tile(LogicalTileFactory::GetTile());
+    inner_tile->AddColumns(manager.GetTileGroup(pairs.first),
+                           inner_column_ids_);
+    inner_tile->AddPositionList(std::move(inner_positions));
+    BufferRightTile(inner_tile.release());
+    auto right_tile = right_result_tiles_.back().get();
+
+    auto output_tile = BuildOutputLogicalTile(outer_tile, right_tile);
+    LogicalTile::PositionListsBuilder pos_lists_builder(outer_tile,
+                                                        right_tile);
+    for (oid_t pair_itr = 0; pair_itr < pairs.second.size(); pair_itr++) {
+      pos_lists_builder.AddRow(pairs.second[pair_itr].first, pair_itr);
+    }
+    output_tile->SetPositionListsAndVisibility(pos_lists_builder.Release());
+    output_tiles_.push_back(std::move(output_tile));
+  }
+
+  LOG_TRACE("Join tiles : %lu", output_tiles_.size());
+
+  return true;
+}
+
+}  // namespace executor
+}  // namespace peloton
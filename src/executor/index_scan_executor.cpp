@@ -12,6 +12,7 @@
 
 #include "executor/index_scan_executor.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -76,6 +77,7 @@ bool IndexScanExecutor::DInit() {
   values_ = node.GetValues();
   runtime_keys_ = node.GetRunTimeKeys();
   predicate_ = node.GetPredicate();
+  key_list_ = node.GetKeyList();
 
   if (runtime_keys_.size() != 0) {
     PL_ASSERT(runtime_keys_.size() == values_.size());
@@ -111,7 +113,10 @@ bool IndexScanExecutor::DExecute() {
   LOG_TRACE("Index Scan executor :: 0 child");
 
   if (!done_) {
-    if (index_->GetIndexType() == INDEX_CONSTRAINT_TYPE_PRIMARY_KEY) {
+    if (key_list_.size() != 0) {
+      auto status = ExecKeyListLookup();
+      if (status == false) return false;
+    } else if (index_->GetIndexType() == INDEX_CONSTRAINT_TYPE_PRIMARY_KEY) {
       auto status = ExecPrimaryIndexLookup();
       if (status == false) return false;
     } else {
@@ -172,126 +177,42 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
 
   // for every tuple that is found in the index.
   for (auto tuple_location_ptr : tuple_location_ptrs) {
+    ItemPointer tuple_location;
+    if (GetVisibleVersion(current_txn, *tuple_location_ptr, tuple_location) ==
+        false) {
+      return false;
+    }
+    // the tuple is deleted
+    if (tuple_location.IsNull()) {
+      continue;
+    }
 
-    ItemPointer tuple_location = *tuple_location_ptr;
-
-    auto &manager = catalog::Manager::GetInstance();
-    auto tile_group = manager.GetTileGroup(tuple_location.block);
-    auto tile_group_header = tile_group.get()->GetHeader();
-
-    size_t chain_length = 0;
-
-    // the following code traverses the version chain until a certain visible
-    // version is found.
-    // we should always find a visible version from a version chain.
-    while (true) {
-      ++chain_length;
-
-      auto visibility = transaction_manager.IsVisible(
-          current_txn, tile_group_header, tuple_location.offset);
-
-      // if the tuple is deleted
-      if (visibility == VISIBILITY_DELETED) {
-        LOG_TRACE("encounter deleted tuple: %u, %u", tuple_location.block,
-                  tuple_location.offset);
-        break;
-      }
-      // if the tuple is visible.
-      else if (visibility == VISIBILITY_OK) {
-        LOG_TRACE("perform read: %u, %u", tuple_location.block,
-                  tuple_location.offset);
-
-        bool eval = true;
-        // if having predicate, then perform evaluation.
-        if (predicate_ != nullptr) {
-          expression::ContainerTuple<storage::TileGroup> tuple(
-              tile_group.get(), tuple_location.offset);
-          eval =
-              predicate_->Evaluate(&tuple, nullptr, executor_context_).IsTrue();
-        }
-        // if passed evaluation, then perform write.
-        if (eval == true) {
-          auto res = transaction_manager.PerformRead(
-              current_txn, tuple_location, acquire_owner);
-          if (!res) {
-            transaction_manager.SetTransactionResult(current_txn,
-                                                     RESULT_FAILURE);
-            return res;
-          }
-          // if perform read is successful, then add to visible tuple vector.
-          visible_tuples[tuple_location.block].push_back(tuple_location.offset);
-        }
-
-        break;
-      }
-      // if the tuple is not visible.
-      else {
-        PL_ASSERT(visibility == VISIBILITY_INVISIBLE);
-
-        LOG_TRACE("Invisible read: %u, %u", tuple_location.block,
-                  tuple_location.offset);
-
-        bool is_acquired = (tile_group_header->GetTransactionId(
-                                tuple_location.offset) == INITIAL_TXN_ID);
-        bool is_alive =
-            (tile_group_header->GetEndCommitId(tuple_location.offset) <=
-             current_txn->GetBeginCommitId());
-        if (is_acquired && is_alive) {
-          // See an invisible version that does not belong to any one in the
-          // version chain.
-          // this means that some other transactions have modified the version
-          // chain.
-          // Wire back because the current version is expired. have to search
-          // from scratch.
-          tuple_location =
-              *(tile_group_header->GetIndirection(tuple_location.offset));
-          tile_group = manager.GetTileGroup(tuple_location.block);
-          tile_group_header = tile_group.get()->GetHeader();
-          chain_length = 0;
-          continue;
-        }
-
-        ItemPointer old_item = tuple_location;
-        tuple_location = tile_group_header->GetNextItemPointer(old_item.offset);
-
-        // there must exist a visible version.
-        if (tuple_location.IsNull()) {
-          if (chain_length == 1) {
-            break;
-          }
-
-          // in most cases, there should exist a visible version.
-          // if we have traversed through the chain and still can not fulfill
-          // one of the above conditions,
-          // then return result_failure.
-          transaction_manager.SetTransactionResult(current_txn, RESULT_FAILURE);
-          return false;
-        }
-
-        // search for next version.
-        tile_group = manager.GetTileGroup(tuple_location.block);
-        tile_group_header = tile_group.get()->GetHeader();
-        continue;
+    LOG_TRACE("perform read: %u, %u", tuple_location.block,
+              tuple_location.offset);
+
+    bool eval = true;
+    // if having predicate, then perform evaluation.
+    if (predicate_ != nullptr) {
+      auto &manager = catalog::Manager::GetInstance();
+      expression::ContainerTuple<storage::TileGroup> tuple(
+          manager.GetTileGroupPtr(tuple_location.block),
+          tuple_location.offset);
+      eval = predicate_->Evaluate(&tuple, nullptr, executor_context_).IsTrue();
+    }
+    // if passed evaluation, then perform write.
+    if (eval == true) {
+      auto res = transaction_manager.PerformRead(current_txn, tuple_location,
+                                                 acquire_owner);
+      if (!res) {
+        transaction_manager.SetTransactionResult(current_txn, RESULT_FAILURE);
+        return res;
       }
+      // if perform read is successful, then add to visible tuple vector.
+      visible_tuples[tuple_location.block].push_back(tuple_location.offset);
     }
-    LOG_TRACE("Traverse length: %d\n", (int)chain_length);
   }
 
-  // Construct a logical tile for each block
-  for (auto tuples : visible_tuples) {
-    auto &manager = catalog::Manager::GetInstance();
-    auto tile_group = manager.GetTileGroup(tuples.first);
-
-    std::unique_ptr<LogicalTile> logical_tile(LogicalTileFactory::GetTile());
-    // Add relevant columns to logical tile
-    logical_tile->AddColumns(tile_group, full_column_ids_);
-    logical_tile->AddPositionList(std::move(tuples.second));
-    if (column_ids_.size() != 0) {
-      logical_tile->ProjectColumns(full_column_ids_, column_ids_);
-    }
-
-    result_.push_back(logical_tile.release());
-  }
+  BuildResultTiles(visible_tuples);
 
   done_ = true;
 
@@ -333,141 +254,191 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
   std::map<oid_t, std::vector<oid_t>> visible_tuples;
 
   for (auto tuple_location_ptr : tuple_location_ptrs) {
+    ItemPointer tuple_location;
+    if (GetVisibleVersion(current_txn, *tuple_location_ptr, tuple_location) ==
+        false) {
+      return false;
+    }
+    // the tuple is deleted
+    if (tuple_location.IsNull()) {
+      continue;
+    }
 
-    ItemPointer tuple_location = *tuple_location_ptr;
+    LOG_TRACE("perform read: %u, %u", tuple_location.block,
+              tuple_location.offset);
 
+    // different from primary key index lookup, we have to compare the
+    // secondary key to guarantee the correctness of the result.
     auto &manager = catalog::Manager::GetInstance();
-    auto tile_group = manager.GetTileGroup(tuple_location.block);
-    auto tile_group_header = tile_group.get()->GetHeader();
+    auto tile_group = manager.GetTileGroupPtr(tuple_location.block);
+
+    // Further check if the version has the secondary key
+    storage::Tuple key_tuple(index_->GetKeySchema(), true);
+    expression::ContainerTuple<storage::TileGroup> candidate_tuple(
+        tile_group, tuple_location.offset);
+    // Construct the key tuple
+    auto &indexed_columns = index_->GetKeySchema()->GetIndexedColumns();
+
+    oid_t this_col_itr = 0;
+    for (auto col : indexed_columns) {
+      common::Value val = (candidate_tuple.GetValue(col));
+      key_tuple.SetValue(this_col_itr, val, index_->GetPool());
+      this_col_itr++;
+    }
 
-    size_t chain_length = 0;
+    // Compare the key tuple and the key
+    if (index_->Compare(key_tuple, key_column_ids_, expr_types_, values_) ==
+        false) {
+      LOG_TRACE("Secondary key mismatch: %u, %u\n", tuple_location.block,
+                tuple_location.offset);
+      continue;
+    }
 
-    // the following code traverses the version chain until a certain visible
-    // version is found.
-    // we should always find a visible version from a version chain.
-    // different from primary key index lookup, we have to compare the secondary
-    // key to
-    // guarantee the correctness of the result.
-    while (true) {
-      ++chain_length;
+    bool eval = true;
+    // if having predicate, then perform evaluation.
+    if (predicate_ != nullptr) {
+      eval = predicate_->Evaluate(&candidate_tuple, nullptr, executor_context_)
+                 .IsTrue();
+    }
+    // if passed evaluation, then perform write.
+    if (eval == true) {
+      auto res = transaction_manager.PerformRead(current_txn, tuple_location,
+                                                 acquire_owner);
+      if (!res) {
+        transaction_manager.SetTransactionResult(current_txn, RESULT_FAILURE);
+        return res;
+      }
+      // if perform read is successful, then add to visible tuple vector.
+      visible_tuples[tuple_location.block].push_back(tuple_location.offset);
+    }
+  }
 
-      auto visibility = transaction_manager.IsVisible(
-          current_txn, tile_group_header, tuple_location.offset);
+  BuildResultTiles(visible_tuples);
 
-      // if the tuple is deleted
-      if (visibility == VISIBILITY_DELETED) {
-        LOG_TRACE("encounter deleted tuple: %u, %u", tuple_location.block,
-                  tuple_location.offset);
-        break;
-      }
-      // if the tuple is visible.
-      else if (visibility == VISIBILITY_OK) {
-        LOG_TRACE("perform read: %u, %u", tuple_location.block,
-                  tuple_location.offset);
+  done_ = true;
 
-        // Further check if the version has the secondary key
-        storage::Tuple key_tuple(index_->GetKeySchema(), true);
-        expression::ContainerTuple<storage::TileGroup> candidate_tuple(
-            tile_group.get(), tuple_location.offset);
-        // Construct the key tuple
-        auto &indexed_columns = index_->GetKeySchema()->GetIndexedColumns();
-
-        oid_t this_col_itr = 0;
-        for (auto col : indexed_columns) {
-          common::Value val = (candidate_tuple.GetValue(col));
-          key_tuple.SetValue(this_col_itr, val, index_->GetPool());
-          this_col_itr++;
-        }
+  LOG_TRACE("Result tiles : %lu", result_.size());
 
-        // Compare the key tuple and the key
-        if (index_->Compare(key_tuple, key_column_ids_, expr_types_, values_) ==
-            false) {
-          LOG_TRACE("Secondary key mismatch: %u, %u\n", tuple_location.block,
-                    tuple_location.offset);
-          break;
-        }
+  return true;
+}
 
-        bool eval = true;
-        // if having predicate, then perform evaluation.
-        if (predicate_ != nullptr) {
-          expression::ContainerTuple<storage::TileGroup> tuple(
-              tile_group.get(), tuple_location.offset);
-          eval =
-              predicate_->Evaluate(&tuple, nullptr, executor_context_).IsTrue();
-        }
-        // if passed evaluation, then perform write.
-        if (eval == true) {
-          auto res = transaction_manager.PerformRead(
-              current_txn, tuple_location, acquire_owner);
-          if (!res) {
-            transaction_manager.SetTransactionResult(current_txn,
-                                                     RESULT_FAILURE);
-            return res;
-          }
-          // if perform read is successful, then add to visible tuple vector.
-          visible_tuples[tuple_location.block].push_back(tuple_location.offset);
-        }
+/**
+ * @brief Look up every key of the plan's key list (an IN list) with a single
+ * batched index probe. The keys are probed in ascending order and each
+ * distinct key once.
+ */
+bool IndexScanExecutor::ExecKeyListLookup() {
+  LOG_TRACE("ExecKeyListLookup");
+  PL_ASSERT(!done_);
 
-        break;
+  bool acquire_owner = GetPlanNode<planner::AbstractScan>().IsForUpdate();
+  bool check_key = (index_->GetIndexType() != INDEX_CONSTRAINT_TYPE_PRIMARY_KEY);
+
+  // Build a key tuple for every key
+  std::vector<std::unique_ptr<storage::Tuple>> key_tuples;
+  for (auto &key_values : key_list_) {
+    PL_ASSERT(key_values.size() == index_->GetKeySchema()->GetColumnCount());
+    std::unique_ptr<storage::Tuple> key_tuple(
+        new storage::Tuple(index_->GetKeySchema(), true));
+    for (oid_t key_column_itr = 0; key_column_itr < key_values.size();
+         key_column_itr++) {
+      key_tuple->SetValue(key_column_itr, key_values[key_column_itr],
+                          index_->GetPool());
+    }
+    key_tuples.push_back(std::move(key_tuple));
+  }
+
+  std::vector<const storage::Tuple *> keys;
+  for (auto &key_tuple : key_tuples) {
+    keys.push_back(key_tuple.get());
+  }
+  std::sort(keys.begin(), keys.end(),
+            [](const storage::Tuple *lhs, const storage::Tuple *rhs) {
+              return lhs->Compare(*rhs) < 0;
+            });
+  keys.erase(std::unique(keys.begin(), keys.end(),
+                         [](const storage::Tuple *lhs,
+                            const storage::Tuple *rhs) {
+                           return lhs->Compare(*rhs) == 0;
+                         }),
+             keys.end());
+
+  std::vector<ItemPointer *> tuple_location_ptrs;
+  std::vector<size_t> key_offsets;
+  index_->ScanKeys(keys, tuple_location_ptrs, key_offsets);
+
+  if (tuple_location_ptrs.size() == 0) {
+    LOG_TRACE("no tuple is retrieved from index.");
+    return false;
+  }
+
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+
+  auto current_txn = executor_context_->GetTransaction();
+
+  std::map<oid_t, std::vector<oid_t>> visible_tuples;
+
+  for (size_t key_itr = 0; key_itr < keys.size(); key_itr++) {
+    for (size_t location_itr = key_offsets[key_itr];
+         location_itr < key_offsets[key_itr + 1]; location_itr++) {
+      ItemPointer tuple_location;
+      if (GetVisibleVersion(current_txn, *tuple_location_ptrs[location_itr],
+                            tuple_location) == false) {
+        return false;
+      }
+      // the tuple is deleted
+      if (tuple_location.IsNull()) {
+        continue;
       }
-      // if the tuple is not visible.
-      else {
-        PL_ASSERT(visibility == VISIBILITY_INVISIBLE);
 
-        LOG_TRACE("Invisible read: %u, %u", tuple_location.block,
-                  tuple_location.offset);
+      auto &manager = catalog::Manager::GetInstance();
+      auto tile_group = manager.GetTileGroupPtr(tuple_location.block);
 
-        bool is_acquired = (tile_group_header->GetTransactionId(
-                                tuple_location.offset) == INITIAL_TXN_ID);
-        bool is_alive =
-            (tile_group_header->GetEndCommitId(tuple_location.offset) <=
-             current_txn->GetBeginCommitId());
-        if (is_acquired && is_alive) {
-          // See an invisible version that does not belong to any one in the
-          // version chain.
-          // this means that some other transactions have modified the version
-          // chain.
-          // Wire back because the current version is expired. have to search
-          // from scratch.
-          tuple_location =
-              *(tile_group_header->GetIndirection(tuple_location.offset));
-          tile_group = manager.GetTileGroup(tuple_location.block);
-          tile_group_header = tile_group.get()->GetHeader();
-          chain_length = 0;
-          continue;
-        }
+      if (check_key == true &&
+          HasIndexKey(index_.get(), tile_group, tuple_location.offset,
+                      *keys[key_itr]) == false) {
+        LOG_TRACE("Secondary key mismatch: %u, %u", tuple_location.block,
+                  tuple_location.offset);
+        continue;
+      }
 
-        ItemPointer old_item = tuple_location;
-        tuple_location = tile_group_header->GetNextItemPointer(old_item.offset);
-
-        if (tuple_location.IsNull()) {
-          // For an index scan on a version chain, the result should be one of
-          // the following:
-          //    (1) find a visible version
-          //    (2) find a deleted version
-          //    (3) find an aborted version with chain length equal to one
-          if (chain_length == 1) {
-            break;
-          }
-
-          // in most cases, there should exist a visible version.
-          // if we have traversed through the chain and still can not fulfill
-          // one of the above conditions,
-          // then return result_failure.
+      bool eval = true;
+      // if having predicate, then perform evaluation.
+      if (predicate_ != nullptr) {
+        expression::ContainerTuple<storage::TileGroup> tuple(
+            tile_group, tuple_location.offset);
+        eval =
+            predicate_->Evaluate(&tuple, nullptr, executor_context_).IsTrue();
+      }
+      // if passed evaluation, then perform write.
+      if (eval == true) {
+        auto res = transaction_manager.PerformRead(current_txn, tuple_location,
+                                                   acquire_owner);
+        if (!res) {
           transaction_manager.SetTransactionResult(current_txn, RESULT_FAILURE);
-          return false;
+          return res;
         }
-
-        // search for next version.
-        tile_group = manager.GetTileGroup(tuple_location.block);
-        tile_group_header = tile_group.get()->GetHeader();
+        visible_tuples[tuple_location.block].push_back(tuple_location.offset);
       }
     }
-    LOG_TRACE("Traverse length: %d\n", (int)chain_length);
   }
 
-  // Construct a logical tile for each block
-  for (auto tuples : visible_tuples) {
+  BuildResultTiles(visible_tuples);
+
+  done_ = true;
+
+  LOG_TRACE("Result tiles : %lu", result_.size());
+
+  return true;
+}
+
+/**
+ * @brief Construct a logical tile for each block of visible tuples.
+ */
+void IndexScanExecutor::BuildResultTiles(
+    std::map<oid_t, std::vector<oid_t>> &visible_tuples) {
+  for (auto &tuples : visible_tuples) {
     auto &manager = catalog::Manager::GetInstance();
     auto tile_group = manager.GetTileGroup(tuples.first);
 
@@ -481,14 +452,159 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
 
     result_.push_back(logical_tile.release());
   }
+}
 
-  done_ = true;
+/**
+ * @brief Traverse the version chain of an index entry until the version
+ * visible to the transaction is found.
+ * @param current_txn The transaction reading the tuple.
+ * @param tuple_location The location stored in the index.
+ * @param visible_location The visible version, or a null item pointer if
+ * the tuple is deleted.
+ * @return false if the transaction has to abort, true otherwise.
+ */
+bool IndexScanExecutor::GetVisibleVersion(concurrency::Transaction *current_txn,
+                                          ItemPointer tuple_location,
+                                          ItemPointer &visible_location) {
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  auto &manager = catalog::Manager::GetInstance();
+  auto tile_group = manager.GetTileGroupPtr(tuple_location.block);
+  auto tile_group_header = tile_group->GetHeader();
 
-  LOG_TRACE("Result tiles : %lu", result_.size());
+  visible_location = ItemPointer();
+
+  // the oldest-to-newest chains are traversed from the index to the newer
+  // versions, the versions the transaction has passed are expired.
+  auto table = static_cast<storage::DataTable *>(tile_group->GetAbstractTable());
+  if (table->GetVersionStorageType() == VERSION_STORAGE_TYPE_OLDEST_TO_NEWEST) {
+    while (true) {
+      auto visibility = transaction_manager.IsVisible(
+          current_txn, tile_group_header, tuple_location.offset);
+
+      if (visibility == VISIBILITY_DELETED) {
+        break;
+      } else if (visibility == VISIBILITY_OK) {
+        visible_location = tuple_location;
+        break;
+      }
+
+      // no version is visible if the newest one is not
+      tuple_location =
+          tile_group_header->GetPrevItemPointer(tuple_location.offset);
+      if (tuple_location.IsNull()) {
+        break;
+      }
+
+      tile_group = manager.GetTileGroupPtr(tuple_location.block);
+      tile_group_header = tile_group->GetHeader();
+    }
+    return true;
+  }
+
+  size_t chain_length = 0;
+
+  // the following code traverses the version chain until a certain visible
+  // version is found.
+  // we should always find a visible version from a version chain.
+  while (true) {
+    ++chain_length;
+
+    auto visibility = transaction_manager.IsVisible(
+        current_txn, tile_group_header, tuple_location.offset);
+
+    // if the tuple is deleted
+    if (visibility == VISIBILITY_DELETED) {
+      LOG_TRACE("encounter deleted tuple: %u, %u", tuple_location.block,
+                tuple_location.offset);
+      break;
+    }
+    // if the tuple is visible.
+    else if (visibility == VISIBILITY_OK) {
+      visible_location = tuple_location;
+      break;
+    }
+    // if the tuple is not visible.
+    else {
+      PL_ASSERT(visibility == VISIBILITY_INVISIBLE);
+
+      LOG_TRACE("Invisible read: %u, %u", tuple_location.block,
+                tuple_location.offset);
+
+      bool is_acquired = (tile_group_header->GetTransactionId(
+                              tuple_location.offset) == INITIAL_TXN_ID);
+      bool is_alive =
+          (tile_group_header->GetEndCommitId(tuple_location.offset) <=
+           current_txn->GetBeginCommitId());
+      if (is_acquired && is_alive) {
+        // See an invisible version that does not belong to any one in the
+        // version chain.
+        // this means that some other transactions have modified the version
+        // chain.
+        // Wire back because the current version is expired. have to search
+        // from scratch.
+        tuple_location =
+            *(tile_group_header->GetIndirection(tuple_location.offset));
+        tile_group = manager.GetTileGroupPtr(tuple_location.block);
+        tile_group_header = tile_group->GetHeader();
+        chain_length = 0;
+        continue;
+      }
+
+      ItemPointer old_item = tuple_location;
+      tuple_location = tile_group_header->GetNextItemPointer(old_item.offset);
+
+      if (tuple_location.IsNull()) {
+        // For an index scan on a version chain, the result should be one of
+        // the following:
+        //    (1) find a visible version
+        //    (2) find a deleted version
+        //    (3) find an aborted version with chain length equal to one
+        if (chain_length == 1) {
+          break;
+        }
+
+        // in most cases, there should exist a visible version.
+        // if we have traversed through the chain and still can not fulfill
+        // one of the above conditions,
+        // then return result_failure.
+        transaction_manager.SetTransactionResult(current_txn, RESULT_FAILURE);
+        return false;
+      }
+
+      // search for next version.
+      tile_group = manager.GetTileGroupPtr(tuple_location.block);
+      tile_group_header = tile_group->GetHeader();
+    }
+  }
+  LOG_TRACE("Traverse length: %d\n", (int)chain_length);
 
   return true;
 }
 
+/**
+ * @brief Check whether a version of a tuple still has the given index key.
+ * Secondary indexes keep the entries of old keys until they are collected.
+ */
+bool IndexScanExecutor::HasIndexKey(index::Index *index,
+                                    storage::TileGroup *tile_group,
+                                    oid_t tuple_offset,
+                                    const storage::Tuple &key) {
+  storage::Tuple key_tuple(index->GetKeySchema(), true);
+  expression::ContainerTuple<storage::TileGroup> candidate_tuple(tile_group,
+                                                                 tuple_offset);
+  auto &indexed_columns = index->GetKeySchema()->GetIndexedColumns();
+
+  oid_t this_col_itr = 0;
+  for (auto col : indexed_columns) {
+    key_tuple.SetValue(this_col_itr, candidate_tuple.GetValue(col),
+                       index->GetPool());
+    this_col_itr++;
+  }
+
+  return key_tuple.Compare(key) == 0;
+}
+
 void IndexScanExecutor::UpdatePredicate(const std::vector<oid_t> &key_column_ids
                                             UNUSED_ATTRIBUTE,
                                         const std::vector<common::Value> &values
@@ -0,0 +1,71 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// morsel_queue.cpp
+//
+// Identification: src/executor/morsel_queue.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+
+#include "common/macros.h"
+#include "executor/morsel_queue.h"
+
+namespace peloton {
+namespace executor {
+
+MorselQueue::MorselQueue(const oid_t &tile_group_count,
+                         const size_t &worker_count,
+                         const oid_t &morsel_tile_group_count) {
+  PL_ASSERT(worker_count > 0);
+  PL_ASSERT(morsel_tile_group_count > 0);
+
+  for (size_t worker_itr = 0; worker_itr < worker_count; worker_itr++) {
+    partitions_.emplace_back(new Partition());
+  }
+
+  // split the morsels into contiguous ranges of (almost) equal size
+  oid_t morsel_count = (tile_group_count + morsel_tile_group_count - 1) /
+                       morsel_tile_group_count;
+  for (oid_t morsel_itr = 0; morsel_itr < morsel_count; morsel_itr++) {
+    oid_t tile_group_offset = morsel_itr * morsel_tile_group_count;
+    oid_t morsel_size = std::min(morsel_tile_group_count,
+                                 tile_group_count - tile_group_offset);
+    size_t worker_id = (size_t)morsel_itr * worker_count / morsel_count;
+    partitions_[worker_id]->morsels.push_back(
+        Morsel(tile_group_offset, morsel_size));
+  }
+}
+
+bool MorselQueue::GetNextMorsel(const size_t &worker_id, Morsel &morsel) {
+  size_t partition_count = partitions_.size();
+  for (size_t partition_itr = 0; partition_itr < partition_count;
+       partition_itr++) {
+    auto &partition =
+        partitions_[(worker_id + partition_itr) % partition_count];
+
+    partition->partition_lock.Lock();
+    if (partition->morsels.empty() == false) {
+      // the owner scans its range forward, thieves take the last morsels
+      if (partition_itr == 0) {
+        morsel = partition->morsels.front();
+        partition->morsels.pop_front();
+      } else {
+        morsel = partition->morsels.back();
+        partition->morsels.pop_back();
+      }
+      partition->partition_lock.Unlock();
+      return true;
+    }
+    partition->partition_lock.Unlock();
+  }
+
+  return false;
+}
+
+}  // End executor namespace
+}  // End peloton namespace
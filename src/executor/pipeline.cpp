@@ -0,0 +1,191 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// pipeline.cpp
+//
+// Identification: src/executor/pipeline.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <functional>
+#include <thread>
+
+#include "common/logger.h"
+#include "concurrency/transaction.h"
+#include "executor/executor_context.h"
+#include "executor/materialization_executor.h"
+#include "executor/pipeline.h"
+#include "executor/projection_executor.h"
+#include "executor/seq_scan_executor.h"
+#include "executor/task_scheduler.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
+
+namespace peloton {
+namespace executor {
+
+Pipeline::Pipeline(const planner::AbstractPlan *plan,
+                   ExecutorContext *executor_context,
+                   const size_t &degree_of_parallelism)
+    : plan_(plan),
+      executor_context_(executor_context),
+      degree_of_parallelism_(degree_of_parallelism),
+      finished_worker_count_(0),
+      worker_failed_(false) {
+  PL_ASSERT(IsParallelizable(plan_) == true);
+  PL_ASSERT(degree_of_parallelism_ > 0);
+}
+
+Pipeline::~Pipeline() {}
+
+bool Pipeline::IsPipelineBreaker(const planner::AbstractPlan *plan) {
+  switch (plan->GetPlanNodeType()) {
+    case PLAN_NODE_TYPE_HASH:
+    case PLAN_NODE_TYPE_ORDERBY:
+    case PLAN_NODE_TYPE_AGGREGATE_V2:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool Pipeline::IsParallelizable(const planner::AbstractPlan *plan) {
+  auto &children = plan->GetChildren();
+  switch (plan->GetPlanNodeType()) {
+    case PLAN_NODE_TYPE_SEQSCAN:
+      return children.empty() &&
+             static_cast<const planner::SeqScanPlan *>(plan)->GetTable() !=
+                 nullptr;
+    case PLAN_NODE_TYPE_PROJECTION:
+    case PLAN_NODE_TYPE_MATERIALIZE:
+      return children.size() == 1 && IsParallelizable(children[0].get());
+    default:
+      return false;
+  }
+}
+
+storage::DataTable *Pipeline::GetSourceTable(
+    const planner::AbstractPlan *plan) {
+  while (plan->GetPlanNodeType() != PLAN_NODE_TYPE_SEQSCAN) {
+    plan = plan->GetChildren()[0].get();
+  }
+  return static_cast<const planner::SeqScanPlan *>(plan)->GetTable();
+}
+
+bool Pipeline::Execute(
+    std::vector<std::unique_ptr<LogicalTile>> &result_tiles) {
+  auto table = GetSourceTable(plan_);
+  morsel_queue_.reset(
+      new MorselQueue(table->GetTileGroupCount(), degree_of_parallelism_));
+
+  worker_contexts_.clear();
+  worker_executors_.clear();
+  worker_tiles_.clear();
+  worker_executors_.resize(degree_of_parallelism_);
+  worker_tiles_.resize(degree_of_parallelism_);
+  for (size_t worker_itr = 0; worker_itr < degree_of_parallelism_;
+       worker_itr++) {
+    worker_contexts_.emplace_back(new ExecutorContext(
+        executor_context_->GetTransaction(), executor_context_->GetParams()));
+  }
+  finished_worker_count_ = 0;
+
+  LOG_TRACE("Running pipeline on %lu workers", degree_of_parallelism_);
+
+  // the calling thread is worker 0
+  auto &task_scheduler = TaskScheduler::GetInstance();
+  for (size_t worker_itr = 1; worker_itr < degree_of_parallelism_;
+       worker_itr++) {
+    if (task_scheduler.SubmitTask(
+            std::bind(&Pipeline::RunWorker, this, worker_itr), worker_itr) ==
+        false) {
+      RunWorker(worker_itr);
+    }
+  }
+  RunWorker(0);
+
+  // help with the pending tasks while the other workers finish
+  while (finished_worker_count_.load() < degree_of_parallelism_) {
+    if (task_scheduler.RunPendingTask(0) == false) {
+      std::this_thread::yield();
+    }
+  }
+
+  worker_executors_.clear();
+
+  if (worker_exception_ != nullptr) {
+    std::rethrow_exception(worker_exception_);
+  }
+
+  for (auto &tiles : worker_tiles_) {
+    for (auto &tile : tiles) {
+      result_tiles.push_back(std::move(tile));
+    }
+  }
+  worker_tiles_.clear();
+
+  return executor_context_->GetTransaction()->GetResult() ==
+         Result::RESULT_SUCCESS;
+}
+
+void Pipeline::RunWorker(const size_t worker_id) {
+  auto current_txn = executor_context_->GetTransaction();
+
+  try {
+    auto executor_tree = BuildWorkerTree(plan_, worker_id);
+
+    if (executor_tree->Init() == true) {
+      while (worker_failed_ == false &&
+             current_txn->GetResult() == Result::RESULT_SUCCESS &&
+             executor_tree->Execute() == true) {
+        std::unique_ptr<LogicalTile> logical_tile(executor_tree->GetOutput());
+        if (logical_tile != nullptr) {
+          worker_tiles_[worker_id].push_back(std::move(logical_tile));
+        }
+      }
+    }
+  } catch (...) {
+    // only the first exception is reported
+    if (worker_failed_.exchange(true) == false) {
+      worker_exception_ = std::current_exception();
+    }
+  }
+
+  finished_worker_count_++;
+}
+
+AbstractExecutor *Pipeline::BuildWorkerTree(const planner::AbstractPlan *plan,
+                                            const size_t &worker_id) {
+  auto executor_context = worker_contexts_[worker_id].get();
+
+  AbstractExecutor *executor = nullptr;
+  switch (plan->GetPlanNodeType()) {
+    case PLAN_NODE_TYPE_SEQSCAN: {
+      auto scan_executor = new SeqScanExecutor(plan, executor_context);
+      scan_executor->SetMorselQueue(morsel_queue_.get(), worker_id);
+      executor = scan_executor;
+    } break;
+    case PLAN_NODE_TYPE_PROJECTION:
+      executor = new ProjectionExecutor(plan, executor_context);
+      break;
+    case PLAN_NODE_TYPE_MATERIALIZE:
+      executor = new MaterializationExecutor(plan, executor_context);
+      break;
+    default:
+      PL_ASSERT(false);
+      return nullptr;
+  }
+  worker_executors_[worker_id].emplace_back(executor);
+
+  for (auto &child : plan->GetChildren()) {
+    executor->AddChild(BuildWorkerTree(child.get(), worker_id));
+  }
+
+  return executor;
+}
+
+}  // End executor namespace
+}  // End peloton namespace
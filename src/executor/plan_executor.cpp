@@ -10,14 +10,20 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <iomanip>
+#include <sstream>
 #include <vector>
 
+#include "common/config.h"
 #include "common/logger.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "executor/executor_context.h"
+#include "executor/executor_tree_pool.h"
 #include "executor/executors.h"
 #include "executor/plan_executor.h"
+#include "executor/task_scheduler.h"
 #include "optimizer/util.h"
+#include "statistics/backend_stats_context.h"
 #include "storage/tuple_iterator.h"
 
 namespace peloton {
@@ -35,6 +41,75 @@ executor::AbstractExecutor *BuildExecutorTree(
 
 void CleanExecutorTree(executor::AbstractExecutor *root);
 
+/**
+ * @brief Let the executors of the tree drop what they hold of the tables
+ * once the execution is over.
+ */
+static void EndExecution(executor::AbstractExecutor *root) {
+  root->EndExecution();
+  for (auto child : root->GetChildren()) {
+    EndExecution(child);
+  }
+}
+
+/**
+ * @brief Append the tuples of a result tile to the result, as strings in the
+ * given formats.
+ */
+static void AddResultTuples(executor::LogicalTile *logical_tile,
+                            const std::vector<int> &result_format,
+                            std::vector<ResultType> &result) {
+  LOG_TRACE("Final Answer: %s",
+            logical_tile->GetInfo().c_str());  // Printing the answers
+  std::unique_ptr<catalog::Schema> output_schema(
+      logical_tile->GetPhysicalSchema());  // Physical schema of the tile
+  std::vector<std::vector<std::string>> answer_tuples;
+  answer_tuples = std::move(logical_tile->GetAllValuesAsStrings(result_format));
+
+  // Construct the returned results
+  for (auto &tuple : answer_tuples) {
+    unsigned int col_index = 0;
+    auto &schema_columns = output_schema->GetColumns();
+    for (auto &column : schema_columns) {
+      auto column_name = column.GetName();
+      auto res = ResultType();
+      PlanExecutor::copyFromTo(column_name, res.first);
+      LOG_TRACE("column name: %s", column_name.c_str());
+      PlanExecutor::copyFromTo(tuple[col_index++], res.second);
+      if (tuple[col_index - 1].c_str() != nullptr) {
+        LOG_TRACE("column content: %s", tuple[col_index - 1].c_str());
+      }
+      result.push_back(res);
+    }
+  }
+}
+
+/**
+ * @brief Commit or abort a transaction begun for a single statement.
+ * @return result of the transaction.
+ */
+static Result EndTransaction(concurrency::Transaction *txn,
+                             const bool single_statement_txn) {
+  if (single_statement_txn == false) {
+    // the caller ends its transaction
+    return txn->GetResult();
+  }
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  switch (txn->GetResult()) {
+    case Result::RESULT_SUCCESS:
+      // Commit
+      LOG_TRACE("Commit Transaction");
+      return txn_manager.CommitTransaction(txn);
+
+    case Result::RESULT_FAILURE:
+    default:
+      // Abort
+      LOG_TRACE("Abort Transaction");
+      return txn_manager.AbortTransaction(txn);
+  }
+}
+
 /**
  * @brief Build a executor tree and execute it.
  * Use std::vector<common::Value> as params to make it more elegant for
@@ -46,7 +121,8 @@ void CleanExecutorTree(executor::AbstractExecutor *root);
 peloton_status PlanExecutor::ExecutePlan(
     const planner::AbstractPlan *plan,
     const std::vector<common::Value> &params, std::vector<ResultType> &result,
-    const std::vector<int> &result_format) {
+    const std::vector<int> &result_format, concurrency::Transaction *txn,
+    std::string *profile, executor::ExecutorTreePool *tree_pool) {
   peloton_status p_status;
 
   if (plan == nullptr) return p_status;
@@ -54,39 +130,56 @@ peloton_status PlanExecutor::ExecutePlan(
   LOG_TRACE("PlanExecutor Start ");
 
   bool status;
-  bool init_failure = false;
   bool single_statement_txn = false;
 
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
-  // auto txn = peloton::concurrency::current_txn;
   // This happens for single statement queries in PG
-  // if (txn == nullptr) {
-  single_statement_txn = true;
-  auto txn = txn_manager.BeginTransaction();
-  // }
+  if (txn == nullptr) {
+    single_statement_txn = true;
+    txn = txn_manager.BeginTransaction();
+  }
   PL_ASSERT(txn);
 
   LOG_TRACE("Txn ID = %lu ", txn->GetTransactionId());
-  LOG_TRACE("Building the executor tree");
 
-  // Use const std::vector<common::Value> &params to make it more elegant for
-  // network
-  std::unique_ptr<executor::ExecutorContext> executor_context(
-      BuildExecutorContext(params, txn));
+  // The profiled executors keep their statistics, they are not reused
+  if (profile != nullptr) {
+    tree_pool = nullptr;
+  }
 
-  // Build the executor tree
-  std::unique_ptr<executor::AbstractExecutor> executor_tree(
-      BuildExecutorTree(nullptr, plan, executor_context.get()));
+  std::unique_ptr<executor::ExecutorTree> executor_tree;
+  if (tree_pool != nullptr) {
+    executor_tree = tree_pool->Acquire();
+  }
+
+  if (executor_tree != nullptr) {
+    LOG_TRACE("Reusing an executor tree");
+    executor_tree->context->Rebind(txn, params);
+  } else {
+    LOG_TRACE("Building the executor tree");
+
+    // Use const std::vector<common::Value> &params to make it more elegant for
+    // network
+    auto executor_context = BuildExecutorContext(params, txn);
+    executor_context->SetProfiling(profile != nullptr);
+
+    // Build the executor tree
+    executor_tree.reset(new executor::ExecutorTree(
+        executor_context,
+        BuildExecutorTree(nullptr, plan, executor_context)));
+  }
+  auto executor_context = executor_tree->context.get();
+  auto executor_root = executor_tree->root.get();
 
   LOG_TRACE("Initializing the executor tree");
 
-  // Initialize the executor tree
-  status = executor_tree->Init();
+  // Initialize the executor tree, this also resets a reused one
+  status = executor_root->Init();
 
   // Abort and cleanup
   if (status == false) {
-    init_failure = true;
     txn->SetResult(Result::RESULT_FAILURE);
+    tree_pool = nullptr;
     goto cleanup;
   }
 
@@ -95,36 +188,13 @@ peloton_status PlanExecutor::ExecutePlan(
 
   // Execute the tree until we get result tiles from root node
   while (status == true) {
-    status = executor_tree->Execute();
+    status = executor_root->Execute();
 
     std::unique_ptr<executor::LogicalTile> logical_tile(
-        executor_tree->GetOutput());
+        executor_root->GetOutput());
     // Some executors don't return logical tiles (e.g., Update).
     if (logical_tile.get() != nullptr) {
-      LOG_TRACE("Final Answer: %s",
-                logical_tile->GetInfo().c_str());  // Printing the answers
-      std::unique_ptr<catalog::Schema> output_schema(
-          logical_tile->GetPhysicalSchema());  // Physical schema of the tile
-      std::vector<std::vector<std::string>> answer_tuples;
-      answer_tuples =
-          std::move(logical_tile->GetAllValuesAsStrings(result_format));
-
-      // Construct the returned results
-      for (auto &tuple : answer_tuples) {
-        unsigned int col_index = 0;
-        auto &schema_columns = output_schema->GetColumns();
-        for (auto &column : schema_columns) {
-          auto column_name = column.GetName();
-          auto res = ResultType();
-          PlanExecutor::copyFromTo(column_name, res.first);
-          LOG_TRACE("column name: %s", column_name.c_str());
-          PlanExecutor::copyFromTo(tuple[col_index++], res.second);
-          if (tuple[col_index - 1].c_str() != nullptr) {
-            LOG_TRACE("column content: %s", tuple[col_index - 1].c_str());
-          }
-          result.push_back(res);
-        }
-      }
+      AddResultTuples(logical_tile.get(), result_format, result);
     }
   }
 
@@ -135,30 +205,74 @@ peloton_status PlanExecutor::ExecutePlan(
 // final cleanup
 cleanup:
 
-  LOG_TRACE("About to commit: single stmt: %d, init_failure: %d, status: %d",
-            single_statement_txn, init_failure, txn->GetResult());
+  LOG_TRACE("About to commit: single stmt: %d, status: %d",
+            single_statement_txn, txn->GetResult());
+
+  // The query metric is completed once the transaction ends, attach the
+  // profile before
+  if (profile != nullptr) {
+    *profile = GetProfileInfo(executor_root);
+    if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+      auto query_metric =
+          stats::BackendStatsContext::GetInstance()->GetOnGoingQueryMetric();
+      if (query_metric != nullptr) {
+        query_metric->SetOperatorProfile(*profile);
+      }
+    }
+  }
+
+  // A pooled tree may outlive the tables it read, do not wait for it to be
+  // freed
+  EndExecution(executor_root);
 
   // should we commit or abort ?
-  if (single_statement_txn == true || init_failure == true) {
-    auto status = txn->GetResult();
-    switch (status) {
-      case Result::RESULT_SUCCESS:
-        // Commit
-        LOG_TRACE("Commit Transaction");
-        p_status.m_result = txn_manager.CommitTransaction(txn);
-        break;
+  p_status.m_result = EndTransaction(txn, single_statement_txn);
 
-      case Result::RESULT_FAILURE:
-      default:
-        // Abort
-        LOG_TRACE("Abort Transaction");
-        p_status.m_result = txn_manager.AbortTransaction(txn);
-    }
+  // keep the executor tree for the next execution, or clean it up
+  if (tree_pool != nullptr) {
+    tree_pool->Release(std::move(executor_tree));
   }
 
-  // clean up executor tree
-  CleanExecutorTree(executor_tree.get());
+  return p_status;
+}
+
+/**
+ * @brief Run a compiled pipeline, the tuples are pushed through the fused
+ * operators instead of being pulled up an executor tree.
+ * @return status of execution.
+ */
+peloton_status PlanExecutor::ExecutePipeline(
+    const executor::CompiledPipeline *pipeline,
+    const std::vector<common::Value> &params, std::vector<ResultType> &result,
+    const std::vector<int> &result_format, concurrency::Transaction *txn) {
+  peloton_status p_status;
+
+  if (pipeline == nullptr) return p_status;
+
+  bool single_statement_txn = false;
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  if (txn == nullptr) {
+    single_statement_txn = true;
+    txn = txn_manager.BeginTransaction();
+  }
+  PL_ASSERT(txn);
+
+  std::unique_ptr<executor::ExecutorContext> executor_context(
+      BuildExecutorContext(params, txn));
 
+  LOG_TRACE("Running the compiled pipeline");
+  result.clear();
+  auto status = pipeline->Execute(
+      executor_context.get(),
+      [&result, &result_format](executor::LogicalTile *logical_tile) {
+        AddResultTuples(logical_tile, result_format, result);
+      });
+  if (status == false) {
+    txn->SetResult(Result::RESULT_FAILURE);
+  }
+
+  p_status.m_processed = executor_context->num_processed;
+  p_status.m_result = EndTransaction(txn, single_statement_txn);
   return p_status;
 }
 
@@ -292,6 +406,55 @@ void PlanExecutor::PrintPlan(const planner::AbstractPlan *plan,
   }
 }
 
+/**
+ * @brief Pretty print the executor tree with the runtime statistics of the
+ * executors.
+ * @param The profiled executor tree
+ * @return The annotated plan, one line per executor.
+ */
+std::string PlanExecutor::GetProfileInfo(
+    const executor::AbstractExecutor *executor, std::string prefix) {
+  if (executor == nullptr) {
+    return "";
+  }
+
+  std::stringstream os;
+  os << prefix
+     << PlanNodeTypeToString(executor->GetRawNode()->GetPlanNodeType());
+
+  auto profile = executor->GetProfile();
+  if (profile != nullptr) {
+    // The time of an executor includes the time of its children
+    size_t rows_in = 0;
+    uint64_t children_time_ns = 0;
+    for (auto child : executor->GetChildren()) {
+      if (child->GetProfile() != nullptr) {
+        rows_in += child->GetProfile()->rows_out;
+        children_time_ns += child->GetProfile()->wall_time_ns;
+      }
+    }
+    uint64_t self_time_ns = profile->wall_time_ns > children_time_ns
+                                ? profile->wall_time_ns - children_time_ns
+                                : 0;
+
+    os << std::fixed << std::setprecision(3);
+    os << " (rows in=" << rows_in << " out=" << profile->rows_out;
+    os << " tiles=" << profile->tiles_out << " calls=" << profile->calls;
+    os << " time=" << (double)profile->wall_time_ns / 1000000 << " ms";
+    os << " self=" << (double)self_time_ns / 1000000 << " ms";
+    if (profile->cycles != 0) {
+      os << " cycles=" << profile->cycles;
+    }
+    os << ")";
+  }
+  os << std::endl;
+
+  for (auto child : executor->GetChildren()) {
+    os << GetProfileInfo(child, prefix + "  ");
+  }
+  return os.str();
+}
+
 /**
  * @brief Build Executor Context
  */
@@ -315,6 +478,24 @@ executor::AbstractExecutor *BuildExecutorTree(
 
   executor::AbstractExecutor *child_executor = nullptr;
 
+  // Run the pipelines that feed a pipeline breaker, or the client, on the
+  // morsels of their table in parallel
+  auto degree_of_parallelism =
+      executor::TaskScheduler::GetInstance().GetParallelism(
+          executor_context->GetDegreeOfParallelism());
+  if (degree_of_parallelism > 1 &&
+      (root == nullptr ||
+       executor::Pipeline::IsPipelineBreaker(root->GetRawNode())) &&
+      executor::Pipeline::IsParallelizable(plan)) {
+    LOG_TRACE("Adding Gather Executer");
+    child_executor = new executor::GatherExecutor(plan, executor_context);
+    if (root != nullptr)
+      root->AddChild(child_executor);
+    else
+      root = child_executor;
+    return root;
+  }
+
   auto plan_node_type = plan->GetPlanNodeType();
   switch (plan_node_type) {
     case PLAN_NODE_TYPE_INVALID:
@@ -357,6 +538,12 @@ executor::AbstractExecutor *BuildExecutorTree(
           new executor::NestedLoopJoinExecutor(plan, executor_context);
       break;
 
+    case PLAN_NODE_TYPE_NESTLOOPINDEX:
+      LOG_TRACE("Adding Index Nested Loop Join Executer");
+      child_executor =
+          new executor::IndexNestedLoopJoinExecutor(plan, executor_context);
+      break;
+
     case PLAN_NODE_TYPE_MERGEJOIN:
       LOG_TRACE("Adding Merge Join Executer");
       child_executor = new executor::MergeJoinExecutor(plan, executor_context);
@@ -17,12 +17,16 @@
 #include <vector>
 #include <numeric>
 
+#include "common/config.h"
 #include "common/types.h"
 #include "executor/logical_tile.h"
 #include "executor/logical_tile_factory.h"
 #include "executor/executor_context.h"
+#include "executor/morsel_queue.h"
 #include "expression/abstract_expression.h"
+#include "expression/compiled_expression.h"
 #include "common/container_tuple.h"
+#include "statistics/metric_series.h"
 #include "storage/data_table.h"
 #include "storage/tile_group_header.h"
 #include "storage/tile.h"
@@ -41,6 +45,8 @@ SeqScanExecutor::SeqScanExecutor(const planner::AbstractPlan *node,
                                  ExecutorContext *executor_context)
     : AbstractScanExecutor(node, executor_context) {}
 
+SeqScanExecutor::~SeqScanExecutor() { DetachSharedScan(); }
+
 /**
  * @brief Let base class DInit() first, then do mine.
  * @return true on success, false otherwise.
@@ -56,6 +62,9 @@ bool SeqScanExecutor::DInit() {
   target_table_ = node.GetTable();
   
   current_tile_group_offset_ = START_OID;
+  morsel_end_offset_ = START_OID;
+  scan_start_offset_ = START_OID;
+  DetachSharedScan();
 
   if (target_table_ != nullptr) {
     table_tile_group_count_ = target_table_->GetTileGroupCount();
@@ -64,6 +73,31 @@ bool SeqScanExecutor::DInit() {
       column_ids_.resize(target_table_->GetSchema()->GetColumnCount());
       std::iota(column_ids_.begin(), column_ids_.end(), 0);
     }
+
+    // The metric tables are virtual, their rows are in a metric series
+    metric_series_ = stats::MetricSeries::GetInstance(target_table_);
+    metric_series_done_ = false;
+
+    // A full scan joins the scans already running over the table. The
+    // workers of a parallel pipeline get their tile groups from the morsels.
+    if (metric_series_ == nullptr && morsel_queue_ == nullptr &&
+        table_tile_group_count_ > 1 && FLAGS_shared_scans == true) {
+      shared_scan_ = &target_table_->GetSharedScan();
+      scan_start_offset_ = shared_scan_->Attach(table_tile_group_count_);
+    }
+  }
+
+  // The predicate is compiled once per plan, the evaluator is per executor
+  compiled_predicate_.reset();
+  if (predicate_ != nullptr && target_table_ != nullptr &&
+      metric_series_ == nullptr && FLAGS_compile_expressions == true) {
+    auto compiled_predicate =
+        node.GetCompiledPredicate(executor_context_->GetParams());
+    if (compiled_predicate != nullptr &&
+        compiled_predicate->GetValueType() == common::Type::BOOLEAN) {
+      compiled_predicate_.reset(new expression::CompiledExpressionEvaluator(
+          compiled_predicate, executor_context_));
+    }
   }
 
   return true;
@@ -115,6 +149,10 @@ bool SeqScanExecutor::DExecute() {
     PL_ASSERT(target_table_ != nullptr);
     PL_ASSERT(column_ids_.size() > 0);
 
+    if (metric_series_ != nullptr) {
+      return ExecuteMetricSeries();
+    }
+
     // Force to use occ txn manager if dirty read is forbidden
     concurrency::TransactionManager &transaction_manager =
         concurrency::TransactionManagerFactory::GetInstance();
@@ -123,17 +161,36 @@ bool SeqScanExecutor::DExecute() {
     auto current_txn = executor_context_->GetTransaction();
 
     // Retrieve next tile group.
-    while (current_tile_group_offset_ < table_tile_group_count_) {
-      auto tile_group =
-          target_table_->GetTileGroup(current_tile_group_offset_++);
+    oid_t tile_group_offset = INVALID_OID;
+    while (GetNextTileGroupOffset(tile_group_offset) == true) {
+      auto tile_group = target_table_->GetTileGroup(tile_group_offset);
+
+      // Skip tile groups that can not hold any qualifying tuple
+      if (CanSkipTileGroup(tile_group.get()) == true) {
+        continue;
+      }
+
       auto tile_group_header = tile_group->GetHeader();
 
       oid_t active_tuple_count = tile_group->GetNextTupleSlot();
 
+      // Filter compressed tile groups without decompressing the values
+      std::vector<bool> matches;
+      bool prefiltered = EvaluateCompressedPredicates(
+          column_predicates_, tile_group.get(), active_tuple_count, matches);
+
+      // The compiled predicate is evaluated at once on the visible tuples
+      bool compiled = (compiled_predicate_ != nullptr &&
+                       compiled_predicate_->SetTileGroup(tile_group.get()));
+
       // Construct position list by looping through tile group
       // and applying the predicate.
       std::vector<oid_t> position_list;
       for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+        if (prefiltered == true && matches[tuple_id] == false) {
+          continue;
+        }
+
         ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
 
 
@@ -142,7 +199,9 @@ bool SeqScanExecutor::DExecute() {
         // check transaction visibility
         if (visibility == VISIBILITY_OK) {
           // if the tuple is visible, then perform predicate evaluation.
-          if (predicate_ == nullptr) {
+          if (compiled == true) {
+            position_list.push_back(tuple_id);
+          } else if (predicate_ == nullptr) {
             position_list.push_back(tuple_id);
             auto res = transaction_manager.PerformRead(current_txn, location, acquire_owner);
             if (!res) {
@@ -169,6 +228,20 @@ bool SeqScanExecutor::DExecute() {
         }
       }
 
+      if (compiled == true) {
+        compiled_predicate_->Filter(position_list);
+        for (auto tuple_id : position_list) {
+          ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
+          auto res = transaction_manager.PerformRead(current_txn, location,
+                                                     acquire_owner);
+          if (!res) {
+            transaction_manager.SetTransactionResult(current_txn,
+                                                     RESULT_FAILURE);
+            return res;
+          }
+        }
+      }
+
       // Don't return empty tiles
       if (position_list.size() == 0) {
         continue;
@@ -188,5 +261,90 @@ bool SeqScanExecutor::DExecute() {
   return false;
 }
 
+bool SeqScanExecutor::ExecuteMetricSeries() {
+  if (metric_series_done_ == true) {
+    return false;
+  }
+  metric_series_done_ = true;
+
+  // The rows are not versioned, the scan sees the rows of the aggregations
+  // so far
+  auto rows = metric_series_->GetRows();
+  std::vector<stats::MetricRow *> qualifying_rows;
+  for (auto &row : rows) {
+    if (predicate_ != nullptr) {
+      expression::ContainerTuple<stats::MetricRow> tuple(&row);
+      if (predicate_->Evaluate(&tuple, nullptr, executor_context_).IsTrue() ==
+          false) {
+        continue;
+      }
+    }
+    qualifying_rows.push_back(&row);
+  }
+
+  if (qualifying_rows.empty() == true) {
+    return false;
+  }
+
+  // Materialize the rows into a temporary tile
+  auto schema = target_table_->GetSchema();
+  std::shared_ptr<storage::Tile> tile(
+      storage::TileFactory::GetTempTile(*schema, qualifying_rows.size()));
+  for (oid_t tuple_id = 0; tuple_id < qualifying_rows.size(); tuple_id++) {
+    auto &row = *qualifying_rows[tuple_id];
+    for (oid_t column_id = 0; column_id < row.size(); column_id++) {
+      tile->SetValue(row[column_id], tuple_id, column_id);
+    }
+  }
+
+  std::unique_ptr<LogicalTile> logical_tile(LogicalTileFactory::GetTile());
+  std::vector<oid_t> position_list(qualifying_rows.size());
+  std::iota(position_list.begin(), position_list.end(), 0);
+  auto position_list_idx =
+      logical_tile->AddPositionList(std::move(position_list));
+  for (auto column_id : column_ids_) {
+    logical_tile->AddColumn(tile, column_id, position_list_idx);
+  }
+
+  SetOutput(logical_tile.release());
+  return true;
+}
+
+bool SeqScanExecutor::GetNextTileGroupOffset(oid_t &tile_group_offset) {
+  if (morsel_queue_ == nullptr) {
+    if (current_tile_group_offset_ >= table_tile_group_count_) {
+      DetachSharedScan();
+      return false;
+    }
+    // wrap around to the tile groups before the start of the scan
+    tile_group_offset = (scan_start_offset_ + current_tile_group_offset_++) %
+                        table_tile_group_count_;
+    if (shared_scan_ != nullptr) {
+      shared_scan_->SetPosition(tile_group_offset);
+    }
+    return true;
+  }
+
+  // move on to the next morsel once the current one is scanned
+  if (current_tile_group_offset_ >= morsel_end_offset_) {
+    Morsel morsel;
+    if (morsel_queue_->GetNextMorsel(worker_id_, morsel) == false) {
+      return false;
+    }
+    current_tile_group_offset_ = morsel.tile_group_offset;
+    morsel_end_offset_ = morsel.tile_group_offset + morsel.tile_group_count;
+  }
+
+  tile_group_offset = current_tile_group_offset_++;
+  return true;
+}
+
+void SeqScanExecutor::DetachSharedScan() {
+  if (shared_scan_ != nullptr) {
+    shared_scan_->Detach();
+    shared_scan_ = nullptr;
+  }
+}
+
 }  // namespace executor
 }  // namespace peloton
@@ -0,0 +1,154 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// task_scheduler.cpp
+//
+// Identification: src/executor/task_scheduler.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <chrono>
+
+#include "common/logger.h"
+#include "executor/task_scheduler.h"
+
+namespace peloton {
+namespace executor {
+
+// sleep time of an idle worker
+#define TASK_SCHEDULER_SLEEP_MICROSECONDS 50
+
+// number of times an idle worker looks for a task before it goes to sleep
+#define TASK_SCHEDULER_SPIN_COUNT 64
+
+TaskScheduler::TaskScheduler() : is_running_(false), pending_task_count_(0) {}
+
+TaskScheduler &TaskScheduler::GetInstance() {
+  static TaskScheduler task_scheduler;
+  return task_scheduler;
+}
+
+void TaskScheduler::StartScheduler(const size_t &worker_count) {
+  std::lock_guard<std::mutex> lock(scheduler_mutex_);
+  if (is_running_ == true || worker_count == 0) {
+    return;
+  }
+
+  LOG_TRACE("Starting task scheduler with %lu workers", worker_count);
+
+  task_queues_.clear();
+  for (size_t worker_itr = 0; worker_itr < worker_count; worker_itr++) {
+    task_queues_.emplace_back(new TaskQueue());
+  }
+
+  is_running_ = true;
+  for (size_t worker_itr = 0; worker_itr < worker_count; worker_itr++) {
+    worker_threads_.emplace_back(
+        new std::thread(&TaskScheduler::Running, this, worker_itr));
+  }
+}
+
+void TaskScheduler::StopScheduler() {
+  std::lock_guard<std::mutex> lock(scheduler_mutex_);
+  if (is_running_ == false) {
+    return;
+  }
+
+  LOG_TRACE("Stopping task scheduler");
+  is_running_ = false;
+  for (auto &worker_thread : worker_threads_) {
+    worker_thread->join();
+  }
+  worker_threads_.clear();
+
+  DrainTasks();
+}
+
+size_t TaskScheduler::GetParallelism(
+    const size_t &degree_of_parallelism) const {
+  if (is_running_ == false || degree_of_parallelism == 0) {
+    return 1;
+  }
+  return std::min(degree_of_parallelism, GetWorkerCount() + 1);
+}
+
+bool TaskScheduler::SubmitTask(const Task &task, const size_t &worker_id) {
+  if (is_running_ == false) {
+    return false;
+  }
+
+  auto &task_queue = task_queues_[worker_id % task_queues_.size()];
+  task_queue->queue_lock.Lock();
+  task_queue->tasks.push_back(task);
+  pending_task_count_++;
+  task_queue->queue_lock.Unlock();
+
+  return true;
+}
+
+bool TaskScheduler::RunPendingTask(const size_t &worker_id) {
+  Task task;
+  if (PopTask(worker_id, task) == false) {
+    return false;
+  }
+  task();
+  return true;
+}
+
+void TaskScheduler::Running(const size_t worker_id) {
+  size_t idle_count = 0;
+  while (is_running_ == true) {
+    if (RunPendingTask(worker_id) == true) {
+      idle_count = 0;
+      continue;
+    }
+
+    if (++idle_count < TASK_SCHEDULER_SPIN_COUNT) {
+      std::this_thread::yield();
+    } else {
+      std::this_thread::sleep_for(
+          std::chrono::microseconds(TASK_SCHEDULER_SLEEP_MICROSECONDS));
+    }
+  }
+}
+
+bool TaskScheduler::PopTask(const size_t &worker_id, Task &task) {
+  if (pending_task_count_.load() == 0) {
+    return false;
+  }
+
+  size_t queue_count = task_queues_.size();
+  for (size_t queue_itr = 0; queue_itr < queue_count; queue_itr++) {
+    auto &task_queue = task_queues_[(worker_id + queue_itr) % queue_count];
+
+    task_queue->queue_lock.Lock();
+    if (task_queue->tasks.empty() == false) {
+      // the owner takes the oldest task, thieves take the newest one
+      if (queue_itr == 0) {
+        task = std::move(task_queue->tasks.front());
+        task_queue->tasks.pop_front();
+      } else {
+        task = std::move(task_queue->tasks.back());
+        task_queue->tasks.pop_back();
+      }
+      pending_task_count_--;
+      task_queue->queue_lock.Unlock();
+      return true;
+    }
+    task_queue->queue_lock.Unlock();
+  }
+
+  return false;
+}
+
+void TaskScheduler::DrainTasks() {
+  while (RunPendingTask(0) == true)
+    ;
+}
+
+}  // End executor namespace
+}  // End peloton namespace
@@ -41,10 +41,9 @@ UpdateExecutor::UpdateExecutor(const planner::AbstractPlan *node,
  */
 bool UpdateExecutor::DInit() {
   PL_ASSERT(children_.size() == 1);
-  PL_ASSERT(target_table_ == nullptr);
-  PL_ASSERT(project_info_ == nullptr);
 
-  // Grab settings from node
+  // Grab settings from node, the executor may be initialized again to be
+  // reused
   const planner::UpdatePlan &node = GetPlanNode<planner::UpdatePlan>();
   target_table_ = node.GetTable();
   project_info_ = node.GetProjectInfo();
@@ -136,10 +135,10 @@ bool UpdateExecutor::DExecute() {
         ItemPointer new_location = target_table_->AcquireVersion();
         
         auto &manager = catalog::Manager::GetInstance();
-        auto new_tile_group = manager.GetTileGroup(new_location.block);
+        auto new_tile_group = manager.GetTileGroupPtr(new_location.block);
 
         expression::ContainerTuple<storage::TileGroup> new_tuple(
-            new_tile_group.get(), new_location.offset);
+            new_tile_group, new_location.offset);
 
         expression::ContainerTuple<storage::TileGroup> old_tuple(
             tile_group, physical_tuple_id);
@@ -0,0 +1,1017 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compiled_expression.cpp
+//
+// Identification: src/expression/compiled_expression.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+
+#include "catalog/schema.h"
+#include "common/exception.h"
+#include "common/value_factory.h"
+#include "executor/executor_context.h"
+#include "expression/abstract_expression.h"
+#include "expression/compiled_expression.h"
+#include "expression/constant_value_expression.h"
+#include "expression/parameter_value_expression.h"
+#include "expression/tuple_value_expression.h"
+#include "storage/tile.h"
+#include "storage/tile_group.h"
+
+namespace peloton {
+namespace expression {
+
+//===--------------------------------------------------------------------===//
+// Null Bitmasks
+//===--------------------------------------------------------------------===//
+
+static const size_t COMPILED_NULL_WORDS = COMPILED_BATCH_SIZE / 64;
+
+static inline size_t GetNullWordCount(const size_t &size) {
+  return (size + 63) / 64;
+}
+
+static inline void SetNull(uint64_t *nulls, const size_t &offset) {
+  nulls[offset / 64] |= (1UL << (offset % 64));
+}
+
+static inline bool IsNull(const uint64_t *nulls, const size_t &offset) {
+  return (nulls[offset / 64] & (1UL << (offset % 64))) != 0;
+}
+
+static inline void ClearNulls(uint64_t *nulls, const size_t &size) {
+  std::memset(nulls, 0, GetNullWordCount(size) * sizeof(uint64_t));
+}
+
+static inline void OrNulls(uint64_t *nulls, const uint64_t *left_nulls,
+                           const uint64_t *right_nulls, const size_t &size) {
+  for (size_t word = 0; word < GetNullWordCount(size); word++) {
+    nulls[word] = left_nulls[word] | right_nulls[word];
+  }
+}
+
+//===--------------------------------------------------------------------===//
+// Typed Accessors
+//===--------------------------------------------------------------------===//
+
+// the stored values that stand for null, see common/value.h
+static inline bool IsNullValue(const int8_t &value) {
+  return value == PELOTON_INT8_NULL;
+}
+static inline bool IsNullValue(const int16_t &value) {
+  return value == PELOTON_INT16_NULL;
+}
+static inline bool IsNullValue(const int32_t &value) {
+  return value == PELOTON_INT32_NULL;
+}
+static inline bool IsNullValue(const int64_t &value) {
+  return value == PELOTON_INT64_NULL;
+}
+static inline bool IsNullValue(const double &value) {
+  return value == PELOTON_DECIMAL_NULL;
+}
+
+template <typename D>
+static inline D GetDatum(const CompiledDatum &datum);
+
+template <>
+inline int64_t GetDatum<int64_t>(const CompiledDatum &datum) {
+  return datum.integer;
+}
+
+template <>
+inline double GetDatum<double>(const CompiledDatum &datum) {
+  return datum.decimal;
+}
+
+static inline void SetDatum(CompiledDatum &datum, const int64_t &value) {
+  datum.integer = value;
+}
+
+static inline void SetDatum(CompiledDatum &datum, const double &value) {
+  datum.decimal = value;
+}
+
+// the stored value of the column of the tuple
+template <typename T>
+static inline T ReadColumn(const char *base, const size_t &stride,
+                           const oid_t &tuple_id) {
+  T value;
+  std::memcpy(&value, base + tuple_id * stride, sizeof(T));
+  return value;
+}
+
+// whether an integer result can be stored in the given type. the smallest
+// value of each type stands for null, so it is out of range too.
+static inline bool IsInRange(const int64_t &value,
+                             const common::Type::TypeId &type_id) {
+  switch (type_id) {
+    case common::Type::TINYINT:
+      return value > INT8_MIN && value <= INT8_MAX;
+    case common::Type::SMALLINT:
+      return value > INT16_MIN && value <= INT16_MAX;
+    case common::Type::INTEGER:
+      return value > INT32_MIN && value <= INT32_MAX;
+    default:
+      return value > INT64_MIN;
+  }
+}
+
+//===--------------------------------------------------------------------===//
+// Steps
+//===--------------------------------------------------------------------===//
+
+template <typename T, typename D>
+static void LoadColumn(const CompiledStep &step, CompiledBatch &batch) {
+  auto base = batch.column_bases[step.column];
+  auto stride = batch.column_strides[step.column];
+  auto values = batch.values[step.result].data();
+  auto nulls = batch.nulls[step.result].data();
+  ClearNulls(nulls, batch.size);
+  for (size_t offset = 0; offset < batch.size; offset++) {
+    auto value = ReadColumn<T>(base, stride, batch.tuple_ids[offset]);
+    SetDatum(values[offset], static_cast<D>(value));
+    if (IsNullValue(value)) {
+      SetNull(nulls, offset);
+    }
+  }
+}
+
+static void LoadConstant(const CompiledStep &step, CompiledBatch &batch) {
+  auto constant = batch.constants[step.constant];
+  auto values = batch.values[step.result].data();
+  auto nulls = batch.nulls[step.result].data();
+  for (size_t offset = 0; offset < batch.size; offset++) {
+    values[offset] = constant;
+  }
+  std::memset(nulls, batch.constant_nulls[step.constant] ? 0xff : 0,
+              GetNullWordCount(batch.size) * sizeof(uint64_t));
+}
+
+static void CastToDecimal(const CompiledStep &step, CompiledBatch &batch) {
+  auto left = batch.values[step.left].data();
+  auto values = batch.values[step.result].data();
+  for (size_t offset = 0; offset < batch.size; offset++) {
+    values[offset].decimal = static_cast<double>(left[offset].integer);
+  }
+  std::memcpy(batch.nulls[step.result].data(), batch.nulls[step.left].data(),
+              GetNullWordCount(batch.size) * sizeof(uint64_t));
+}
+
+template <template <typename> class Op, typename D>
+static void Compare(const CompiledStep &step, CompiledBatch &batch) {
+  Op<D> op;
+  auto left = batch.values[step.left].data();
+  auto right = batch.values[step.right].data();
+  auto values = batch.values[step.result].data();
+  for (size_t offset = 0; offset < batch.size; offset++) {
+    values[offset].integer =
+        op(GetDatum<D>(left[offset]), GetDatum<D>(right[offset]));
+  }
+  OrNulls(batch.nulls[step.result].data(), batch.nulls[step.left].data(),
+          batch.nulls[step.right].data(), batch.size);
+}
+
+// a column compared with a constant in a single pass, the most common
+// predicate
+template <template <typename> class Op, typename T, typename D>
+static void CompareColumnConstant(const CompiledStep &step,
+                                  CompiledBatch &batch) {
+  Op<D> op;
+  auto base = batch.column_bases[step.column];
+  auto stride = batch.column_strides[step.column];
+  auto constant = GetDatum<D>(batch.constants[step.constant]);
+  auto values = batch.values[step.result].data();
+  auto nulls = batch.nulls[step.result].data();
+  if (batch.constant_nulls[step.constant] == true) {
+    std::memset(nulls, 0xff, GetNullWordCount(batch.size) * sizeof(uint64_t));
+    return;
+  }
+
+  ClearNulls(nulls, batch.size);
+  for (size_t offset = 0; offset < batch.size; offset++) {
+    auto value = ReadColumn<T>(base, stride, batch.tuple_ids[offset]);
+    values[offset].integer = op(static_cast<D>(value), constant);
+    if (IsNullValue(value)) {
+      SetNull(nulls, offset);
+    }
+  }
+}
+
+// integer operators return true on overflow
+struct AddOperator {
+  static inline bool Apply(int64_t x, int64_t y, int64_t &result) {
+    return __builtin_add_overflow(x, y, &result);
+  }
+  static inline double Apply(double x, double y) { return x + y; }
+};
+
+struct SubtractOperator {
+  static inline bool Apply(int64_t x, int64_t y, int64_t &result) {
+    return __builtin_sub_overflow(x, y, &result);
+  }
+  static inline double Apply(double x, double y) { return x - y; }
+};
+
+struct MultiplyOperator {
+  static inline bool Apply(int64_t x, int64_t y, int64_t &result) {
+    return __builtin_mul_overflow(x, y, &result);
+  }
+  static inline double Apply(double x, double y) { return x * y; }
+};
+
+struct DivideOperator {
+  static inline bool Apply(int64_t x, int64_t y, int64_t &result) {
+    if (y == 0) {
+      throw Exception(EXCEPTION_TYPE_DIVIDE_BY_ZERO, "Division by zero.");
+    }
+    if (x == INT64_MIN && y == -1) {
+      return true;
+    }
+    result = x / y;
+    return false;
+  }
+  static inline double Apply(double x, double y) {
+    if (y == 0) {
+      throw Exception(EXCEPTION_TYPE_DIVIDE_BY_ZERO, "Division by zero.");
+    }
+    return x / y;
+  }
+};
+
+struct ModuloOperator {
+  static inline bool Apply(int64_t x, int64_t y, int64_t &result) {
+    if (y == 0) {
+      throw Exception(EXCEPTION_TYPE_DIVIDE_BY_ZERO, "Division by zero.");
+    }
+    result = (y == -1) ? 0 : x % y;
+    return false;
+  }
+  static inline double Apply(double x, double y) {
+    if (y == 0) {
+      throw Exception(EXCEPTION_TYPE_DIVIDE_BY_ZERO, "Division by zero.");
+    }
+    return std::fmod(x, y);
+  }
+};
+
+template <typename Operator>
+static void IntegerArithmetic(const CompiledStep &step, CompiledBatch &batch) {
+  auto left = batch.values[step.left].data();
+  auto right = batch.values[step.right].data();
+  auto values = batch.values[step.result].data();
+  auto nulls = batch.nulls[step.result].data();
+  OrNulls(nulls, batch.nulls[step.left].data(), batch.nulls[step.right].data(),
+          batch.size);
+  for (size_t offset = 0; offset < batch.size; offset++) {
+    if (IsNull(nulls, offset) == true) {
+      continue;
+    }
+    int64_t result;
+    if (Operator::Apply(left[offset].integer, right[offset].integer, result) ||
+        IsInRange(result, step.value_type) == false) {
+      throw Exception(EXCEPTION_TYPE_OUT_OF_RANGE,
+                      "Numeric value out of range.");
+    }
+    values[offset].integer = result;
+  }
+}
+
+template <typename Operator>
+static void DecimalArithmetic(const CompiledStep &step, CompiledBatch &batch) {
+  auto left = batch.values[step.left].data();
+  auto right = batch.values[step.right].data();
+  auto values = batch.values[step.result].data();
+  auto nulls = batch.nulls[step.result].data();
+  OrNulls(nulls, batch.nulls[step.left].data(), batch.nulls[step.right].data(),
+          batch.size);
+  for (size_t offset = 0; offset < batch.size; offset++) {
+    if (IsNull(nulls, offset) == false) {
+      values[offset].decimal =
+          Operator::Apply(left[offset].decimal, right[offset].decimal);
+    }
+  }
+}
+
+// three valued logic, false wins over null in AND and true in OR
+static void And(const CompiledStep &step, CompiledBatch &batch) {
+  auto left = batch.values[step.left].data();
+  auto right = batch.values[step.right].data();
+  auto left_nulls = batch.nulls[step.left].data();
+  auto right_nulls = batch.nulls[step.right].data();
+  auto values = batch.values[step.result].data();
+  auto nulls = batch.nulls[step.result].data();
+  ClearNulls(nulls, batch.size);
+  for (size_t offset = 0; offset < batch.size; offset++) {
+    bool left_null = IsNull(left_nulls, offset);
+    bool right_null = IsNull(right_nulls, offset);
+    if ((left_null == false && left[offset].integer == 0) ||
+        (right_null == false && right[offset].integer == 0)) {
+      values[offset].integer = 0;
+    } else if (left_null || right_null) {
+      SetNull(nulls, offset);
+    } else {
+      values[offset].integer = 1;
+    }
+  }
+}
+
+static void Or(const CompiledStep &step, CompiledBatch &batch) {
+  auto left = batch.values[step.left].data();
+  auto right = batch.values[step.right].data();
+  auto left_nulls = batch.nulls[step.left].data();
+  auto right_nulls = batch.nulls[step.right].data();
+  auto values = batch.values[step.result].data();
+  auto nulls = batch.nulls[step.result].data();
+  ClearNulls(nulls, batch.size);
+  for (size_t offset = 0; offset < batch.size; offset++) {
+    bool left_null = IsNull(left_nulls, offset);
+    bool right_null = IsNull(right_nulls, offset);
+    if ((left_null == false && left[offset].integer != 0) ||
+        (right_null == false && right[offset].integer != 0)) {
+      values[offset].integer = 1;
+    } else if (left_null || right_null) {
+      SetNull(nulls, offset);
+    } else {
+      values[offset].integer = 0;
+    }
+  }
+}
+
+static void Not(const CompiledStep &step, CompiledBatch &batch) {
+  auto left = batch.values[step.left].data();
+  auto values = batch.values[step.result].data();
+  for (size_t offset = 0; offset < batch.size; offset++) {
+    values[offset].integer = (left[offset].integer == 0) ? 1 : 0;
+  }
+  std::memcpy(batch.nulls[step.result].data(), batch.nulls[step.left].data(),
+              GetNullWordCount(batch.size) * sizeof(uint64_t));
+}
+
+//===--------------------------------------------------------------------===//
+// Expression Compiler
+//===--------------------------------------------------------------------===//
+
+static inline bool IsIntegerType(const common::Type::TypeId &type_id) {
+  return type_id == common::Type::TINYINT ||
+         type_id == common::Type::SMALLINT ||
+         type_id == common::Type::INTEGER || type_id == common::Type::BIGINT;
+}
+
+static inline bool IsNumericType(const common::Type::TypeId &type_id) {
+  return IsIntegerType(type_id) || type_id == common::Type::DECIMAL;
+}
+
+// the comparison with the operands swapped
+static ExpressionType GetSwappedComparison(const ExpressionType &type) {
+  switch (type) {
+    case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+      return EXPRESSION_TYPE_COMPARE_GREATERTHAN;
+    case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+      return EXPRESSION_TYPE_COMPARE_LESSTHAN;
+    case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+      return EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO;
+    case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+      return EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO;
+    default:
+      return type;
+  }
+}
+
+template <template <typename> class Op>
+static CompiledStepFunction GetColumnConstantFunction(
+    const common::Type::TypeId &column_type, const bool &decimal) {
+  switch (column_type) {
+    case common::Type::TINYINT:
+      return decimal ? CompareColumnConstant<Op, int8_t, double>
+                     : CompareColumnConstant<Op, int8_t, int64_t>;
+    case common::Type::SMALLINT:
+      return decimal ? CompareColumnConstant<Op, int16_t, double>
+                     : CompareColumnConstant<Op, int16_t, int64_t>;
+    case common::Type::INTEGER:
+      return decimal ? CompareColumnConstant<Op, int32_t, double>
+                     : CompareColumnConstant<Op, int32_t, int64_t>;
+    case common::Type::BIGINT:
+      return decimal ? CompareColumnConstant<Op, int64_t, double>
+                     : CompareColumnConstant<Op, int64_t, int64_t>;
+    default:
+      return CompareColumnConstant<Op, double, double>;
+  }
+}
+
+static CompiledStepFunction GetColumnConstantFunction(
+    const ExpressionType &type, const common::Type::TypeId &column_type,
+    const bool &decimal) {
+  switch (type) {
+    case EXPRESSION_TYPE_COMPARE_EQUAL:
+      return GetColumnConstantFunction<std::equal_to>(column_type, decimal);
+    case EXPRESSION_TYPE_COMPARE_NOTEQUAL:
+      return GetColumnConstantFunction<std::not_equal_to>(column_type,
+                                                          decimal);
+    case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+      return GetColumnConstantFunction<std::less>(column_type, decimal);
+    case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+      return GetColumnConstantFunction<std::greater>(column_type, decimal);
+    case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+      return GetColumnConstantFunction<std::less_equal>(column_type, decimal);
+    case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+      return GetColumnConstantFunction<std::greater_equal>(column_type,
+                                                           decimal);
+    default:
+      return nullptr;
+  }
+}
+
+template <typename D>
+static CompiledStepFunction GetCompareFunction(const ExpressionType &type) {
+  switch (type) {
+    case EXPRESSION_TYPE_COMPARE_EQUAL:
+      return Compare<std::equal_to, D>;
+    case EXPRESSION_TYPE_COMPARE_NOTEQUAL:
+      return Compare<std::not_equal_to, D>;
+    case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+      return Compare<std::less, D>;
+    case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+      return Compare<std::greater, D>;
+    case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+      return Compare<std::less_equal, D>;
+    case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+      return Compare<std::greater_equal, D>;
+    default:
+      return nullptr;
+  }
+}
+
+template <typename Operator>
+static CompiledStepFunction GetArithmeticFunction(const bool &decimal) {
+  return decimal ? DecimalArithmetic<Operator> : IntegerArithmetic<Operator>;
+}
+
+static CompiledStepFunction GetArithmeticFunction(const ExpressionType &type,
+                                                  const bool &decimal) {
+  switch (type) {
+    case EXPRESSION_TYPE_OPERATOR_PLUS:
+      return GetArithmeticFunction<AddOperator>(decimal);
+    case EXPRESSION_TYPE_OPERATOR_MINUS:
+    case EXPRESSION_TYPE_OPERATOR_UNARY_MINUS:
+      return GetArithmeticFunction<SubtractOperator>(decimal);
+    case EXPRESSION_TYPE_OPERATOR_MULTIPLY:
+      return GetArithmeticFunction<MultiplyOperator>(decimal);
+    case EXPRESSION_TYPE_OPERATOR_DIVIDE:
+      return GetArithmeticFunction<DivideOperator>(decimal);
+    case EXPRESSION_TYPE_OPERATOR_MOD:
+      return GetArithmeticFunction<ModuloOperator>(decimal);
+    default:
+      return nullptr;
+  }
+}
+
+// builds the program of an expression, the operands before the operators
+class ExpressionCompiler {
+ public:
+  ExpressionCompiler(CompiledExpression *expression,
+                     const catalog::Schema *schema,
+                     const std::vector<common::Type::TypeId> &param_types)
+      : expression_(expression),
+        schema_(schema),
+        param_types_(param_types) {}
+
+  // the register holding the value of the expression, false if it can not be
+  // compiled
+  bool Compile(const AbstractExpression *expression, size_t &result,
+               common::Type::TypeId &type_id);
+
+ private:
+  bool CompileColumn(const TupleValueExpression *expression, size_t &result,
+                     common::Type::TypeId &type_id);
+
+  bool CompileConstant(const common::Value &value, const int &param_idx,
+                       size_t &result, common::Type::TypeId &type_id);
+
+  bool CompileComparison(const AbstractExpression *expression, size_t &result,
+                         common::Type::TypeId &type_id);
+
+  bool CompileArithmetic(const ExpressionType &type,
+                         const AbstractExpression *left_expression,
+                         const AbstractExpression *right_expression,
+                         size_t &result, common::Type::TypeId &type_id);
+
+  // the type of a constant or parameter operand, false if it is not one
+  bool GetConstantType(const AbstractExpression *expression,
+                       common::Type::TypeId &type_id) const;
+
+  size_t AddConstant(const common::Value &value, const int &param_idx);
+
+  size_t AddColumn(const oid_t &column_id);
+
+  size_t AddStep(const CompiledStepFunction &function, const size_t &left,
+                 const size_t &right, const common::Type::TypeId &type_id);
+
+  // convert an integer register to a decimal one
+  size_t CastToDecimal(const size_t &left);
+
+  CompiledExpression *expression_;
+
+  const catalog::Schema *schema_;
+
+  const std::vector<common::Type::TypeId> &param_types_;
+};
+
+size_t ExpressionCompiler::AddConstant(const common::Value &value,
+                                       const int &param_idx) {
+  expression_->constants_.push_back(value);
+  expression_->constant_param_idxs_.push_back(param_idx);
+  return expression_->constants_.size() - 1;
+}
+
+size_t ExpressionCompiler::AddColumn(const oid_t &column_id) {
+  auto &column_ids = expression_->column_ids_;
+  for (size_t column = 0; column < column_ids.size(); column++) {
+    if (column_ids[column] == column_id) {
+      return column;
+    }
+  }
+  column_ids.push_back(column_id);
+  return column_ids.size() - 1;
+}
+
+size_t ExpressionCompiler::AddStep(const CompiledStepFunction &function,
+                                   const size_t &left, const size_t &right,
+                                   const common::Type::TypeId &type_id) {
+  CompiledStep step;
+  step.function = function;
+  step.result = expression_->steps_.size();
+  step.left = left;
+  step.right = right;
+  step.column = 0;
+  step.constant = 0;
+  step.value_type = type_id;
+  expression_->steps_.push_back(step);
+  return step.result;
+}
+
+size_t ExpressionCompiler::CastToDecimal(const size_t &left) {
+  return AddStep(expression::CastToDecimal, left, left,
+                 common::Type::DECIMAL);
+}
+
+bool ExpressionCompiler::GetConstantType(const AbstractExpression *expression,
+                                         common::Type::TypeId &type_id) const {
+  if (expression->GetExpressionType() == EXPRESSION_TYPE_VALUE_CONSTANT) {
+    type_id = expression->GetValueType();
+    return true;
+  }
+  if (expression->GetExpressionType() == EXPRESSION_TYPE_VALUE_PARAMETER) {
+    auto param_idx = static_cast<const ParameterValueExpression *>(expression)
+                         ->GetValueIdx();
+    if (param_idx < 0 || param_idx >= (int)param_types_.size()) {
+      return false;
+    }
+    type_id = param_types_[param_idx];
+    return true;
+  }
+  return false;
+}
+
+bool ExpressionCompiler::CompileColumn(const TupleValueExpression *expression,
+                                       size_t &result,
+                                       common::Type::TypeId &type_id) {
+  auto column_id = expression->GetColumnId();
+  if (expression->GetTupleId() != 0 || column_id < 0 ||
+      column_id >= (int)schema_->GetColumnCount()) {
+    return false;
+  }
+
+  type_id = schema_->GetType(column_id);
+  CompiledStepFunction function;
+  switch (type_id) {
+    case common::Type::BOOLEAN:
+    case common::Type::TINYINT:
+      function = LoadColumn<int8_t, int64_t>;
+      break;
+    case common::Type::SMALLINT:
+      function = LoadColumn<int16_t, int64_t>;
+      break;
+    case common::Type::INTEGER:
+      function = LoadColumn<int32_t, int64_t>;
+      break;
+    case common::Type::BIGINT:
+      function = LoadColumn<int64_t, int64_t>;
+      break;
+    case common::Type::DECIMAL:
+      function = LoadColumn<double, double>;
+      break;
+    default:
+      return false;
+  }
+
+  result = AddStep(function, 0, 0, type_id);
+  expression_->steps_[result].column = AddColumn(column_id);
+  return true;
+}
+
+bool ExpressionCompiler::CompileConstant(const common::Value &value,
+                                         const int &param_idx, size_t &result,
+                                         common::Type::TypeId &type_id) {
+  if (IsNumericType(type_id) == false && type_id != common::Type::BOOLEAN) {
+    return false;
+  }
+  result = AddStep(LoadConstant, 0, 0, type_id);
+  expression_->steps_[result].constant = AddConstant(value, param_idx);
+  return true;
+}
+
+bool ExpressionCompiler::CompileComparison(
+    const AbstractExpression *expression, size_t &result,
+    common::Type::TypeId &type_id) {
+  auto type = expression->GetExpressionType();
+  auto left_expression = expression->GetChild(0);
+  auto right_expression = expression->GetChild(1);
+  if (left_expression == nullptr || right_expression == nullptr) {
+    return false;
+  }
+  type_id = common::Type::BOOLEAN;
+
+  // fuse a column compared with a constant into a single step
+  common::Type::TypeId constant_type;
+  if (left_expression->GetExpressionType() != EXPRESSION_TYPE_VALUE_TUPLE) {
+    std::swap(left_expression, right_expression);
+    type = GetSwappedComparison(type);
+  }
+  if (left_expression->GetExpressionType() == EXPRESSION_TYPE_VALUE_TUPLE &&
+      GetConstantType(right_expression, constant_type) == true) {
+    auto column_expression =
+        static_cast<const TupleValueExpression *>(left_expression);
+    auto column_id = column_expression->GetColumnId();
+    if (column_expression->GetTupleId() != 0 || column_id < 0 ||
+        column_id >= (int)schema_->GetColumnCount()) {
+      return false;
+    }
+    auto column_type = schema_->GetType(column_id);
+    if (IsNumericType(column_type) == false ||
+        IsNumericType(constant_type) == false) {
+      return false;
+    }
+
+    bool decimal = (column_type == common::Type::DECIMAL ||
+                    constant_type == common::Type::DECIMAL);
+    result = AddStep(GetColumnConstantFunction(type, column_type, decimal), 0,
+                     0, type_id);
+    PL_ASSERT(expression_->steps_[result].function != nullptr);
+    expression_->steps_[result].column = AddColumn(column_id);
+
+    // a constant compared with a decimal column is kept as a decimal
+    common::Value constant;
+    int param_idx = -1;
+    if (right_expression->GetExpressionType() ==
+        EXPRESSION_TYPE_VALUE_CONSTANT) {
+      constant = static_cast<const ConstantValueExpression *>(right_expression)
+                     ->GetValue();
+      if (decimal && constant.IsNull() == false) {
+        constant = constant.CastAs(common::Type::DECIMAL);
+      }
+    } else {
+      param_idx = static_cast<const ParameterValueExpression *>(
+                      right_expression)->GetValueIdx();
+      constant = common::ValueFactory::GetNullValueByType(
+          decimal ? common::Type::DECIMAL : constant_type);
+    }
+    expression_->steps_[result].constant = AddConstant(constant, param_idx);
+    return true;
+  }
+
+  size_t left, right;
+  common::Type::TypeId left_type, right_type;
+  if (Compile(left_expression, left, left_type) == false ||
+      Compile(right_expression, right, right_type) == false ||
+      IsNumericType(left_type) == false ||
+      IsNumericType(right_type) == false) {
+    return false;
+  }
+
+  if (left_type == common::Type::DECIMAL ||
+      right_type == common::Type::DECIMAL) {
+    if (left_type != common::Type::DECIMAL) {
+      left = CastToDecimal(left);
+    }
+    if (right_type != common::Type::DECIMAL) {
+      right = CastToDecimal(right);
+    }
+    result = AddStep(GetCompareFunction<double>(type), left, right, type_id);
+  } else {
+    result = AddStep(GetCompareFunction<int64_t>(type), left, right, type_id);
+  }
+  return true;
+}
+
+bool ExpressionCompiler::CompileArithmetic(
+    const ExpressionType &type, const AbstractExpression *left_expression,
+    const AbstractExpression *right_expression, size_t &result,
+    common::Type::TypeId &type_id) {
+  size_t left, right;
+  common::Type::TypeId left_type, right_type;
+  if (type == EXPRESSION_TYPE_OPERATOR_UNARY_MINUS) {
+    // zero minus the operand, as in OperatorUnaryMinusExpression
+    left_type = common::Type::INTEGER;
+    if (CompileConstant(common::ValueFactory::GetIntegerValue(0), -1, left,
+                        left_type) == false) {
+      return false;
+    }
+  } else if (left_expression == nullptr ||
+             Compile(left_expression, left, left_type) == false) {
+    return false;
+  }
+  if (right_expression == nullptr ||
+      Compile(right_expression, right, right_type) == false ||
+      IsNumericType(left_type) == false ||
+      IsNumericType(right_type) == false) {
+    return false;
+  }
+
+  // the wider of the two types, as in the value arithmetic
+  type_id = std::max(left_type, right_type);
+  bool decimal = (type_id == common::Type::DECIMAL);
+  if (decimal && left_type != common::Type::DECIMAL) {
+    left = CastToDecimal(left);
+  }
+  if (decimal && right_type != common::Type::DECIMAL) {
+    right = CastToDecimal(right);
+  }
+  result =
+      AddStep(GetArithmeticFunction(type, decimal), left, right, type_id);
+  return true;
+}
+
+bool ExpressionCompiler::Compile(const AbstractExpression *expression,
+                                 size_t &result,
+                                 common::Type::TypeId &type_id) {
+  auto type = expression->GetExpressionType();
+  switch (type) {
+    case EXPRESSION_TYPE_VALUE_TUPLE:
+      return CompileColumn(
+          static_cast<const TupleValueExpression *>(expression), result,
+          type_id);
+
+    case EXPRESSION_TYPE_VALUE_CONSTANT: {
+      auto value =
+          static_cast<const ConstantValueExpression *>(expression)->GetValue();
+      type_id = value.GetTypeId();
+      return CompileConstant(value, -1, result, type_id);
+    }
+
+    case EXPRESSION_TYPE_VALUE_PARAMETER: {
+      if (GetConstantType(expression, type_id) == false) {
+        return false;
+      }
+      auto param_idx =
+          static_cast<const ParameterValueExpression *>(expression)
+              ->GetValueIdx();
+      return CompileConstant(
+          common::ValueFactory::GetNullValueByType(type_id), param_idx,
+          result, type_id);
+    }
+
+    case EXPRESSION_TYPE_COMPARE_EQUAL:
+    case EXPRESSION_TYPE_COMPARE_NOTEQUAL:
+    case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+    case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+    case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+    case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+      return CompileComparison(expression, result, type_id);
+
+    case EXPRESSION_TYPE_CONJUNCTION_AND:
+    case EXPRESSION_TYPE_CONJUNCTION_OR:
+    case EXPRESSION_TYPE_OPERATOR_NOT: {
+      size_t left, right;
+      common::Type::TypeId left_type, right_type;
+      if (expression->GetChild(0) == nullptr ||
+          Compile(expression->GetChild(0), left, left_type) == false ||
+          left_type != common::Type::BOOLEAN) {
+        return false;
+      }
+      type_id = common::Type::BOOLEAN;
+      if (type == EXPRESSION_TYPE_OPERATOR_NOT) {
+        result = AddStep(Not, left, left, type_id);
+        return true;
+      }
+      if (expression->GetChild(1) == nullptr ||
+          Compile(expression->GetChild(1), right, right_type) == false ||
+          right_type != common::Type::BOOLEAN) {
+        return false;
+      }
+      result = AddStep((type == EXPRESSION_TYPE_CONJUNCTION_AND) ? And : Or,
+                       left, right, type_id);
+      return true;
+    }
+
+    case EXPRESSION_TYPE_OPERATOR_PLUS:
+    case EXPRESSION_TYPE_OPERATOR_MINUS:
+    case EXPRESSION_TYPE_OPERATOR_MULTIPLY:
+    case EXPRESSION_TYPE_OPERATOR_DIVIDE:
+    case EXPRESSION_TYPE_OPERATOR_MOD:
+      return CompileArithmetic(type, expression->GetChild(0),
+                               expression->GetChild(1), result, type_id);
+
+    case EXPRESSION_TYPE_OPERATOR_UNARY_MINUS:
+      return CompileArithmetic(type, nullptr, expression->GetChild(0), result,
+                               type_id);
+
+    default:
+      return false;
+  }
+}
+
+//===--------------------------------------------------------------------===//
+// Compiled Expression
+//===--------------------------------------------------------------------===//
+
+std::unique_ptr<CompiledExpression> CompiledExpression::Compile(
+    const AbstractExpression *expression, const catalog::Schema *schema,
+    const std::vector<common::Type::TypeId> &param_types) {
+  std::unique_ptr<CompiledExpression> compiled_expression;
+  if (expression == nullptr || schema == nullptr) {
+    return compiled_expression;
+  }
+
+  compiled_expression.reset(new CompiledExpression());
+  ExpressionCompiler compiler(compiled_expression.get(), schema, param_types);
+  size_t result;
+  common::Type::TypeId type_id;
+  if (compiler.Compile(expression, result, type_id) == false) {
+    compiled_expression.reset();
+    return compiled_expression;
+  }
+
+  // the result of the program is in the register of its last step
+  PL_ASSERT(result == compiled_expression->steps_.size() - 1);
+  return compiled_expression;
+}
+
+//===--------------------------------------------------------------------===//
+// Compiled Expression Evaluator
+//===--------------------------------------------------------------------===//
+
+// the value stored in a register for the given value of the given type
+static void SetConstant(CompiledBatch &batch, const size_t &constant,
+                        common::Value value,
+                        const common::Type::TypeId &type_id) {
+  if (value.IsNull() == true) {
+    batch.constant_nulls[constant] = true;
+    return;
+  }
+  if (value.GetTypeId() != type_id) {
+    value = value.CastAs(type_id);
+  }
+
+  auto &datum = batch.constants[constant];
+  batch.constant_nulls[constant] = false;
+  switch (type_id) {
+    case common::Type::BOOLEAN:
+    case common::Type::TINYINT:
+      datum.integer = value.GetAs<int8_t>();
+      break;
+    case common::Type::SMALLINT:
+      datum.integer = value.GetAs<int16_t>();
+      break;
+    case common::Type::INTEGER:
+      datum.integer = value.GetAs<int32_t>();
+      break;
+    case common::Type::BIGINT:
+      datum.integer = value.GetAs<int64_t>();
+      break;
+    default:
+      datum.decimal = value.GetAs<double>();
+      break;
+  }
+}
+
+static common::Value GetValue(const CompiledDatum &datum, const bool &is_null,
+                              const common::Type::TypeId &type_id) {
+  if (is_null == true) {
+    return common::ValueFactory::GetNullValueByType(type_id);
+  }
+  switch (type_id) {
+    case common::Type::BOOLEAN:
+      return common::ValueFactory::GetBooleanValue(datum.integer != 0);
+    case common::Type::TINYINT:
+      return common::ValueFactory::GetTinyIntValue((int8_t)datum.integer);
+    case common::Type::SMALLINT:
+      return common::ValueFactory::GetSmallIntValue((int16_t)datum.integer);
+    case common::Type::INTEGER:
+      return common::ValueFactory::GetIntegerValue((int32_t)datum.integer);
+    case common::Type::BIGINT:
+      return common::ValueFactory::GetBigIntValue(datum.integer);
+    default:
+      return common::ValueFactory::GetDoubleValue(datum.decimal);
+  }
+}
+
+CompiledExpressionEvaluator::CompiledExpressionEvaluator(
+    const CompiledExpression *expression, executor::ExecutorContext *context)
+    : expression_(expression) {
+  auto step_count = expression->steps_.size();
+  batch_.values.resize(step_count,
+                       std::vector<CompiledDatum>(COMPILED_BATCH_SIZE));
+  batch_.nulls.resize(step_count,
+                      std::vector<uint64_t>(COMPILED_NULL_WORDS, 0));
+  batch_.column_bases.resize(expression->column_ids_.size(), nullptr);
+  batch_.column_strides.resize(expression->column_ids_.size(), 0);
+
+  auto constant_count = expression->constants_.size();
+  batch_.constants.resize(constant_count);
+  batch_.constant_nulls.resize(constant_count, true);
+  for (size_t constant = 0; constant < constant_count; constant++) {
+    auto &value = expression->constants_[constant];
+    auto param_idx = expression->constant_param_idxs_[constant];
+    if (param_idx < 0) {
+      SetConstant(batch_, constant, value, value.GetTypeId());
+    } else {
+      PL_ASSERT(context != nullptr);
+      SetConstant(batch_, constant, context->GetParams().at(param_idx),
+                  value.GetTypeId());
+    }
+  }
+}
+
+bool CompiledExpressionEvaluator::SetTileGroup(storage::TileGroup *tile_group) {
+  auto &column_ids = expression_->column_ids_;
+  for (size_t column = 0; column < column_ids.size(); column++) {
+    if (tile_group->GetCompressedColumn(column_ids[column]) != nullptr) {
+      return false;
+    }
+
+    oid_t tile_offset, tile_column_id;
+    tile_group->LocateTileAndColumn(column_ids[column], tile_offset,
+                                    tile_column_id);
+    auto tile = tile_group->GetTile(tile_offset);
+    auto tile_schema = tile->GetSchema();
+    batch_.column_bases[column] =
+        tile->GetTupleLocation(0) + tile_schema->GetOffset(tile_column_id);
+    batch_.column_strides[column] = tile_schema->GetLength();
+  }
+  return true;
+}
+
+void CompiledExpressionEvaluator::RunBatch(const oid_t *tuple_ids,
+                                           const size_t &size) {
+  PL_ASSERT(size <= COMPILED_BATCH_SIZE);
+  batch_.tuple_ids = tuple_ids;
+  batch_.size = size;
+  for (auto &step : expression_->steps_) {
+    step.function(step, batch_);
+  }
+}
+
+void CompiledExpressionEvaluator::Filter(std::vector<oid_t> &tuple_ids) {
+  PL_ASSERT(expression_->GetValueType() == common::Type::BOOLEAN);
+  auto &values = batch_.values.back();
+  auto &nulls = batch_.nulls.back();
+
+  // the tuples that are kept are moved to the front of the list
+  size_t match_count = 0;
+  for (size_t batch_begin = 0; batch_begin < tuple_ids.size();
+       batch_begin += COMPILED_BATCH_SIZE) {
+    size_t size =
+        std::min(COMPILED_BATCH_SIZE, tuple_ids.size() - batch_begin);
+    RunBatch(tuple_ids.data() + batch_begin, size);
+    for (size_t offset = 0; offset < size; offset++) {
+      if (values[offset].integer != 0 &&
+          IsNull(nulls.data(), offset) == false) {
+        tuple_ids[match_count++] = tuple_ids[batch_begin + offset];
+      }
+    }
+  }
+  tuple_ids.resize(match_count);
+}
+
+void CompiledExpressionEvaluator::Evaluate(const std::vector<oid_t> &tuple_ids,
+                                           std::vector<common::Value> &values) {
+  auto type_id = expression_->GetValueType();
+  auto &result_values = batch_.values.back();
+  auto &result_nulls = batch_.nulls.back();
+  values.clear();
+  values.reserve(tuple_ids.size());
+  for (size_t batch_begin = 0; batch_begin < tuple_ids.size();
+       batch_begin += COMPILED_BATCH_SIZE) {
+    size_t size =
+        std::min(COMPILED_BATCH_SIZE, tuple_ids.size() - batch_begin);
+    RunBatch(tuple_ids.data() + batch_begin, size);
+    for (size_t offset = 0; offset < size; offset++) {
+      values.push_back(GetValue(result_values[offset],
+                                IsNull(result_nulls.data(), offset),
+                                type_id));
+    }
+  }
+}
+
+}  // End expression namespace
+}  // End peloton namespace
@@ -10,10 +10,13 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+
 #include "gc/transaction_level_gc_manager.h"
 #include "storage/tuple.h"
 #include "storage/database.h"
 #include "storage/tile_group.h"
+#include "storage/zone_map.h"
 #include "catalog/manager.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "common/container_tuple.h"
@@ -50,6 +53,9 @@ bool TransactionLevelGCManager::ResetTuple(const ItemPointer &location) {
     tile_group_header->GetReservedFieldRef(location.offset), 0,
     storage::TileGroupHeader::GetReservedSize());
 
+  // the zone map may still cover the values of the removed version
+  tile_group->GetZoneMap()->MarkStale();
+
   LOG_TRACE("Garbage tuple(%u, %u) is reset", location.block, location.offset);
   return true;
 }
@@ -74,7 +80,7 @@ void TransactionLevelGCManager::Running(const int &thread_id) {
 }
 
 
-void TransactionLevelGCManager::RecycleTransaction(std::shared_ptr<ReadWriteSet> gc_set, const cid_t &timestamp, const GCSetType gc_set_type) {
+void TransactionLevelGCManager::RecycleTransaction(std::shared_ptr<concurrency::ReadWriteSet> gc_set, const cid_t &timestamp, const GCSetType gc_set_type) {
     // Add the garbage context to the lockfree queue
     std::shared_ptr<GarbageContext> gc_context(new GarbageContext(gc_set, timestamp, gc_set_type));
     unlink_queues_[HashToThread(gc_context->timestamp_)]->Enqueue(gc_context);
@@ -88,10 +94,22 @@ void TransactionLevelGCManager::Unlink(const int &thread_id, const cid_t &max_ci
   // every time we garbage collect at most MAX_ATTEMPT_COUNT tuples.
   std::vector<std::shared_ptr<GarbageContext>> garbages;
 
+  // the garbage whose retention has ended is unlinked as the other garbage.
+  // the retention is not waited for when the gc stops.
+  auto &retained_map = retained_maps_[thread_id];
+  auto retained_end = retained_map.end();
+  if (max_cid != MAX_CID) {
+    retained_end = retained_map.upper_bound(std::chrono::steady_clock::now());
+  }
+  for (auto itr = retained_map.begin(); itr != retained_end; ++itr) {
+    local_unlink_queues_[thread_id].push_back(itr->second);
+  }
+  retained_map.erase(retained_map.begin(), retained_end);
+
   // First iterate the local unlink queue
   local_unlink_queues_[thread_id].remove_if(
     [this, &garbages, &tuple_counter, max_cid](const std::shared_ptr<GarbageContext>& garbage_ctx) -> bool {
-      bool res = garbage_ctx->timestamp_ < max_cid;
+      bool res = CanUnlink(garbage_ctx, max_cid);
       if (res == true) {
         DeleteFromIndexes(garbage_ctx);
         // Add to the garbage map
@@ -110,10 +128,20 @@ void TransactionLevelGCManager::Unlink(const int &thread_id, const cid_t &max_ci
       break;
     }
 
-    if (garbage_ctx->timestamp_ < max_cid) {
-      // as the max timestamp of committed transactions is larger than the gc's timestamp,
-      // it means that no active transactions can read it.
-      // so we can unlink it.
+    // the tables may keep the versions for historical reads
+    if (garbage_ctx->gc_set_type_ == GC_SET_TYPE_COMMITTED &&
+        max_cid != MAX_CID) {
+      auto retention = GetVersionRetention(garbage_ctx);
+      if (retention > 0) {
+        retained_map.emplace(
+            garbage_ctx->expire_time_ + std::chrono::seconds(retention),
+            garbage_ctx);
+        continue;
+      }
+    }
+
+    if (CanUnlink(garbage_ctx, max_cid) == true) {
+      // no active transactions can read it, so we can unlink it.
       // we need to delete all the tuples from the indexes to which it belongs as well.
       DeleteFromIndexes(garbage_ctx);
       // Add to the garbage map
@@ -162,38 +190,45 @@ void TransactionLevelGCManager::Reclaim(const int &thread_id, const cid_t &max_c
 // Multiple GC thread share the same recycle map
 void TransactionLevelGCManager::AddToRecycleMap(std::shared_ptr<GarbageContext> garbage_ctx) {
   
+  auto &manager = catalog::Manager::GetInstance();
+
+  oid_t tile_group_id = INVALID_OID;
+  std::shared_ptr<storage::TileGroup> tile_group;
   for (auto &entry : *(garbage_ctx->gc_set_.get())) {
 
-    auto &manager = catalog::Manager::GetInstance();
-    auto tile_group = manager.GetTileGroup(entry.first);
+    // consecutive entries are mostly in the same tile group
+    if (entry.location.block != tile_group_id) {
+      tile_group_id = entry.location.block;
+      tile_group = manager.GetTileGroup(tile_group_id);
+    }
 
     // During the resetting, a table may deconstruct because of the DROP TABLE request
     if (tile_group == nullptr) {
-      return;
+      continue;
     }
 
-    PL_ASSERT(tile_group != nullptr);
-
     storage::DataTable *table =
       dynamic_cast<storage::DataTable *>(tile_group->GetAbstractTable());
     PL_ASSERT(table != nullptr);
 
     oid_t table_id = table->GetOid();
 
-    for (auto &element : entry.second) {
+    // as this transaction has been committed, we should reclaim older versions.
+    ItemPointer location = entry.location;
 
-      // as this transaction has been committed, we should reclaim older versions.
-      ItemPointer location(entry.first, element.first); 
-      
-      // If the tuple being reset no longer exists, just skip it
-      if (ResetTuple(location) == false) {
-        continue;
-      }
-      // if the entry for table_id exists.
-      PL_ASSERT(recycle_queue_map_.find(table_id) != recycle_queue_map_.end());
-      recycle_queue_map_[table_id]->Enqueue(location);
+    // If the tuple being reset no longer exists, just skip it
+    if (ResetTuple(location) == false) {
+      continue;
+    }
 
+    // the slots of compressed tile groups are read-only, never reuse them
+    if (tile_group->IsCompressed() == true) {
+      continue;
     }
+
+    // if the entry for table_id exists.
+    PL_ASSERT(recycle_queue_map_.find(table_id) != recycle_queue_map_.end());
+    recycle_queue_map_[table_id]->Enqueue(location);
   }
 
 }
@@ -214,7 +249,8 @@ ItemPointer TransactionLevelGCManager::ReturnFreeSlot(const oid_t &table_id) {
 }
 
 void TransactionLevelGCManager::ClearGarbage(int thread_id) {
-  while(!unlink_queues_[thread_id]->IsEmpty() || !local_unlink_queues_[thread_id].empty()) {
+  while(!unlink_queues_[thread_id]->IsEmpty() || !local_unlink_queues_[thread_id].empty() ||
+        !retained_maps_[thread_id].empty()) {
     Unlink(thread_id, MAX_CID);
   }
 
@@ -232,42 +268,173 @@ void TransactionLevelGCManager::DeleteFromIndexes(const std::shared_ptr<GarbageC
   if (gc_set_type == GC_SET_TYPE_COMMITTED) {
     // if the transaction is committed, 
     // then we need to remove tuples that are deleted by the transaction from indexes.
-    for (auto entry : *(garbage_ctx->gc_set_.get())) {
-      for (auto &element : entry.second) {
-        if (element.second == RW_TYPE_DELETE || element.second == RW_TYPE_INS_DEL) {
-          // only old versions are stored in the gc set.
-          // so we can safely get indirection from the indirection array.
-          auto tile_group_header = catalog::Manager::GetInstance()
-                                       .GetTileGroup(entry.first)
-                                       ->GetHeader();
-          ItemPointer *indirection = tile_group_header->GetIndirection(element.first);
-
-          DeleteTupleFromIndexes(indirection);
-
-        }
+    for (auto &entry : *(garbage_ctx->gc_set_.get())) {
+      if (entry.type == RW_TYPE_DELETE || entry.type == RW_TYPE_INS_DEL) {
+        // only old versions are stored in the gc set.
+        // so we can safely get indirection from the indirection array.
+        auto tile_group_header = catalog::Manager::GetInstance()
+                                     .GetTileGroup(entry.location.block)
+                                     ->GetHeader();
+        ItemPointer *indirection =
+            tile_group_header->GetIndirection(entry.location.offset);
+
+        DeleteTupleFromIndexes(indirection);
+
+      }
+
+      // the old versions are about to be reclaimed, the indexes must not
+      // point to them anymore
+      if (entry.type == RW_TYPE_UPDATE || entry.type == RW_TYPE_DELETE) {
+        UnlinkExpiredVersions(entry.location, garbage_ctx->timestamp_);
       }
     }
 
   } else {
     PL_ASSERT(gc_set_type == GC_SET_TYPE_ABORTED);
 
-    for (auto entry : *(garbage_ctx->gc_set_.get())) {
-      for (auto &element : entry.second) {
-        if (element.second == RW_TYPE_INSERT || element.second == RW_TYPE_INS_DEL) {
-          auto tile_group_header = catalog::Manager::GetInstance()
-                                       .GetTileGroup(entry.first)
-                                       ->GetHeader();
-          ItemPointer *indirection = tile_group_header->GetIndirection(element.first);
-
-          DeleteTupleFromIndexes(indirection);
-           
-        }
+    for (auto &entry : *(garbage_ctx->gc_set_.get())) {
+      if (entry.type == RW_TYPE_INSERT || entry.type == RW_TYPE_INS_DEL) {
+        auto tile_group_header = catalog::Manager::GetInstance()
+                                     .GetTileGroup(entry.location.block)
+                                     ->GetHeader();
+        ItemPointer *indirection =
+            tile_group_header->GetIndirection(entry.location.offset);
+
+        DeleteTupleFromIndexes(indirection);
+         
       }
     }
   }
 
 }
 
+// the versions of a committed transaction can be unlinked once neither a
+// running transaction nor the snapshot of a historical one can read them.
+bool TransactionLevelGCManager::CanUnlink(
+    const std::shared_ptr<GarbageContext>& garbage_ctx, const cid_t &max_cid) {
+  // as the max timestamp of committed transactions is larger than the gc's
+  // timestamp, no active transaction can read it.
+  if (garbage_ctx->timestamp_ >= max_cid) {
+    return false;
+  }
+
+  // the versions of an aborted transaction were never visible
+  if (garbage_ctx->gc_set_type_ == GC_SET_TYPE_ABORTED) {
+    return true;
+  }
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  if (garbage_ctx->timestamp_ > txn_manager.GetOldestSnapshotCid()) {
+    return false;
+  }
+
+  // the historical transactions beginning from now on can not read the tables
+  // at snapshots before the versions expired. check again for the ones that
+  // began meanwhile.
+  RaiseExpiredCids(garbage_ctx);
+  return garbage_ctx->timestamp_ <= txn_manager.GetOldestSnapshotCid();
+}
+
+// the longest retention of the tables of the expired versions
+size_t TransactionLevelGCManager::GetVersionRetention(
+    const std::shared_ptr<GarbageContext>& garbage_ctx) {
+  auto &manager = catalog::Manager::GetInstance();
+
+  size_t retention = 0;
+  oid_t tile_group_id = INVALID_OID;
+  for (auto &entry : *(garbage_ctx->gc_set_.get())) {
+    // consecutive entries are mostly in the same tile group
+    if (entry.location.block == tile_group_id) {
+      continue;
+    }
+    tile_group_id = entry.location.block;
+
+    auto tile_group = manager.GetTileGroup(tile_group_id);
+    if (tile_group == nullptr) {
+      continue;
+    }
+
+    storage::DataTable *table =
+      dynamic_cast<storage::DataTable *>(tile_group->GetAbstractTable());
+    PL_ASSERT(table != nullptr);
+    retention = std::max(retention, table->GetVersionRetention());
+  }
+  return retention;
+}
+
+void TransactionLevelGCManager::RaiseExpiredCids(
+    const std::shared_ptr<GarbageContext>& garbage_ctx) {
+  auto &manager = catalog::Manager::GetInstance();
+
+  oid_t tile_group_id = INVALID_OID;
+  storage::DataTable *last_table = nullptr;
+  for (auto &entry : *(garbage_ctx->gc_set_.get())) {
+    if (entry.location.block == tile_group_id) {
+      continue;
+    }
+    tile_group_id = entry.location.block;
+
+    auto tile_group = manager.GetTileGroup(tile_group_id);
+    if (tile_group == nullptr) {
+      continue;
+    }
+
+    storage::DataTable *table =
+      dynamic_cast<storage::DataTable *>(tile_group->GetAbstractTable());
+    PL_ASSERT(table != nullptr);
+    if (table != last_table) {
+      table->RaiseExpiredCid(garbage_ctx->timestamp_);
+      last_table = table;
+    }
+  }
+}
+
+// in the oldest-to-newest chains, the indirection points to the oldest
+// version. move it to the newer versions past the ones that expired before
+// the timestamp. the other gc threads may be moving it concurrently.
+void TransactionLevelGCManager::UnlinkExpiredVersions(
+    const ItemPointer &location, const cid_t &timestamp) {
+  auto &manager = catalog::Manager::GetInstance();
+  auto tile_group = manager.GetTileGroup(location.block);
+  if (tile_group == nullptr) {
+    return;
+  }
+
+  storage::DataTable *table =
+    dynamic_cast<storage::DataTable *>(tile_group->GetAbstractTable());
+  PL_ASSERT(table != nullptr);
+  if (table->GetVersionStorageType() != VERSION_STORAGE_TYPE_OLDEST_TO_NEWEST) {
+    return;
+  }
+
+  ItemPointer *indirection =
+      tile_group->GetHeader()->GetIndirection(location.offset);
+  if (indirection == nullptr) {
+    return;
+  }
+
+  while (true) {
+    ItemPointer oldest_location = *indirection;
+    auto tile_group_header = manager.GetTileGroupHeader(oldest_location.block);
+
+    // only the committed versions that no transaction can read are unlinked
+    if (tile_group_header->GetTransactionId(oldest_location.offset) !=
+            INITIAL_TXN_ID ||
+        tile_group_header->GetEndCommitId(oldest_location.offset) >
+            timestamp) {
+      break;
+    }
+
+    ItemPointer newer_location =
+        tile_group_header->GetPrevItemPointer(oldest_location.offset);
+    if (newer_location.IsNull()) {
+      break;
+    }
+
+    CompareAndSwapItemPointer(indirection, oldest_location, newer_location);
+  }
+}
+
 // delete a tuple from all its indexes it belongs to.
 void TransactionLevelGCManager::DeleteTupleFromIndexes(ItemPointer *indirection) {
   LOG_TRACE("Deleting indirection %p from index", indirection);
@@ -13,9 +13,11 @@
 #pragma once
 
 #include <vector>
+#include <map>
 #include <mutex>
 #include <atomic>
 #include <thread>
+#include <chrono>
 
 #include "common/types.h"
 
@@ -67,6 +69,10 @@ class LayoutTuner {
   // Update layout of table
   void UpdateDefaultPartition(storage::DataTable* table);
 
+  // Transform the next cold tile group of table into its default layout,
+  // or compress it if it already has that layout
+  void TransformColdTileGroup(storage::DataTable* table);
+
  private:
 
   // Tables whose layout must be tuned
@@ -80,6 +86,12 @@ class LayoutTuner {
   // Tuner thread
   std::thread layout_tuner_thread;
 
+  // Next tile group to be considered for transformation in each table
+  std::map<storage::DataTable*, oid_t> tile_group_cursors;
+
+  // Time of the last tile group transformation
+  std::chrono::steady_clock::time_point last_transformation_time;
+
   //===--------------------------------------------------------------------===//
   // Tuner Parameters
   //===--------------------------------------------------------------------===//
@@ -99,6 +111,15 @@ class LayoutTuner {
   // Desired layout tile count
   oid_t tile_count = 2;
 
+  // Minimum period between two tile group transformations (in us)
+  oid_t transformation_interval = 10000;
+
+  // Number of commits since the last write after which a tile group is cold
+  cid_t cold_cid_distance = 10000;
+
+  // Compress cold tile groups into read-only columnar blocks
+  bool compress_cold_tile_groups = true;
+
 };
 
 
@@ -13,6 +13,7 @@
 #pragma once
 
 #include "common/types.h"
+#include "catalog/catalog_cache.h"
 #include "catalog/schema.h"
 #include "storage/database.h"
 #include "storage/data_table.h"
@@ -30,6 +31,8 @@
 #define TABLE_METRIC_NAME "table_metric"
 #define INDEX_METRIC_NAME "index_metric"
 #define QUERY_METRIC_NAME "query_metric"
+#define WAIT_METRIC_NAME "wait_metric"
+#define EXECUTION_METRIC_NAME "execution_metric"
 
 #define QUERY_NUM_PARAM_COL_NAME "num_params"
 #define QUERY_PARAM_TYPE_COL_NAME "param_types"
@@ -154,6 +157,12 @@ class Catalog {
   // Initialize the schema of the query metrics table
   std::unique_ptr<catalog::Schema> InitializeQueryMetricsSchema();
 
+  // Initialize the schema of the wait metrics table
+  std::unique_ptr<catalog::Schema> InitializeWaitMetricsSchema();
+
+  // Initialize the schema of the query execution pool metrics table
+  std::unique_ptr<catalog::Schema> InitializeExecutionMetricsSchema();
+
   // Get table from a database with its name
   storage::DataTable *GetTableWithName(std::string database_name,
                                        std::string table_name);
@@ -165,6 +174,10 @@ class Catalog {
   // Get the number of databases currently in the catalog
   oid_t GetDatabaseCount();
 
+  // Number of DDL changes so far, plans built from an older version may
+  // refer to dropped tables
+  uint64_t GetVersion() const;
+
   void PrintCatalogs();
 
   // Get a new id for database, table, etc.
@@ -193,8 +206,8 @@ class Catalog {
                                          std::string &database_name,
                                          concurrency::Transaction *txn);
 
-  // A vector of the database pointers in the catalog
-  std::vector<storage::Database *> databases_;
+  // The databases in the catalog, hashed by name and oid
+  CatalogCache<storage::Database> databases_;
 
   // The id variable that get assigned to objects. Initialized with (START_OID
   // +
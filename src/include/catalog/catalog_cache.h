@@ -0,0 +1,153 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// catalog_cache.h
+//
+// Identification: src/include/catalog/catalog_cache.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/rcu.h"
+#include "common/types.h"
+
+namespace peloton {
+namespace catalog {
+
+// number of DDL changes to any catalog cache so far. a plan built from the
+// catalog is stale once it has changed.
+uint64_t GetCatalogVersion();
+
+// for DDL that does not change a catalog cache, e.g., new indexes
+void IncrementCatalogVersion();
+
+//===--------------------------------------------------------------------===//
+// Catalog Cache
+//===--------------------------------------------------------------------===//
+
+// the databases of the catalog or the tables of a database, hashed by name
+// and by oid. lookups read an immutable snapshot and never lock. DDL copies
+// the snapshot, changes the copy and publishes it, the old snapshot is freed
+// once no lookup can still be reading it.
+template <typename T>
+class CatalogCache {
+ public:
+  CatalogCache(const CatalogCache &) = delete;
+  CatalogCache &operator=(const CatalogCache &) = delete;
+
+  CatalogCache() : snapshot_(new Snapshot()) {}
+
+  // nullptr if there is no such object. with duplicate names, the object
+  // added first is returned.
+  T *GetWithName(const std::string &name) const {
+    RCUReadGuard guard;
+    auto &by_name = snapshot_.Read()->by_name;
+    auto object_itr = by_name.find(name);
+    return (object_itr == by_name.end()) ? nullptr : object_itr->second;
+  }
+
+  T *GetWithOid(const oid_t oid) const {
+    RCUReadGuard guard;
+    auto &by_oid = snapshot_.Read()->by_oid;
+    auto object_itr = by_oid.find(oid);
+    return (object_itr == by_oid.end()) ? nullptr : object_itr->second;
+  }
+
+  // objects are kept in the order they were added
+  T *GetWithOffset(const oid_t offset) const {
+    RCUReadGuard guard;
+    auto &objects = snapshot_.Read()->objects;
+    return (offset < objects.size()) ? objects[offset].object : nullptr;
+  }
+
+  size_t GetSize() const {
+    RCUReadGuard guard;
+    return snapshot_.Read()->objects.size();
+  }
+
+  std::vector<T *> GetAll() const {
+    std::vector<T *> all_objects;
+    RCUReadGuard guard;
+    for (auto &entry : snapshot_.Read()->objects) {
+      all_objects.push_back(entry.object);
+    }
+    return all_objects;
+  }
+
+  // number of changes so far
+  uint64_t GetVersion() const { return snapshot_.GetVersion(); }
+
+  // the name is read when the object is added, renaming it later does not
+  // change the cache
+  void Add(T *object, const std::string &name, const oid_t oid) {
+    std::lock_guard<std::mutex> lock(writer_lock_);
+    std::unique_ptr<Snapshot> snapshot(new Snapshot());
+    snapshot->objects = snapshot_.Read()->objects;
+    snapshot->objects.push_back({object, name, oid});
+    snapshot->BuildMaps();
+    snapshot_.Publish(snapshot.release());
+    IncrementCatalogVersion();
+  }
+
+  // removes the object from the cache and returns it, nullptr if there is no
+  // such object
+  T *Remove(const oid_t oid) {
+    std::lock_guard<std::mutex> lock(writer_lock_);
+    T *object = nullptr;
+    std::unique_ptr<Snapshot> snapshot(new Snapshot());
+    for (auto &entry : snapshot_.Read()->objects) {
+      if (object == nullptr && entry.oid == oid) {
+        object = entry.object;
+      } else {
+        snapshot->objects.push_back(entry);
+      }
+    }
+    if (object != nullptr) {
+      snapshot->BuildMaps();
+      snapshot_.Publish(snapshot.release());
+      IncrementCatalogVersion();
+    }
+    return object;
+  }
+
+ private:
+  struct Entry {
+    T *object;
+    std::string name;
+    oid_t oid;
+  };
+
+  struct Snapshot {
+    std::vector<Entry> objects;
+    std::unordered_map<std::string, T *> by_name;
+    std::unordered_map<oid_t, T *> by_oid;
+
+    void BuildMaps() {
+      by_name.reserve(objects.size());
+      by_oid.reserve(objects.size());
+      for (auto &entry : objects) {
+        by_name.emplace(entry.name, entry.object);
+        by_oid.emplace(entry.oid, entry.object);
+      }
+    }
+  };
+
+  VersionedSnapshot<Snapshot> snapshot_;
+
+  // serializes the writers, readers never take it
+  std::mutex writer_lock_;
+};
+
+}  // End catalog namespace
+}  // End peloton namespace
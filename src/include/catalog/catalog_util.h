@@ -69,6 +69,16 @@ std::unique_ptr<storage::Tuple> GetQueryMetricsCatalogTuple(
     stats::QueryMetric::QueryParamBuf format_buf,
     stats::QueryMetric::QueryParamBuf val_buf, int64_t reads, int64_t updates,
     int64_t deletes, int64_t inserts, int64_t latency, int64_t cpu_time,
+    int64_t time_stamp, const std::string &operator_profile,
+    common::VarlenPool *pool);
+
+std::unique_ptr<storage::Tuple> GetWaitMetricsCatalogTuple(
+    catalog::Schema *schema, std::string wait_class, int64_t wait_count,
+    int64_t wait_time, int64_t time_stamp, common::VarlenPool *pool);
+
+std::unique_ptr<storage::Tuple> GetExecutionMetricsCatalogTuple(
+    catalog::Schema *schema, std::string stage, int64_t stage_count,
+    int64_t avg_latency, int64_t total_latency, int64_t depth,
     int64_t time_stamp, common::VarlenPool *pool);
 }
 }
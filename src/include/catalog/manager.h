@@ -27,6 +27,7 @@ namespace peloton {
 
 namespace storage {
 class TileGroup;
+class TileGroupHeader;
 class IndirectionArray;
 }
 
@@ -62,6 +63,15 @@ class Manager {
 
   std::shared_ptr<storage::TileGroup> GetTileGroup(const oid_t oid);
 
+  // lookups without reference counting. dropped and replaced tile groups are
+  // retired to the epoch manager, so the pointers stay valid until the
+  // calling transaction exits its epoch.
+  storage::TileGroup *GetTileGroupPtr(const oid_t oid) {
+    return tile_group_ptr_locator_.Find(oid);
+  }
+
+  storage::TileGroupHeader *GetTileGroupHeader(const oid_t oid);
+
   void ClearTileGroup(void);
 
 
@@ -96,6 +106,9 @@ class Manager {
 
   LockFreeArray<std::shared_ptr<storage::TileGroup>> tile_group_locator_;
 
+  // raw pointers to the tile groups in the locator
+  LockFreeArray<storage::TileGroup *> tile_group_ptr_locator_;
+
   static std::shared_ptr<storage::TileGroup> empty_tile_group_;
 
   //===--------------------------------------------------------------------===//
@@ -0,0 +1,105 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// arena.h
+//
+// Identification: src/include/common/arena.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "common/platform.h"
+
+namespace peloton {
+namespace common {
+
+// size of the chunks an arena allocates from
+static const size_t ARENA_CHUNK_SIZE = (1 << 16);  // Bytes
+
+// allocations larger than this get a block of their own
+static const size_t ARENA_MAX_SMALL_SIZE = ARENA_CHUNK_SIZE / 4;
+
+static const size_t ARENA_ALIGNMENT = 16;
+
+// max number of free chunks kept for the next arenas
+static const size_t ARENA_MAX_CACHED_CHUNKS = 1024;
+
+//===--------------------------------------------------------------------===//
+// Arena Chunk Cache
+//===--------------------------------------------------------------------===//
+
+// the chunks released by the arenas, handed out again to the next ones so
+// that a query does not go to the heap for its memory
+class ArenaChunkCache {
+ public:
+  ArenaChunkCache(const ArenaChunkCache &) = delete;
+  ArenaChunkCache &operator=(const ArenaChunkCache &) = delete;
+
+  static ArenaChunkCache &GetInstance();
+
+  // a chunk of ARENA_CHUNK_SIZE bytes
+  char *Get();
+
+  // the chunk is freed if the cache is full
+  void Put(char *chunk);
+
+  size_t GetSize() const;
+
+ private:
+  ArenaChunkCache() {}
+
+  ~ArenaChunkCache();
+
+  std::vector<char *> chunks_;
+
+  mutable Spinlock chunks_lock_;
+};
+
+//===--------------------------------------------------------------------===//
+// Arena
+//===--------------------------------------------------------------------===//
+
+// a bump allocator, the memory is not freed one allocation at a time but all
+// at once when the arena is reset or destroyed. no destructor is run on what
+// is allocated in it. owned by a single thread.
+class Arena {
+ public:
+  Arena(const Arena &) = delete;
+  Arena &operator=(const Arena &) = delete;
+
+  Arena() {}
+
+  ~Arena();
+
+  // aligned to ARENA_ALIGNMENT, never nullptr
+  void *Allocate(size_t size);
+
+  // release all the memory of the arena, the chunks go back to the cache
+  void Reset();
+
+  // number of bytes handed out since the arena was last reset
+  size_t GetAllocatedSize() const { return allocated_size_; }
+
+  size_t GetChunkCount() const { return chunks_.size(); }
+
+ private:
+  std::vector<char *> chunks_;
+
+  std::vector<char *> large_blocks_;
+
+  // free space of the last chunk
+  char *chunk_head_ = nullptr;
+  size_t chunk_remaining_ = 0;
+
+  size_t allocated_size_ = 0;
+};
+
+}  // namespace common
+}  // namespace peloton
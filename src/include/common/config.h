@@ -23,9 +23,50 @@ DECLARE_uint64(max_connections);
 // Socket family (AF_UNIX, AF_INET)
 DECLARE_string(socket_family);
 
+// Accept connections on a listening socket per worker thread
+DECLARE_bool(reuse_port);
+
+// Dispatch of accepted connections (round_robin, least_loaded)
+DECLARE_string(dispatch_mode);
+
 // Enable or disable statistics collection
 DECLARE_uint64(stats_mode);
 
+DECLARE_uint64(stats_series_size);
+
+// Default degree of parallelism of a query
+DECLARE_uint64(parallelism);
+
+// Maximum degree of parallelism of a query
+DECLARE_uint64(max_parallelism);
+
+// Number of threads that execute the queries of the clients
+DECLARE_uint64(execution_threads);
+
+// Count the CPU cycles spent in each executor of a profiled query
+DECLARE_bool(profile_cycles);
+
+// Evaluate the scan predicates with compiled programs
+DECLARE_bool(compile_expressions);
+
+// Number of executions of a prepared statement before its plan is compiled
+DECLARE_uint64(pipeline_compile_threshold);
+
+// Number of idle executor trees kept per prepared statement
+DECLARE_uint64(executor_tree_pool_size);
+
+// Parse the simple single table statements without the generated parser
+DECLARE_bool(fast_path_parser);
+
+// Order of the version chains of the new tables
+DECLARE_string(version_storage);
+
+// Seconds for which the expired versions of the new tables are kept
+DECLARE_uint64(version_retention);
+
+// Start the sequential scans of a table at the tile group the running ones read
+DECLARE_bool(shared_scans);
+
 // Both for showing the help info
 DECLARE_bool(h);
 DECLARE_bool(help);
@@ -19,6 +19,8 @@
 #include <pthread.h>
 #include <immintrin.h>
 
+#include "common/wait_event.h"
+
 //===--------------------------------------------------------------------===//
 // Synchronization utilities
 //===--------------------------------------------------------------------===//
@@ -116,7 +118,13 @@ class Spinlock {
  public:
   Spinlock() : spin_lock_state(Unlocked) {}
 
-  inline void Lock() {
+  // the wait is only timed once the lock turns out to be taken
+  inline void Lock(const WaitClass wait_class = WAIT_CLASS_SPINLOCK) {
+    if (TryLock()) {
+      return;
+    }
+
+    WaitEventTimer wait(wait_class);
     while (!TryLock()) {
       _mm_pause();  // helps the cpu to detect busy-wait loop
     }
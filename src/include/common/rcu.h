@@ -0,0 +1,122 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// rcu.h
+//
+// Identification: src/include/common/rcu.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <utility>
+
+namespace peloton {
+
+// read epoch of a thread, 0 while it is not reading. only written by the
+// thread itself.
+struct RCUReaderSlot {
+  std::atomic<uint64_t> epoch;
+  uint32_t depth;
+};
+
+//===--------------------------------------------------------------------===//
+// Read-Copy-Update
+//===--------------------------------------------------------------------===//
+
+// readers announce the epoch they started in, which is a single store to a
+// slot of their own, and never lock. writers publish a new copy of the data
+// and retire the old one, which is freed once every reader that started
+// before it was retired has finished.
+class RCU {
+ public:
+  RCU(const RCU &) = delete;
+  RCU &operator=(const RCU &) = delete;
+
+  static RCU &GetInstance();
+
+  // read sections can be nested
+  void ReadLock();
+
+  void ReadUnlock();
+
+  // free the old copy once no reader can see it anymore. only call it after
+  // the new copy is published.
+  void Retire(std::function<void()> &&deleter);
+
+  // free the retired copies that no reader can see anymore
+  void Reclaim();
+
+  // number of retired copies that are not freed yet
+  size_t GetRetiredCount();
+
+ private:
+  RCU() {}
+
+  // the slot of the calling thread, registered on first use
+  static RCUReaderSlot &GetThreadSlot();
+
+  // the oldest epoch a reader is still in
+  uint64_t GetMinReaderEpoch();
+
+  std::atomic<uint64_t> epoch_{1};
+
+  std::mutex retired_lock_;
+
+  // deleters with the epoch they were retired in, the oldest first
+  std::deque<std::pair<uint64_t, std::function<void()>>> retired_;
+};
+
+// read section for the lifetime of the guard
+class RCUReadGuard {
+ public:
+  RCUReadGuard(const RCUReadGuard &) = delete;
+  RCUReadGuard &operator=(const RCUReadGuard &) = delete;
+
+  RCUReadGuard() { RCU::GetInstance().ReadLock(); }
+
+  ~RCUReadGuard() { RCU::GetInstance().ReadUnlock(); }
+};
+
+//===--------------------------------------------------------------------===//
+// Versioned Snapshot
+//===--------------------------------------------------------------------===//
+
+// an immutable object that writers replace as a whole. read it within a read
+// section, replace it under a lock of the writers.
+template <typename T>
+class VersionedSnapshot {
+ public:
+  VersionedSnapshot(const VersionedSnapshot &) = delete;
+  VersionedSnapshot &operator=(const VersionedSnapshot &) = delete;
+
+  explicit VersionedSnapshot(T *snapshot) : snapshot_(snapshot) {}
+
+  ~VersionedSnapshot() { delete snapshot_.load(); }
+
+  inline const T *Read() const { return snapshot_.load(); }
+
+  // number of snapshots published so far
+  inline uint64_t GetVersion() const { return version_.load(); }
+
+  void Publish(T *snapshot) {
+    const T *old_snapshot = snapshot_.exchange(snapshot);
+    version_++;
+    RCU::GetInstance().Retire([old_snapshot] { delete old_snapshot; });
+  }
+
+ private:
+  std::atomic<const T *> snapshot_;
+
+  std::atomic<uint64_t> version_{0};
+};
+
+}  // End peloton namespace
@@ -23,6 +23,11 @@ namespace planner {
 class AbstractPlan;
 }
 
+namespace executor {
+class CompiledPipeline;
+class ExecutorTreePool;
+}
+
 typedef std::pair<std::vector<unsigned char>, std::vector<unsigned char>>
     ResultType;
 
@@ -66,6 +71,37 @@ class Statement {
 
   const std::shared_ptr<planner::AbstractPlan>& GetPlanTree() const;
 
+  void SetExplainAnalyze(const bool explain_analyze);
+
+  bool IsExplainAnalyze() const;
+
+  void SetCatalogVersion(const uint64_t catalog_version);
+
+  uint64_t GetCatalogVersion() const;
+
+  // the commit id of the snapshot read by an AS OF select, INVALID_CID to read
+  // the current one
+  void SetSnapshotCid(const cid_t snapshot_cid);
+
+  cid_t GetSnapshotCid() const;
+
+  // returns the number of executions so far, including this one
+  uint64_t IncrementExecutionCount();
+
+  // the pipeline compiled from the plan tree, nullptr if the plan can not be
+  // compiled. it is dropped when the plan tree changes.
+  void SetCompiledPipeline(
+      std::shared_ptr<executor::CompiledPipeline> compiled_pipeline);
+
+  const std::shared_ptr<executor::CompiledPipeline>& GetCompiledPipeline()
+      const;
+
+  bool IsPipelineCompiled() const;
+
+  // the idle executor trees of the plan tree, created on first use. nullptr
+  // if the executors of the plan tree can not be reused.
+  const std::shared_ptr<executor::ExecutorTreePool>& GetExecutorTreePool();
+
  private:
   // logical name of statement
   std::string statement_name;
@@ -84,6 +120,26 @@ class Statement {
 
   // cached plan tree
   std::shared_ptr<planner::AbstractPlan> plan_tree;
+
+  // whether the annotated plan is returned instead of the result
+  bool explain_analyze = false;
+
+  // version of the catalog the plan tree was built from
+  uint64_t catalog_version = 0;
+
+  // commit id of the AS OF snapshot
+  cid_t snapshot_cid = INVALID_CID;
+
+  // number of executions of the plan tree
+  uint64_t execution_count = 0;
+
+  // compiled pipeline of the plan tree, once a compilation was tried
+  std::shared_ptr<executor::CompiledPipeline> compiled_pipeline;
+
+  bool pipeline_compiled = false;
+
+  // executor trees of the plan tree kept for the next executions
+  std::shared_ptr<executor::ExecutorTreePool> executor_tree_pool;
 };
 
 }  // namespace peloton
@@ -300,7 +300,8 @@ enum NetworkMessageType {
 
 enum ConcurrencyType {
   CONCURRENCY_TYPE_INVALID = 0,
-  CONCURRENCY_TYPE_TIMESTAMP_ORDERING = 1  // timestamp ordering
+  CONCURRENCY_TYPE_TIMESTAMP_ORDERING = 1,  // timestamp ordering
+  CONCURRENCY_TYPE_OPTIMISTIC = 2           // optimistic mvcc
 };
 
 //===--------------------------------------------------------------------===//
@@ -669,6 +670,14 @@ typedef enum LayoutType {
   LAYOUT_TYPE_HYBRID = 3  /* Hybrid layout */
 } LayoutType;
 
+// encodings of the columns of frozen (compressed) tiles
+enum CompressionType {
+  COMPRESSION_TYPE_INVALID = 0,
+  COMPRESSION_TYPE_DICTIONARY = 1,          // codes into the distinct values
+  COMPRESSION_TYPE_RUN_LENGTH = 2,          // (value, run end) pairs
+  COMPRESSION_TYPE_FRAME_OF_REFERENCE = 3,  // bit-packed offsets from minimum
+};
+
 enum LoggerMappingStrategyType {
   LOGGER_MAPPING_TYPE_INVALID = 0,
   LOGGER_MAPPING_TYPE_ROUND_ROBIN = 1,
@@ -927,8 +936,18 @@ enum RWType {
 
 enum GCSetType { GC_SET_TYPE_COMMITTED, GC_SET_TYPE_ABORTED };
 
-typedef std::unordered_map<oid_t, std::unordered_map<oid_t, RWType>>
-    ReadWriteSet;
+//===--------------------------------------------------------------------===//
+// Version Storage Types
+//===--------------------------------------------------------------------===//
+
+// order of the version chains of a table
+enum VersionStorageType {
+  VERSION_STORAGE_TYPE_INVALID = 0,
+  // the indirection points to the newest version, updates prepend
+  VERSION_STORAGE_TYPE_NEWEST_TO_OLDEST = 1,
+  // the indirection points to the oldest version, updates append
+  VERSION_STORAGE_TYPE_OLDEST_TO_NEWEST = 2
+};
 
 //===--------------------------------------------------------------------===//
 // File Handle
@@ -958,6 +977,11 @@ bool HexDecodeToBinary(unsigned char *bufferdst, const char *hexString);
 
 bool AtomicUpdateItemPointer(ItemPointer *src_ptr, const ItemPointer &value);
 
+// set the item pointer to value only if it still holds expected
+bool CompareAndSwapItemPointer(ItemPointer *src_ptr,
+                               const ItemPointer &expected,
+                               const ItemPointer &value);
+
 //===--------------------------------------------------------------------===//
 // Transformers
 //===--------------------------------------------------------------------===//
@@ -965,6 +989,9 @@ bool AtomicUpdateItemPointer(ItemPointer *src_ptr, const ItemPointer &value);
 std::string BackendTypeToString(BackendType type);
 BackendType StringToBackendType(const std::string &str);
 
+std::string VersionStorageTypeToString(VersionStorageType type);
+VersionStorageType StringToVersionStorageType(const std::string &str);
+
 std::string TypeIdToString(common::Type::TypeId type);
 common::Type::TypeId StringToTypeId(const std::string &str);
 
@@ -993,6 +1020,8 @@ std::string LoggingStatusToString(LoggingStatus type);
 std::string LoggerTypeToString(LoggerType type);
 std::string LogRecordTypeToString(LogRecordType type);
 
+std::string ResultToString(Result result);
+
 common::Type::TypeId PostgresValueTypeToPelotonValueType(
     PostgresValueType PostgresValType);
 ConstraintType PostgresConstraintTypeToPelotonConstraintType(
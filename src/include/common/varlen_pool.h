@@ -38,6 +38,8 @@ static const size_t MAX_EMPTY_NUM = 4;
 namespace peloton {
 namespace common {
 
+class Arena;
+
 class Buffer {
  public:
   size_t buf_size_;
@@ -59,6 +61,10 @@ class VarlenPool {
   VarlenPool(BackendType backend_type);
   VarlenPool();
 
+  // Allocate from the given arena instead. Free() is a no-op then, the memory
+  // is released with the arena.
+  explicit VarlenPool(Arena *arena);
+
   // Destroy this pool, and all memory it owns.
   ~VarlenPool();
 
@@ -99,6 +105,9 @@ class VarlenPool {
 
   // Each buffer list has a mutex
   Spinlock list_lock_[MAX_LIST_NUM];
+
+  // Arena the pool allocates from, if any
+  Arena *arena_ = nullptr;
 };
 
 }  // namespace common
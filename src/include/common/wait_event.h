@@ -0,0 +1,89 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// wait_event.h
+//
+// Identification: src/include/common/wait_event.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace peloton {
+
+// the waits that are instrumented
+enum WaitClass {
+  WAIT_CLASS_SPINLOCK = 0,           // spinlocks without a class of their own
+  WAIT_CLASS_TUPLE_LOCK = 1,         // tuple header locks
+  WAIT_CLASS_DATA_FILE_LOCK = 2,     // storage manager data file lock
+  WAIT_CLASS_VARLEN_POOL_LOCK = 3,   // varlen pool free lists
+  WAIT_CLASS_EPOCH = 4,              // epoch counters updated concurrently
+  WAIT_CLASS_LOG_FLUSH = 5,          // commits waiting for the log flush
+  WAIT_CLASS_TUPLE_SLOT = 6,         // inserts waiting for a new tile group
+  WAIT_CLASS_COUNT = 7
+};
+
+// wait counters of a thread, only written by the thread itself
+struct WaitEventCounters {
+  std::atomic<uint64_t> wait_count[WAIT_CLASS_COUNT];
+  std::atomic<uint64_t> wait_time_ns[WAIT_CLASS_COUNT];
+};
+
+//===--------------------------------------------------------------------===//
+// Wait Events
+//===--------------------------------------------------------------------===//
+
+// the waits of all threads. a wait is only recorded once a thread actually
+// has to wait, e.g., when a spinlock is taken, so the uncontended paths are
+// not affected.
+class WaitEvents {
+ public:
+  // record a wait of the calling thread. the time is 0 for the waits that
+  // are only counted, e.g., failed compare and swaps.
+  static void RecordWait(const WaitClass &wait_class,
+                         const uint64_t &wait_time_ns);
+
+  // totals of all the threads, including those that have exited
+  static uint64_t GetWaitCount(const WaitClass &wait_class);
+
+  static uint64_t GetWaitTime(const WaitClass &wait_class);
+
+  static std::string WaitClassToString(const WaitClass &wait_class);
+
+ private:
+  // the counters of the calling thread, registered on first use
+  static WaitEventCounters &GetThreadCounters();
+};
+
+// times a wait from its construction to its destruction. only construct it
+// once the thread has to wait.
+class WaitEventTimer {
+ public:
+  WaitEventTimer(const WaitEventTimer &) = delete;
+  WaitEventTimer &operator=(const WaitEventTimer &) = delete;
+
+  explicit WaitEventTimer(const WaitClass &wait_class)
+      : wait_class_(wait_class), start_(std::chrono::steady_clock::now()) {}
+
+  ~WaitEventTimer() {
+    auto elapsed = std::chrono::steady_clock::now() - start_;
+    WaitEvents::RecordWait(
+        wait_class_,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+  }
+
+ private:
+  WaitClass wait_class_;
+
+  std::chrono::steady_clock::time_point start_;
+};
+
+}  // End peloton namespace
@@ -13,6 +13,11 @@
 
 #pragma once
 
+#include <chrono>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <thread>
 #include <vector>
 
@@ -23,6 +28,11 @@
 #include "common/thread_pool.h"
 
 namespace peloton {
+
+namespace storage {
+class TileGroup;
+}
+
 namespace concurrency {
 
 struct Epoch {
@@ -65,16 +75,31 @@ public:
     : epoch_queue_(epoch_queue_size_),
       queue_tail_(0), reclaim_tail_(0), current_epoch_(0),
       queue_tail_token_(true), reclaim_tail_token_(true),
-      max_cid_ro_(READ_ONLY_START_CID), max_cid_gc_(0), finish_(false) {
+      max_cid_ro_(READ_ONLY_START_CID), max_cid_gc_(0), finish_(false),
+      is_running_(false) {
   }
 
   void StartEpoch() {
     finish_ = false;
+    is_running_ = true;
     thread_pool.SubmitDedicatedTask(&EpochManager::Start, this);
   }
 
   void StopEpoch() {
     finish_ = true;
+    is_running_ = false;
+  }
+
+  // hand over a tile group that has been dropped or replaced in the catalog.
+  // transactions may still hold raw pointers to it, so it is only released
+  // once all the epochs up to the current one are reclaimed.
+  void RetireTileGroup(std::shared_ptr<storage::TileGroup> tile_group) {
+    if (is_running_ == false) {
+      // epochs never advance, release it with the caller's reference
+      return;
+    }
+    std::lock_guard<std::mutex> lock(retire_lock_);
+    retired_tile_groups_.emplace_back(current_epoch_.load(), tile_group);
   }
 
   size_t EnterReadOnlyEpoch(cid_t begin_cid) {
@@ -131,6 +156,22 @@ public:
     return max_cid_ro_;
   }
 
+  // the commit id of the read-only transactions at a wall clock time, in
+  // microseconds since the unix epoch. it is sampled once per
+  // snapshot_history_interval_, INVALID_CID if the time is older than the
+  // samples.
+  cid_t GetSnapshotCid(const uint64_t &time) {
+    std::lock_guard<std::mutex> lock(snapshot_history_lock_);
+    cid_t snapshot_cid = INVALID_CID;
+    for (auto &sample : snapshot_history_) {
+      if (sample.first > time) {
+        break;
+      }
+      snapshot_cid = sample.second;
+    }
+    return snapshot_cid;
+  }
+
 private:
   void Start() {
     while (!finish_) {
@@ -145,6 +186,7 @@ private:
         // in this case, just increase tail
         IncreaseQueueTail();
         IncreaseReclaimTail();
+        ReleaseTileGroups();
         continue;
       }
 
@@ -155,9 +197,45 @@ private:
 
       IncreaseQueueTail();
       IncreaseReclaimTail();
+      ReleaseTileGroups();
+      RecordSnapshotCid();
     }
   }
 
+  // remember which snapshot the read-only transactions read at this time
+  void RecordSnapshotCid() {
+    uint64_t now = std::chrono::duration_cast<std::chrono::microseconds>(
+                       std::chrono::system_clock::now().time_since_epoch())
+                       .count();
+
+    std::lock_guard<std::mutex> lock(snapshot_history_lock_);
+    if (snapshot_history_.empty() == false &&
+        now < snapshot_history_.back().first + snapshot_history_interval_) {
+      return;
+    }
+    snapshot_history_.emplace_back(now, max_cid_ro_);
+    if (snapshot_history_.size() > snapshot_history_size_) {
+      snapshot_history_.pop_front();
+    }
+  }
+
+  // release the retired tile groups whose epoch has been reclaimed. they are
+  // retired in epoch order, so only the front of the list is checked.
+  void ReleaseTileGroups() {
+    auto reclaim_tail = reclaim_tail_.load();
+    std::list<std::pair<size_t, std::shared_ptr<storage::TileGroup>>> released;
+    {
+      std::lock_guard<std::mutex> lock(retire_lock_);
+      auto itr = retired_tile_groups_.begin();
+      while (itr != retired_tile_groups_.end() && itr->first < reclaim_tail) {
+        itr++;
+      }
+      released.splice(released.begin(), retired_tile_groups_,
+                      retired_tile_groups_.begin(), itr);
+    }
+    // the tile groups are freed outside of the lock
+  }
+
   void IncreaseReclaimTail() {
     bool expect = true, desired = false;
     if(!reclaim_tail_token_.compare_exchange_weak(expect, desired)){
@@ -240,6 +318,8 @@ private:
       }else if ( __sync_bool_compare_and_swap(addr, old, max) ) {
         return;
       }
+      // another thread raised the max concurrently, count the retry
+      WaitEvents::RecordWait(WAIT_CLASS_EPOCH, 0);
     }
   }
 
@@ -257,6 +337,10 @@ private:
   // queue size
   static const size_t epoch_queue_size_ = 4096;
 
+  // the snapshot history covers an hour, a sample per second
+  static const uint64_t snapshot_history_interval_ = 1000000;
+  static const size_t snapshot_history_size_ = 3600;
+
   // Epoch vector
   std::vector<Epoch> epoch_queue_;
   std::atomic<size_t> queue_tail_;
@@ -267,6 +351,16 @@ private:
   cid_t max_cid_ro_;
   cid_t max_cid_gc_;
   bool finish_;
+  std::atomic<bool> is_running_;
+
+  // tile groups retired from the catalog, with the epoch they were retired in
+  std::list<std::pair<size_t, std::shared_ptr<storage::TileGroup>>>
+      retired_tile_groups_;
+  std::mutex retire_lock_;
+
+  // (wall clock time, read-only commit id) samples, the oldest first
+  std::deque<std::pair<uint64_t, cid_t>> snapshot_history_;
+  std::mutex snapshot_history_lock_;
 };
 
 
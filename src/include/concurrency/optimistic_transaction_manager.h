@@ -0,0 +1,75 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// optimistic_transaction_manager.h
+//
+// Identification: src/include/concurrency/optimistic_transaction_manager.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+
+#include "concurrency/timestamp_ordering_transaction_manager.h"
+
+namespace peloton {
+namespace concurrency {
+
+//===--------------------------------------------------------------------===//
+// optimistic mvcc
+//===--------------------------------------------------------------------===//
+
+// reads never write to the tuple headers: they are only recorded in the read
+// set of the transaction. a transaction reads the snapshot of the last
+// installed commit, and gets a new commit id when it commits. at commit time,
+// the read set is validated against the end commit ids of the versions it
+// read, unless the isolation level is snapshot isolation. writes acquire the
+// ownership of the latest version as in timestamp ordering, so the first
+// writer wins.
+class OptimisticTransactionManager
+    : public TimestampOrderingTransactionManager {
+ public:
+  OptimisticTransactionManager() : last_committed_cid_(START_CID - 1) {}
+
+  virtual ~OptimisticTransactionManager() {}
+
+  static OptimisticTransactionManager &GetInstance();
+
+  // only the latest version can be owned.
+  virtual bool IsOwnable(
+      Transaction *const current_txn,
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id);
+
+  virtual bool AcquireOwnership(
+      Transaction *const current_txn,
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id);
+
+  virtual bool PerformRead(Transaction *const current_txn,
+                           const ItemPointer &location,
+                           bool acquire_ownership = false);
+
+  virtual Result CommitTransaction(Transaction *const current_txn);
+
+  virtual Transaction *BeginTransaction();
+
+ private:
+  // whether every version read by the transaction is still the latest one.
+  bool ValidateReadSet(Transaction *const current_txn);
+
+  // commit id of the last transaction whose versions are all installed.
+  std::atomic<cid_t> last_committed_cid_;
+
+  // validation and installation are atomic with respect to other commits, so
+  // that a snapshot never sees a partially installed transaction.
+  std::mutex commit_mutex_;
+};
+
+}  // End concurrency namespace
+}  // End peloton namespace
@@ -0,0 +1,93 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// read_write_set.h
+//
+// Identification: src/include/concurrency/read_write_set.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "common/types.h"
+
+namespace peloton {
+namespace concurrency {
+
+// an access of a transaction to a tuple version
+struct ReadWriteEntry {
+  ReadWriteEntry(const ItemPointer &location, const RWType &type)
+      : location(location), type(type) {}
+
+  ItemPointer location;
+  RWType type;
+};
+
+//===--------------------------------------------------------------------===//
+// Read Write Set
+//===--------------------------------------------------------------------===//
+
+// the tuple versions accessed by a transaction, in the order of their first
+// access. the entries are appended to a flat buffer that is only taken on
+// the first insert, so that empty sets, e.g., the gc sets of read-only
+// transactions, do not allocate. it comes from a pool of the thread refilled
+// by the sets the thread destroys. small sets are searched linearly, a hash
+// index over the entries is only built when a larger set is searched. sets
+// that are never searched, e.g., the gc sets, never build it.
+class ReadWriteSet {
+  ReadWriteSet(const ReadWriteSet &) = delete;
+  ReadWriteSet &operator=(const ReadWriteSet &) = delete;
+
+ public:
+  typedef std::vector<ReadWriteEntry>::iterator iterator;
+  typedef std::vector<ReadWriteEntry>::const_iterator const_iterator;
+
+  ReadWriteSet();
+
+  ~ReadWriteSet();
+
+  inline iterator begin() { return entries_.begin(); }
+
+  inline iterator end() { return entries_.end(); }
+
+  inline const_iterator begin() const { return entries_.begin(); }
+
+  inline const_iterator end() const { return entries_.end(); }
+
+  inline size_t size() const { return entries_.size(); }
+
+  inline bool empty() const { return entries_.empty(); }
+
+  // the type recorded for the location, or nullptr if it was not accessed
+  RWType *Find(const ItemPointer &location);
+
+  // the location must not be in the set yet, the callers look it up first
+  void Insert(const ItemPointer &location, const RWType &type);
+
+ private:
+  // take a buffer from the pool of the thread, or allocate one
+  void ReserveBuffer();
+
+  static inline uint64_t GetKey(const ItemPointer &location) {
+    return (static_cast<uint64_t>(location.block) << 32) | location.offset;
+  }
+
+ private:
+  static const size_t linear_search_limit_ = 16;
+
+  std::vector<ReadWriteEntry> entries_;
+
+  // position of the first indexed_count_ entries, only built for large sets
+  std::unordered_map<uint64_t, size_t> index_;
+
+  size_t indexed_count_;
+};
+
+}  // End concurrency namespace
+}  // End peloton namespace
@@ -105,10 +105,18 @@ class TimestampOrderingTransactionManager : public TransactionManager {
 
   virtual Transaction *BeginReadonlyTransaction();
 
+  virtual Transaction *BeginHistoricalTransaction(const cid_t &snapshot_cid);
+
   virtual void EndTransaction(Transaction *current_txn);
 
   virtual void EndReadonlyTransaction(Transaction *current_txn);
 
+protected:
+  // install the versions of the write set with the given commit id, and end
+  // the transaction.
+  Result CommitWriteSet(Transaction *const current_txn,
+                        const cid_t &end_commit_id);
+
 private:
   static const int LOCK_OFFSET = 0;
   static const int LAST_READER_OFFSET = (LOCK_OFFSET + 8);
@@ -19,9 +19,11 @@
 #include <unordered_map>
 #include <unordered_set>
 
+#include "common/platform.h"
 #include "common/printable.h"
 #include "common/types.h"
 #include "common/exception.h"
+#include "concurrency/read_write_set.h"
 
 
 namespace peloton {
@@ -61,8 +63,9 @@ class Transaction : public Printable {
     end_cid_ = MAX_CID;
     is_written_ = false;
     declared_readonly_ = false;
+    historical_ = false;
     insert_count_ = 0;
-    gc_set_.reset(new ReadWriteSet());
+    gc_set_ = std::make_shared<ReadWriteSet>();
   }
 
   //===--------------------------------------------------------------------===//
@@ -119,6 +122,11 @@ class Transaction : public Printable {
     return declared_readonly_;
   }
 
+  // a read-only transaction reading the snapshot of a past commit id
+  inline bool IsHistorical() const { return historical_; }
+
+  inline void SetHistorical(const bool historical) { historical_ = historical; }
+
  private:
   //===--------------------------------------------------------------------===//
   // Data members
@@ -138,6 +146,10 @@ class Transaction : public Printable {
 
   ReadWriteSet rw_set_;
 
+  // the workers of a parallel pipeline record and look up their reads
+  // concurrently
+  Spinlock rw_set_lock_;
+
   // this set contains data location that needs to be gc'd in the transaction.
   std::shared_ptr<ReadWriteSet> gc_set_;
 
@@ -148,6 +160,8 @@ class Transaction : public Printable {
   size_t insert_count_;
 
   bool declared_readonly_;
+
+  bool historical_;
 };
 
 }  // End concurrency namespace
@@ -16,6 +16,8 @@
 #include <atomic>
 #include <unordered_map>
 #include <list>
+#include <mutex>
+#include <set>
 #include <utility>
 
 #include "storage/tile_group_header.h"
@@ -46,6 +48,7 @@ class TransactionManager {
     next_txn_id_ = ATOMIC_VAR_INIT(START_TXN_ID);
     next_cid_ = ATOMIC_VAR_INIT(START_CID);
     maximum_grant_cid_ = ATOMIC_VAR_INIT(MAX_CID);
+    oldest_snapshot_cid_ = ATOMIC_VAR_INIT(MAX_CID);
   }
 
   virtual ~TransactionManager() {}
@@ -140,6 +143,10 @@ class TransactionManager {
 
   virtual Transaction *BeginReadonlyTransaction() = 0;
 
+  // a read-only transaction reading the snapshot of a past commit id. nullptr
+  // if transactions before the commit id may still commit.
+  virtual Transaction *BeginHistoricalTransaction(const cid_t &snapshot_cid) = 0;
+
   virtual void EndTransaction(Transaction *current_txn) = 0;
 
   virtual void EndReadonlyTransaction(Transaction *current_txn) = 0;
@@ -160,6 +167,24 @@ class TransactionManager {
     return EpochManagerFactory::GetInstance().GetMaxDeadTxnCid();
   }
 
+  // the gc keeps the versions visible at the commit ids of the snapshots of
+  // the running historical transactions
+  void RegisterSnapshot(const cid_t &snapshot_cid) {
+    std::lock_guard<std::mutex> lock(snapshot_lock_);
+    snapshot_cids_.insert(snapshot_cid);
+    oldest_snapshot_cid_ = *snapshot_cids_.begin();
+  }
+
+  void ReleaseSnapshot(const cid_t &snapshot_cid) {
+    std::lock_guard<std::mutex> lock(snapshot_lock_);
+    snapshot_cids_.erase(snapshot_cids_.find(snapshot_cid));
+    oldest_snapshot_cid_ =
+        snapshot_cids_.empty() ? MAX_CID : *snapshot_cids_.begin();
+  }
+
+  // MAX_CID if there is no historical transaction
+  cid_t GetOldestSnapshotCid() const { return oldest_snapshot_cid_.load(); }
+
   void SetDirtyRange(std::pair<cid_t, cid_t> dirty_range) {
     this->dirty_range_ = dirty_range;
   }
@@ -177,6 +202,11 @@ class TransactionManager {
   std::atomic<txn_id_t> next_txn_id_;
   std::atomic<cid_t> next_cid_;
   std::atomic<cid_t> maximum_grant_cid_;
+
+  // commit ids of the snapshots of the historical transactions
+  std::multiset<cid_t> snapshot_cids_;
+  std::atomic<cid_t> oldest_snapshot_cid_;
+  std::mutex snapshot_lock_;
 };
 }  // End storage namespace
 }  // End peloton namespace
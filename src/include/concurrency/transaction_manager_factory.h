@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include "concurrency/optimistic_transaction_manager.h"
 #include "concurrency/timestamp_ordering_transaction_manager.h"
 
 namespace peloton {
@@ -25,6 +26,9 @@ class TransactionManagerFactory {
       case CONCURRENCY_TYPE_TIMESTAMP_ORDERING:
         return TimestampOrderingTransactionManager::GetInstance();
 
+      case CONCURRENCY_TYPE_OPTIMISTIC:
+        return OptimisticTransactionManager::GetInstance();
+
       default:
         return TimestampOrderingTransactionManager::GetInstance();
     }
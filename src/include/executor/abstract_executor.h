@@ -30,6 +30,23 @@ class ExecutorContext;
 
 namespace executor {
 
+// runtime statistics of an executor, only collected when the query is
+// profiled
+struct ExecutorProfile {
+  // invocations of Execute()
+  size_t calls = 0;
+
+  // logical tiles and tuples produced
+  size_t tiles_out = 0;
+  size_t rows_out = 0;
+
+  // time spent in Execute(), including the time spent in the children
+  uint64_t wall_time_ns = 0;
+
+  // cpu cycles spent in Execute(), only counted with FLAGS_profile_cycles
+  uint64_t cycles = 0;
+};
+
 class AbstractExecutor {
  public:
   AbstractExecutor(const AbstractExecutor &) = delete;
@@ -61,6 +78,9 @@ class AbstractExecutor {
 
   const planner::AbstractPlan *GetRawNode() const { return node_; }
 
+  // nullptr unless the query is profiled
+  const ExecutorProfile *GetProfile() const { return profile_.get(); }
+
   // set the context
   void SetContext(common::Value &value);
 
@@ -77,6 +97,11 @@ class AbstractExecutor {
   // Used to reset the state. For now it's overloaded by index scan executor
   virtual void ResetState() {}
 
+  // Called once the execution of the tree is over, whether or not the
+  // executor ran to its end, before the tree is freed or kept for the next
+  // execution. Drops what the executor holds of the tables it read.
+  virtual void EndExecution() {}
+
  protected:
   // NOTE: The reason why we keep the plan node separate from the executor
   // context is because we might want to reuse the plan multiple times
@@ -92,6 +117,12 @@ class AbstractExecutor {
 
   void SetOutput(LogicalTile *val);
 
+ private:
+  // Execute() of a profiled executor
+  bool ProfiledExecute();
+
+ protected:
+
   /**
    * @brief Convenience method to return plan node corresponding to this
    *        executor, appropriately type-casted.
@@ -116,6 +147,11 @@ class AbstractExecutor {
   /** @brief Plan node corresponding to this executor. */
   const planner::AbstractPlan *node_ = nullptr;
 
+  // Runtime statistics, only allocated when the query is profiled
+  std::unique_ptr<ExecutorProfile> profile_;
+
+  bool profile_cycles_ = false;
+
  protected:
   // Executor context
   ExecutorContext *executor_context_ = nullptr;
@@ -14,9 +14,15 @@
 
 #include "planner/abstract_scan_plan.h"
 #include "common/types.h"
+#include "common/value.h"
 #include "executor/abstract_executor.h"
 
 namespace peloton {
+
+namespace storage {
+class TileGroup;
+}
+
 namespace executor {
 
 /**
@@ -41,11 +47,41 @@ class AbstractScanExecutor : public AbstractExecutor {
 
   virtual void ResetState() {}
 
+  // a "column <comparison> constant" conjunct of the predicate
+  struct ColumnPredicate {
+    oid_t column_id;
+    ExpressionType comparison_type;
+    common::Value constant;
+  };
+
+  // collect the conjuncts of the predicate that compare a column of the
+  // scanned table with a constant
+  static void GetColumnPredicates(
+      const expression::AbstractExpression *expression,
+      std::vector<ColumnPredicate> &column_predicates);
+
+  // whether no tuple of the tile group can satisfy the column predicates,
+  // according to its zone map
+  static bool CanSkipTileGroup(
+      const std::vector<ColumnPredicate> &column_predicates,
+      storage::TileGroup *tile_group);
+
+  // evaluate the column predicates directly on the compressed columns of the
+  // tile group. returns false if no column of the predicates is compressed.
+  static bool EvaluateCompressedPredicates(
+      const std::vector<ColumnPredicate> &column_predicates,
+      storage::TileGroup *tile_group, const oid_t &tuple_count,
+      std::vector<bool> &matches);
+
  protected:
   bool DInit();
 
   virtual bool DExecute() = 0;
 
+  bool CanSkipTileGroup(storage::TileGroup *tile_group) const {
+    return CanSkipTileGroup(column_predicates_, tile_group);
+  }
+
  protected:
   //===--------------------------------------------------------------------===//
   // Plan Info
@@ -56,6 +92,10 @@ class AbstractScanExecutor : public AbstractExecutor {
 
   /** @brief Columns from tile group to be added to logical tile output. */
   std::vector<oid_t> column_ids_;
+
+  /** @brief Conjuncts of the predicate that can be checked against zone maps
+   * and compressed columns. */
+  std::vector<ColumnPredicate> column_predicates_;
 };
 
 }  // namespace executor
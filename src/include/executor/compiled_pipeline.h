@@ -0,0 +1,77 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compiled_pipeline.h
+//
+// Identification: src/include/executor/compiled_pipeline.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <functional>
+#include <memory>
+
+#include "common/types.h"
+
+namespace peloton {
+
+namespace planner {
+class AbstractPlan;
+class AggregatePlan;
+class ProjectionPlan;
+class SeqScanPlan;
+}
+
+namespace executor {
+
+class ExecutorContext;
+class LogicalTile;
+
+//===--------------------------------------------------------------------===//
+// Compiled Pipeline
+//===--------------------------------------------------------------------===//
+
+// a plan run as a single push based loop instead of a tree of executors. the
+// supported plans are a sequential scan, optionally under a projection and
+// an aggregation. each visible tuple that satisfies the predicate of the scan
+// is pushed through the projection straight into the aggregator or the
+// output, no logical tile is built between the operators. like the scan
+// executor, it skips tile groups by their zone maps, prefilters compressed
+// columns and joins the shared cursor of the table. the pipeline only
+// refers to the plan, so it is built once per prepared statement and run with
+// the parameters of each execution.
+class CompiledPipeline {
+ public:
+  CompiledPipeline(const CompiledPipeline &) = delete;
+  CompiledPipeline &operator=(const CompiledPipeline &) = delete;
+
+  // called with each output tile, which is freed once it returns
+  typedef std::function<void(LogicalTile *)> OutputConsumer;
+
+  // nullptr if the plan has an operator the pipeline does not support, it
+  // has to be run by the executors then
+  static std::unique_ptr<CompiledPipeline> Compile(
+      const planner::AbstractPlan *plan);
+
+  // run the pipeline in the transaction of the context. returns false if a
+  // tuple could not be read, the transaction has failed then, or if the
+  // aggregates could not be finalized.
+  bool Execute(ExecutorContext *executor_context,
+               const OutputConsumer &consumer) const;
+
+ private:
+  CompiledPipeline() {}
+
+  const planner::SeqScanPlan *scan_plan_ = nullptr;
+
+  const planner::ProjectionPlan *projection_plan_ = nullptr;
+
+  const planner::AggregatePlan *aggregate_plan_ = nullptr;
+};
+
+}  // End executor namespace
+}  // End peloton namespace
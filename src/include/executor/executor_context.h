@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include "common/arena.h"
 #include "common/varlen_pool.h"
 #include "common/value.h"
 
@@ -52,9 +53,32 @@ class ExecutorContext {
 
   void ClearParams();
 
-  // Get a varlen pool (will construct the pool only if needed)
+  // run the executors of the context for another execution of their plan,
+  // in the given transaction and with the given parameters
+  void Rebind(concurrency::Transaction *transaction,
+              const std::vector<common::Value> &params);
+
+  // Get a varlen pool (will construct the pool only if needed), it allocates
+  // from the arena of the context
   common::VarlenPool *GetExecutorContextPool();
 
+  // memory released in one go once the query is done, for what the executors
+  // allocate while running it
+  common::Arena *GetArena() { return &arena_; }
+
+  // number of workers that run the pipelines of the query
+  size_t GetDegreeOfParallelism() const { return degree_of_parallelism_; }
+
+  void SetDegreeOfParallelism(const size_t &degree_of_parallelism) {
+    degree_of_parallelism_ = degree_of_parallelism;
+  }
+
+  // whether the executors collect runtime statistics, e.g., for EXPLAIN
+  // ANALYZE
+  bool IsProfiling() const { return profiling_; }
+
+  void SetProfiling(const bool &profiling) { profiling_ = profiling; }
+
   // num of tuple processed
   uint32_t num_processed = 0;
 
@@ -69,9 +93,18 @@ class ExecutorContext {
   // params
   std::vector<common::Value> params_;
 
+  // arena, declared before the pool that allocates from it
+  common::Arena arena_;
+
   // pool
   std::unique_ptr<common::VarlenPool> pool_;
 
+  // degree of parallelism
+  size_t degree_of_parallelism_;
+
+  // whether the executors are profiled
+  bool profiling_ = false;
+
 };
 
 }  // namespace executor
@@ -0,0 +1,81 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// executor_tree_pool.h
+//
+// Identification: src/include/executor/executor_tree_pool.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "common/platform.h"
+
+namespace peloton {
+
+namespace planner {
+class AbstractPlan;
+}
+
+namespace executor {
+
+class AbstractExecutor;
+class ExecutorContext;
+
+// an executor tree built for a plan, with the context its executors refer to
+struct ExecutorTree {
+  ExecutorTree(ExecutorContext *context, AbstractExecutor *root);
+
+  // frees the executors of the tree
+  ~ExecutorTree();
+
+  std::unique_ptr<ExecutorContext> context;
+
+  std::unique_ptr<AbstractExecutor> root;
+};
+
+//===--------------------------------------------------------------------===//
+// Executor Tree Pool
+//===--------------------------------------------------------------------===//
+
+// the idle executor trees of a prepared statement. a tree is taken out for an
+// execution, rebound to its transaction and parameters, initialized again and
+// put back once the results are read, so that repeated executions do not
+// allocate the executors and their context again. the trees refer to the plan
+// tree, the pool is dropped with it.
+class ExecutorTreePool {
+ public:
+  ExecutorTreePool(const ExecutorTreePool &) = delete;
+  ExecutorTreePool &operator=(const ExecutorTreePool &) = delete;
+
+  explicit ExecutorTreePool(const size_t &max_size) : max_size_(max_size) {}
+
+  // whether all the executors of the plan get back to their initial state
+  // when they are initialized again
+  static bool IsReusable(const planner::AbstractPlan *plan);
+
+  // nullptr if no tree is idle
+  std::unique_ptr<ExecutorTree> Acquire();
+
+  // keep the tree for a later execution, it is freed if the pool is full
+  void Release(std::unique_ptr<ExecutorTree> tree);
+
+  size_t GetSize() const;
+
+ private:
+  // max number of idle trees
+  size_t max_size_;
+
+  std::vector<std::unique_ptr<ExecutorTree>> trees_;
+
+  mutable Spinlock trees_lock_;
+};
+
+}  // End executor namespace
+}  // End peloton namespace
@@ -25,6 +25,7 @@
 #include "executor/delete_executor.h"
 #include "executor/update_executor.h"
 #include "executor/nested_loop_join_executor.h"
+#include "executor/index_nested_loop_join_executor.h"
 #include "executor/merge_join_executor.h"
 #include "executor/hash_join_executor.h"
 #include "executor/hash_executor.h"
@@ -33,3 +34,4 @@
 #include "executor/append_executor.h"
 #include "executor/projection_executor.h"
 #include "executor/copy_executor.h"
+#include "executor/gather_executor.h"
@@ -0,0 +1,63 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// gather_executor.h
+//
+// Identification: src/include/executor/gather_executor.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "executor/abstract_executor.h"
+#include "executor/pipeline.h"
+
+namespace peloton {
+namespace executor {
+
+/**
+ * Runs the pipeline rooted at its plan node on the morsels of the scanned
+ * table in parallel, and returns the logical tiles produced by all the
+ * workers. It takes the place of the pipeline in the executor tree, i.e., it
+ * feeds a pipeline breaker or the client.
+ */
+class GatherExecutor : public AbstractExecutor {
+ public:
+  GatherExecutor(const GatherExecutor &) = delete;
+  GatherExecutor &operator=(const GatherExecutor &) = delete;
+  GatherExecutor(GatherExecutor &&) = delete;
+  GatherExecutor &operator=(GatherExecutor &&) = delete;
+
+  explicit GatherExecutor(const planner::AbstractPlan *node,
+                          ExecutorContext *executor_context);
+
+ protected:
+  bool DInit();
+
+  bool DExecute();
+
+ private:
+  //===--------------------------------------------------------------------===//
+  // Executor State
+  //===--------------------------------------------------------------------===//
+
+  std::unique_ptr<Pipeline> pipeline_;
+
+  /** @brief Whether the pipeline has been run. */
+  bool done_ = false;
+
+  /** @brief Output tiles of the pipeline. */
+  std::vector<std::unique_ptr<LogicalTile>> result_tiles_;
+
+  /** @brief Next tile to return. */
+  size_t result_tile_itr_ = 0;
+};
+
+}  // namespace executor
+}  // namespace peloton
@@ -0,0 +1,67 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_nested_loop_join_executor.h
+//
+// Identification: src/include/executor/index_nested_loop_join_executor.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "executor/abstract_join_executor.h"
+
+#include <memory>
+#include <vector>
+
+namespace peloton {
+
+namespace index {
+class Index;
+}
+
+namespace executor {
+
+class IndexNestedLoopJoinExecutor : public AbstractJoinExecutor {
+  IndexNestedLoopJoinExecutor(const IndexNestedLoopJoinExecutor &) = delete;
+  IndexNestedLoopJoinExecutor &operator=(const IndexNestedLoopJoinExecutor &) =
+      delete;
+
+ public:
+  explicit IndexNestedLoopJoinExecutor(const planner::AbstractPlan *node,
+                                       ExecutorContext *executor_context);
+
+ protected:
+  bool DInit();
+  bool DExecute();
+
+ private:
+  //===--------------------------------------------------------------------===//
+  // Helper
+  //===--------------------------------------------------------------------===//
+  bool JoinOuterTile(size_t outer_tile_idx);
+
+  //===--------------------------------------------------------------------===//
+  // Executor State
+  //===--------------------------------------------------------------------===//
+
+  /** @brief Join tiles of the current outer tile that are not returned yet */
+  std::vector<std::unique_ptr<LogicalTile>> output_tiles_;
+  size_t output_tile_itr_ = 0;
+
+  //===--------------------------------------------------------------------===//
+  // Plan Info
+  //===--------------------------------------------------------------------===//
+
+  std::shared_ptr<index::Index> index_;
+
+  std::vector<oid_t> outer_key_column_ids_;
+
+  std::vector<oid_t> inner_column_ids_;
+};
+
+}  // namespace executor
+}  // namespace peloton
@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <map>
 #include <vector>
 
 #include "executor/abstract_scan_executor.h"
@@ -19,8 +20,14 @@
 
 namespace peloton {
 
+namespace concurrency {
+class Transaction;
+}
+
 namespace storage {
 class AbstractTable;
+class TileGroup;
+class Tuple;
 }
 
 namespace executor {
@@ -41,6 +48,10 @@ class IndexScanExecutor : public AbstractScanExecutor {
                            UNUSED_ATTRIBUTE);
 
   void ResetState() {
+    // the tiles that were not returned are still owned by the executor
+    for (auto tile_itr = result_itr_; tile_itr < result_.size(); tile_itr++) {
+      delete result_[tile_itr];
+    }
     result_.clear();
 
     result_itr_ = START_OID;
@@ -48,6 +59,13 @@ class IndexScanExecutor : public AbstractScanExecutor {
     done_ = false;
   }
 
+  static bool GetVisibleVersion(concurrency::Transaction *current_txn,
+                                ItemPointer tuple_location,
+                                ItemPointer &visible_location);
+
+  static bool HasIndexKey(index::Index *index, storage::TileGroup *tile_group,
+                          oid_t tuple_offset, const storage::Tuple &key);
+
  protected:
   bool DInit();
 
@@ -59,6 +77,9 @@ class IndexScanExecutor : public AbstractScanExecutor {
   //===--------------------------------------------------------------------===//
   bool ExecPrimaryIndexLookup();
   bool ExecSecondaryIndexLookup();
+  bool ExecKeyListLookup();
+
+  void BuildResultTiles(std::map<oid_t, std::vector<oid_t>> &visible_tuples);
 
   //===--------------------------------------------------------------------===//
   // Executor State
@@ -99,6 +120,9 @@ class IndexScanExecutor : public AbstractScanExecutor {
 
   std::vector<expression::AbstractExpression *> runtime_keys_;
 
+  // point keys of an IN list, probed instead of the key columns if not empty
+  std::vector<std::vector<common::Value>> key_list_;
+
   bool key_ready_ = false;
 };
 
@@ -0,0 +1,75 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// morsel_queue.h
+//
+// Identification: src/include/executor/morsel_queue.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "common/platform.h"
+#include "common/types.h"
+
+namespace peloton {
+namespace executor {
+
+// number of tile groups in a morsel
+#define DEFAULT_MORSEL_TILE_GROUP_COUNT 1
+
+//===--------------------------------------------------------------------===//
+// Morsel
+//===--------------------------------------------------------------------===//
+
+// a range of consecutive tile groups of a table
+struct Morsel {
+  Morsel() : tile_group_offset(INVALID_OID), tile_group_count(0) {}
+  Morsel(const oid_t &tile_group_offset, const oid_t &tile_group_count)
+      : tile_group_offset(tile_group_offset),
+        tile_group_count(tile_group_count) {}
+
+  oid_t tile_group_offset;
+  oid_t tile_group_count;
+};
+
+//===--------------------------------------------------------------------===//
+// Morsel Queue
+//===--------------------------------------------------------------------===//
+
+// hands out the morsels of a table scan to the workers of a pipeline. the
+// tile groups are split into one contiguous range per worker, so that a
+// worker scans neighbouring tile groups. a worker that has consumed its own
+// range steals morsels from the end of the ranges of the other workers.
+class MorselQueue {
+ public:
+  MorselQueue(const MorselQueue &) = delete;
+  MorselQueue &operator=(const MorselQueue &) = delete;
+
+  MorselQueue(const oid_t &tile_group_count, const size_t &worker_count,
+              const oid_t &morsel_tile_group_count =
+                  DEFAULT_MORSEL_TILE_GROUP_COUNT);
+
+  // returns false once all the morsels have been handed out
+  bool GetNextMorsel(const size_t &worker_id, Morsel &morsel);
+
+  size_t GetWorkerCount() const { return partitions_.size(); }
+
+ private:
+  struct Partition {
+    Spinlock partition_lock;
+    std::deque<Morsel> morsels;
+  };
+
+  std::vector<std::unique_ptr<Partition>> partitions_;
+};
+
+}  // End executor namespace
+}  // End peloton namespace
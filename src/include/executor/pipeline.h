@@ -0,0 +1,115 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// pipeline.h
+//
+// Identification: src/include/executor/pipeline.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <vector>
+
+#include "common/types.h"
+#include "executor/logical_tile.h"
+#include "executor/morsel_queue.h"
+
+namespace peloton {
+
+namespace planner {
+class AbstractPlan;
+}
+
+namespace storage {
+class DataTable;
+}
+
+namespace executor {
+
+class AbstractExecutor;
+class ExecutorContext;
+
+//===--------------------------------------------------------------------===//
+// Pipeline
+//===--------------------------------------------------------------------===//
+
+/**
+ * A chain of operators that stream the tuples of a sequential table scan
+ * without materializing them, e.g., scan -> filter -> projection. Plans are
+ * split into pipelines at the operators that have to consume all of their
+ * input before producing any output, i.e., hash builds, sorts and
+ * aggregations.
+ *
+ * A pipeline runs on the morsels of its table in parallel. Every worker
+ * builds its own copy of the operators, and pulls morsels from a shared
+ * morsel queue until all the tile groups are scanned. The workers run as
+ * tasks of the task scheduler, and the calling thread acts as one of them.
+ */
+class Pipeline {
+ public:
+  Pipeline(const Pipeline &) = delete;
+  Pipeline &operator=(const Pipeline &) = delete;
+
+  Pipeline(const planner::AbstractPlan *plan, ExecutorContext *executor_context,
+           const size_t &degree_of_parallelism);
+
+  ~Pipeline();
+
+  // whether the plan consumes all of its input before producing its output
+  static bool IsPipelineBreaker(const planner::AbstractPlan *plan);
+
+  // whether the plan only streams the tuples of a sequential table scan, so
+  // that it can run on disjoint morsels of the table
+  static bool IsParallelizable(const planner::AbstractPlan *plan);
+
+  // the table scanned by a parallelizable plan
+  static storage::DataTable *GetSourceTable(const planner::AbstractPlan *plan);
+
+  // run the pipeline to completion, and append the output tiles of all the
+  // workers to the result. the order of the tiles is not defined. returns
+  // false if the transaction failed.
+  bool Execute(std::vector<std::unique_ptr<LogicalTile>> &result_tiles);
+
+  size_t GetDegreeOfParallelism() const { return degree_of_parallelism_; }
+
+ private:
+  void RunWorker(const size_t worker_id);
+
+  // build the operators of a worker. all of them are added to the executors
+  // of the worker, which own them.
+  AbstractExecutor *BuildWorkerTree(const planner::AbstractPlan *plan,
+                                    const size_t &worker_id);
+
+ private:
+  const planner::AbstractPlan *plan_;
+
+  ExecutorContext *executor_context_;
+
+  size_t degree_of_parallelism_;
+
+  std::unique_ptr<MorselQueue> morsel_queue_;
+
+  // every worker evaluates expressions in its own context
+  std::vector<std::unique_ptr<ExecutorContext>> worker_contexts_;
+
+  std::vector<std::vector<std::unique_ptr<AbstractExecutor>>> worker_executors_;
+
+  std::vector<std::vector<std::unique_ptr<LogicalTile>>> worker_tiles_;
+
+  std::atomic<size_t> finished_worker_count_;
+
+  // first exception thrown by a worker, rethrown by Execute
+  std::exception_ptr worker_exception_;
+
+  std::atomic<bool> worker_failed_;
+};
+
+}  // End executor namespace
+}  // End peloton namespace
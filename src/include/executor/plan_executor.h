@@ -15,6 +15,8 @@
 #include "common/statement.h"
 #include "common/types.h"
 #include "executor/abstract_executor.h"
+#include "executor/compiled_pipeline.h"
+#include "executor/executor_tree_pool.h"
 
 namespace peloton {
 namespace bridge {
@@ -56,6 +58,11 @@ class PlanExecutor {
   static void PrintPlan(const planner::AbstractPlan *plan,
                         std::string prefix = "");
 
+  // The plan of the executor tree annotated with the runtime statistics of
+  // the executors, one line per executor. The tree must have been profiled.
+  static std::string GetProfileInfo(const executor::AbstractExecutor *executor,
+                                    std::string prefix = "");
+
   // Copy From
   static inline void copyFromTo(const std::string &src,
                                 std::vector<unsigned char> &dst) {
@@ -81,11 +88,29 @@ class PlanExecutor {
    *        Before ExecutePlan, a node first receives value list, so we should
    * pass
    *        value list directly rather than passing Postgres's ParamListInfo
+   *        The plan runs in a transaction of its own, unless the caller
+   * passes the transaction to run it in, and ends that transaction itself
+   *        If profile is given, the executors are profiled and the annotated
+   * plan is written to it
+   *        If tree_pool is given, an idle executor tree of the plan is
+   * reused and put back into it afterwards
    */
-  static peloton_status ExecutePlan(const planner::AbstractPlan *plan,
-                                    const std::vector<common::Value> &params,
-                                    std::vector<ResultType> &result,
-                                    const std::vector<int> &result_format);
+  static peloton_status ExecutePlan(
+      const planner::AbstractPlan *plan,
+      const std::vector<common::Value> &params,
+      std::vector<ResultType> &result, const std::vector<int> &result_format,
+      concurrency::Transaction *txn = nullptr, std::string *profile = nullptr,
+      executor::ExecutorTreePool *tree_pool = nullptr);
+
+  /*
+   * @brief Run a compiled pipeline instead of building an executor tree, the
+   * results and the transaction are handled as by ExecutePlan
+   */
+  static peloton_status ExecutePipeline(
+      const executor::CompiledPipeline *pipeline,
+      const std::vector<common::Value> &params,
+      std::vector<ResultType> &result, const std::vector<int> &result_format,
+      concurrency::Transaction *txn = nullptr);
 
   /*
    * @brief When a peloton node recvs a query plan, this function is invoked
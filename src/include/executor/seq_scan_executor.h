@@ -12,12 +12,31 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "planner/seq_scan_plan.h"
 #include "executor/abstract_scan_executor.h"
 
 namespace peloton {
+
+namespace storage {
+class SharedScan;
+class TileGroup;
+}
+
+namespace stats {
+class MetricSeries;
+}
+
+namespace expression {
+class CompiledExpressionEvaluator;
+}
+
 namespace executor {
 
+class MorselQueue;
+
 class SeqScanExecutor : public AbstractScanExecutor {
  public:
   SeqScanExecutor(const SeqScanExecutor &) = delete;
@@ -28,7 +47,22 @@ class SeqScanExecutor : public AbstractScanExecutor {
   explicit SeqScanExecutor(const planner::AbstractPlan *node,
                            ExecutorContext *executor_context);
 
-  void ResetState() { current_tile_group_offset_ = START_OID; }
+  ~SeqScanExecutor();
+
+  void ResetState() {
+    current_tile_group_offset_ = START_OID;
+    DetachSharedScan();
+  }
+
+  // a scan cut short, e.g., by a limit, leaves the shared scan here
+  void EndExecution() { DetachSharedScan(); }
+
+  // only scan the tile groups of the morsels that the queue hands out to the
+  // given worker of a parallel pipeline
+  void SetMorselQueue(MorselQueue *morsel_queue, const size_t &worker_id) {
+    morsel_queue_ = morsel_queue;
+    worker_id_ = worker_id;
+  }
 
  protected:
   bool DInit();
@@ -36,6 +70,16 @@ class SeqScanExecutor : public AbstractScanExecutor {
   bool DExecute();
 
  private:
+  // offset of the next tile group to scan. returns false once the scan is
+  // done.
+  bool GetNextTileGroupOffset(oid_t &tile_group_offset);
+
+  // stop moving the shared scan cursor of the table, if attached
+  void DetachSharedScan();
+
+  // scan the rows of a virtual metric table at once
+  bool ExecuteMetricSeries();
+
   //===--------------------------------------------------------------------===//
   // Executor State
   //===--------------------------------------------------------------------===//
@@ -46,6 +90,29 @@ class SeqScanExecutor : public AbstractScanExecutor {
   /** @brief Keeps track of the number of tile groups to scan. */
   oid_t table_tile_group_count_ = INVALID_OID;
 
+  /** @brief Tile group the scan started at, it wraps around to the ones
+   * before. */
+  oid_t scan_start_offset_ = START_OID;
+
+  /** @brief Cursor of the table scans this scan is attached to, if any. */
+  storage::SharedScan *shared_scan_ = nullptr;
+
+  /** @brief Source of the morsels in a parallel pipeline, if any. */
+  MorselQueue *morsel_queue_ = nullptr;
+
+  size_t worker_id_ = 0;
+
+  /** @brief End of the morsel being scanned. */
+  oid_t morsel_end_offset_ = INVALID_OID;
+
+  /** @brief Rows of the target table if it is a metric table. */
+  stats::MetricSeries *metric_series_ = nullptr;
+
+  bool metric_series_done_ = false;
+
+  /** @brief Evaluator of the compiled predicate, if it could be compiled. */
+  std::unique_ptr<expression::CompiledExpressionEvaluator> compiled_predicate_;
+
   //===--------------------------------------------------------------------===//
   // Plan Info
   //===--------------------------------------------------------------------===//
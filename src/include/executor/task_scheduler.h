@@ -0,0 +1,103 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// task_scheduler.h
+//
+// Identification: src/include/executor/task_scheduler.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/macros.h"
+#include "common/platform.h"
+
+namespace peloton {
+namespace executor {
+
+typedef std::function<void()> Task;
+
+//===--------------------------------------------------------------------===//
+// Task Scheduler
+//===--------------------------------------------------------------------===//
+
+// a fixed set of worker threads, one per core, that execute the tasks of
+// parallel queries. every worker owns a task queue. a worker takes tasks from
+// the front of its own queue, and steals from the back of the queues of the
+// other workers once its own queue is empty.
+class TaskScheduler {
+ public:
+  TaskScheduler(const TaskScheduler &) = delete;
+  TaskScheduler &operator=(const TaskScheduler &) = delete;
+
+  TaskScheduler();
+
+  ~TaskScheduler() {}
+
+  static TaskScheduler &GetInstance();
+
+  void StartScheduler(const size_t &worker_count);
+
+  void StopScheduler();
+
+  bool IsRunning() const { return is_running_; }
+
+  size_t GetWorkerCount() const { return task_queues_.size(); }
+
+  // the degree of parallelism granted to a query that asks for the given
+  // one. it is capped by the number of workers plus the calling thread.
+  size_t GetParallelism(const size_t &degree_of_parallelism) const;
+
+  // enqueue the task on the queue of a worker. returns false if the
+  // scheduler is not running, in which case the caller has to run the task
+  // itself.
+  bool SubmitTask(const Task &task, const size_t &worker_id);
+
+  // run one pending task on the calling thread. threads that wait for their
+  // tasks invoke this, so that a query never waits on tasks that no worker
+  // has picked up yet. returns false if there is no pending task.
+  bool RunPendingTask(const size_t &worker_id);
+
+ private:
+  void Running(const size_t worker_id);
+
+  // take a task from the worker's own queue, or steal one from the others.
+  bool PopTask(const size_t &worker_id, Task &task);
+
+  // run all the tasks left in the queues on the calling thread.
+  void DrainTasks();
+
+ private:
+  struct TaskQueue {
+    Spinlock queue_lock;
+    std::deque<Task> tasks;
+  };
+
+  //===--------------------------------------------------------------------===//
+  // Data members
+  //===--------------------------------------------------------------------===//
+  volatile bool is_running_;
+
+  std::mutex scheduler_mutex_;
+
+  std::vector<std::unique_ptr<TaskQueue>> task_queues_;
+
+  std::vector<std::unique_ptr<std::thread>> worker_threads_;
+
+  // tasks that are enqueued but not taken yet
+  std::atomic<size_t> pending_task_count_;
+};
+
+}  // End executor namespace
+}  // End peloton namespace
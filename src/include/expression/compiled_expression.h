@@ -0,0 +1,175 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compiled_expression.h
+//
+// Identification: src/include/expression/compiled_expression.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "common/types.h"
+#include "common/value.h"
+
+namespace peloton {
+
+namespace catalog {
+class Schema;
+}
+
+namespace executor {
+class ExecutorContext;
+}
+
+namespace storage {
+class TileGroup;
+}
+
+namespace expression {
+
+class AbstractExpression;
+
+// number of tuples a compiled expression evaluates at once
+static const size_t COMPILED_BATCH_SIZE = 1024;
+
+// a value of a compiled expression. booleans and all the integer types are
+// kept in the integer, decimals in the decimal.
+union CompiledDatum {
+  int64_t integer;
+  double decimal;
+};
+
+// the state of a compiled expression while it evaluates a batch, a register
+// per step of the program. nulls are kept apart in a bitmask per register.
+struct CompiledBatch {
+  // offsets of the tuples of the batch in the tile group
+  const oid_t *tuple_ids = nullptr;
+  size_t size = 0;
+
+  // where the columns read by the program start in the tiles, and the length
+  // of a tuple of their tile
+  std::vector<const char *> column_bases;
+  std::vector<size_t> column_strides;
+
+  // the constants and the parameters
+  std::vector<CompiledDatum> constants;
+  std::vector<bool> constant_nulls;
+
+  std::vector<std::vector<CompiledDatum>> values;
+  std::vector<std::vector<uint64_t>> nulls;
+};
+
+struct CompiledStep;
+
+typedef void (*CompiledStepFunction)(const CompiledStep &step,
+                                     CompiledBatch &batch);
+
+// a step of a compiled expression, a function specialized for the operator
+// and the types of the operands
+struct CompiledStep {
+  CompiledStepFunction function;
+
+  // registers of the result and of the operands
+  size_t result;
+  size_t left;
+  size_t right;
+
+  // column or constant read by the step, if any
+  size_t column;
+  size_t constant;
+
+  // type of the result, integers of a narrower type are checked to fit it
+  common::Type::TypeId value_type;
+};
+
+//===--------------------------------------------------------------------===//
+// Compiled Expression
+//===--------------------------------------------------------------------===//
+
+// an expression over the columns of a table, compiled into a flat program of
+// typed steps. each step runs over a batch of tuples at once, reading the
+// column bytes straight from the tiles. the program never changes after it is
+// compiled, so all the threads running a plan share it; each of them
+// evaluates it with its own CompiledExpressionEvaluator.
+class CompiledExpression {
+ public:
+  CompiledExpression(const CompiledExpression &) = delete;
+  CompiledExpression &operator=(const CompiledExpression &) = delete;
+
+  // nullptr if the expression can not be compiled, e.g. if it reads a
+  // varlen column, calls a function or refers to a second tuple. the
+  // parameters are compiled as constants of the given types.
+  static std::unique_ptr<CompiledExpression> Compile(
+      const AbstractExpression *expression, const catalog::Schema *schema,
+      const std::vector<common::Type::TypeId> &param_types);
+
+  inline common::Type::TypeId GetValueType() const {
+    return steps_.back().value_type;
+  }
+
+  inline size_t GetStepCount() const { return steps_.size(); }
+
+ private:
+  friend class CompiledExpressionEvaluator;
+  friend class ExpressionCompiler;
+
+  CompiledExpression() {}
+
+  std::vector<CompiledStep> steps_;
+
+  // columns of the table read by the program
+  std::vector<oid_t> column_ids_;
+
+  // the constants of the program, the parameters are filled in by the
+  // evaluator
+  std::vector<common::Value> constants_;
+  std::vector<int> constant_param_idxs_;
+};
+
+//===--------------------------------------------------------------------===//
+// Compiled Expression Evaluator
+//===--------------------------------------------------------------------===//
+
+// evaluates a compiled expression on the tuples of the tile groups of its
+// table. owned by a single thread.
+class CompiledExpressionEvaluator {
+ public:
+  CompiledExpressionEvaluator(const CompiledExpressionEvaluator &) = delete;
+  CompiledExpressionEvaluator &operator=(const CompiledExpressionEvaluator &) =
+      delete;
+
+  // the parameters are read from the context
+  CompiledExpressionEvaluator(const CompiledExpression *expression,
+                              executor::ExecutorContext *context);
+
+  // read the columns from the tiles of the given tile group. returns false if
+  // a column read by the expression is compressed in it, the expression has
+  // to be interpreted then.
+  bool SetTileGroup(storage::TileGroup *tile_group);
+
+  // keep the tuples of the list that satisfy the predicate
+  void Filter(std::vector<oid_t> &tuple_ids);
+
+  // the value of the expression for each tuple of the list
+  void Evaluate(const std::vector<oid_t> &tuple_ids,
+                std::vector<common::Value> &values);
+
+ private:
+  // run the program on a batch of at most COMPILED_BATCH_SIZE tuples
+  void RunBatch(const oid_t *tuple_ids, const size_t &size);
+
+  const CompiledExpression *expression_;
+
+  CompiledBatch batch_;
+};
+
+}  // End expression namespace
+}  // End peloton namespace
@@ -60,6 +60,7 @@ public:
   UNUSED_ATTRIBUTE executor::ExecutorContext *context) const override {
     // for now support only one child
     std::vector<Value> child_values;
+    child_values.reserve(children_.size());
     PL_ASSERT(func_ptr_ != nullptr);
     for (auto &child: children_){
       child_values.push_back(child->Evaluate(tuple1, tuple2, context));
@@ -18,6 +18,7 @@
 #include "common/macros.h"
 #include "common/types.h"
 #include "common/logger.h"
+#include "concurrency/read_write_set.h"
 
 namespace peloton {
 namespace gc {
@@ -55,7 +56,7 @@ class GCManager {
 
   virtual void RegisterTable(const oid_t &table_id UNUSED_ATTRIBUTE) { }
 
-  virtual void RecycleTransaction(std::shared_ptr<ReadWriteSet> gc_set UNUSED_ATTRIBUTE, 
+  virtual void RecycleTransaction(std::shared_ptr<concurrency::ReadWriteSet> gc_set UNUSED_ATTRIBUTE, 
                                    const cid_t &timestamp UNUSED_ATTRIBUTE,
                                    const GCSetType gc_set_type UNUSED_ATTRIBUTE) {}
 
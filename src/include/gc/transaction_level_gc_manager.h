@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <thread>
 #include <unordered_map>
 #include <map>
@@ -25,6 +26,11 @@
 #include "container/lock_free_queue.h"
 
 namespace peloton {
+
+namespace test {
+class GCManagerTestsUtil;
+}
+
 namespace gc {
 
 #define MAX_QUEUE_LENGTH 100000
@@ -33,24 +39,32 @@ namespace gc {
 
 struct GarbageContext {
   GarbageContext() : timestamp_(INVALID_CID), gc_set_type_(GC_SET_TYPE_COMMITTED) {}
-  GarbageContext(std::shared_ptr<ReadWriteSet> gc_set, 
+  GarbageContext(std::shared_ptr<concurrency::ReadWriteSet> gc_set, 
                  const cid_t &timestamp, 
                  const GCSetType gc_set_type) : timestamp_(timestamp), gc_set_type_(gc_set_type) {
     gc_set_ = gc_set;
+    expire_time_ = std::chrono::steady_clock::now();
   }
 
-  std::shared_ptr<ReadWriteSet> gc_set_;
+  std::shared_ptr<concurrency::ReadWriteSet> gc_set_;
   cid_t timestamp_;
   GCSetType gc_set_type_;
+
+  // when the versions expired, their retention starts from it
+  std::chrono::steady_clock::time_point expire_time_;
 };
 
 class TransactionLevelGCManager : public GCManager {
+  // collects the garbage in the tests, without the gc threads
+  friend class test::GCManagerTestsUtil;
+
 public:
   TransactionLevelGCManager(int thread_count) 
     : is_running_(true),
       gc_thread_count_(thread_count),
       gc_threads_(thread_count),
-      reclaim_maps_(thread_count) {
+      reclaim_maps_(thread_count),
+      retained_maps_(thread_count) {
 
     unlink_queues_.reserve(thread_count);
     for (int i = 0; i < gc_thread_count_; ++i) {
@@ -84,7 +98,7 @@ public:
     }
   }
 
-  virtual void RecycleTransaction(std::shared_ptr<ReadWriteSet> gc_set, const cid_t &timestamp, const GCSetType) override;
+  virtual void RecycleTransaction(std::shared_ptr<concurrency::ReadWriteSet> gc_set, const cid_t &timestamp, const GCSetType) override;
 
   virtual ItemPointer ReturnFreeSlot(const oid_t &table_id) override;
 
@@ -105,12 +119,16 @@ private:
     return (unsigned int)ts % gc_thread_count_;
   }
 
+  // unlink and reclaim all the garbage of the thread, without waiting for
+  // the retention of the tables
   void ClearGarbage(int thread_id);
 
   void Running(const int &thread_id);
 
+  // unlink the garbage that no transaction can read anymore from the indexes
   void Unlink(const int &thread_id, const cid_t &max_cid);
 
+  // reset the unlinked versions older than max_cid for reuse
   void Reclaim(const int &thread_id, const cid_t &max_cid);
 
   void AddToRecycleMap(std::shared_ptr<GarbageContext> gc_ctx);
@@ -121,6 +139,16 @@ private:
 
   void DeleteTupleFromIndexes(ItemPointer *indirection);
 
+  void UnlinkExpiredVersions(const ItemPointer &location,
+                             const cid_t &timestamp);
+
+  bool CanUnlink(const std::shared_ptr<GarbageContext>& garbage_ctx,
+                 const cid_t &max_cid);
+
+  size_t GetVersionRetention(const std::shared_ptr<GarbageContext>& garbage_ctx);
+
+  void RaiseExpiredCids(const std::shared_ptr<GarbageContext>& garbage_ctx);
+
 private:
   //===--------------------------------------------------------------------===//
   // Data members
@@ -142,6 +170,11 @@ private:
   // metadata of the garbage.
   std::vector<std::multimap<cid_t, std::shared_ptr<GarbageContext>>> reclaim_maps_;
 
+  // multimaps for the garbage kept for the retention of its tables.
+  // The key is the time when the retention ends.
+  std::vector<std::multimap<std::chrono::steady_clock::time_point,
+                            std::shared_ptr<GarbageContext>>> retained_maps_;
+
   // queues for to-be-reused tuples.
   std::unordered_map<oid_t, std::shared_ptr<peloton::LockFreeQueue<ItemPointer>>> recycle_queue_map_;
 
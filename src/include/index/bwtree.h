@@ -6382,6 +6382,93 @@ before_switch:
 
     return value_set;
   }
+
+  /*
+   * GetValueBatch() - Fill a value list with the values of a list of keys
+   *
+   * The values of the i-th key are stored in value_list between
+   * key_offset_list[i] and key_offset_list[i + 1], so the offset list has
+   * one more element than the key list.
+   *
+   * Keys should be sorted in ascending order: a leaf node is consolidated
+   * once and reused for all following keys that fall below its high key,
+   * so that a run of nearby keys costs a single traversal from the root.
+   * Unsorted keys are still answered correctly, but a key smaller than the
+   * previous one always traverses from the root again.
+   */
+  void GetValueBatch(const std::vector<KeyType> &search_key_list,
+                     std::vector<ValueType> &value_list,
+                     std::vector<size_t> &key_offset_list) {
+    bwt_printf("GetValueBatch()\n");
+
+    key_offset_list.clear();
+    key_offset_list.reserve(search_key_list.size() + 1);
+    key_offset_list.push_back(value_list.size());
+
+    // Consolidated copy of the current leaf; it is private to this thread
+    // so it could be read outside of the epoch
+    LeafNode *leaf_node_p = nullptr;
+    KeyNodeIDPair high_key_pair{};
+    const KeyType *prev_key_p = nullptr;
+    auto it = typename std::vector<KeyValuePair>::iterator{};
+
+    for(const KeyType &search_key : search_key_list) {
+      // The leaf covers [low key, high key) and the previous key is inside
+      // it, so any key between the previous key and the high key is too
+      // (an INVALID_NODE_ID high key stands for +Inf)
+      bool need_traverse =
+        (leaf_node_p == nullptr) ||
+        KeyCmpLess(search_key, *prev_key_p) ||
+        ((high_key_pair.second != INVALID_NODE_ID) &&
+         KeyCmpGreaterEqual(search_key, high_key_pair.first));
+
+      if(need_traverse == true) {
+        EpochNode *epoch_node_p = epoch_manager.JoinEpoch();
+
+        Context context{search_key};
+        Traverse(&context, nullptr, nullptr);
+
+        NodeSnapshot *snapshot_p = GetLatestNodeSnapshot(&context);
+        const BaseNode *node_p = snapshot_p->node_p;
+        assert(node_p->IsOnLeafDeltaChain() == true);
+
+        high_key_pair = node_p->GetHighKeyPair();
+
+        if(leaf_node_p != nullptr) {
+          delete leaf_node_p;
+        }
+
+        leaf_node_p = CollectAllValuesOnLeaf(snapshot_p);
+
+        epoch_manager.LeaveEpoch(epoch_node_p);
+
+        it = leaf_node_p->data_list.begin();
+      }
+
+      // Keys only move forward inside the leaf, so start from the
+      // position of the previous key
+      it = std::lower_bound(it,
+                            leaf_node_p->data_list.end(),
+                            std::make_pair(search_key, ValueType{}),
+                            key_value_pair_cmp_obj);
+
+      for(auto value_it = it;
+          (value_it != leaf_node_p->data_list.end()) &&
+          KeyCmpEqual(value_it->first, search_key);
+          value_it++) {
+        value_list.push_back(value_it->second);
+      }
+
+      key_offset_list.push_back(value_list.size());
+      prev_key_p = &search_key;
+    }
+
+    if(leaf_node_p != nullptr) {
+      delete leaf_node_p;
+    }
+
+    return;
+  }
   
   ///////////////////////////////////////////////////////////////////
   // Garbage Collection Interface
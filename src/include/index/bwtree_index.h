@@ -107,6 +107,10 @@ class BWTreeIndex : public Index {
   void ScanKey(const storage::Tuple *key,
                std::vector<ValueType> &result);
 
+  void ScanKeys(const std::vector<const storage::Tuple *> &keys,
+                std::vector<ValueType> &result,
+                std::vector<size_t> &key_offsets);
+
   std::string GetTypeName() const;
 
   // TODO: Implement this
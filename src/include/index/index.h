@@ -240,6 +240,14 @@ class Index : public Printable {
   virtual void ScanKey(const storage::Tuple *key,
                        std::vector<ItemPointer *> &result) = 0;
 
+  // Point lookup of a list of keys in one call. The locations of the i-th
+  // key are stored in result between key_offsets[i] and key_offsets[i + 1].
+  // Keys in ascending order let the index share the work between
+  // neighbouring keys, but any order gives the same result.
+  virtual void ScanKeys(const std::vector<const storage::Tuple *> &keys,
+                        std::vector<ItemPointer *> &result,
+                        std::vector<size_t> &key_offsets);
+
   ///////////////////////////////////////////////////////////////////
   // Garbage Collection
   ///////////////////////////////////////////////////////////////////
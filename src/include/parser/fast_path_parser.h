@@ -0,0 +1,46 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// fast_path_parser.h
+//
+// Identification: src/include/parser/fast_path_parser.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "parser/sql_statement.h"
+
+namespace peloton {
+namespace parser {
+
+//===--------------------------------------------------------------------===//
+// Fast Path Parser
+//===--------------------------------------------------------------------===//
+
+// recognizes the simple single table statements with a hand written
+// tokenizer, and builds the same parse tree as the grammar without running
+// the generated scanner and parser:
+//
+//   SELECT * | col [, col ...] FROM table [WHERE pred [AND pred ...]]
+//       [FOR UPDATE]
+//   UPDATE table SET col = value [, col = value ...] [WHERE pred [AND ...]]
+//   INSERT INTO table [(col [, col ...])] VALUES (value [, value ...])
+//
+// where a pred is col = value, and a value is a string, an integer, a decimal
+// or a $n parameter.
+class FastPathParser {
+ public:
+  // nullptr if the query is not one of these statements, it has to go
+  // through the full parser then
+  static std::unique_ptr<SQLStatementList> Parse(const std::string &query);
+};
+
+}  // End parser namespace
+}  // End peloton namespace
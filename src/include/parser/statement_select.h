@@ -86,7 +86,8 @@ struct SelectStatement : SQLStatement {
         union_select(NULL),
         order(NULL),
         limit(NULL),
-        is_for_update(false){};
+        is_for_update(false),
+        as_of(NULL){};
 
   virtual ~SelectStatement() {
     delete from_table;
@@ -102,6 +103,7 @@ struct SelectStatement : SQLStatement {
     delete union_select;
     delete order;
     delete limit;
+    delete as_of;
   }
 
 
@@ -116,6 +118,10 @@ struct SelectStatement : SQLStatement {
   LimitDescription* limit;
   bool is_for_update;
 
+  // AS OF commit id or timestamp of the snapshot to read, NULL to read the
+  // current one
+  expression::AbstractExpression* as_of;
+
 public:
 	const std::vector<expression::AbstractExpression*>* getSelectList() const {
 		return select_list;
@@ -12,13 +12,16 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
 #include "abstract_plan.h"
 #include "common/types.h"
 #include "expression/abstract_expression.h"
+#include "expression/compiled_expression.h"
 
 namespace peloton {
 
@@ -47,6 +50,12 @@ class AbstractScan : public AbstractPlan {
     return predicate_.get();
   }
 
+  // the predicate compiled for the types of the given parameters, nullptr if
+  // it can not be compiled. it is compiled once per plan, so the plan of a
+  // prepared statement keeps it across executions.
+  const expression::CompiledExpression *GetCompiledPredicate(
+      const std::vector<common::Value> &params) const;
+
   inline const std::vector<oid_t> &GetColumnIds() const { return column_ids_; }
 
   inline PlanNodeType GetPlanNodeType() const {
@@ -67,6 +76,8 @@ class AbstractScan : public AbstractPlan {
   void SetColumnId(oid_t col_id) { column_ids_.push_back(col_id); }
   void SetPredicate(expression::AbstractExpression *predicate) {
     predicate_ = std::unique_ptr<expression::AbstractExpression>(predicate);
+    std::lock_guard<std::mutex> lock(compiled_predicates_lock_);
+    compiled_predicates_.clear();
   }
   void SetForUpdateFlag(bool flag) { is_for_update = flag; }
 
@@ -83,6 +94,14 @@ class AbstractScan : public AbstractPlan {
 
   // "For Update" Flag
   bool is_for_update = false;
+
+  /** @brief Compiled predicate per types of the parameters, nullptr if the
+   * predicate can not be compiled. */
+  mutable std::map<std::vector<common::Type::TypeId>,
+                   std::unique_ptr<expression::CompiledExpression>>
+      compiled_predicates_;
+
+  mutable std::mutex compiled_predicates_lock_;
 };
 
 }  // namespace planner
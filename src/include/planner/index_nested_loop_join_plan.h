@@ -0,0 +1,88 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_nested_loop_join_plan.h
+//
+// Identification: src/include/planner/index_nested_loop_join_plan.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "planner/abstract_join_plan.h"
+
+namespace peloton {
+
+namespace index {
+class Index;
+}
+
+namespace storage {
+class DataTable;
+}
+
+namespace planner {
+
+class ProjectInfo;
+
+// Joins the tuples of its only child (the outer side) with the tuples of the
+// inner table found by looking up their join keys in an index of the inner
+// table. The keys of a whole outer tile are looked up in one batch.
+class IndexNestedLoopJoinPlan : public AbstractJoinPlan {
+ public:
+  IndexNestedLoopJoinPlan(const IndexNestedLoopJoinPlan &) = delete;
+  IndexNestedLoopJoinPlan &operator=(const IndexNestedLoopJoinPlan &) = delete;
+  IndexNestedLoopJoinPlan(IndexNestedLoopJoinPlan &&) = delete;
+  IndexNestedLoopJoinPlan &operator=(IndexNestedLoopJoinPlan &&) = delete;
+
+  // outer_key_column_ids are the columns of the outer tile that make up the
+  // index key, in the order of the key schema. inner_column_ids are the
+  // columns of the inner table that are joined to the outer columns.
+  IndexNestedLoopJoinPlan(
+      PelotonJoinType join_type,
+      std::unique_ptr<const expression::AbstractExpression> &&predicate,
+      std::unique_ptr<const ProjectInfo> &&proj_info,
+      std::shared_ptr<const catalog::Schema> &proj_schema,
+      storage::DataTable *inner_table, std::shared_ptr<index::Index> index,
+      const std::vector<oid_t> &outer_key_column_ids,
+      const std::vector<oid_t> &inner_column_ids);
+
+  inline PlanNodeType GetPlanNodeType() const {
+    return PLAN_NODE_TYPE_NESTLOOPINDEX;
+  }
+
+  const std::string GetInfo() const { return "IndexNestedLoopJoin"; }
+
+  storage::DataTable *GetInnerTable() const { return inner_table_; }
+
+  std::shared_ptr<index::Index> GetIndex() const { return index_; }
+
+  const std::vector<oid_t> &GetOuterKeyColumnIds() const {
+    return outer_key_column_ids_;
+  }
+
+  const std::vector<oid_t> &GetInnerColumnIds() const {
+    return inner_column_ids_;
+  }
+
+  std::unique_ptr<AbstractPlan> Copy() const;
+
+ private:
+  storage::DataTable *inner_table_;
+
+  std::shared_ptr<index::Index> index_;
+
+  std::vector<oid_t> outer_key_column_ids_;
+
+  std::vector<oid_t> inner_column_ids_;
+};
+
+}  // namespace planner
+}  // namespace peloton
@@ -68,6 +68,15 @@ class IndexScanPlan : public AbstractScan {
           value_list(p_value_list),
           runtime_key_list(p_runtime_key_list) {}
 
+    /*
+     * Constructor - for a scan of a list of point keys (an IN list)
+     *
+     * Every key has a value per column of the index key schema
+     */
+    IndexScanDesc(std::shared_ptr<index::Index> p_index_obj,
+                  const std::vector<std::vector<common::Value>> &p_key_list)
+        : index_obj(p_index_obj), key_list(p_key_list) {}
+
     ~IndexScanDesc() {
       // for (auto val : value_list)
       //  delete val;
@@ -95,6 +104,10 @@ class IndexScanPlan : public AbstractScan {
 
     // ???
     std::vector<expression::AbstractExpression *> runtime_key_list;
+
+    // A list of point keys that are looked up in one batch. If it is not
+    // empty, the column, expression and value lists are not used
+    std::vector<std::vector<common::Value>> key_list;
   };
 
   ///////////////////////////////////////////////////////////////////
@@ -135,6 +148,10 @@ class IndexScanPlan : public AbstractScan {
 
   const std::vector<common::Value> &GetValues() const { return values_; }
 
+  const std::vector<std::vector<common::Value>> &GetKeyList() const {
+    return key_list_;
+  }
+
   const std::vector<expression::AbstractExpression *> &GetRunTimeKeys() const {
     return runtime_keys_;
   }
@@ -155,6 +172,7 @@ class IndexScanPlan : public AbstractScan {
 
     IndexScanDesc desc(index_, key_column_ids_, expr_types_, values_,
                        new_runtime_keys);
+    desc.key_list = key_list_;
     IndexScanPlan *new_plan = new IndexScanPlan(
         GetTable(), GetPredicate()->Copy(), GetColumnIds(), desc, false);
     return std::unique_ptr<AbstractPlan>(new_plan);
@@ -190,6 +208,9 @@ class IndexScanPlan : public AbstractScan {
 
   const std::vector<expression::AbstractExpression *> runtime_keys_;
 
+  // point keys of an IN list
+  const std::vector<std::vector<common::Value>> key_list_;
+
   // Currently we just support single conjunction predicate
   //
   // In the future this might be extended into an array of conjunctive
@@ -49,7 +49,7 @@ class BackendStatsContext {
  public:
   static BackendStatsContext* GetInstance();
 
-  BackendStatsContext(size_t max_latency_history, bool regiser_to_aggregator);
+  BackendStatsContext(bool regiser_to_aggregator);
   ~BackendStatsContext();
 
   //===--------------------------------------------------------------------===//
@@ -80,6 +80,12 @@ class BackendStatsContext {
   // Returns the latency metric
   LatencyMetric& GetTxnLatencyMetric();
 
+  // Returns the latency metric of the queries of the given type
+  LatencyMetric& GetQueryLatencyMetric(QueryLatencyType query_type);
+
+  // Returns the latency metric of the log flushes
+  LatencyMetric& GetLogFlushLatencyMetric();
+
   // Increment the read stat for given tile group
   void IncrementTableReads(oid_t tile_group_id);
 
@@ -156,6 +162,10 @@ class BackendStatsContext {
   // Index oid spin lock
   Spinlock index_id_lock;
 
+  // Protects the database and table metric maps while the aggregator reads
+  // them. Only taken to add a metric, not to update one.
+  Spinlock metrics_lock_;
+
   // Metrics for completed queries
   LockFreeQueue<std::shared_ptr<QueryMetric>> completed_query_metrics_{
       QUERY_METRIC_QUEUE_SIZE};
@@ -174,6 +184,12 @@ class BackendStatsContext {
   // Latencies recorded by this worker
   LatencyMetric txn_latencies_;
 
+  // Query latencies recorded by this worker, per query type
+  std::unique_ptr<LatencyMetric> query_latencies_[QUERY_LATENCY_TYPE_COUNT];
+
+  // Log flush latencies recorded by this worker
+  LatencyMetric log_flush_latencies_;
+
   // Whether this context is registered to the global aggregator
   bool is_registered_to_aggregator_;
 
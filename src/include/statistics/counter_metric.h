@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <sstream>
 
@@ -23,33 +24,44 @@ namespace stats {
 
 /**
  * Metric as a counter. E.g. # txns committed, # tuples read, etc.
+ * A counter has a single writer, the aggregator reads it concurrently
+ * without any lock.
  */
 class CounterMetric : public AbstractMetric {
  public:
   CounterMetric(MetricType type);
 
+  CounterMetric(const CounterMetric &other)
+      : AbstractMetric(other.GetType()), count_(other.count_.load()) {}
+
   //===--------------------------------------------------------------------===//
   // ACCESSORS
   //===--------------------------------------------------------------------===//
 
-  inline void Increment() { count_++; }
+  inline void Increment() { Increment(1); }
 
-  inline void Increment(int64_t count) { count_ += count; }
+  inline void Increment(int64_t count) {
+    count_.store(count_.load(std::memory_order_relaxed) + count,
+                 std::memory_order_relaxed);
+  }
 
-  inline void Decrement() { count_--; }
+  inline void Decrement() { Increment(-1); }
 
-  inline void Decrement(int64_t count) { count_ -= count; }
+  inline void Decrement(int64_t count) { Increment(-count); }
 
   //===--------------------------------------------------------------------===//
   // HELPER METHODS
   //===--------------------------------------------------------------------===//
 
-  inline void Reset() { count_ = 0; }
+  inline void Reset() { count_.store(0, std::memory_order_relaxed); }
 
-  inline int64_t GetCounter() { return count_; }
+  inline int64_t GetCounter() {
+    return count_.load(std::memory_order_relaxed);
+  }
 
   inline bool operator==(const CounterMetric &other) {
-    return count_ == other.count_;
+    return count_.load(std::memory_order_relaxed) ==
+           other.count_.load(std::memory_order_relaxed);
   }
 
   inline bool operator!=(const CounterMetric &other) {
@@ -62,7 +74,7 @@ class CounterMetric : public AbstractMetric {
   // Returns a string representation of this counter
   inline const std::string GetInfo() const {
     std::stringstream ss;
-    ss << count_;
+    ss << count_.load(std::memory_order_relaxed);
     return ss.str();
   }
 
@@ -71,8 +83,9 @@ class CounterMetric : public AbstractMetric {
   // MEMBERS
   //===--------------------------------------------------------------------===//
 
-  // The current count
-  int64_t count_;
+  // The current count, a plain load and store since there is a single
+  // writer
+  std::atomic<int64_t> count_;
 };
 
 }  // namespace stats
@@ -0,0 +1,126 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// latency_histogram.h
+//
+// Identification: src/include/statistics/latency_histogram.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace peloton {
+namespace stats {
+
+//===--------------------------------------------------------------------===//
+// Latency Histogram
+//===--------------------------------------------------------------------===//
+
+// log-linear histogram of latencies in microseconds. values below
+// LINEAR_BUCKET_COUNT have a bucket each, larger values are split into powers
+// of two, each of which is divided into LINEAR_BUCKET_COUNT buckets. a
+// bucket is at most ~3% wide relative to its values.
+//
+// a histogram has a single writer, the thread that owns it, which records
+// without locks or atomic read-modify-writes. other threads, e.g., the
+// aggregator, may read it or merge it concurrently.
+class LatencyHistogram {
+ public:
+  LatencyHistogram(const LatencyHistogram &) = delete;
+  LatencyHistogram &operator=(const LatencyHistogram &) = delete;
+
+  LatencyHistogram() { Reset(); }
+
+  // only called by the owner
+  inline void Record(const uint64_t &latency) {
+    auto bucket = GetBucket(latency);
+    Increment(counts_[bucket], 1);
+    Increment(count_, 1);
+    Increment(total_, latency);
+    if (latency < min_.load(std::memory_order_relaxed)) {
+      min_.store(latency, std::memory_order_relaxed);
+    }
+    if (latency > max_.load(std::memory_order_relaxed)) {
+      max_.store(latency, std::memory_order_relaxed);
+    }
+  }
+
+  // add the latencies of the source to this histogram. only called by the
+  // owner of this histogram.
+  void Merge(const LatencyHistogram &source);
+
+  // add the latencies the source recorded since the previous call to this
+  // histogram, and remember them in collected. the min and max of those
+  // latencies are only known up to their buckets. only called by the owner
+  // of this histogram, who also owns collected.
+  void MergeSince(const LatencyHistogram &source,
+                  LatencyHistogram &collected);
+
+  void Reset();
+
+  inline uint64_t GetCount() const {
+    return count_.load(std::memory_order_relaxed);
+  }
+
+  inline uint64_t GetMin() const {
+    return GetCount() == 0 ? 0 : min_.load(std::memory_order_relaxed);
+  }
+
+  inline uint64_t GetMax() const { return max_.load(std::memory_order_relaxed); }
+
+  double GetAverage() const;
+
+  // the smallest latency that is at least as large as the given fraction of
+  // the latencies, e.g., 0.99 for the 99th percentile. the bucket is
+  // reported by its largest value, capped by the max.
+  uint64_t GetPercentile(const double &fraction) const;
+
+  // buckets of the values
+  static size_t GetBucket(const uint64_t &latency);
+
+  // smallest value of the bucket
+  static uint64_t GetBucketLowerBound(const size_t &bucket);
+
+  // largest value of the bucket
+  static uint64_t GetBucketUpperBound(const size_t &bucket);
+
+ public:
+  static const size_t LINEAR_BUCKET_BITS = 5;
+
+  static const size_t LINEAR_BUCKET_COUNT = 1 << LINEAR_BUCKET_BITS;
+
+  // latencies above 2^MAX_LATENCY_BITS us (~12 days) share the last bucket
+  static const size_t MAX_LATENCY_BITS = 40;
+
+  static const size_t BUCKET_COUNT =
+      LINEAR_BUCKET_COUNT * (MAX_LATENCY_BITS - LINEAR_BUCKET_BITS + 1);
+
+ private:
+  // single writer, so a plain load and store is enough
+  static inline void Increment(std::atomic<uint64_t> &counter,
+                               const uint64_t &delta) {
+    counter.store(counter.load(std::memory_order_relaxed) + delta,
+                  std::memory_order_relaxed);
+  }
+
+ private:
+  std::atomic<uint64_t> counts_[BUCKET_COUNT];
+
+  std::atomic<uint64_t> count_;
+
+  std::atomic<uint64_t> total_;
+
+  std::atomic<uint64_t> min_;
+
+  std::atomic<uint64_t> max_;
+};
+
+}  // namespace stats
+}  // namespace peloton
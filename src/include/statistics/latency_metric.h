@@ -19,101 +19,116 @@
 #include "common/macros.h"
 #include "common/types.h"
 #include "common/exception.h"
-#include "container/circular_buffer.h"
 #include "statistics/abstract_metric.h"
-#include <mutex>
+#include "statistics/latency_histogram.h"
 
 namespace peloton {
 namespace stats {
 
-// Container for different latency measurements
+// Container for different latency measurements, in milliseconds
 struct LatencyMeasurements {
+  uint64_t count_ = 0;
   double average_ = 0.0;
   double min_ = 0.0;
   double max_ = 0.0;
   double median_ = 0.0;
-  double perc_25th_ = 0.0;
-  double perc_75th_ = 0.0;
   double perc_99th_ = 0.0;
+  double perc_999th_ = 0.0;
 };
 
 /**
- * Metric for storing raw latency values and computing
+ * Timer for a single latency measurement
+ */
+class LatencyTimer {
+ public:
+  // Starts the timer for the next latency measurement
+  inline void StartTimer() {
+    timer_us_.Reset();
+    timer_us_.Start();
+  }
+
+  // Stops the latency timer and records the total time elapsed
+  inline void RecordLatency() { timer_us_.Stop(); }
+
+  // Returns the latency in microseconds
+  inline uint64_t GetLatency() const {
+    return (uint64_t)timer_us_.GetDuration();
+  }
+
+ private:
+  Timer<std::ratio<1, 1000000>> timer_us_;
+};
+
+/**
+ * Metric for recording latencies into a histogram and computing
  * latency measurements.
  */
 class LatencyMetric : public AbstractMetric {
  public:
-  LatencyMetric(MetricType type, size_t max_history);
+  LatencyMetric(MetricType type, const std::string &name);
 
   //===--------------------------------------------------------------------===//
   // HELPER METHODS
   //===--------------------------------------------------------------------===//
 
   inline void Reset() {
-    latencies_.Clear();
-    timer_ms_.Reset();
+    latencies_.Reset();
+    collected_.Reset();
+    latency_measurements_ = LatencyMeasurements();
   }
 
   // Starts the timer for the next latency measurement
-  inline void StartTimer() {
-    timer_ms_.Reset();
-    timer_ms_.Start();
-  }
+  inline void StartTimer() { timer_.StartTimer(); }
 
   // Stops the latency timer and records the total time elapsed
   inline void RecordLatency() {
-    timer_ms_.Stop();
-    double latency_value = timer_ms_.GetDuration();
-    // Record this latency only if we can do so without blocking.
-    // Occasionally losing single latency measurements is fine.
-    {
-      std::unique_lock<std::mutex> lock(latency_mutex_, std::defer_lock);
-      if (lock.try_lock()) {
-        latencies_.PushBack(latency_value);
-      }
-    }
+    timer_.RecordLatency();
+    latencies_.Record(timer_.GetLatency());
+  }
+
+  // Records a latency measured elsewhere, in microseconds
+  inline void RecordLatency(const uint64_t &latency) {
+    latencies_.Record(latency);
   }
 
-  // Returns the first latency value recorded
-  inline double GetFirstLatencyValue() {
-    PL_ASSERT(latencies_.begin() != latencies_.end());
-    return *(latencies_.begin());
+  inline const LatencyHistogram &GetHistogram() const { return latencies_; }
+
+  // Returns the result of the last call to ComputeLatencies()
+  inline const LatencyMeasurements &GetMeasurements() const {
+    return latency_measurements_;
   }
 
   // Computes the latency measurements using the latencies
   // collected so far.
   void ComputeLatencies();
 
-  // Combines the source latency metric with this latency metric
+  // Combines the latencies the source recorded since it was last aggregated
+  // with this latency metric
   void Aggregate(AbstractMetric &source);
 
   // Returns a string representation of this latency metric
   const std::string GetInfo() const;
 
-  // Returns a copy of the latencies collected
-  CircularBuffer<double> Copy();
-
  private:
   //===--------------------------------------------------------------------===//
   // MEMBERS
   //===--------------------------------------------------------------------===//
 
-  // Circular buffer with capacity N that stores the <= N
-  // most recent latencies collected
-  CircularBuffer<double> latencies_;
+  // Name printed by GetInfo()
+  std::string name_;
+
+  // Histogram of all latencies recorded, only written by the owning thread
+  LatencyHistogram latencies_;
+
+  // Latencies already handed to an aggregation, only written by the
+  // aggregating thread
+  LatencyHistogram collected_;
 
   // Timer for timing individual latencies
-  Timer<std::ratio<1, 1000>> timer_ms_;
+  LatencyTimer timer_;
 
   // Stores result of last call to ComputeLatencies()
   LatencyMeasurements latency_measurements_;
-
-  // The maximum number of latencies that can be stored
-  // (the capacity size N of the circular buffer)
-  size_t max_history_;
-
-  // Protects accesses to the circular buffer
-  std::mutex latency_mutex_;
 };
 
 }  // namespace stats
@@ -0,0 +1,83 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// metric_series.h
+//
+// Identification: src/include/statistics/metric_series.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "common/platform.h"
+#include "common/value.h"
+
+namespace peloton {
+
+namespace storage {
+class DataTable;
+}
+
+namespace stats {
+
+// a row of a metric table, a value per column of its schema
+typedef std::vector<common::Value> MetricRow;
+
+//===--------------------------------------------------------------------===//
+// Metric Series
+//===--------------------------------------------------------------------===//
+
+// the rows of a metric table as a fixed size ring buffer. the aggregator
+// appends the rows of every interval, which overwrite the oldest rows once
+// the series is full. the metric tables in the catalog are virtual, a scan of
+// one of them reads its series, so aggregating never runs a transaction and
+// the series never grows.
+class MetricSeries {
+ public:
+  MetricSeries(const MetricSeries &) = delete;
+  MetricSeries &operator=(const MetricSeries &) = delete;
+
+  explicit MetricSeries(const size_t &capacity);
+
+  // the series of the metric table with the given name, nullptr if there is
+  // no such metric table
+  static MetricSeries *GetInstance(const std::string &table_name);
+
+  // the series of the given table, nullptr if it is not a metric table
+  static MetricSeries *GetInstance(const storage::DataTable *table);
+
+  // append a row, dropping the oldest one if the series is full
+  void Append(MetricRow &&row);
+
+  // copy of the rows, the oldest first
+  std::vector<MetricRow> GetRows() const;
+
+  // number of rows in the series
+  size_t GetSize() const;
+
+  inline size_t GetCapacity() const { return rows_.size(); }
+
+  // number of rows appended so far, including the dropped ones
+  uint64_t GetAppendCount() const;
+
+  void Clear();
+
+ private:
+  std::vector<MetricRow> rows_;
+
+  // the next row goes to next_ % capacity
+  uint64_t next_ = 0;
+
+  // only held to copy a row in or out, never by the worker threads
+  mutable Spinlock rows_lock_;
+};
+
+}  // namespace stats
+}  // namespace peloton
@@ -28,6 +28,16 @@ namespace stats {
 // Same type defined in wire/marshal.h
 typedef unsigned char uchar;
 
+// The query types whose latencies are tracked separately
+enum QueryLatencyType {
+  QUERY_LATENCY_TYPE_SELECT = 0,
+  QUERY_LATENCY_TYPE_INSERT = 1,
+  QUERY_LATENCY_TYPE_UPDATE = 2,
+  QUERY_LATENCY_TYPE_DELETE = 3,
+  QUERY_LATENCY_TYPE_OTHER = 4,
+  QUERY_LATENCY_TYPE_COUNT = 5
+};
+
 /**
  * Metric for the access of a query
  */
@@ -64,7 +74,8 @@ class QueryMetric : public AbstractMetric {
 
   QueryMetric(MetricType type, const std::string &query_name,
               std::shared_ptr<QueryParams> query_params,
-              const oid_t database_id);
+              const oid_t database_id,
+              QueryLatencyType query_type = QUERY_LATENCY_TYPE_OTHER);
 
   //===--------------------------------------------------------------------===//
   // ACCESSORS
@@ -72,7 +83,7 @@ class QueryMetric : public AbstractMetric {
 
   inline AccessMetric &GetQueryAccess() { return query_access_; }
 
-  inline LatencyMetric &GetQueryLatency() { return latency_metric_; }
+  inline LatencyTimer &GetQueryLatency() { return latency_timer_; }
 
   inline ProcessorMetric &GetProcessorMetric() { return processor_metric_; }
 
@@ -80,6 +91,17 @@ class QueryMetric : public AbstractMetric {
 
   inline oid_t GetDatabaseId() const { return database_id_; }
 
+  inline QueryLatencyType GetQueryType() const { return query_type_; }
+
+  // The plan annotated with the runtime statistics of its executors
+  inline const std::string &GetOperatorProfile() const {
+    return operator_profile_;
+  }
+
+  inline void SetOperatorProfile(const std::string &operator_profile) {
+    operator_profile_ = operator_profile;
+  }
+
   inline std::shared_ptr<QueryParams> const GetQueryParams() {
     return query_params_;
   }
@@ -118,8 +140,14 @@ class QueryMetric : public AbstractMetric {
   // The number of tuple accesses
   AccessMetric query_access_{ACCESS_METRIC};
 
-  // Latency metric
-  LatencyMetric latency_metric_{LATENCY_METRIC, 2};
+  // The type of this query
+  QueryLatencyType query_type_;
+
+  // Latency of this query
+  LatencyTimer latency_timer_;
+
+  // The profile of the executors of this query
+  std::string operator_profile_;
 
   // Processor metric
   ProcessorMetric processor_metric_{PROCESSOR_METRIC};
@@ -23,10 +23,12 @@
 
 #include "common/logger.h"
 #include "common/macros.h"
+#include "common/wait_event.h"
 #include "statistics/backend_stats_context.h"
 #include "storage/database.h"
 #include "storage/data_table.h"
 #include "concurrency/transaction.h"
+#include "wire/query_execution_pool.h"
 
 //===--------------------------------------------------------------------===//
 // GUC Variables
@@ -34,8 +36,6 @@
 
 #define STATS_AGGREGATION_INTERVAL_MS 1000
 #define STATS_LOG_INTERVALS 10
-#define LATENCY_MAX_HISTORY_THREAD 100
-#define LATENCY_MAX_HISTORY_AGGREGATOR 10000
 
 class BackendStatsContext;
 
@@ -128,6 +128,16 @@ class StatsAggregator {
 
   int64_t total_prev_txn_committed_;
 
+  // Wait totals at the previous aggregation
+  uint64_t prev_wait_count_[WAIT_CLASS_COUNT] = {};
+
+  uint64_t prev_wait_time_ns_[WAIT_CLASS_COUNT] = {};
+
+  // Query execution pool totals at the previous aggregation
+  uint64_t prev_stage_count_[wire::EXECUTION_STAGE_COUNT] = {};
+
+  uint64_t prev_stage_latency_[wire::EXECUTION_STAGE_COUNT] = {};
+
   // Stats aggregator background thread
   std::thread aggregator_thread_;
 
@@ -154,16 +164,25 @@ class StatsAggregator {
   void UpdateMetrics();
 
   // Update the table metrics with a given database
-  void UpdateTableMetrics(storage::Database *database, int64_t time_stamp,
-                          concurrency::Transaction *txn);
+  void UpdateTableMetrics(storage::Database *database, int64_t time_stamp);
 
   // Update the index metrics with a given table
   void UpdateIndexMetrics(storage::Database *database,
-                          storage::DataTable *table, int64_t time_stamp,
-                          concurrency::Transaction *txn);
+                          storage::DataTable *table, int64_t time_stamp);
 
   // Write all query metrics to a metric table
-  void UpdateQueryMetrics(int64_t time_stamp, concurrency::Transaction *txn);
+  void UpdateQueryMetrics(int64_t time_stamp);
+
+  // Write the waits since the previous aggregation to a metric table
+  void UpdateWaitMetrics(int64_t time_stamp);
+
+  // Write the query execution pool stages since the previous aggregation to a
+  // metric table
+  void UpdateExecutionMetrics(int64_t time_stamp);
+
+  // Append the tuple to the series of the given metric table
+  void AppendMetricRow(const std::string &table_name,
+                       std::unique_ptr<storage::Tuple> tuple);
 
   // Aggregate stats periodically
   void RunAggregator();
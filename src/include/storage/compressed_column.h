@@ -0,0 +1,205 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compressed_column.h
+//
+// Identification: src/include/storage/compressed_column.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "common/types.h"
+#include "common/value.h"
+
+namespace peloton {
+namespace storage {
+
+//===--------------------------------------------------------------------===//
+// Bit-Packed Vector
+//===--------------------------------------------------------------------===//
+
+// fixed-width unsigned integers packed into 64-bit words.
+class BitPackedVector {
+ public:
+  BitPackedVector() : bit_width_(0), mask_(0), size_(0) {}
+
+  BitPackedVector(const size_t &size, const uint64_t &max_value);
+
+  inline uint64_t Get(const oid_t &offset) const {
+    if (bit_width_ == 0) {
+      return 0;
+    }
+    size_t bit_offset = offset * bit_width_;
+    size_t word_offset = bit_offset / 64;
+    size_t word_bit_offset = bit_offset % 64;
+
+    uint64_t value = words_[word_offset] >> word_bit_offset;
+    if (word_bit_offset + bit_width_ > 64) {
+      value |= words_[word_offset + 1] << (64 - word_bit_offset);
+    }
+    return value & mask_;
+  }
+
+  void Set(const oid_t &offset, const uint64_t &value);
+
+  size_t GetBitWidth() const { return bit_width_; }
+
+  size_t GetSize() const { return words_.size() * sizeof(uint64_t); }
+
+ private:
+  size_t bit_width_;
+
+  uint64_t mask_;
+
+  size_t size_;
+
+  std::vector<uint64_t> words_;
+};
+
+//===--------------------------------------------------------------------===//
+// Compressed Column
+//===--------------------------------------------------------------------===//
+
+/**
+ * An immutable, compressed copy of one column of a frozen tile.
+ *
+ * Predicates of the form "column <comparison> constant" can be evaluated
+ * directly on the compressed form, i.e., once per distinct value or run, or on
+ * the packed integers, without materializing the values.
+ */
+class CompressedColumn {
+ public:
+  CompressedColumn(const CompressedColumn &) = delete;
+  CompressedColumn &operator=(const CompressedColumn &) = delete;
+
+  virtual ~CompressedColumn() {}
+
+  virtual CompressionType GetCompressionType() const = 0;
+
+  virtual common::Value GetValue(const oid_t &tuple_offset) const = 0;
+
+  // clear the entries of the tuples whose value does not satisfy
+  // "value <comparison_type> constant". entries that are already cleared are
+  // left untouched.
+  virtual void Evaluate(const ExpressionType &comparison_type,
+                        const common::Value &constant,
+                        std::vector<bool> &matches) const = 0;
+
+  // bytes occupied by the compressed column
+  virtual size_t GetSize() const = 0;
+
+  common::Type::TypeId GetValueType() const { return value_type_; }
+
+  oid_t GetTupleCount() const { return tuple_count_; }
+
+  // compress the values of a column with the encoding that takes the least
+  // space.
+  static CompressedColumn *Compress(const std::vector<common::Value> &values,
+                                    const common::Type::TypeId &value_type);
+
+  // same semantics as the comparison expression
+  static bool Compare(const common::Value &value,
+                      const ExpressionType &comparison_type,
+                      const common::Value &constant);
+
+ protected:
+  CompressedColumn(const common::Type::TypeId &value_type,
+                   const oid_t &tuple_count)
+      : value_type_(value_type), tuple_count_(tuple_count) {}
+
+  static size_t GetValueSize(const common::Value &value);
+
+  common::Type::TypeId value_type_;
+
+  oid_t tuple_count_;
+};
+
+// low-cardinality columns: every value is replaced by a bit-packed code into
+// the array of distinct values.
+class DictionaryCompressedColumn : public CompressedColumn {
+ public:
+  DictionaryCompressedColumn(const std::vector<common::Value> &values,
+                             const common::Type::TypeId &value_type);
+
+  CompressionType GetCompressionType() const override {
+    return COMPRESSION_TYPE_DICTIONARY;
+  }
+
+  common::Value GetValue(const oid_t &tuple_offset) const override;
+
+  void Evaluate(const ExpressionType &comparison_type,
+                const common::Value &constant,
+                std::vector<bool> &matches) const override;
+
+  size_t GetSize() const override;
+
+ private:
+  std::vector<common::Value> dictionary_;
+
+  BitPackedVector codes_;
+};
+
+// sorted or repeated columns: every run of equal values is stored once.
+class RunLengthCompressedColumn : public CompressedColumn {
+ public:
+  RunLengthCompressedColumn(const std::vector<common::Value> &values,
+                            const common::Type::TypeId &value_type);
+
+  CompressionType GetCompressionType() const override {
+    return COMPRESSION_TYPE_RUN_LENGTH;
+  }
+
+  common::Value GetValue(const oid_t &tuple_offset) const override;
+
+  void Evaluate(const ExpressionType &comparison_type,
+                const common::Value &constant,
+                std::vector<bool> &matches) const override;
+
+  size_t GetSize() const override;
+
+ private:
+  std::vector<common::Value> run_values_;
+
+  // offset following the last tuple of each run
+  std::vector<oid_t> run_ends_;
+};
+
+// integer columns without nulls: every value is stored as a bit-packed offset
+// from the minimum value of the column.
+class FrameOfReferenceCompressedColumn : public CompressedColumn {
+ public:
+  FrameOfReferenceCompressedColumn(const std::vector<common::Value> &values,
+                                   const common::Type::TypeId &value_type);
+
+  CompressionType GetCompressionType() const override {
+    return COMPRESSION_TYPE_FRAME_OF_REFERENCE;
+  }
+
+  common::Value GetValue(const oid_t &tuple_offset) const override;
+
+  void Evaluate(const ExpressionType &comparison_type,
+                const common::Value &constant,
+                std::vector<bool> &matches) const override;
+
+  size_t GetSize() const override;
+
+  // whether the values can be encoded, i.e., they are non-null integers
+  static bool IsEncodable(const std::vector<common::Value> &values,
+                          const common::Type::TypeId &value_type);
+
+  static bool GetIntegerValue(const common::Value &value, int64_t &result);
+
+ private:
+  int64_t reference_;
+
+  BitPackedVector offsets_;
+};
+
+}  // End storage namespace
+}  // End peloton namespace
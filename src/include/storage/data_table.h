@@ -23,6 +23,7 @@
 #include "index/index.h"
 #include "storage/abstract_table.h"
 #include "storage/indirection_array.h"
+#include "storage/shared_scan.h"
 
 //===--------------------------------------------------------------------===//
 // GUC Variables
@@ -83,6 +84,7 @@ class DataTable : public AbstractTable {
   friend class TileGroup;
   friend class TileGroupFactory;
   friend class TableFactory;
+  friend class TileGroupPreallocator;
   friend class logging::LogManager;
 
   DataTable() = delete;
@@ -188,6 +190,8 @@ class DataTable : public AbstractTable {
   storage::TileGroup *TransformTileGroup(const oid_t &tile_group_offset,
                                          const double &theta);
 
+  storage::TileGroup *CompressTileGroup(const oid_t &tile_group_offset);
+
   //===--------------------------------------------------------------------===//
   // STATS
   //===--------------------------------------------------------------------===//
@@ -216,6 +220,8 @@ class DataTable : public AbstractTable {
 
   void SetDefaultLayout(const column_map_type &layout);
 
+  const column_map_type &GetDefaultLayout() const { return default_partition_; }
+
   //===--------------------------------------------------------------------===//
   // INDEX TUNER
   //===--------------------------------------------------------------------===//
@@ -226,6 +232,45 @@ class DataTable : public AbstractTable {
 
   void ClearIndexSamples();
 
+  //===--------------------------------------------------------------------===//
+  // VERSION STORAGE
+  //===--------------------------------------------------------------------===//
+
+  VersionStorageType GetVersionStorageType() const {
+    return version_storage_type_;
+  }
+
+  // the order of the version chains can only be changed while the table holds
+  // no version. false if it does.
+  bool SetVersionStorageType(const VersionStorageType &version_storage_type);
+
+  //===--------------------------------------------------------------------===//
+  // VERSION RETENTION
+  //===--------------------------------------------------------------------===//
+
+  // seconds for which the gc keeps the expired versions for historical reads
+  size_t GetVersionRetention() const { return version_retention_.load(); }
+
+  void SetVersionRetention(const size_t &version_retention) {
+    version_retention_ = version_retention;
+  }
+
+  // whether the gc has kept all the versions visible at the commit id
+  bool IsSnapshotRetained(const cid_t &snapshot_cid) const {
+    return snapshot_cid >= expired_cid_.load();
+  }
+
+  // called by the gc before it unlinks the versions that expired at the
+  // commit id
+  void RaiseExpiredCid(const cid_t &expired_cid);
+
+  //===--------------------------------------------------------------------===//
+  // SHARED SCANS
+  //===--------------------------------------------------------------------===//
+
+  // cursor of the sequential scans running over the table
+  SharedScan &GetSharedScan() { return shared_scan_; }
+
   //===--------------------------------------------------------------------===//
   // UTILITIES
   //===--------------------------------------------------------------------===//
@@ -273,11 +318,42 @@ class DataTable : public AbstractTable {
   // add a tile group to the table
   oid_t AddDefaultTileGroup();
   // add a tile group to the table. replace the active_tile_group_id-th active
-  // tile group.
+  // tile group. the preallocated standby tile group of the slot is used if
+  // available.
   oid_t AddDefaultTileGroup(const size_t &active_tile_group_id);
 
+  // build the standby tile group of the active_tile_group_id-th active tile
+  // group. invoked by the tile group preallocator.
+  void PreallocateTileGroup(const size_t &active_tile_group_id);
+
+  // the active tile group (and indirection array) slot of the calling thread.
+  // each worker thread takes the lowest free slot when it first inserts, and
+  // frees it when it exits.
+  static size_t GetThreadSlot();
+
   oid_t AddDefaultIndirectionArray(const size_t &active_indirection_array_id);
 
+  bool IsActiveTileGroup(const storage::TileGroup *tile_group) const;
+
+  //===--------------------------------------------------------------------===//
+  // ONLINE TILE GROUP REBUILDING
+  //===--------------------------------------------------------------------===//
+
+  std::shared_ptr<storage::TileGroup> GetFrozenTileGroup(
+      const oid_t &tile_group_offset);
+
+  bool LockTileGroup(concurrency::Transaction *txn,
+                     storage::TileGroup *tile_group);
+
+  void UnlockTileGroup(concurrency::Transaction *txn,
+                       storage::TileGroup *tile_group,
+                       const oid_t &locked_tuple_count);
+
+  void ReplaceTileGroup(
+      concurrency::Transaction *txn,
+      const std::shared_ptr<storage::TileGroup> &tile_group,
+      const std::shared_ptr<storage::TileGroup> &new_tile_group);
+
   // get a partitioning with given layout type
   column_map_type GetTileGroupLayout(LayoutType layout_type);
 
@@ -313,6 +389,10 @@ class DataTable : public AbstractTable {
 
   std::vector<std::shared_ptr<storage::TileGroup>> active_tile_groups_;
 
+  // the next tile group of each active tile group slot, built in the
+  // background. accessed with atomic shared_ptr operations.
+  std::vector<std::shared_ptr<storage::TileGroup>> standby_tile_groups_;
+
   std::atomic<size_t> tile_group_count_ = ATOMIC_VAR_INIT(0);
 
   // INDIRECTIONS
@@ -344,6 +424,19 @@ class DataTable : public AbstractTable {
   // dirty flag. for detecting whether the tile group has been used.
   bool dirty_ = false;
 
+  // order of the version chains, from the version the indirection points to
+  VersionStorageType version_storage_type_ =
+      VERSION_STORAGE_TYPE_NEWEST_TO_OLDEST;
+
+  // retention of the expired versions, in seconds
+  std::atomic<size_t> version_retention_ = ATOMIC_VAR_INIT(0);
+
+  // latest commit id at which the gc has unlinked expired versions
+  std::atomic<cid_t> expired_cid_ = ATOMIC_VAR_INIT(INVALID_CID);
+
+  // where the concurrent sequential scans attach
+  SharedScan shared_scan_;
+
   //===--------------------------------------------------------------------===//
   // TUNING MEMBERS
   //===--------------------------------------------------------------------===//
@@ -14,8 +14,8 @@
 #pragma once
 
 #include <iostream>
-#include <mutex>
 
+#include "catalog/catalog_cache.h"
 #include "common/printable.h"
 #include "storage/data_table.h"
 
@@ -84,9 +84,7 @@ class Database : public Printable {
   std::string database_name;
 
   // TABLES
-  std::vector<storage::DataTable *> tables;
-
-  std::mutex database_mutex;
+  catalog::CatalogCache<storage::DataTable> tables;
 };
 
 }  // End storage namespace
@@ -0,0 +1,108 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// shared_scan.h
+//
+// Identification: src/include/storage/shared_scan.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+
+#include "common/types.h"
+
+namespace peloton {
+namespace storage {
+
+//===--------------------------------------------------------------------===//
+// Shared Scan
+//===--------------------------------------------------------------------===//
+
+/**
+ * Cursor of the sequential scans running over a table.
+ *
+ * A scan that starts while others are running attaches at the tile group they
+ * are reading, scans up to the end of the table and wraps around to the tile
+ * groups it missed. The concurrent scans then move over the table together
+ * and read each tile group about once from memory, instead of once per scan.
+ *
+ * The cursor only decides where the scans start, each scan still checks the
+ * visibility of the tuples for its own transaction.
+ */
+class SharedScan {
+ public:
+  SharedScan(const SharedScan &) = delete;
+  SharedScan &operator=(const SharedScan &) = delete;
+
+  SharedScan() {}
+
+  // attach a scan over the given number of tile groups, returns the offset
+  // of the tile group it starts at
+  oid_t Attach(const oid_t &tile_group_count) {
+    if (scan_count_++ == 0) {
+      // no scan to join, start from the beginning
+      position_ = START_OID;
+      return START_OID;
+    }
+    auto position = position_.load();
+    return (position < tile_group_count) ? position : START_OID;
+  }
+
+  void Detach() { scan_count_--; }
+
+  // an attached scan moved on to the tile group
+  void SetPosition(const oid_t &tile_group_offset) {
+    position_ = tile_group_offset;
+  }
+
+  oid_t GetPosition() const { return position_.load(); }
+
+  size_t GetScanCount() const { return scan_count_.load(); }
+
+ private:
+  // offset of the tile group the attached scans read last
+  std::atomic<oid_t> position_ = ATOMIC_VAR_INIT(START_OID);
+
+  // # of attached scans
+  std::atomic<size_t> scan_count_ = ATOMIC_VAR_INIT(0);
+};
+
+// detaches a scan from its shared scan once the scan is done, or when it is
+// left by an exception
+class SharedScanGuard {
+ public:
+  SharedScanGuard(const SharedScanGuard &) = delete;
+  SharedScanGuard &operator=(const SharedScanGuard &) = delete;
+
+  SharedScanGuard() {}
+
+  ~SharedScanGuard() { Detach(); }
+
+  // attach to the shared scan, returns the offset of the tile group the scan
+  // starts at
+  oid_t Attach(SharedScan *shared_scan, const oid_t &tile_group_count) {
+    Detach();
+    shared_scan_ = shared_scan;
+    return shared_scan_->Attach(tile_group_count);
+  }
+
+  void Detach() {
+    if (shared_scan_ != nullptr) {
+      shared_scan_->Detach();
+      shared_scan_ = nullptr;
+    }
+  }
+
+  SharedScan *GetSharedScan() const { return shared_scan_; }
+
+ private:
+  SharedScan *shared_scan_ = nullptr;
+};
+
+}  // End storage namespace
+}  // End peloton namespace
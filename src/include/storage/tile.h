@@ -19,8 +19,11 @@
 #include "common/serializeio.h"
 #include "common/varlen_pool.h"
 #include "common/printable.h"
+#include "storage/compressed_column.h"
 
+#include <memory>
 #include <mutex>
+#include <vector>
 
 namespace peloton {
 namespace storage {
@@ -111,6 +114,28 @@ class Tile : public Printable {
   // Copy current tile in given backend and return new tile
   Tile *CopyTile(BackendType backend_type);
 
+  //===--------------------------------------------------------------------===//
+  // Compression
+  //===--------------------------------------------------------------------===//
+
+  /**
+   * Replace the tuple slots by compressed columns. The tile becomes read-only.
+   * Returns false (and leaves the tile untouched) if compression does not
+   * save space.
+   * NOTE : Not thread-safe, must be done before the tile is published.
+   */
+  bool Compress();
+
+  bool IsCompressed() const { return compressed_columns.empty() == false; }
+
+  // the tuple slots of a compressed tile are released. throws before they
+  // are written or read in place.
+  void CheckUncompressed() const;
+
+  const CompressedColumn *GetCompressedColumn(const oid_t column_id) const {
+    return compressed_columns[column_id].get();
+  }
+
   //===--------------------------------------------------------------------===//
   // Size Stats
   //===--------------------------------------------------------------------===//
@@ -121,7 +146,12 @@ class Tile : public Printable {
   int64_t GetUninlinedDataSize() const { return uninlined_data_size; }
 
   // Both inlined and uninlined data
-  uint32_t GetSize() const { return tile_size + uninlined_data_size; }
+  uint32_t GetSize() const {
+    if (IsCompressed()) {
+      return compressed_size;
+    }
+    return tile_size + uninlined_data_size;
+  }
 
   //===--------------------------------------------------------------------===//
   // Columns
@@ -217,6 +247,12 @@ class Tile : public Printable {
 
   oid_t column_header_size;
 
+  // compressed columns. empty if the tile is not compressed
+  std::vector<std::unique_ptr<CompressedColumn>> compressed_columns;
+
+  // space occupied by the compressed columns
+  size_t compressed_size;
+
   /**
    * NOTE : Tiles don't keep track of number of occupied slots.
    * This is maintained by shared Tile Header.
@@ -48,6 +48,8 @@ class TileGroupHeader;
 class AbstractTable;
 class TileGroupIterator;
 class RollbackSegment;
+class CompressedColumn;
+class ZoneMap;
 
 typedef std::map<oid_t, std::pair<oid_t, oid_t>> column_map_type;
 
@@ -167,6 +169,32 @@ class TileGroup : public Printable {
 
   double GetSchemaDifference(const storage::column_map_type &new_column_map);
 
+  //===--------------------------------------------------------------------===//
+  // Zone Map
+  //===--------------------------------------------------------------------===//
+
+  ZoneMap *GetZoneMap() const { return zone_map.get(); }
+
+  // recompute the zone map from the tuple slots, which tightens it after
+  // versions were removed
+  void RebuildZoneMap();
+
+  //===--------------------------------------------------------------------===//
+  // Compression
+  //===--------------------------------------------------------------------===//
+
+  // compress the tiles of the tile group. returns false if no tile could be
+  // compressed. the tile group must not be published yet.
+  bool Compress();
+
+  // whether some tile is compressed. the tuple slots of such a tile group can
+  // not be overwritten anymore.
+  bool IsCompressed() const;
+
+  // the compressed column of the given column. nullptr if the tile holding
+  // the column is not compressed.
+  const CompressedColumn *GetCompressedColumn(oid_t column_id);
+
   // Sync the contents
   void Sync();
 
@@ -206,6 +234,9 @@ class TileGroup : public Printable {
   // column to tile mapping :
   // <column offset> to <tile offset, tile column offset>
   column_map_type column_map;
+
+  // min/max of every column
+  std::unique_ptr<ZoneMap> zone_map;
 };
 
 }  // End storage namespace
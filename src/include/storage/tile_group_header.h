@@ -130,6 +130,10 @@ class TileGroupHeader : public Printable {
 
   oid_t GetActiveTupleCount();
 
+  // a tile group is frozen if all of its slots hold committed, live versions
+  // that began before frozen_cid. no transaction can be writing it.
+  bool IsFrozen(const cid_t &frozen_cid) const;
+
   //===--------------------------------------------------------------------===//
   // MVCC utilities
   //===--------------------------------------------------------------------===//
@@ -0,0 +1,130 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_preallocator.h
+//
+// Identification: src/include/storage/tile_group_preallocator.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <sched.h>
+
+#include "common/macros.h"
+#include "common/types.h"
+
+namespace peloton {
+namespace storage {
+
+class DataTable;
+
+#define MAX_PREALLOCATION_QUEUE_LENGTH 1000
+
+//===--------------------------------------------------------------------===//
+// Tile Group Preallocator
+//===--------------------------------------------------------------------===//
+
+// a request for building a standby tile group for one of the active tile
+// group slots of a table.
+struct PreallocationRequest {
+  PreallocationRequest()
+      : table_(nullptr), active_tile_group_id_(0), numa_node_(-1) {}
+  PreallocationRequest(DataTable *table, const size_t &active_tile_group_id,
+                       const int &numa_node)
+      : table_(table),
+        active_tile_group_id_(active_tile_group_id),
+        numa_node_(numa_node) {}
+
+  DataTable *table_;
+  size_t active_tile_group_id_;
+  // numa node of the thread that inserts into the slot. -1 if unknown.
+  int numa_node_;
+};
+
+// builds the next tile group of every active tile group slot in the
+// background, so that inserting threads never have to allocate (and zero out)
+// a tile group on the critical path. the allocation is performed on a cpu of
+// the numa node of the requesting thread, so that the first touch places the
+// pages close to the inserter.
+class TileGroupPreallocator {
+ public:
+  TileGroupPreallocator(const TileGroupPreallocator &) = delete;
+  TileGroupPreallocator &operator=(const TileGroupPreallocator &) = delete;
+
+  TileGroupPreallocator();
+
+  ~TileGroupPreallocator() {}
+
+  static TileGroupPreallocator &GetInstance();
+
+  void StartPreallocation();
+
+  void StopPreallocation();
+
+  bool IsRunning() const { return is_running_; }
+
+  // returns false if the background thread is not running or too far
+  // behind, in which case the caller has to allocate synchronously.
+  bool RequestTileGroup(DataTable *table, const size_t &active_tile_group_id);
+
+  // drop the pending requests of the table and wait until the tile group
+  // being built for it, if any, is done. called when the table is destroyed.
+  void CancelRequests(DataTable *table);
+
+  // numa node of the calling thread. -1 if unknown.
+  static int GetCurrentNumaNode();
+
+ private:
+  void Running();
+
+  void Preallocate(const PreallocationRequest &request);
+
+  // move the preallocation thread onto the cpus of the given numa node.
+  void BindToNumaNode(const int &numa_node);
+
+  void LoadNumaTopology();
+
+ private:
+  //===--------------------------------------------------------------------===//
+  // Data members
+  //===--------------------------------------------------------------------===//
+  volatile bool is_running_;
+
+  std::unique_ptr<std::thread> preallocation_thread_;
+
+  std::mutex preallocation_mutex_;
+
+  // protects the requests and the table being served
+  std::mutex request_mutex_;
+
+  // signaled when a request is added or the thread stops
+  std::condition_variable request_cv_;
+
+  // signaled when a request has been served
+  std::condition_variable served_cv_;
+
+  std::deque<PreallocationRequest> requests_;
+
+  // table of the request being served. nullptr if none.
+  DataTable *serving_table_;
+
+  // cpus of each numa node. empty if the machine is not numa.
+  std::vector<cpu_set_t> numa_node_cpus_;
+
+  // numa node the preallocation thread is currently bound to.
+  int current_numa_node_;
+};
+
+}  // End storage namespace
+}  // End peloton namespace
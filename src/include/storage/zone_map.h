@@ -0,0 +1,110 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// zone_map.h
+//
+// Identification: src/include/storage/zone_map.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+#include "common/platform.h"
+#include "common/types.h"
+#include "common/value.h"
+
+namespace peloton {
+namespace storage {
+
+class TileGroup;
+
+//===--------------------------------------------------------------------===//
+// Zone Map
+//===--------------------------------------------------------------------===//
+
+/**
+ * Min/max and null count of every column of a tile group.
+ *
+ * The zone map is conservative: it covers every value that has been written
+ * into the tile group, including versions that are not visible anymore. The
+ * writers only mark it stale, without taking a lock, and it is rebuilt from
+ * the tuple slots by the next reader.
+ */
+class ZoneMap {
+ public:
+  ZoneMap(const ZoneMap &) = delete;
+  ZoneMap &operator=(const ZoneMap &) = delete;
+
+  ZoneMap(TileGroup *tile_group, const oid_t &column_count);
+
+  // some value has been written into the tile group or some version has been
+  // removed from it. must be invoked after the values have been written.
+  void MarkStale() {
+    // pairs with the fence of Rebuild, either the rebuild reads the values or
+    // the zone map stays stale
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (stale_.load(std::memory_order_relaxed) == false) {
+      stale_.store(true, std::memory_order_relaxed);
+    }
+  }
+
+  bool IsStale() const { return stale_.load(); }
+
+  // recompute the zone map from the values in the tuple slots
+  void Rebuild();
+
+  // false if no value of the column can satisfy
+  // "value <comparison_type> constant"
+  bool MightSatisfy(const oid_t &column_id,
+                    const ExpressionType &comparison_type,
+                    const common::Value &constant);
+
+  //===--------------------------------------------------------------------===//
+  // Accessors
+  //===--------------------------------------------------------------------===//
+
+  // whether some non-null value has been written into the column
+  bool HasValues(const oid_t &column_id);
+
+  common::Value GetMin(const oid_t &column_id);
+
+  common::Value GetMax(const oid_t &column_id);
+
+  oid_t GetNullCount(const oid_t &column_id);
+
+ private:
+  struct ColumnZone {
+    ColumnZone() : has_values(false), null_count(0) {}
+
+    bool has_values;
+    common::Value min;
+    common::Value max;
+    oid_t null_count;
+  };
+
+  static void Widen(ColumnZone &zone, const common::Value &value);
+
+  // rebuild the zone map before reading it, if it is stale
+  void Refresh() {
+    if (IsStale() == true) {
+      Rebuild();
+    }
+  }
+
+  TileGroup *tile_group_;
+
+  std::vector<ColumnZone> zones_;
+
+  std::atomic<bool> stale_;
+
+  Spinlock zone_map_lock_;
+};
+
+}  // End storage namespace
+}  // End peloton namespace
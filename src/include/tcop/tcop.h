@@ -54,6 +54,14 @@ class TrafficCop {
       const std::vector<int> &result_format, std::vector<ResultType> &result,
       int &rows_change, std::string &error_message);
 
+  // Execute a statement once for every set of parameters, in a single
+  // transaction. The batch stops at the first failed execution, rows_changed
+  // holds the rows changed by the executions that succeeded
+  Result ExecuteStatementBatch(
+      const std::shared_ptr<Statement> &statement,
+      std::vector<std::vector<common::Value>> &params_batch,
+      std::vector<int> &rows_changed, std::string &error_message);
+
   // InitBindPrepStmt - Prepare and bind a query from a query string
   std::shared_ptr<Statement> PrepareStatement(const std::string &statement_name,
                                               const std::string &query_string,
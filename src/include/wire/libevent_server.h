@@ -24,6 +24,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <chrono>
 #include <iostream>
 #include <vector>
 
@@ -52,6 +53,7 @@ enum ConnState {
   CONN_WRITE,      // State the writes data to the network
   CONN_WAIT,       // State for waiting for some event to happen
   CONN_PROCESS,    // State that runs the wire protocol on received data
+  CONN_EXECUTING,  // State for waiting for the execution pool
   CONN_CLOSING,    // State for closing the client connection
   CONN_CLOSED,     // State for closed connection
   CONN_INVALID,    // Invalid STate
@@ -71,9 +73,10 @@ enum WriteState {
 
 /* Libevent Callbacks */
 
-/* Used by a worker thread to receive a new connection from the main thread and
- * launch the event handler */
-void WorkerHandleNewConn(evutil_socket_t local_fd, short ev_flags, void *arg);
+/* Used by a worker thread to receive the new connections from the main thread
+ * and the connections posted back by the execution pool, and launch the event
+ * handler */
+void WorkerHandleNotify(evutil_socket_t notify_fd, short ev_flags, void *arg);
 
 /* Used by a worker to execute the main event loop for a connection */
 void EventHandler(evutil_socket_t connfd, short ev_flags, void *arg);
@@ -135,18 +138,6 @@ struct Buffer {
   inline size_t GetMaxSize() { return SOCKET_BUFFER_SIZE; }
 };
 
-struct NewConnQueueItem {
-  int new_conn_fd;
-  short event_flags;
-  ConnState init_state;
-
-  inline NewConnQueueItem(int new_conn_fd, short event_flags,
-                          ConnState init_state)
-      : new_conn_fd(new_conn_fd),
-        event_flags(event_flags),
-        init_state(init_state) {}
-};
-
 /*
  * SocketManager - Wrapper for managing socket.
  * 	B is the STL container type used as the protocol's buffer.
@@ -161,11 +152,17 @@ class LibeventSocket {
   PacketManager pkt_manager;       // Stores state for this socket
   ConnState state = CONN_INVALID;  // Initial state of connection
   InputPacket rpkt;                // Used for reading a single Postgres packet
+  std::vector<InputPacket> pkt_batch;  // Packets to process in one round
+
+  // Used while the packet is run by the execution pool
+  bool exec_status = false;  // Result of processing the packet
+  std::chrono::steady_clock::time_point exec_stage_start;  // Stage start time
 
  private:
   Buffer rbuf_;                     // Socket's read buffer
   Buffer wbuf_;                     // Socket's write buffer
   unsigned int next_response_ = 0;  // The next response in the response buffer
+  size_t queued_bytes_ = 0;  // Unprocessed bytes accounted to the thread
 
  private:
   // Is the requested amount of data available from the current position in
@@ -198,12 +195,24 @@ class LibeventSocket {
   // Update the existing event to listen to the passed flags
   bool UpdateEvent(short flags);
 
+  // Stop listening to the socket
+  bool DisableEvent();
+
+  // Account the bytes left in the buffers to the load of the worker thread.
+  // Invoked when the state machine yields
+  void UpdateQueuedBytes();
+
   // Extracts the header of a Postgres packet from the read socket buffer
   bool ReadPacketHeader();
 
   // Extracts the contents of Postgres packet from the read socket buffer
   bool ReadPacket();
 
+  // Moves the complete packets in the read socket buffer to the packet batch,
+  // up to the first one whose responses are flushed. Returns false if there
+  // is no complete packet
+  bool ReadPacketBatch();
+
   WriteState WritePackets();
 
   void PrintWriteBuffer();
@@ -238,6 +247,10 @@ struct LibeventServer {
   static void CreateNewConn(const int &connfd, short ev_flags,
                             LibeventThread *thread, ConnState init_state);
 
+  // Creates a socket listening on the port. With reuse_port, every thread
+  // may listen on the port with a socket of its own
+  static int CreateListenSocket(const uint64_t &port, const bool &reuse_port);
+
  private:
   /* Maintain a global list of connections.
    * Helps reuse connection objects when possible
@@ -24,6 +24,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <atomic>
 #include <iostream>
 #include <vector>
 
@@ -40,7 +41,17 @@ namespace peloton {
 namespace wire {
 
 // Forward Declarations
-struct NewConnQueueItem;
+class LibeventSocket;
+
+struct NewConnQueueItem {
+  int new_conn_fd;
+  short event_flags;
+
+  inline NewConnQueueItem() : new_conn_fd(-1), event_flags(0) {}
+
+  inline NewConnQueueItem(int new_conn_fd, short event_flags)
+      : new_conn_fd(new_conn_fd), event_flags(event_flags) {}
+};
 
 class LibeventThread {
  protected:
@@ -67,28 +78,54 @@ class LibeventThread {
 
 class LibeventWorkerThread : public LibeventThread {
  private:
-  // New connection event
-  struct event *new_conn_event_;
+  // Notification event
+  struct event *notify_event_;
 
  public:
-  // Notify new connection pipe(send end)
-  int new_conn_send_fd;
-
-  // Notify new connection pipe(receive end)
-  int new_conn_receive_fd;
+  // Notifies the worker of new and posted back connections (eventfd)
+  int notify_fd;
 
   /* The queue for new connection requests */
-  LockFreeQueue<std::shared_ptr<NewConnQueueItem>> new_conn_queue;
+  LockFreeQueue<NewConnQueueItem> new_conn_queue;
+
+  /* The queue for connections whose packet is processed by the execution
+   * pool */
+  LockFreeQueue<LibeventSocket *> post_back_queue;
+
+  // Connections served by the worker
+  std::atomic<size_t> conn_count;
+
+  // Bytes received or buffered for sending, but not processed yet
+  std::atomic<size_t> queued_bytes;
 
  public:
   LibeventWorkerThread(const int thread_id);
+
+  /* Hand a new connection over to this thread. It is counted right away,
+   * before the thread picks it up. Invoked by the master thread */
+  void AcceptConn(int new_conn_fd, short event_flags);
+
+  /* Hand a connection back to this thread once its packet is processed.
+   * Invoked by the execution threads */
+  void PostBackConn(LibeventSocket *conn);
+
+  // Wake up the event loop to drain the queues
+  void Notify();
+
+  // Load used by the load-aware dispatch. A connection weighs as much as a
+  // full socket buffer of queued bytes
+  inline size_t GetLoad() const {
+    return conn_count.load() * SOCKET_BUFFER_SIZE + queued_bytes.load();
+  }
 };
 
 class LibeventMasterThread : public LibeventThread {
  private:
   const int num_threads_;
 
-  // TODO: have a smarter dispatch scheduler
+  // Pick the least loaded worker instead of the next one
+  const bool load_aware_dispatch_;
+
   int next_thread_id_ = 0;  // next thread we dispatched to
 
  public:
@@ -99,6 +136,15 @@ class LibeventMasterThread : public LibeventThread {
   std::vector<std::shared_ptr<LibeventWorkerThread>> &GetWorkerThreads();
 
   static void StartWorker(peloton::wire::LibeventWorkerThread *worker_thread);
+
+  // The worker with the lowest load. The search starts at the start id, so
+  // that ties go to the first worker from there on
+  static int GetLeastLoadedWorker(
+      const std::vector<std::shared_ptr<LibeventWorkerThread>> &threads,
+      const int &start_id);
+
+ private:
+  int SelectWorker();
 };
 
 }  // namespace wire
@@ -0,0 +1,157 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// query_execution_pool.h
+//
+// Identification: src/include/wire/query_execution_pool.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace peloton {
+namespace wire {
+
+class LibeventSocket;
+
+// the stages a packet goes through once it is parsed by a network thread
+enum ExecutionStage {
+  EXECUTION_STAGE_QUEUED = 0,     // waiting for an execution thread
+  EXECUTION_STAGE_EXECUTING = 1,  // processed by an execution thread
+  EXECUTION_STAGE_POST_BACK = 2,  // waiting for the network thread to respond
+  EXECUTION_STAGE_COUNT = 3
+};
+
+//===--------------------------------------------------------------------===//
+// Query Execution Pool
+//===--------------------------------------------------------------------===//
+
+// the threads that run the packets of the clients. a network thread hands the
+// packets parsed in a round over to the pool and goes on serving its other
+// connections. once the packets are processed, the connection is posted back
+// to the event loop of its network thread, which writes out the responses.
+class QueryExecutionPool {
+ public:
+  QueryExecutionPool(const QueryExecutionPool &) = delete;
+  QueryExecutionPool &operator=(const QueryExecutionPool &) = delete;
+
+  QueryExecutionPool();
+
+  ~QueryExecutionPool() {}
+
+  static QueryExecutionPool &GetInstance();
+
+  void StartPool(const size_t &thread_count);
+
+  void StopPool();
+
+  bool IsRunning() const { return is_running_; }
+
+  size_t GetThreadCount() const { return execution_threads_.size(); }
+
+  // process the packets read by the connection on an execution thread. the
+  // connection must not be touched by its network thread until it is posted
+  // back.
+  void SubmitPackets(LibeventSocket *conn);
+
+  // invoked by the network thread once it picks up a posted back connection
+  void CompletePostBack(LibeventSocket *conn);
+
+  //===--------------------------------------------------------------------===//
+  // Statistics
+  //===--------------------------------------------------------------------===//
+
+  // connections waiting for an execution thread
+  size_t GetQueueDepth() const { return queue_depth_.load(); }
+
+  // connections whose packets are being processed
+  size_t GetExecutingCount() const { return executing_count_.load(); }
+
+  // processed connections that are not picked up by their network thread yet
+  size_t GetPostBackDepth() const { return post_back_depth_.load(); }
+
+  // connections in the stage right now
+  size_t GetStageDepth(const ExecutionStage &stage) const;
+
+  // connections processed by the execution threads rather than inline by a
+  // submitting thread after the pool is stopped
+  uint64_t GetPoolExecutedCount() const { return pool_executed_count_.load(); }
+
+  uint64_t GetStageCount(const ExecutionStage &stage) const {
+    return stage_latencies_[stage].count.load();
+  }
+
+  // in microseconds, summed over the connections that went through the stage
+  uint64_t GetTotalLatency(const ExecutionStage &stage) const {
+    return stage_latencies_[stage].total.load();
+  }
+
+  // in microseconds
+  uint64_t GetAverageLatency(const ExecutionStage &stage) const;
+
+  // in microseconds
+  uint64_t GetMaxLatency(const ExecutionStage &stage) const {
+    return stage_latencies_[stage].max.load();
+  }
+
+  void ResetStatistics();
+
+  static std::string ExecutionStageToString(const ExecutionStage &stage);
+
+ private:
+  void Running();
+
+  // process the packets and post the connection back
+  void ProcessPackets(LibeventSocket *conn);
+
+  // record the time the connection spent in the stage, and start the next one
+  void RecordLatency(LibeventSocket *conn, const ExecutionStage &stage);
+
+ private:
+  struct StageLatency {
+    std::atomic<uint64_t> count;
+    std::atomic<uint64_t> total;
+    std::atomic<uint64_t> max;
+  };
+
+  //===--------------------------------------------------------------------===//
+  // Data members
+  //===--------------------------------------------------------------------===//
+  volatile bool is_running_;
+
+  std::mutex pool_mutex_;
+
+  std::vector<std::unique_ptr<std::thread>> execution_threads_;
+
+  std::mutex queue_mutex_;
+
+  std::condition_variable queue_cv_;
+
+  std::deque<LibeventSocket *> packet_queue_;
+
+  std::atomic<size_t> queue_depth_;
+
+  std::atomic<size_t> executing_count_;
+
+  std::atomic<size_t> post_back_depth_;
+
+  std::atomic<uint64_t> pool_executed_count_;
+
+  StageLatency stage_latencies_[EXECUTION_STAGE_COUNT];
+};
+
+}  // End wire namespace
+}  // End peloton namespace
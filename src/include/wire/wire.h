@@ -123,6 +123,11 @@ private:
   /* Process the EXECUTE message of the extended query protocol */
   void ExecExecuteMessage(InputPacket* pkt);
 
+  /* Bind and execute the pairs as one batch, in a single transaction.
+   * Returns the number of packets processed */
+  size_t ExecExecuteBatch(std::vector<InputPacket>& pkts, size_t start,
+                          size_t pair_count);
+
  public:
   // Deserialize the parameter types from packet
   static size_t ReadParamType(InputPacket* pkt, int num_params,
@@ -148,6 +153,23 @@ private:
    * packet. Avoid flushing the response for extended protocols. */
   bool ProcessPacket(InputPacket* pkt);
 
+  /* Process the packets read in one round, in order. Consecutive executions
+   * of the same prepared statement are batched. Returns false if the session
+   * needs to be closed. */
+  bool ProcessPackets(std::vector<InputPacket>& pkts);
+
+  /* Count the BIND/EXECUTE pairs from the start index on that can run as one
+   * batch: the pairs bind the same write statement to the portal they
+   * execute. Returns 0 for less than two pairs */
+  size_t GetExecuteBatchSize(std::vector<InputPacket>& pkts, size_t start);
+
+  /* The responses are flushed after these packets, so the socket ends a
+   * batch of packets with them */
+  static inline bool IsFlushPacket(uchar msg_type) {
+    return msg_type == SIMPLE_QUERY_COMMAND || msg_type == SYNC_COMMAND ||
+           msg_type == TERMINATE_COMMAND;
+  }
+
   /* Manage the startup packet */
   //  bool ManageStartupPacket();
   void Reset();
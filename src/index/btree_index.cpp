@@ -290,6 +290,69 @@ void BTREE_TEMPLATE_TYPE::ScanKey(const storage::Tuple *key,
   }
 }
 
+/**
+ * @brief Return all locations related to each of the keys.
+ * The read lock is taken once for the whole list. When a key is larger than
+ * the previous one, its entries are searched by walking forward from
+ * where the previous key ended before falling back to a search from the root.
+ */
+BTREE_TEMPLATE_ARGUMENT
+void BTREE_TEMPLATE_TYPE::ScanKeys(
+    const std::vector<const storage::Tuple *> &keys,
+    std::vector<ValueType> &result, std::vector<size_t> &key_offsets) {
+  // number of entries walked over before searching from the root
+  const size_t max_forward_steps = 8;
+
+  std::vector<KeyType> index_key_list(keys.size());
+  for (size_t key_itr = 0; key_itr < keys.size(); key_itr++) {
+    index_key_list[key_itr].SetFromKey(keys[key_itr]);
+  }
+
+  size_t result_size = result.size();
+  key_offsets.clear();
+  key_offsets.reserve(keys.size() + 1);
+  key_offsets.push_back(result.size());
+
+  {
+    index_lock.ReadLock();
+
+    auto key_cmp = container.key_comp();
+    auto entry = container.end();
+    const KeyType *prev_key = nullptr;
+
+    for (auto &index_key : index_key_list) {
+      bool found = false;
+      if (prev_key != nullptr && key_cmp(*prev_key, index_key)) {
+        // first entry not smaller than the key, close after the previous key
+        for (size_t step = 0; step < max_forward_steps; step++) {
+          if (entry == container.end() || !key_cmp(entry->first, index_key)) {
+            found = true;
+            break;
+          }
+          ++entry;
+        }
+      }
+      if (!found) {
+        entry = container.lower_bound(index_key);
+      }
+
+      while (entry != container.end() && !key_cmp(index_key, entry->first)) {
+        result.push_back(entry->second);
+        ++entry;
+      }
+      key_offsets.push_back(result.size());
+      prev_key = &index_key;
+    }
+
+    index_lock.Unlock();
+  }
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+        result.size() - result_size, metadata);
+  }
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////
 
 BTREE_TEMPLATE_ARGUMENT
@@ -246,6 +246,32 @@ void BWTREE_INDEX_TYPE::ScanKey(const storage::Tuple *key,
   return;
 }
 
+/*
+ * ScanKeys() - Point lookup of a list of keys
+ *
+ * All keys are passed to the tree at once, which reuses a leaf node for
+ * the following keys as long as they fall inside it
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+void BWTREE_INDEX_TYPE::ScanKeys(const std::vector<const storage::Tuple *> &keys,
+                                 std::vector<ValueType> &result,
+                                 std::vector<size_t> &key_offsets) {
+  std::vector<KeyType> index_key_list(keys.size());
+  for (size_t key_itr = 0; key_itr < keys.size(); key_itr++) {
+    index_key_list[key_itr].SetFromKey(keys[key_itr]);
+  }
+
+  size_t result_size = result.size();
+  container.GetValueBatch(index_key_list, result, key_offsets);
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+        result.size() - result_size, metadata);
+  }
+
+  return;
+}
+
 BWTREE_TEMPLATE_ARGUMENTS
 std::string BWTREE_INDEX_TYPE::GetTypeName() const { return "BWTree"; }
 
@@ -161,6 +161,27 @@ void Index::ScanTest(const std::vector<common::Value> &value_list,
   return;
 }
 
+/*
+ * ScanKeys() - Point lookup of a list of keys
+ *
+ * This is the fallback for indices without a batched lookup, which probes
+ * the keys one by one
+ */
+void Index::ScanKeys(const std::vector<const storage::Tuple *> &keys,
+                     std::vector<ItemPointer *> &result,
+                     std::vector<size_t> &key_offsets) {
+  key_offsets.clear();
+  key_offsets.reserve(keys.size() + 1);
+  key_offsets.push_back(result.size());
+
+  for (auto key : keys) {
+    ScanKey(key, result);
+    key_offsets.push_back(result.size());
+  }
+
+  return;
+}
+
 /*
  * Compare() - Check whether a given index key satisfies a predicate
  *
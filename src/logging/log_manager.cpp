@@ -17,6 +17,7 @@
 #include "catalog/manager.h"
 #include "common/logger.h"
 #include "common/macros.h"
+#include "common/wait_event.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "executor/executor_context.h"
 #include "logging/log_manager.h"
@@ -485,10 +486,15 @@ void LogManager::WaitForFlush(cid_t cid) {
   {
     std::unique_lock<std::mutex> wait_lock(flush_notify_mutex);
 
+    // the wait is only timed if the commit is not flushed yet
+    std::unique_ptr<WaitEventTimer> wait;
     while (this->GetPersistentFlushedCommitId() < cid) {
       LOG_TRACE(
           "Logs up to %lu cid is flushed. %lu cid is not flushed yet. Wait...",
           this->GetPersistentFlushedCommitId(), cid);
+      if (wait == nullptr) {
+        wait.reset(new WaitEventTimer(WAIT_CLASS_LOG_FLUSH));
+      }
       flush_notify_cv.wait(wait_lock);
     }
     LOG_TRACE(
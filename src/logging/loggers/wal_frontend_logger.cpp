@@ -20,6 +20,7 @@
 #include "catalog/catalog.h"
 #include "catalog/manager.h"
 #include "catalog/schema.h"
+#include "common/config.h"
 #include "common/varlen_pool.h"
 #include "concurrency/transaction.h"
 #include "concurrency/transaction_manager_factory.h"
@@ -42,6 +43,7 @@
 #include "index/index.h"
 #include "executor/executor_context.h"
 #include "planner/seq_scan_plan.h"
+#include "statistics/backend_stats_context.h"
 
 int logger_id_counter = 0;
 
@@ -176,7 +178,15 @@ void WriteAheadFrontendLogger::FlushLogRecords(void) {
         // have at least 1 delimiter
         if (Clock::now() > last_flush + flush_frequency) {
           if (!no_write_) {
-            LoggingUtil::FFlushFsync(cur_file_handle);
+            if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+              auto &flush_latencies = stats::BackendStatsContext::GetInstance()
+                                          ->GetLogFlushLatencyMetric();
+              flush_latencies.StartTimer();
+              LoggingUtil::FFlushFsync(cur_file_handle);
+              flush_latencies.RecordLatency();
+            } else {
+              LoggingUtil::FFlushFsync(cur_file_handle);
+            }
           }
           last_flush = Clock::now();
           if (this->max_collected_commit_id > max_flushed_commit_id) {
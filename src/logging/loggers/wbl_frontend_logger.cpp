@@ -13,6 +13,7 @@
 #include <sys/stat.h>
 #include <sys/mman.h>
 
+#include "common/config.h"
 #include "common/exception.h"
 #include "catalog/manager.h"
 #include "catalog/schema.h"
@@ -25,6 +26,7 @@
 #include "logging/loggers/wbl_backend_logger.h"
 #include "logging/logging_util.h"
 #include "logging/log_manager.h"
+#include "statistics/backend_stats_context.h"
 
 #define POSSIBLY_DIRTY_GRANT_SIZE 10000000;  // ten million seems reasonable
 
@@ -95,9 +97,20 @@ void WriteBehindFrontendLogger::FlushLogRecords(void) {
   }
 
   // for now fsync every time because the cost is relatively low
+  bool record_latency = (FLAGS_stats_mode != STATS_TYPE_INVALID);
+  if (record_latency) {
+    stats::BackendStatsContext::GetInstance()
+        ->GetLogFlushLatencyMetric()
+        .StartTimer();
+  }
   if (fsync(log_file_fd)) {
     LOG_ERROR("Unable to fsync log");
   }
+  if (record_latency) {
+    stats::BackendStatsContext::GetInstance()
+        ->GetLogFlushLatencyMetric()
+        .RecordLatency();
+  }
 
   // inform backend loggers they can proceed if waiting for sync
   max_flushed_commit_id = max_collected_commit_id;
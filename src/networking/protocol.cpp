@@ -12,6 +12,7 @@
 
 #include <cstdio>
 #include <unordered_map>
+#include "catalog/catalog.h"
 #include "common/cache.h"
 #include "common/macros.h"
 #include "common/portal.h"
@@ -427,6 +428,22 @@ void PacketManager::ExecBindMessage(InputPacket *pkt) {
     return;
   }
 
+  // Plan the statement again if DDL has changed the catalog since it was
+  // prepared, its plan may still refer to a dropped table
+  if (statement->GetCatalogVersion() !=
+      catalog::Catalog::GetInstance()->GetVersion()) {
+    std::string error_message;
+    auto new_statement = tcop::TrafficCop::GetInstance().PrepareStatement(
+        statement->GetStatementName(), query_string, error_message);
+    if (new_statement.get() == nullptr) {
+      SendErrorResponse({{HUMAN_READABLE_ERROR, error_message}});
+      return;
+    }
+    statement->SetPlanTree(new_statement->GetPlanTree());
+    statement->SetTupleDescriptor(new_statement->GetTupleDescriptor());
+    statement->SetCatalogVersion(new_statement->GetCatalogVersion());
+  }
+
   // Group the parameter types and the parameters in this vector
   std::vector<std::pair<int, std::string>> bind_parameters(num_params);
   std::vector<common::Value> param_values(num_params);
@@ -722,6 +739,151 @@ void PacketManager::ExecExecuteMessage(InputPacket *pkt) {
   CompleteCommand(query_type, rows_affected);
 }
 
+size_t PacketManager::GetExecuteBatchSize(std::vector<InputPacket> &pkts,
+                                          size_t start) {
+  std::string portal_name, statement_name;
+  std::string first_statement_name;
+  size_t pair_count = 0;
+
+  for (size_t pkt_itr = start; pkt_itr + 1 < pkts.size(); pkt_itr += 2) {
+    auto &bind_pkt = pkts[pkt_itr];
+    auto &execute_pkt = pkts[pkt_itr + 1];
+    if (bind_pkt.msg_type != BIND_COMMAND ||
+        execute_pkt.msg_type != EXECUTE_COMMAND || bind_pkt.is_extended ||
+        execute_pkt.is_extended) {
+      break;
+    }
+
+    // peek at the names without consuming the packets
+    InputPacket bind_peek = bind_pkt;
+    GetStringToken(&bind_peek, portal_name);
+    GetStringToken(&bind_peek, statement_name);
+    InputPacket execute_peek = execute_pkt;
+    std::string execute_portal_name;
+    GetStringToken(&execute_peek, execute_portal_name);
+
+    if (portal_name != execute_portal_name) break;
+    if (pair_count == 0) {
+      first_statement_name = statement_name;
+    } else if (statement_name != first_statement_name) {
+      break;
+    }
+    pair_count++;
+  }
+
+  if (pair_count < 2) return 0;
+
+  // only writes are batched, they send no rows back
+  std::shared_ptr<Statement> statement;
+  if (first_statement_name.empty()) {
+    statement = unnamed_statement_;
+  } else {
+    auto statement_cache_itr = statement_cache_.find(first_statement_name);
+    if (statement_cache_itr != statement_cache_.end()) {
+      statement = *statement_cache_itr;
+    }
+  }
+  if (statement.get() == nullptr) return 0;
+
+  const auto &query_type = statement->GetQueryType();
+  if (query_type != "INSERT" && query_type != "UPDATE" &&
+      query_type != "DELETE") {
+    return 0;
+  }
+  return pair_count;
+}
+
+size_t PacketManager::ExecExecuteBatch(std::vector<InputPacket> &pkts,
+                                       size_t start, size_t pair_count) {
+  std::vector<ResponseBuffer> bind_responses;
+  std::vector<std::vector<common::Value>> params_batch;
+  std::shared_ptr<Statement> statement;
+  size_t next_pkt = start;
+
+  // bind all the pairs first, and keep their responses aside so that they
+  // are sent in the order of the packets
+  for (size_t pair_itr = 0; pair_itr < pair_count; pair_itr++) {
+    auto &bind_pkt = pkts[start + 2 * pair_itr];
+    std::string portal_name;
+    InputPacket bind_peek = bind_pkt;
+    GetStringToken(&bind_peek, portal_name);
+
+    auto response_count = responses.size();
+    ExecBindMessage(&bind_pkt);
+    next_pkt += 1;
+
+    ResponseBuffer pair_responses;
+    for (size_t response_itr = response_count;
+         response_itr < responses.size(); response_itr++) {
+      pair_responses.push_back(std::move(responses[response_itr]));
+    }
+    responses.resize(response_count);
+    bool bound = (pair_responses.size() == 1 &&
+                  pair_responses[0]->msg_type == BIND_COMPLETE &&
+                  skipped_stmt_ == false);
+    bind_responses.push_back(std::move(pair_responses));
+
+    // the rest is processed packet by packet, starting at this execute
+    if (bound == false) break;
+
+    auto &portal = portals_[portal_name];
+    statement = portal->GetStatement();
+    params_batch.push_back(portal->GetParameters());
+    next_pkt += 1;
+  }
+
+  std::vector<int> rows_changed;
+  std::string error_message;
+  Result status = Result::RESULT_SUCCESS;
+  if (params_batch.empty() == false) {
+    auto &tcop = tcop::TrafficCop::GetInstance();
+    status = tcop.ExecuteStatementBatch(statement, params_batch, rows_changed,
+                                        error_message);
+  }
+
+  for (size_t pair_itr = 0; pair_itr < bind_responses.size(); pair_itr++) {
+    for (auto &response : bind_responses[pair_itr]) {
+      responses.push_back(std::move(response));
+    }
+    if (pair_itr < rows_changed.size()) {
+      CompleteCommand(statement->GetQueryType(), rows_changed[pair_itr]);
+    } else if (pair_itr < params_batch.size()) {
+      // the whole batch is rolled back, the executions after the failed
+      // one are dropped
+      LOG_ERROR("Failed to execute batch: %s", error_message.c_str());
+      SendErrorResponse({{HUMAN_READABLE_ERROR, error_message}});
+      SendReadyForQuery(txn_state_);
+      break;
+    }
+  }
+
+  // the batch failed when it was committed
+  if (status == Result::RESULT_FAILURE &&
+      rows_changed.size() == params_batch.size()) {
+    LOG_ERROR("Failed to commit batch: %s", error_message.c_str());
+    SendErrorResponse({{HUMAN_READABLE_ERROR, error_message}});
+    SendReadyForQuery(txn_state_);
+  }
+
+  return next_pkt - start;
+}
+
+bool PacketManager::ProcessPackets(std::vector<InputPacket> &pkts) {
+  size_t pkt_itr = 0;
+  while (pkt_itr < pkts.size()) {
+    auto pair_count = GetExecuteBatchSize(pkts, pkt_itr);
+    if (pair_count > 0) {
+      pkt_itr += ExecExecuteBatch(pkts, pkt_itr, pair_count);
+      continue;
+    }
+    if (ProcessPacket(&pkts[pkt_itr]) == false) {
+      return false;
+    }
+    pkt_itr++;
+  }
+  return true;
+}
+
 /*
  * process_packet - Main switch block; process incoming packets,
  *  Returns false if the session needs to be closed.
@@ -0,0 +1,414 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// fast_path_parser.cpp
+//
+// Identification: src/parser/fast_path_parser.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <unordered_set>
+#include <vector>
+
+#include "common/logger.h"
+#include "common/value_factory.h"
+#include "expression/comparison_expression.h"
+#include "expression/conjunction_expression.h"
+#include "expression/constant_value_expression.h"
+#include "expression/function_expression.h"
+#include "expression/parameter_value_expression.h"
+#include "expression/star_expression.h"
+#include "expression/tuple_value_expression.h"
+#include "parser/fast_path_parser.h"
+#include "parser/statements.h"
+
+namespace peloton {
+namespace parser {
+
+namespace {
+
+// the keywords of the scanner, they are not identifiers
+const std::unordered_set<std::string> kKeywords = {
+    "add",       "after",     "all",        "alter",     "analyze",
+    "and",       "as",        "asc",        "avg",       "before",
+    "begin",     "between",   "bigint",     "boolean",   "btree",
+    "bwtree",    "by",        "call",       "cascade",   "char",
+    "column",    "columns",   "commit",     "control",   "copy",
+    "count",     "create",    "cross",      "csv",       "database",
+    "date",      "deallocate", "decimal",   "default",   "delete",
+    "delimiter", "delta",     "desc",       "direct",    "distinct",
+    "double",    "drop",      "escape",     "except",    "execute",
+    "exists",    "explain",   "file",       "float",     "for",
+    "foreign",   "from",      "full",       "global",    "group",
+    "hash",      "having",    "hint",       "if",        "in",
+    "index",     "inner",     "insert",     "int",       "integer",
+    "intersect", "into",      "is",         "isnull",    "join",
+    "key",       "left",      "like",       "limit",     "load",
+    "local",     "max",       "merge",      "min",       "minus",
+    "natural",   "not",       "null",       "nvarchar",  "of",
+    "off",       "offset",    "on",         "or",        "order",
+    "outer",     "parameters", "part",      "plan",      "prepare",
+    "primary",   "references", "rename",    "restrict",  "right",
+    "rollback",  "schema",    "schemas",    "select",    "set",
+    "show",      "skiplist",  "smallint",   "sorted",    "spatial",
+    "sum",       "table",     "tables",     "temporary", "text",
+    "time",      "timestamp", "tinyint",    "to",        "top",
+    "transaction", "truncate", "union",     "unique",    "unload",
+    "update",    "using",     "values",     "varbinary", "varchar",
+    "view",      "virtual",   "where",      "with"};
+
+enum FastPathTokenType {
+  FAST_PATH_TOKEN_KEYWORD,
+  FAST_PATH_TOKEN_IDENTIFIER,
+  FAST_PATH_TOKEN_INTEGER,
+  FAST_PATH_TOKEN_DECIMAL,
+  FAST_PATH_TOKEN_STRING,
+  FAST_PATH_TOKEN_PARAMETER,
+  FAST_PATH_TOKEN_SYMBOL,
+  FAST_PATH_TOKEN_END
+};
+
+struct FastPathToken {
+  FastPathTokenType type;
+
+  // lower case for the keywords and the identifiers
+  std::string text;
+
+  int64_t integer = 0;
+  double decimal = 0;
+};
+
+// Split the query into tokens as the scanner does, false if it has a token
+// the fast path does not handle
+bool Tokenize(const std::string &query, std::vector<FastPathToken> &tokens) {
+  size_t position = 0;
+  while (position < query.size()) {
+    char c = query[position];
+    FastPathToken token;
+
+    if (c == ' ' || c == '\t' || c == '\n') {
+      position++;
+      continue;
+    }
+
+    if (isalpha(c)) {
+      size_t end = position;
+      while (end < query.size() &&
+             (isalnum(query[end]) || query[end] == '_')) {
+        token.text.push_back(tolower(query[end]));
+        end++;
+      }
+      token.type = (kKeywords.count(token.text) != 0)
+                       ? FAST_PATH_TOKEN_KEYWORD
+                       : FAST_PATH_TOKEN_IDENTIFIER;
+      position = end;
+    } else if (isdigit(c)) {
+      size_t end = position;
+      while (end < query.size() && isdigit(query[end])) end++;
+      if (end < query.size() && query[end] == '.') {
+        end++;
+        while (end < query.size() && isdigit(query[end])) end++;
+        token.type = FAST_PATH_TOKEN_DECIMAL;
+        token.decimal = atof(query.substr(position, end - position).c_str());
+      } else {
+        // The grammar keeps the integer literals as integers
+        if (end - position > 10) return false;
+        token.type = FAST_PATH_TOKEN_INTEGER;
+        token.integer = atol(query.substr(position, end - position).c_str());
+        if (token.integer > std::numeric_limits<int32_t>::max()) return false;
+      }
+      position = end;
+    } else if (c == '\'') {
+      size_t end = query.find_first_of("'\n", position + 1);
+      if (end == std::string::npos || query[end] != '\'') return false;
+      token.type = FAST_PATH_TOKEN_STRING;
+      token.text = query.substr(position + 1, end - position - 1);
+      position = end + 1;
+    } else if (c == '$') {
+      size_t end = position + 1;
+      while (end < query.size() && isdigit(query[end])) end++;
+      if (end == position + 1 || end - position > 6) return false;
+      token.type = FAST_PATH_TOKEN_PARAMETER;
+      token.integer = atol(query.substr(position + 1, end - position).c_str());
+      if (token.integer == 0) return false;
+      position = end;
+    } else if (strchr("(),.;=*", c) != nullptr) {
+      token.type = FAST_PATH_TOKEN_SYMBOL;
+      token.text = std::string(1, c);
+      position++;
+    } else {
+      // Comments, quoted identifiers, the other operators and the ?
+      // placeholders are left to the full parser
+      return false;
+    }
+
+    tokens.push_back(std::move(token));
+  }
+
+  FastPathToken end_token;
+  end_token.type = FAST_PATH_TOKEN_END;
+  tokens.push_back(std::move(end_token));
+  return true;
+}
+
+char *CopyString(const std::string &text) { return strdup(text.c_str()); }
+
+// Matches the tokens of a statement against the shapes of the fast path. the
+// nodes of the parse tree are built as by the grammar actions.
+class FastPathMatcher {
+ public:
+  FastPathMatcher(const std::vector<FastPathToken> &tokens)
+      : tokens_(tokens) {}
+
+  SQLStatement *MatchStatement() {
+    std::unique_ptr<SQLStatement> statement;
+    if (AcceptKeyword("select")) {
+      statement.reset(MatchSelect());
+    } else if (AcceptKeyword("update")) {
+      statement.reset(MatchUpdate());
+    } else if (AcceptKeyword("insert")) {
+      statement.reset(MatchInsert());
+    }
+
+    if (statement == nullptr) return nullptr;
+
+    // A single statement, optionally followed by a semicolon
+    AcceptSymbol(';');
+    if (Peek().type != FAST_PATH_TOKEN_END) return nullptr;
+    return statement.release();
+  }
+
+ private:
+  const FastPathToken &Peek() const { return tokens_[position_]; }
+
+  bool AcceptKeyword(const char *keyword) {
+    if (Peek().type == FAST_PATH_TOKEN_KEYWORD && Peek().text == keyword) {
+      position_++;
+      return true;
+    }
+    return false;
+  }
+
+  bool AcceptSymbol(const char symbol) {
+    if (Peek().type == FAST_PATH_TOKEN_SYMBOL && Peek().text[0] == symbol) {
+      position_++;
+      return true;
+    }
+    return false;
+  }
+
+  bool AcceptIdentifier(std::string &identifier) {
+    if (Peek().type == FAST_PATH_TOKEN_IDENTIFIER) {
+      identifier = Peek().text;
+      position_++;
+      return true;
+    }
+    return false;
+  }
+
+  // table_name: IDENTIFIER | IDENTIFIER '.' IDENTIFIER
+  TableInfo *MatchTableName() {
+    std::string name;
+    if (AcceptIdentifier(name) == false) return nullptr;
+
+    std::unique_ptr<TableInfo> table_info(new TableInfo());
+    if (AcceptSymbol('.')) {
+      std::string table_name;
+      if (AcceptIdentifier(table_name) == false) return nullptr;
+      table_info->database_name = CopyString(name);
+      table_info->table_name = CopyString(table_name);
+    } else {
+      table_info->table_name = CopyString(name);
+    }
+    return table_info.release();
+  }
+
+  // literal: a string, an integer, a decimal or a $n parameter
+  expression::AbstractExpression *MatchValue() {
+    auto &token = Peek();
+    expression::AbstractExpression *value = nullptr;
+    switch (token.type) {
+      case FAST_PATH_TOKEN_STRING:
+        value = new expression::ConstantValueExpression(
+            common::ValueFactory::GetVarcharValue(token.text.c_str()));
+        break;
+      case FAST_PATH_TOKEN_INTEGER:
+        value = new expression::ConstantValueExpression(
+            common::ValueFactory::GetIntegerValue(token.integer));
+        value->ival_ = token.integer;
+        break;
+      case FAST_PATH_TOKEN_DECIMAL:
+        value = new expression::ConstantValueExpression(
+            common::ValueFactory::GetDoubleValue(token.decimal));
+        break;
+      case FAST_PATH_TOKEN_PARAMETER:
+        value = new expression::ParameterValueExpression(token.integer - 1);
+        break;
+      default:
+        return nullptr;
+    }
+    position_++;
+    return value;
+  }
+
+  // pred [AND pred ...], with pred: column_name '=' literal
+  expression::AbstractExpression *MatchConjunction() {
+    std::unique_ptr<expression::AbstractExpression> conjunction;
+    do {
+      std::string column_name;
+      if (AcceptIdentifier(column_name) == false || AcceptSymbol('=') == false)
+        return nullptr;
+      std::unique_ptr<expression::AbstractExpression> column(
+          new expression::TupleValueExpression(std::move(column_name)));
+      std::unique_ptr<expression::AbstractExpression> value(MatchValue());
+      if (value == nullptr) return nullptr;
+
+      std::unique_ptr<expression::AbstractExpression> predicate(
+          new expression::ComparisonExpression(EXPRESSION_TYPE_COMPARE_EQUAL,
+                                               column.release(),
+                                               value.release()));
+
+      // AND is left associative
+      if (conjunction == nullptr) {
+        conjunction = std::move(predicate);
+      } else {
+        conjunction.reset(new expression::ConjunctionExpression(
+            EXPRESSION_TYPE_CONJUNCTION_AND, conjunction.release(),
+            predicate.release()));
+      }
+    } while (AcceptKeyword("and"));
+
+    return conjunction.release();
+  }
+
+  SQLStatement *MatchSelect() {
+    std::unique_ptr<SelectStatement> select(new SelectStatement());
+    select->select_list = new std::vector<expression::AbstractExpression *>();
+
+    if (AcceptSymbol('*')) {
+      select->select_list->push_back(new expression::StarExpression());
+    } else {
+      do {
+        std::string column_name;
+        if (AcceptIdentifier(column_name) == false) return nullptr;
+        select->select_list->push_back(
+            new expression::TupleValueExpression(std::move(column_name)));
+      } while (AcceptSymbol(','));
+    }
+
+    if (AcceptKeyword("from") == false) return nullptr;
+    select->from_table = new TableRef(TABLE_REFERENCE_TYPE_NAME);
+    select->from_table->table_info_ = MatchTableName();
+    if (select->from_table->table_info_ == nullptr) return nullptr;
+
+    if (AcceptKeyword("where")) {
+      select->where_clause = MatchConjunction();
+      if (select->where_clause == nullptr) return nullptr;
+    }
+
+    if (AcceptKeyword("for")) {
+      if (AcceptKeyword("update") == false) return nullptr;
+      select->is_for_update = true;
+    }
+    return select.release();
+  }
+
+  SQLStatement *MatchUpdate() {
+    std::unique_ptr<UpdateStatement> update(new UpdateStatement());
+    update->table = new TableRef(TABLE_REFERENCE_TYPE_NAME);
+    update->table->table_info_ = MatchTableName();
+    if (update->table->table_info_ == nullptr) return nullptr;
+
+    if (AcceptKeyword("set") == false) return nullptr;
+    update->updates = new std::vector<UpdateClause *>();
+    do {
+      std::string column_name;
+      if (AcceptIdentifier(column_name) == false || AcceptSymbol('=') == false)
+        return nullptr;
+      std::unique_ptr<expression::AbstractExpression> value(MatchValue());
+      if (value == nullptr) return nullptr;
+
+      auto update_clause = new UpdateClause();
+      update_clause->column = CopyString(column_name);
+      update_clause->value = value.release();
+      update->updates->push_back(update_clause);
+    } while (AcceptSymbol(','));
+
+    if (AcceptKeyword("where")) {
+      update->where = MatchConjunction();
+      if (update->where == nullptr) return nullptr;
+    }
+    return update.release();
+  }
+
+  SQLStatement *MatchInsert() {
+    if (AcceptKeyword("into") == false) return nullptr;
+    std::unique_ptr<InsertStatement> insert(
+        new InsertStatement(INSERT_TYPE_VALUES));
+    insert->table_info_ = MatchTableName();
+    if (insert->table_info_ == nullptr) return nullptr;
+
+    if (AcceptSymbol('(')) {
+      insert->columns = new std::vector<char *>();
+      do {
+        std::string column_name;
+        if (AcceptIdentifier(column_name) == false) return nullptr;
+        insert->columns->push_back(CopyString(column_name));
+      } while (AcceptSymbol(','));
+      if (AcceptSymbol(')') == false) return nullptr;
+    }
+
+    // A single row, the values are handed over once they all matched
+    if (AcceptKeyword("values") == false || AcceptSymbol('(') == false)
+      return nullptr;
+    std::vector<std::unique_ptr<expression::AbstractExpression>> values;
+    do {
+      std::unique_ptr<expression::AbstractExpression> value(MatchValue());
+      if (value == nullptr) return nullptr;
+      values.push_back(std::move(value));
+    } while (AcceptSymbol(','));
+    if (AcceptSymbol(')') == false) return nullptr;
+
+    auto row = new std::vector<expression::AbstractExpression *>();
+    for (auto &value : values) {
+      row->push_back(value.release());
+    }
+    insert->insert_values =
+        new std::vector<std::vector<expression::AbstractExpression *> *>();
+    insert->insert_values->push_back(row);
+    return insert.release();
+  }
+
+  const std::vector<FastPathToken> &tokens_;
+
+  size_t position_ = 0;
+};
+
+}  // namespace
+
+std::unique_ptr<SQLStatementList> FastPathParser::Parse(
+    const std::string &query) {
+  std::vector<FastPathToken> tokens;
+  if (Tokenize(query, tokens) == false) {
+    return nullptr;
+  }
+
+  FastPathMatcher matcher(tokens);
+  auto statement = matcher.MatchStatement();
+  if (statement == nullptr) {
+    return nullptr;
+  }
+
+  LOG_TRACE("Fast path parse of: %s", query.c_str());
+  return std::unique_ptr<SQLStatementList>(new SQLStatementList(statement));
+}
+
+}  // End parser namespace
+}  // End peloton namespace
@@ -14,8 +14,10 @@
 #include <string>
 
 #include "parser/parser.h"
+#include "parser/fast_path_parser.h"
 #include "parser/sql_parser.h"
 #include "parser/sql_scanner.h"
+#include "common/config.h"
 #include "common/exception.h"
 #include "common/types.h"
 
@@ -65,6 +67,14 @@ Parser &Parser::GetInstance(){
 }
 
 std::unique_ptr<parser::SQLStatementList> Parser::BuildParseTree(const std::string& query_string){
+  // The simple statements skip the generated scanner and parser
+  if (FLAGS_fast_path_parser) {
+    auto fast_path_stmt = FastPathParser::Parse(query_string);
+    if (fast_path_stmt != nullptr) {
+      return fast_path_stmt;
+    }
+  }
+
   auto stmt  = Parser::ParseSQLString(query_string);
 
   LOG_TRACE("Number of statements: %lu" ,stmt->GetStatements().size());
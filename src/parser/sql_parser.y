@@ -203,7 +203,7 @@ struct PARSER_CUST_LTYPE {
 %token DROP FILE FROM FULL HASH HINT INTO JOIN LEFT LIKE BTREE BWTREE SKIPLIST
 %token LOAD NULL PART PLAN SHOW TEXT TIME VIEW WITH ADD ALL
 %token AND ASC CSV FOR INT KEY NOT OFF SET TOP SUM MIN MAX AVG AS BY IF
-%token IN IS OF ON OR TO
+%token IN IS OF ON OR TO AS_OF
 %token COPY DELIMITER
 
 /*********************************
@@ -228,7 +228,7 @@ struct PARSER_CUST_LTYPE {
 %type <table>		join_clause join_table table_ref_name_no_alias
 %type <expr> 		expr scalar_expr unary_expr binary_expr function_expr star_expr expr_alias parameter_expr opt_default
 %type <expr> 		column_name literal int_literal num_literal string_literal aggregate_expr
-%type <expr> 		comp_expr opt_where join_condition opt_having placeholder_expr
+%type <expr> 		comp_expr opt_where join_condition opt_having placeholder_expr opt_as_of
 %type <table_info>	table_name
 %type <order>		opt_order
 %type <limit>		opt_limit
@@ -296,7 +296,10 @@ statement:
 
 
 preparable_statement:
-		select_statement { $$ = $1; }
+		select_statement opt_as_of {
+			$$ = $1;
+			$1->as_of = $2;
+		}
 	|	create_statement { $$ = $1; }
 	|	insert_statement { $$ = $1; }
 	|	delete_statement { $$ = $1; }
@@ -689,6 +692,12 @@ opt_having:
 		HAVING expr { $$ = $2; }
 	|	/* empty */ { $$ = NULL; }
 
+opt_as_of:
+		AS_OF int_literal { $$ = $2; }
+	|	AS_OF string_literal { $$ = $2; }
+	|	/* empty */ { $$ = NULL; }
+	;
+
 opt_order:
 		ORDER BY expr opt_order_type { $$ = new OrderDescription($4, $3); }
 	|	/* empty */ { $$ = NULL; }
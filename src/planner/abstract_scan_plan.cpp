@@ -0,0 +1,48 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// abstract_scan_plan.cpp
+//
+// Identification: src/planner/abstract_scan_plan.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "planner/abstract_scan_plan.h"
+
+#include "storage/data_table.h"
+
+namespace peloton {
+namespace planner {
+
+const expression::CompiledExpression *AbstractScan::GetCompiledPredicate(
+    const std::vector<common::Value> &params) const {
+  if (predicate_ == nullptr || target_table_ == nullptr) {
+    return nullptr;
+  }
+
+  std::vector<common::Type::TypeId> param_types;
+  param_types.reserve(params.size());
+  for (auto &param : params) {
+    param_types.push_back(param.GetTypeId());
+  }
+
+  std::lock_guard<std::mutex> lock(compiled_predicates_lock_);
+  auto compiled_itr = compiled_predicates_.find(param_types);
+  if (compiled_itr == compiled_predicates_.end()) {
+    // remember the predicates that can not be compiled too
+    compiled_itr =
+        compiled_predicates_.emplace(
+                                param_types,
+                                expression::CompiledExpression::Compile(
+                                    predicate_.get(),
+                                    target_table_->GetSchema(), param_types))
+            .first;
+  }
+  return compiled_itr->second.get();
+}
+
+}  // namespace planner
+}  // namespace peloton
@@ -0,0 +1,60 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_nested_loop_join_plan.cpp
+//
+// Identification: src/planner/index_nested_loop_join_plan.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "planner/index_nested_loop_join_plan.h"
+
+#include "catalog/schema.h"
+#include "expression/abstract_expression.h"
+#include "index/index.h"
+#include "planner/project_info.h"
+
+namespace peloton {
+namespace planner {
+
+IndexNestedLoopJoinPlan::IndexNestedLoopJoinPlan(
+    PelotonJoinType join_type,
+    std::unique_ptr<const expression::AbstractExpression> &&predicate,
+    std::unique_ptr<const ProjectInfo> &&proj_info,
+    std::shared_ptr<const catalog::Schema> &proj_schema,
+    storage::DataTable *inner_table, std::shared_ptr<index::Index> index,
+    const std::vector<oid_t> &outer_key_column_ids,
+    const std::vector<oid_t> &inner_column_ids)
+    : AbstractJoinPlan(join_type, std::move(predicate), std::move(proj_info),
+                       proj_schema),
+      inner_table_(inner_table),
+      index_(index),
+      outer_key_column_ids_(outer_key_column_ids),
+      inner_column_ids_(inner_column_ids) {
+  PL_ASSERT(index_ != nullptr);
+  PL_ASSERT(outer_key_column_ids_.size() ==
+            index_->GetKeySchema()->GetColumnCount());
+}
+
+std::unique_ptr<AbstractPlan> IndexNestedLoopJoinPlan::Copy() const {
+  std::unique_ptr<const expression::AbstractExpression> predicate_copy(
+      GetPredicate() == nullptr ? nullptr : GetPredicate()->Copy());
+
+  std::unique_ptr<const ProjectInfo> proj_info_copy(
+      GetProjInfo() == nullptr ? nullptr : GetProjInfo()->Copy().release());
+
+  std::shared_ptr<const catalog::Schema> schema_copy(
+      GetSchema() == nullptr ? nullptr
+                             : catalog::Schema::CopySchema(GetSchema()));
+
+  return std::unique_ptr<AbstractPlan>(new IndexNestedLoopJoinPlan(
+      GetJoinType(), std::move(predicate_copy), std::move(proj_info_copy),
+      schema_copy, inner_table_, index_, outer_key_column_ids_,
+      inner_column_ids_));
+}
+
+}  // namespace planner
+}  // namespace peloton
@@ -30,6 +30,7 @@ IndexScanPlan::IndexScanPlan(storage::DataTable *table,
       expr_types_(std::move(index_scan_desc.expr_list)),
       values_with_params_(std::move(index_scan_desc.value_list)),
       runtime_keys_(std::move(index_scan_desc.runtime_key_list)),
+      key_list_(index_scan_desc.key_list),
       // Initialize the index scan predicate object and initialize all
       // keys that we could initialize
       index_predicate_() {
@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <map>
 
 #include "common/types.h"
@@ -39,15 +40,22 @@ BackendStatsContext* BackendStatsContext::GetInstance() {
   std::shared_ptr<BackendStatsContext> result(nullptr);
   auto &stats_context_map = GetBackendContextMap();
   if (stats_context_map.Find(this_id, result) == false) {
-    result.reset(new BackendStatsContext(LATENCY_MAX_HISTORY_THREAD, true));
+    result.reset(new BackendStatsContext(true));
     stats_context_map.Insert(this_id, result);
   }
   return result.get();
 }
 
-BackendStatsContext::BackendStatsContext(size_t max_latency_history,
-                                         bool regiser_to_aggregator)
-    : txn_latencies_(LATENCY_METRIC, max_latency_history) {
+BackendStatsContext::BackendStatsContext(bool regiser_to_aggregator)
+    : txn_latencies_(LATENCY_METRIC, "TXN"),
+      log_flush_latencies_(LATENCY_METRIC, "LOG FLUSH") {
+  static const char* query_type_names[QUERY_LATENCY_TYPE_COUNT] = {
+      "SELECT", "INSERT", "UPDATE", "DELETE", "OTHER QUERY"};
+  for (int type_itr = 0; type_itr < QUERY_LATENCY_TYPE_COUNT; type_itr++) {
+    query_latencies_[type_itr].reset(
+        new LatencyMetric(LATENCY_METRIC, query_type_names[type_itr]));
+  }
+
   std::thread::id this_id = std::this_thread::get_id();
   thread_id_ = this_id;
 
@@ -67,20 +75,30 @@ BackendStatsContext::~BackendStatsContext() {}
 // Returns the table metric with the given database ID and table ID
 TableMetric* BackendStatsContext::GetTableMetric(oid_t database_id,
                                                  oid_t table_id) {
-  if (table_metrics_.find(table_id) == table_metrics_.end()) {
-    table_metrics_[table_id] = std::unique_ptr<TableMetric>(
+  auto table_itr = table_metrics_.find(table_id);
+  if (table_itr == table_metrics_.end()) {
+    std::unique_ptr<TableMetric> table_metric(
         new TableMetric{TABLE_METRIC, database_id, table_id});
+    metrics_lock_.Lock();
+    table_itr = table_metrics_.emplace(table_id, std::move(table_metric)).first;
+    metrics_lock_.Unlock();
   }
-  return table_metrics_[table_id].get();
+  return table_itr->second.get();
 }
 
 // Returns the database metric with the given database ID
 DatabaseMetric* BackendStatsContext::GetDatabaseMetric(oid_t database_id) {
-  if (database_metrics_.find(database_id) == database_metrics_.end()) {
-    database_metrics_[database_id] = std::unique_ptr<DatabaseMetric>(
+  auto database_itr = database_metrics_.find(database_id);
+  if (database_itr == database_metrics_.end()) {
+    std::unique_ptr<DatabaseMetric> database_metric(
         new DatabaseMetric{DATABASE_METRIC, database_id});
+    metrics_lock_.Lock();
+    database_itr =
+        database_metrics_.emplace(database_id, std::move(database_metric))
+            .first;
+    metrics_lock_.Unlock();
   }
-  return database_metrics_[database_id].get();
+  return database_itr->second.get();
 }
 
 // Returns the index metric with the given database ID, table ID, and
@@ -107,6 +125,16 @@ LatencyMetric& BackendStatsContext::GetTxnLatencyMetric() {
   return txn_latencies_;
 }
 
+LatencyMetric& BackendStatsContext::GetQueryLatencyMetric(
+    QueryLatencyType query_type) {
+  PL_ASSERT(query_type < QUERY_LATENCY_TYPE_COUNT);
+  return *query_latencies_[query_type];
+}
+
+LatencyMetric& BackendStatsContext::GetLogFlushLatencyMetric() {
+  return log_flush_latencies_;
+}
+
 void BackendStatsContext::IncrementTableReads(oid_t tile_group_id) {
   oid_t table_id =
       catalog::Manager::GetInstance().GetTileGroup(tile_group_id)->GetTableId();
@@ -220,9 +248,25 @@ void BackendStatsContext::IncrementTxnAborted(oid_t database_id) {
 void BackendStatsContext::InitQueryMetric(
     const std::shared_ptr<Statement> statement,
     const std::shared_ptr<QueryMetric::QueryParams> params) {
+  // The query type is the first word of the query as the client typed it
+  std::string query_type = statement->GetQueryType();
+  std::transform(query_type.begin(), query_type.end(), query_type.begin(),
+                 ::toupper);
+  QueryLatencyType latency_type = QUERY_LATENCY_TYPE_OTHER;
+  if (query_type == "SELECT") {
+    latency_type = QUERY_LATENCY_TYPE_SELECT;
+  } else if (query_type == "INSERT") {
+    latency_type = QUERY_LATENCY_TYPE_INSERT;
+  } else if (query_type == "UPDATE") {
+    latency_type = QUERY_LATENCY_TYPE_UPDATE;
+  } else if (query_type == "DELETE") {
+    latency_type = QUERY_LATENCY_TYPE_DELETE;
+  }
+
   // TODO currently all queries belong to DEFAULT_DB
-  ongoing_query_metric_.reset(new QueryMetric(
-      QUERY_METRIC, statement->GetQueryString(), params, DEFAULT_DB_ID));
+  ongoing_query_metric_.reset(
+      new QueryMetric(QUERY_METRIC, statement->GetQueryString(), params,
+                      DEFAULT_DB_ID, latency_type));
 }
 
 //===--------------------------------------------------------------------===//
@@ -233,6 +277,16 @@ void BackendStatsContext::Aggregate(BackendStatsContext& source) {
   // Aggregate all global metrics
   txn_latencies_.Aggregate(source.txn_latencies_);
   txn_latencies_.ComputeLatencies();
+  for (int type_itr = 0; type_itr < QUERY_LATENCY_TYPE_COUNT; type_itr++) {
+    query_latencies_[type_itr]->Aggregate(*source.query_latencies_[type_itr]);
+    query_latencies_[type_itr]->ComputeLatencies();
+  }
+  log_flush_latencies_.Aggregate(source.log_flush_latencies_);
+  log_flush_latencies_.ComputeLatencies();
+
+  // The counters are read while the source thread updates them, only the
+  // maps must not change meanwhile
+  source.metrics_lock_.Lock();
 
   // Aggregate all per-database metrics
   for (auto& database_item : source.database_metrics_) {
@@ -245,6 +299,7 @@ void BackendStatsContext::Aggregate(BackendStatsContext& source) {
                    table_item.second->GetTableId())
         ->Aggregate(*table_item.second);
   }
+  source.metrics_lock_.Unlock();
 
   // Aggregate all per-index metrics
   for (auto id : index_ids_) {
@@ -267,6 +322,10 @@ void BackendStatsContext::Aggregate(BackendStatsContext& source) {
 
 void BackendStatsContext::Reset() {
   txn_latencies_.Reset();
+  for (auto& query_latencies : query_latencies_) {
+    query_latencies->Reset();
+  }
+  log_flush_latencies_.Reset();
 
   for (auto& database_item : database_metrics_) {
     database_item.second->Reset();
@@ -286,10 +345,7 @@ void BackendStatsContext::Reset() {
     oid_t database_id = database->GetOid();
 
     // Reset database metrics
-    if (database_metrics_.find(database_id) == database_metrics_.end()) {
-      database_metrics_[database_id] = std::unique_ptr<DatabaseMetric>(
-          new DatabaseMetric{DATABASE_METRIC, database_id});
-    }
+    GetDatabaseMetric(database_id);
 
     // Reset table metrics
     oid_t num_tables = database->GetTableCount();
@@ -297,10 +353,7 @@ void BackendStatsContext::Reset() {
       auto table = database->GetTable(j);
       oid_t table_id = table->GetOid();
 
-      if (table_metrics_.find(table_id) == table_metrics_.end()) {
-        table_metrics_[table_id] = std::unique_ptr<TableMetric>(
-            new TableMetric{TABLE_METRIC, database_id, table_id});
-      }
+      GetTableMetric(database_id, table_id);
 
       // Reset indexes metrics
       oid_t num_indexes = table->GetIndexCount();
@@ -321,7 +374,11 @@ void BackendStatsContext::Reset() {
 std::string BackendStatsContext::ToString() const {
   std::stringstream ss;
 
-  ss << txn_latencies_.GetInfo() << std::endl;
+  ss << txn_latencies_.GetInfo();
+  for (auto& query_latencies : query_latencies_) {
+    ss << query_latencies->GetInfo();
+  }
+  ss << log_flush_latencies_.GetInfo() << std::endl;
 
   for (auto& database_item : database_metrics_) {
     oid_t database_id = database_item.second->GetDatabaseId();
@@ -360,6 +417,8 @@ void BackendStatsContext::CompleteQueryMetric() {
   if (ongoing_query_metric_ != nullptr) {
     ongoing_query_metric_->GetProcessorMetric().RecordTime();
     ongoing_query_metric_->GetQueryLatency().RecordLatency();
+    GetQueryLatencyMetric(ongoing_query_metric_->GetQueryType())
+        .RecordLatency(ongoing_query_metric_->GetQueryLatency().GetLatency());
     completed_query_metrics_.Enqueue(ongoing_query_metric_);
     ongoing_query_metric_.reset();
     LOG_TRACE("Ongoing query completed");
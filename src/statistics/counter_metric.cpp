@@ -22,7 +22,7 @@ CounterMetric::CounterMetric(MetricType type) : AbstractMetric(type) {
 
 void CounterMetric::Aggregate(AbstractMetric &source) {
   PL_ASSERT(source.GetType() == COUNTER_METRIC);
-  count_ += static_cast<CounterMetric &>(source).GetCounter();
+  Increment(static_cast<CounterMetric &>(source).GetCounter());
 }
 
 }  // namespace stats
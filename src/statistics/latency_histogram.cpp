@@ -0,0 +1,170 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// latency_histogram.cpp
+//
+// Identification: src/statistics/latency_histogram.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <cmath>
+
+#include "statistics/latency_histogram.h"
+
+namespace peloton {
+namespace stats {
+
+const size_t LatencyHistogram::LINEAR_BUCKET_BITS;
+const size_t LatencyHistogram::LINEAR_BUCKET_COUNT;
+const size_t LatencyHistogram::MAX_LATENCY_BITS;
+const size_t LatencyHistogram::BUCKET_COUNT;
+
+size_t LatencyHistogram::GetBucket(const uint64_t &latency) {
+  if (latency < LINEAR_BUCKET_COUNT) {
+    return latency;
+  }
+
+  // the highest set bit selects the power of two, the bits below it select
+  // the bucket within it
+  size_t exponent = 63 - __builtin_clzll(latency);
+  if (exponent >= MAX_LATENCY_BITS) {
+    return BUCKET_COUNT - 1;
+  }
+  size_t shift = exponent - LINEAR_BUCKET_BITS;
+  size_t offset = (latency >> shift) & (LINEAR_BUCKET_COUNT - 1);
+  return (shift + 1) * LINEAR_BUCKET_COUNT + offset;
+}
+
+uint64_t LatencyHistogram::GetBucketLowerBound(const size_t &bucket) {
+  if (bucket == 0) {
+    return 0;
+  }
+  return GetBucketUpperBound(bucket - 1) + 1;
+}
+
+uint64_t LatencyHistogram::GetBucketUpperBound(const size_t &bucket) {
+  if (bucket < LINEAR_BUCKET_COUNT) {
+    return bucket;
+  }
+
+  size_t shift = bucket / LINEAR_BUCKET_COUNT - 1;
+  uint64_t offset = bucket % LINEAR_BUCKET_COUNT;
+  uint64_t lower_bound = (LINEAR_BUCKET_COUNT + offset) << shift;
+  return lower_bound + (1UL << shift) - 1;
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram &source) {
+  for (size_t bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+    auto count = source.counts_[bucket].load(std::memory_order_relaxed);
+    if (count != 0) {
+      Increment(counts_[bucket], count);
+    }
+  }
+  Increment(count_, source.count_.load(std::memory_order_relaxed));
+  Increment(total_, source.total_.load(std::memory_order_relaxed));
+  auto source_min = source.min_.load(std::memory_order_relaxed);
+  if (source_min < min_.load(std::memory_order_relaxed)) {
+    min_.store(source_min, std::memory_order_relaxed);
+  }
+  auto source_max = source.GetMax();
+  if (source_max > GetMax()) {
+    max_.store(source_max, std::memory_order_relaxed);
+  }
+}
+
+void LatencyHistogram::MergeSince(const LatencyHistogram &source,
+                                  LatencyHistogram &collected) {
+  uint64_t count = 0;
+  size_t min_bucket = BUCKET_COUNT;
+  size_t max_bucket = 0;
+  for (size_t bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+    auto source_count = source.counts_[bucket].load(std::memory_order_relaxed);
+    auto collected_count =
+        collected.counts_[bucket].load(std::memory_order_relaxed);
+    if (source_count == collected_count) {
+      continue;
+    }
+    collected.counts_[bucket].store(source_count, std::memory_order_relaxed);
+
+    // the source is reset by its owner once in a while
+    auto delta = source_count > collected_count ? source_count - collected_count
+                                                : source_count;
+    if (delta == 0) {
+      continue;
+    }
+    Increment(counts_[bucket], delta);
+    count += delta;
+    min_bucket = std::min(min_bucket, bucket);
+    max_bucket = bucket;
+  }
+
+  auto source_total = source.total_.load(std::memory_order_relaxed);
+  auto collected_total = collected.total_.load(std::memory_order_relaxed);
+  collected.total_.store(source_total, std::memory_order_relaxed);
+  if (count == 0) {
+    return;
+  }
+  Increment(count_, count);
+  Increment(total_, source_total >= collected_total
+                        ? source_total - collected_total
+                        : source_total);
+
+  // the extremes over the whole life of the source bound the buckets
+  auto source_min = std::max(GetBucketLowerBound(min_bucket),
+                             source.min_.load(std::memory_order_relaxed));
+  if (source_min < min_.load(std::memory_order_relaxed)) {
+    min_.store(source_min, std::memory_order_relaxed);
+  }
+  auto source_max =
+      std::min(GetBucketUpperBound(max_bucket), source.GetMax());
+  if (source_max > GetMax()) {
+    max_.store(source_max, std::memory_order_relaxed);
+  }
+}
+
+void LatencyHistogram::Reset() {
+  for (auto &count : counts_) {
+    count.store(0, std::memory_order_relaxed);
+  }
+  count_.store(0, std::memory_order_relaxed);
+  total_.store(0, std::memory_order_relaxed);
+  min_.store(UINT64_MAX, std::memory_order_relaxed);
+  max_.store(0, std::memory_order_relaxed);
+}
+
+double LatencyHistogram::GetAverage() const {
+  auto count = GetCount();
+  if (count == 0) {
+    return 0;
+  }
+  return (double)total_.load(std::memory_order_relaxed) / count;
+}
+
+uint64_t LatencyHistogram::GetPercentile(const double &fraction) const {
+  // the buckets may be read while the owner records, so the rank is
+  // computed from the buckets themselves
+  uint64_t count = 0;
+  for (auto &bucket_count : counts_) {
+    count += bucket_count.load(std::memory_order_relaxed);
+  }
+  if (count == 0) {
+    return 0;
+  }
+
+  uint64_t rank = std::max<uint64_t>(1, std::ceil(fraction * count));
+  uint64_t seen = 0;
+  for (size_t bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+    seen += counts_[bucket].load(std::memory_order_relaxed);
+    if (seen >= rank) {
+      return std::min(GetBucketUpperBound(bucket), GetMax());
+    }
+  }
+  return GetMax();
+}
+
+}  // namespace stats
+}  // namespace peloton
@@ -10,103 +10,55 @@
 //
 //===----------------------------------------------------------------------===//
 
-#include <algorithm>
-
 #include "statistics/latency_metric.h"
 #include "common/macros.h"
 
 namespace peloton {
 namespace stats {
 
-LatencyMetric::LatencyMetric(MetricType type, size_t max_history)
-    : AbstractMetric(type) {
-  max_history_ = max_history;
-  latencies_.SetCapaciry(max_history_);
-}
+LatencyMetric::LatencyMetric(MetricType type, const std::string &name)
+    : AbstractMetric(type), name_(name) {}
 
 void LatencyMetric::Aggregate(AbstractMetric& source) {
   PL_ASSERT(source.GetType() == LATENCY_METRIC);
 
+  // The source histogram may be written by its owner while we merge it, in
+  // which case the latencies recorded meanwhile show up in the next round.
+  // Only the latencies since the previous round are taken, so that the
+  // percentiles cover a single aggregation interval.
   LatencyMetric& latency_metric = static_cast<LatencyMetric&>(source);
-  CircularBuffer<double> source_latencies = latency_metric.Copy();
-  {
-    // This method should only ever be called by the aggregator which
-    // is the only thread to access its own latencies_, but we lock
-    // here just to be safe. Either way the aggregator should never
-    // have to block here.
-    std::lock_guard<std::mutex> lock(latency_mutex_);
-    for (double latency_value : source_latencies) {
-      latencies_.PushBack(latency_value);
-    }
-  }
-}
-
-CircularBuffer<double> LatencyMetric::Copy() {
-  CircularBuffer<double> new_buffer;
-  {
-    // This method is only called by the aggregator to make
-    // a copy of a worker thread's latencies_.
-    std::lock_guard<std::mutex> lock(latency_mutex_);
-    new_buffer = latencies_;
-  }
-  return new_buffer;
+  latencies_.MergeSince(latency_metric.latencies_, latency_metric.collected_);
 }
 
 const std::string LatencyMetric::GetInfo() const {
   std::stringstream ss;
-  ss << "TXN LATENCY (ms): [ ";
-  ss << "average=" << latency_measurements_.average_;
+  ss << name_ << " LATENCY (ms): [ ";
+  ss << "count=" << latency_measurements_.count_;
+  ss << ", average=" << latency_measurements_.average_;
   ss << ", min=" << latency_measurements_.min_;
-  ss << ", 25th-%-tile=" << latency_measurements_.perc_25th_;
   ss << ", median=" << latency_measurements_.median_;
-  ss << ", 75th-%-tile=" << latency_measurements_.perc_75th_;
   ss << ", 99th-%-tile=" << latency_measurements_.perc_99th_;
+  ss << ", 99.9th-%-tile=" << latency_measurements_.perc_999th_;
   ss << ", max=" << latency_measurements_.max_;
   ss << " ]" << std::endl;
   return ss.str();
 }
 
 void LatencyMetric::ComputeLatencies() {
-  // LatencyMeasurements measurements;
-  if (latencies_.IsEmpty()) {
+  if (latencies_.GetCount() == 0) {
     return;
   }
-  std::vector<double> sorted_latencies;
-  double latency_sum = 0.0;
-  {
-    // This method is called only by the aggregator when
-    // after it's aggregated all worker threads latencies
-    // into its own latencies_ buffer. Still we lock here
-    // just in case.
-    std::lock_guard<std::mutex> lock(latency_mutex_);
-    for (double latency : latencies_) {
-      sorted_latencies.push_back(latency);
-      latency_sum += latency;
-    }
-  }
-
-  std::sort(sorted_latencies.begin(), sorted_latencies.end());
-  size_t latencies_size = sorted_latencies.size();
 
-  // Calculate average
-  latency_measurements_.average_ = latency_sum / latencies_size;
-
-  // Min, max, median, and percentiles are values at indexes
-  latency_measurements_.min_ = sorted_latencies[0];
-  latency_measurements_.max_ = sorted_latencies[latencies_size - 1];
-  size_t mid = latencies_size / 2;
-  if (latencies_size % 2 == 0 || latencies_size == 1) {
-    latency_measurements_.median_ = sorted_latencies[mid];
-  } else {
-    latency_measurements_.median_ =
-        (sorted_latencies[mid - 1] + sorted_latencies[mid]) / 2;
-  }
-  size_t index_25th = (size_t)(0.25 * latencies_size);
-  size_t index_75th = (size_t)(0.75 * latencies_size);
-  size_t index_99th = (size_t)(0.99 * latencies_size);
-  latency_measurements_.perc_25th_ = sorted_latencies[index_25th];
-  latency_measurements_.perc_75th_ = sorted_latencies[index_75th];
-  latency_measurements_.perc_99th_ = sorted_latencies[index_99th];
+  // The histogram is in microseconds
+  latency_measurements_.count_ = latencies_.GetCount();
+  latency_measurements_.average_ = latencies_.GetAverage() / 1000;
+  latency_measurements_.min_ = (double)latencies_.GetMin() / 1000;
+  latency_measurements_.max_ = (double)latencies_.GetMax() / 1000;
+  latency_measurements_.median_ = (double)latencies_.GetPercentile(0.5) / 1000;
+  latency_measurements_.perc_99th_ =
+      (double)latencies_.GetPercentile(0.99) / 1000;
+  latency_measurements_.perc_999th_ =
+      (double)latencies_.GetPercentile(0.999) / 1000;
 }
 
 }  // namespace stats
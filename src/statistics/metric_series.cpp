@@ -0,0 +1,102 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// metric_series.cpp
+//
+// Identification: src/statistics/metric_series.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+
+#include "catalog/catalog.h"
+#include "common/config.h"
+#include "common/macros.h"
+#include "statistics/metric_series.h"
+#include "storage/data_table.h"
+
+namespace peloton {
+namespace stats {
+
+MetricSeries::MetricSeries(const size_t &capacity) : rows_(capacity) {
+  PL_ASSERT(capacity > 0);
+}
+
+MetricSeries *MetricSeries::GetInstance(const std::string &table_name) {
+  // a series per metric table, created once and never changed afterwards
+  static std::unordered_map<std::string, std::unique_ptr<MetricSeries>>
+      metric_series = [] {
+        std::unordered_map<std::string, std::unique_ptr<MetricSeries>> series;
+        size_t capacity = std::max<size_t>(1, FLAGS_stats_series_size);
+        for (auto name : {DATABASE_METRIC_NAME, TABLE_METRIC_NAME,
+                          INDEX_METRIC_NAME, QUERY_METRIC_NAME,
+                          WAIT_METRIC_NAME, EXECUTION_METRIC_NAME}) {
+          series[name].reset(new MetricSeries(capacity));
+        }
+        return series;
+      }();
+
+  auto series_itr = metric_series.find(table_name);
+  if (series_itr == metric_series.end()) {
+    return nullptr;
+  }
+  return series_itr->second.get();
+}
+
+MetricSeries *MetricSeries::GetInstance(const storage::DataTable *table) {
+  // the metric tables are all in the catalog database
+  if (table == nullptr || table->GetDatabaseOid() != START_OID) {
+    return nullptr;
+  }
+  return GetInstance(table->GetName());
+}
+
+void MetricSeries::Append(MetricRow &&row) {
+  rows_lock_.Lock();
+  rows_[next_ % rows_.size()].swap(row);
+  next_++;
+  rows_lock_.Unlock();
+}
+
+std::vector<MetricRow> MetricSeries::GetRows() const {
+  std::vector<MetricRow> rows;
+  rows_lock_.Lock();
+  uint64_t size = std::min<uint64_t>(next_, rows_.size());
+  rows.reserve(size);
+  for (uint64_t row_itr = next_ - size; row_itr < next_; row_itr++) {
+    rows.push_back(rows_[row_itr % rows_.size()]);
+  }
+  rows_lock_.Unlock();
+  return rows;
+}
+
+size_t MetricSeries::GetSize() const {
+  rows_lock_.Lock();
+  size_t size = std::min<uint64_t>(next_, rows_.size());
+  rows_lock_.Unlock();
+  return size;
+}
+
+uint64_t MetricSeries::GetAppendCount() const {
+  rows_lock_.Lock();
+  uint64_t append_count = next_;
+  rows_lock_.Unlock();
+  return append_count;
+}
+
+void MetricSeries::Clear() {
+  rows_lock_.Lock();
+  for (auto &row : rows_) {
+    row.clear();
+  }
+  next_ = 0;
+  rows_lock_.Unlock();
+}
+
+}  // namespace stats
+}  // namespace peloton
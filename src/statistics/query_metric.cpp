@@ -21,12 +21,14 @@ namespace stats {
 
 QueryMetric::QueryMetric(MetricType type, const std::string& query_name,
                          std::shared_ptr<QueryParams> query_params,
-                         const oid_t database_id)
+                         const oid_t database_id,
+                         QueryLatencyType query_type)
     : AbstractMetric(type),
       database_id_(database_id),
       query_name_(query_name),
-      query_params_(query_params) {
-  latency_metric_.StartTimer();
+      query_params_(query_params),
+      query_type_(query_type) {
+  latency_timer_.StartTimer();
   processor_metric_.StartTimer();
   LOG_TRACE("Query metric initialized");
 }
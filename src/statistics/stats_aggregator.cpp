@@ -19,13 +19,14 @@
 #include "statistics/backend_stats_context.h"
 #include "catalog/catalog.h"
 #include "catalog/catalog_util.h"
+#include "statistics/metric_series.h"
 
 namespace peloton {
 namespace stats {
 
 StatsAggregator::StatsAggregator(int64_t aggregation_interval_ms)
-    : stats_history_(0, false),
-      aggregated_stats_(LATENCY_MAX_HISTORY_AGGREGATOR, false),
+    : stats_history_(false),
+      aggregated_stats_(false),
       aggregation_interval_ms_(aggregation_interval_ms),
       thread_number_(0),
       total_prev_txn_committed_(0) {
@@ -78,13 +79,18 @@ void StatsAggregator::Aggregate(int64_t &interval_cnt, double &alpha,
   aggregated_stats_.Reset();
   std::thread::id this_id = aggregator_thread_.get_id();
 
-  for (auto &val : backend_stats_) {
-    // Exclude the txn stats generated by the aggregator thread
-    if (val.first != this_id) {
-      aggregated_stats_.Aggregate((*val.second));
+  // The latencies collected from a context are tracked in the context, so
+  // the contexts must not be aggregated into the history meanwhile
+  {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    for (auto &val : backend_stats_) {
+      // Exclude the txn stats generated by the aggregator thread
+      if (val.first != this_id) {
+        aggregated_stats_.Aggregate((*val.second));
+      }
     }
+    aggregated_stats_.Aggregate(stats_history_);
   }
-  aggregated_stats_.Aggregate(stats_history_);
   LOG_INFO("%s\n", aggregated_stats_.ToString().c_str());
 
   int64_t current_txns_committed = 0;
@@ -130,10 +136,9 @@ void StatsAggregator::Aggregate(int64_t &interval_cnt, double &alpha,
   }
 }
 
-void StatsAggregator::UpdateQueryMetrics(int64_t time_stamp,
-                                         concurrency::Transaction *txn) {
+void StatsAggregator::UpdateQueryMetrics(int64_t time_stamp) {
   // Get the target query metrics table
-  LOG_TRACE("Inserting Query Metric Tuples");
+  LOG_TRACE("Appending Query Metric Rows");
   auto query_metrics_table = GetMetricTable(QUERY_METRIC_NAME);
 
   std::shared_ptr<QueryMetric> query_metric;
@@ -145,7 +150,8 @@ void StatsAggregator::UpdateQueryMetrics(int64_t time_stamp,
     auto updates = table_access.GetUpdates();
     auto deletes = table_access.GetDeletes();
     auto inserts = table_access.GetInserts();
-    auto latency = query_metric->GetQueryLatency().GetFirstLatencyValue();
+    // In milliseconds
+    auto latency = query_metric->GetQueryLatency().GetLatency() / 1000;
     auto cpu_system = query_metric->GetProcessorMetric().GetSystemDuration();
     auto cpu_user = query_metric->GetProcessorMetric().GetUserDuration();
 
@@ -169,19 +175,86 @@ void StatsAggregator::UpdateQueryMetrics(int64_t time_stamp,
         query_metrics_table->GetSchema(), query_metric->GetName(),
         query_metric->GetDatabaseId(), num_params, type_buf, format_buf,
         value_buf, reads, updates, deletes, inserts, (int64_t)latency,
-        (int64_t)(cpu_system + cpu_user), time_stamp, pool_.get());
-    catalog::InsertTuple(query_metrics_table, std::move(query_tuple), txn);
-    LOG_TRACE("Query Metric Tuple inserted");
+        (int64_t)(cpu_system + cpu_user), time_stamp,
+        query_metric->GetOperatorProfile(), pool_.get());
+    AppendMetricRow(QUERY_METRIC_NAME, std::move(query_tuple));
+    LOG_TRACE("Query Metric Row appended");
   }
 }
 
-void StatsAggregator::UpdateMetrics() {
-  // All tuples are inserted in a single txn
-  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
-  auto txn = txn_manager.BeginTransaction();
+void StatsAggregator::UpdateWaitMetrics(int64_t time_stamp) {
+  LOG_TRACE("Appending Wait Metric Rows");
+  auto wait_metrics_table = GetMetricTable(WAIT_METRIC_NAME);
+
+  for (int offset = 0; offset < WAIT_CLASS_COUNT; offset++) {
+    auto wait_class = static_cast<WaitClass>(offset);
+    auto wait_count = WaitEvents::GetWaitCount(wait_class);
+    auto wait_time_ns = WaitEvents::GetWaitTime(wait_class);
+    auto interval_count = wait_count - prev_wait_count_[offset];
+    auto interval_time_ns = wait_time_ns - prev_wait_time_ns_[offset];
+    prev_wait_count_[offset] = wait_count;
+    prev_wait_time_ns_[offset] = wait_time_ns;
+
+    // Only the classes that waited in this interval are written
+    if (interval_count == 0) {
+      continue;
+    }
 
-  // Get the target table metrics table
-  LOG_TRACE("Inserting stat tuples into catalog database..");
+    // In microseconds
+    auto wait_tuple = catalog::GetWaitMetricsCatalogTuple(
+        wait_metrics_table->GetSchema(),
+        WaitEvents::WaitClassToString(wait_class), (int64_t)interval_count,
+        (int64_t)(interval_time_ns / 1000), time_stamp, pool_.get());
+    AppendMetricRow(WAIT_METRIC_NAME, std::move(wait_tuple));
+    LOG_TRACE("Wait Metric Row appended");
+  }
+}
+
+void StatsAggregator::UpdateExecutionMetrics(int64_t time_stamp) {
+  LOG_TRACE("Appending Execution Metric Rows");
+  auto execution_metrics_table = GetMetricTable(EXECUTION_METRIC_NAME);
+  auto &execution_pool = wire::QueryExecutionPool::GetInstance();
+
+  for (int offset = 0; offset < wire::EXECUTION_STAGE_COUNT; offset++) {
+    auto stage = static_cast<wire::ExecutionStage>(offset);
+    auto stage_count = execution_pool.GetStageCount(stage);
+    auto stage_latency = execution_pool.GetTotalLatency(stage);
+    auto depth = execution_pool.GetStageDepth(stage);
+
+    // The statistics of the pool might have been reset in between
+    if (stage_count < prev_stage_count_[offset] ||
+        stage_latency < prev_stage_latency_[offset]) {
+      prev_stage_count_[offset] = 0;
+      prev_stage_latency_[offset] = 0;
+    }
+    auto interval_count = stage_count - prev_stage_count_[offset];
+    auto interval_latency = stage_latency - prev_stage_latency_[offset];
+    prev_stage_count_[offset] = stage_count;
+    prev_stage_latency_[offset] = stage_latency;
+
+    // Only the stages that were used in this interval or hold connections
+    // are written
+    if (interval_count == 0 && depth == 0) {
+      continue;
+    }
+
+    // In microseconds
+    auto avg_latency = interval_count == 0 ? 0 : interval_latency /
+                                                     interval_count;
+    auto execution_tuple = catalog::GetExecutionMetricsCatalogTuple(
+        execution_metrics_table->GetSchema(),
+        wire::QueryExecutionPool::ExecutionStageToString(stage),
+        (int64_t)interval_count, (int64_t)avg_latency,
+        (int64_t)interval_latency, (int64_t)depth, time_stamp, pool_.get());
+    AppendMetricRow(EXECUTION_METRIC_NAME, std::move(execution_tuple));
+    LOG_TRACE("Execution Metric Row appended");
+  }
+}
+
+void StatsAggregator::UpdateMetrics() {
+  // The rows are appended to the series of the metric tables, no
+  // transaction is involved
+  LOG_TRACE("Appending stat rows to the metric series..");
   auto catalog = catalog::Catalog::GetInstance();
   auto database_metrics_table = GetMetricTable(DATABASE_METRIC_NAME);
 
@@ -204,22 +277,39 @@ void StatsAggregator::UpdateMetrics() {
         database_metrics_table->GetSchema(), database_oid, txn_committed,
         txn_aborted, time_stamp);
 
-    catalog::InsertTuple(database_metrics_table, std::move(db_tuple), txn);
-    LOG_TRACE("DB Metric Tuple inserted");
+    AppendMetricRow(DATABASE_METRIC_NAME, std::move(db_tuple));
+    LOG_TRACE("DB Metric Row appended");
 
     // Update all the indices of this database
-    UpdateTableMetrics(database, time_stamp, txn);
+    UpdateTableMetrics(database, time_stamp);
   }
 
   // Update all query metrics
-  UpdateQueryMetrics(time_stamp, txn);
+  UpdateQueryMetrics(time_stamp);
 
-  txn_manager.CommitTransaction(txn);
+  // Update the wait metrics
+  UpdateWaitMetrics(time_stamp);
+
+  // Update the query execution pool metrics
+  UpdateExecutionMetrics(time_stamp);
+}
+
+void StatsAggregator::AppendMetricRow(const std::string &table_name,
+                                      std::unique_ptr<storage::Tuple> tuple) {
+  auto metric_series = MetricSeries::GetInstance(table_name);
+  PL_ASSERT(metric_series != nullptr);
+
+  MetricRow row;
+  auto column_count = tuple->GetSchema()->GetColumnCount();
+  row.reserve(column_count);
+  for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+    row.push_back(tuple->GetValue(column_itr));
+  }
+  metric_series->Append(std::move(row));
 }
 
 void StatsAggregator::UpdateTableMetrics(storage::Database *database,
-                                         int64_t time_stamp,
-                                         concurrency::Transaction *txn) {
+                                         int64_t time_stamp) {
   // Get the target table metrics table
   auto database_oid = database->GetOid();
   auto table_metrics_table = GetMetricTable(TABLE_METRIC_NAME);
@@ -241,17 +331,16 @@ void StatsAggregator::UpdateTableMetrics(storage::Database *database,
     auto table_tuple = catalog::GetTableMetricsCatalogTuple(
         table_metrics_table->GetSchema(), database_oid, table_oid, reads,
         updates, deletes, inserts, time_stamp);
-    catalog::InsertTuple(table_metrics_table, std::move(table_tuple), txn);
-    LOG_TRACE("Table Metric Tuple inserted");
+    AppendMetricRow(TABLE_METRIC_NAME, std::move(table_tuple));
+    LOG_TRACE("Table Metric Row appended");
 
-    UpdateIndexMetrics(database, table, time_stamp, txn);
+    UpdateIndexMetrics(database, table, time_stamp);
   }
 }
 
 void StatsAggregator::UpdateIndexMetrics(storage::Database *database,
                                          storage::DataTable *table,
-                                         int64_t time_stamp,
-                                         concurrency::Transaction *txn) {
+                                         int64_t time_stamp) {
   // Get the target index metrics table
   auto index_metrics_table = GetMetricTable(INDEX_METRIC_NAME);
 
@@ -275,7 +364,7 @@ void StatsAggregator::UpdateIndexMetrics(storage::Database *database,
         index_metrics_table->GetSchema(), database_oid, table_oid, index_oid,
         reads, deletes, inserts, time_stamp);
 
-    catalog::InsertTuple(index_metrics_table, std::move(index_tuple), txn);
+    AppendMetricRow(INDEX_METRIC_NAME, std::move(index_tuple));
   }
 }
 
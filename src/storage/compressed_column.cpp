@@ -0,0 +1,413 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compressed_column.cpp
+//
+// Identification: src/storage/compressed_column.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+
+#include "common/exception.h"
+#include "common/macros.h"
+#include "common/value_factory.h"
+#include "storage/compressed_column.h"
+
+namespace peloton {
+namespace storage {
+
+//===--------------------------------------------------------------------===//
+// Bit-Packed Vector
+//===--------------------------------------------------------------------===//
+
+BitPackedVector::BitPackedVector(const size_t &size, const uint64_t &max_value)
+    : bit_width_(0), mask_(0), size_(size) {
+  while (bit_width_ < 64 && (max_value >> bit_width_) != 0) {
+    bit_width_++;
+  }
+  mask_ = (bit_width_ == 64) ? ~0ULL : ((1ULL << bit_width_) - 1);
+  words_.resize((size_ * bit_width_ + 63) / 64, 0);
+}
+
+void BitPackedVector::Set(const oid_t &offset, const uint64_t &value) {
+  PL_ASSERT(offset < size_);
+  PL_ASSERT((value & ~mask_) == 0);
+  if (bit_width_ == 0) {
+    return;
+  }
+  size_t bit_offset = offset * bit_width_;
+  size_t word_offset = bit_offset / 64;
+  size_t word_bit_offset = bit_offset % 64;
+
+  words_[word_offset] &= ~(mask_ << word_bit_offset);
+  words_[word_offset] |= value << word_bit_offset;
+  if (word_bit_offset + bit_width_ > 64) {
+    size_t spilled_bits = 64 - word_bit_offset;
+    words_[word_offset + 1] &= ~(mask_ >> spilled_bits);
+    words_[word_offset + 1] |= value >> spilled_bits;
+  }
+}
+
+//===--------------------------------------------------------------------===//
+// Compressed Column
+//===--------------------------------------------------------------------===//
+
+CompressedColumn *CompressedColumn::Compress(
+    const std::vector<common::Value> &values,
+    const common::Type::TypeId &value_type) {
+  std::vector<std::unique_ptr<CompressedColumn>> candidates;
+
+  candidates.emplace_back(new DictionaryCompressedColumn(values, value_type));
+  candidates.emplace_back(new RunLengthCompressedColumn(values, value_type));
+  if (FrameOfReferenceCompressedColumn::IsEncodable(values, value_type)) {
+    candidates.emplace_back(
+        new FrameOfReferenceCompressedColumn(values, value_type));
+  }
+
+  auto best_candidate = std::min_element(
+      candidates.begin(), candidates.end(),
+      [](const std::unique_ptr<CompressedColumn> &a,
+         const std::unique_ptr<CompressedColumn> &b) {
+        return a->GetSize() < b->GetSize();
+      });
+
+  return best_candidate->release();
+}
+
+bool CompressedColumn::Compare(const common::Value &value,
+                               const ExpressionType &comparison_type,
+                               const common::Value &constant) {
+  switch (comparison_type) {
+    case EXPRESSION_TYPE_COMPARE_EQUAL:
+      return value.CompareEquals(constant).IsTrue();
+    case EXPRESSION_TYPE_COMPARE_NOTEQUAL:
+      return value.CompareNotEquals(constant).IsTrue();
+    case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+      return value.CompareLessThan(constant).IsTrue();
+    case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+      return value.CompareGreaterThan(constant).IsTrue();
+    case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+      return value.CompareLessThanEquals(constant).IsTrue();
+    case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+      return value.CompareGreaterThanEquals(constant).IsTrue();
+    default:
+      throw Exception("Invalid comparison expression type.");
+  }
+}
+
+size_t CompressedColumn::GetValueSize(const common::Value &value) {
+  auto value_type = value.GetTypeId();
+  if ((value_type == common::Type::VARCHAR ||
+       value_type == common::Type::VARBINARY) &&
+      value.IsNull() == false) {
+    return sizeof(common::Value) + value.GetLength();
+  }
+  return sizeof(common::Value);
+}
+
+//===--------------------------------------------------------------------===//
+// Dictionary
+//===--------------------------------------------------------------------===//
+
+DictionaryCompressedColumn::DictionaryCompressedColumn(
+    const std::vector<common::Value> &values,
+    const common::Type::TypeId &value_type)
+    : CompressedColumn(value_type, values.size()) {
+  std::unordered_map<common::Value, uint64_t, common::Value::hash,
+                     common::Value::equal_to> value_codes;
+  std::vector<uint64_t> codes;
+  codes.reserve(values.size());
+
+  // nulls never compare equal, so they share a single code
+  uint64_t null_code = 0;
+  bool has_null = false;
+
+  for (auto &value : values) {
+    if (value.IsNull()) {
+      if (has_null == false) {
+        has_null = true;
+        null_code = dictionary_.size();
+        dictionary_.push_back(value);
+      }
+      codes.push_back(null_code);
+      continue;
+    }
+
+    auto value_code = value_codes.find(value);
+    if (value_code == value_codes.end()) {
+      value_code = value_codes.emplace(value, dictionary_.size()).first;
+      dictionary_.push_back(value);
+    }
+    codes.push_back(value_code->second);
+  }
+
+  uint64_t max_code = dictionary_.empty() ? 0 : dictionary_.size() - 1;
+  codes_ = BitPackedVector(codes.size(), max_code);
+  for (oid_t tuple_itr = 0; tuple_itr < codes.size(); tuple_itr++) {
+    codes_.Set(tuple_itr, codes[tuple_itr]);
+  }
+}
+
+common::Value DictionaryCompressedColumn::GetValue(
+    const oid_t &tuple_offset) const {
+  PL_ASSERT(tuple_offset < tuple_count_);
+  return dictionary_[codes_.Get(tuple_offset)];
+}
+
+void DictionaryCompressedColumn::Evaluate(const ExpressionType &comparison_type,
+                                          const common::Value &constant,
+                                          std::vector<bool> &matches) const {
+  PL_ASSERT(matches.size() <= tuple_count_);
+
+  // evaluate the predicate once per distinct value
+  std::vector<bool> code_matches(dictionary_.size());
+  for (size_t code_itr = 0; code_itr < dictionary_.size(); code_itr++) {
+    code_matches[code_itr] =
+        Compare(dictionary_[code_itr], comparison_type, constant);
+  }
+
+  for (oid_t tuple_itr = 0; tuple_itr < matches.size(); tuple_itr++) {
+    if (matches[tuple_itr] == true &&
+        code_matches[codes_.Get(tuple_itr)] == false) {
+      matches[tuple_itr] = false;
+    }
+  }
+}
+
+size_t DictionaryCompressedColumn::GetSize() const {
+  size_t size = codes_.GetSize();
+  for (auto &value : dictionary_) {
+    size += GetValueSize(value);
+  }
+  return size;
+}
+
+//===--------------------------------------------------------------------===//
+// Run-Length
+//===--------------------------------------------------------------------===//
+
+RunLengthCompressedColumn::RunLengthCompressedColumn(
+    const std::vector<common::Value> &values,
+    const common::Type::TypeId &value_type)
+    : CompressedColumn(value_type, values.size()) {
+  for (oid_t tuple_itr = 0; tuple_itr < values.size(); tuple_itr++) {
+    auto &value = values[tuple_itr];
+
+    if (run_values_.empty() == false) {
+      auto &run_value = run_values_.back();
+      bool same_run = (run_value.IsNull() && value.IsNull()) ||
+                      (run_value.IsNull() == false && value.IsNull() == false &&
+                       run_value.CompareEquals(value).IsTrue());
+      if (same_run) {
+        run_ends_.back() = tuple_itr + 1;
+        continue;
+      }
+    }
+
+    run_values_.push_back(value);
+    run_ends_.push_back(tuple_itr + 1);
+  }
+}
+
+common::Value RunLengthCompressedColumn::GetValue(
+    const oid_t &tuple_offset) const {
+  PL_ASSERT(tuple_offset < tuple_count_);
+  auto run_end =
+      std::upper_bound(run_ends_.begin(), run_ends_.end(), tuple_offset);
+  return run_values_[run_end - run_ends_.begin()];
+}
+
+void RunLengthCompressedColumn::Evaluate(const ExpressionType &comparison_type,
+                                         const common::Value &constant,
+                                         std::vector<bool> &matches) const {
+  PL_ASSERT(matches.size() <= tuple_count_);
+
+  // evaluate the predicate once per run
+  oid_t run_begin = 0;
+  for (size_t run_itr = 0; run_itr < run_values_.size(); run_itr++) {
+    oid_t run_end = std::min<oid_t>(run_ends_[run_itr], matches.size());
+    if (run_begin >= run_end) {
+      break;
+    }
+
+    if (Compare(run_values_[run_itr], comparison_type, constant) == false) {
+      std::fill(matches.begin() + run_begin, matches.begin() + run_end, false);
+    }
+    run_begin = run_end;
+  }
+}
+
+size_t RunLengthCompressedColumn::GetSize() const {
+  size_t size = run_ends_.size() * sizeof(oid_t);
+  for (auto &value : run_values_) {
+    size += GetValueSize(value);
+  }
+  return size;
+}
+
+//===--------------------------------------------------------------------===//
+// Frame-Of-Reference
+//===--------------------------------------------------------------------===//
+
+FrameOfReferenceCompressedColumn::FrameOfReferenceCompressedColumn(
+    const std::vector<common::Value> &values,
+    const common::Type::TypeId &value_type)
+    : CompressedColumn(value_type, values.size()), reference_(0) {
+  PL_ASSERT(IsEncodable(values, value_type));
+
+  std::vector<int64_t> integers(values.size());
+  for (oid_t tuple_itr = 0; tuple_itr < values.size(); tuple_itr++) {
+    GetIntegerValue(values[tuple_itr], integers[tuple_itr]);
+  }
+
+  uint64_t max_offset = 0;
+  if (integers.empty() == false) {
+    auto min_max = std::minmax_element(integers.begin(), integers.end());
+    reference_ = *min_max.first;
+    max_offset = (uint64_t)*min_max.second - (uint64_t)reference_;
+  }
+
+  offsets_ = BitPackedVector(integers.size(), max_offset);
+  for (oid_t tuple_itr = 0; tuple_itr < integers.size(); tuple_itr++) {
+    offsets_.Set(tuple_itr, (uint64_t)integers[tuple_itr] - (uint64_t)reference_);
+  }
+}
+
+common::Value FrameOfReferenceCompressedColumn::GetValue(
+    const oid_t &tuple_offset) const {
+  PL_ASSERT(tuple_offset < tuple_count_);
+  int64_t value = (int64_t)((uint64_t)reference_ + offsets_.Get(tuple_offset));
+
+  switch (value_type_) {
+    case common::Type::TINYINT:
+      return common::ValueFactory::GetTinyIntValue((int8_t)value);
+    case common::Type::SMALLINT:
+      return common::ValueFactory::GetSmallIntValue((int16_t)value);
+    case common::Type::INTEGER:
+      return common::ValueFactory::GetIntegerValue((int32_t)value);
+    case common::Type::BIGINT:
+      return common::ValueFactory::GetBigIntValue(value);
+    case common::Type::TIMESTAMP:
+      return common::ValueFactory::GetTimestampValue(value);
+    default:
+      throw Exception("Invalid frame-of-reference value type.");
+  }
+}
+
+void FrameOfReferenceCompressedColumn::Evaluate(
+    const ExpressionType &comparison_type, const common::Value &constant,
+    std::vector<bool> &matches) const {
+  PL_ASSERT(matches.size() <= tuple_count_);
+
+  // the packed integers can only be compared against integers of the same
+  // family, everything else goes through the values.
+  int64_t integer_constant;
+  bool comparable = (value_type_ == common::Type::TIMESTAMP) ==
+                    (constant.GetTypeId() == common::Type::TIMESTAMP);
+  if (comparable == false ||
+      GetIntegerValue(constant, integer_constant) == false) {
+    for (oid_t tuple_itr = 0; tuple_itr < matches.size(); tuple_itr++) {
+      if (matches[tuple_itr] == true &&
+          Compare(GetValue(tuple_itr), comparison_type, constant) == false) {
+        matches[tuple_itr] = false;
+      }
+    }
+    return;
+  }
+
+  for (oid_t tuple_itr = 0; tuple_itr < matches.size(); tuple_itr++) {
+    if (matches[tuple_itr] == false) {
+      continue;
+    }
+
+    int64_t value =
+        (int64_t)((uint64_t)reference_ + offsets_.Get(tuple_itr));
+    bool match;
+    switch (comparison_type) {
+      case EXPRESSION_TYPE_COMPARE_EQUAL:
+        match = (value == integer_constant);
+        break;
+      case EXPRESSION_TYPE_COMPARE_NOTEQUAL:
+        match = (value != integer_constant);
+        break;
+      case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+        match = (value < integer_constant);
+        break;
+      case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+        match = (value > integer_constant);
+        break;
+      case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+        match = (value <= integer_constant);
+        break;
+      case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+        match = (value >= integer_constant);
+        break;
+      default:
+        throw Exception("Invalid comparison expression type.");
+    }
+    matches[tuple_itr] = match;
+  }
+}
+
+size_t FrameOfReferenceCompressedColumn::GetSize() const {
+  return sizeof(reference_) + offsets_.GetSize();
+}
+
+bool FrameOfReferenceCompressedColumn::IsEncodable(
+    const std::vector<common::Value> &values,
+    const common::Type::TypeId &value_type) {
+  switch (value_type) {
+    case common::Type::TINYINT:
+    case common::Type::SMALLINT:
+    case common::Type::INTEGER:
+    case common::Type::BIGINT:
+    case common::Type::TIMESTAMP:
+      break;
+    default:
+      return false;
+  }
+
+  for (auto &value : values) {
+    if (value.IsNull()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// returns false if the value is not a non-null integer
+bool FrameOfReferenceCompressedColumn::GetIntegerValue(
+    const common::Value &value, int64_t &result) {
+  if (value.IsNull()) {
+    return false;
+  }
+
+  switch (value.GetTypeId()) {
+    case common::Type::TINYINT:
+      result = value.GetAs<int8_t>();
+      return true;
+    case common::Type::SMALLINT:
+      result = value.GetAs<int16_t>();
+      return true;
+    case common::Type::INTEGER:
+      result = value.GetAs<int32_t>();
+      return true;
+    case common::Type::BIGINT:
+      result = value.GetAs<int64_t>();
+      return true;
+    case common::Type::TIMESTAMP:
+      result = (int64_t)value.GetAs<uint64_t>();
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // End storage namespace
+}  // End peloton namespace
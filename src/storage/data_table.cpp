@@ -10,14 +10,17 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <mutex>
 #include <utility>
 
 #include "brain/clusterer.h"
 #include "brain/sample.h"
+#include "common/config.h"
 #include "common/exception.h"
 #include "common/logger.h"
 #include "common/platform.h"
+#include "common/wait_event.h"
 #include "common/exception.h"
 #include "catalog/foreign_key.h"
 #include "catalog/catalog.h"
@@ -31,6 +34,7 @@
 #include "storage/tile.h"
 #include "storage/tile_group_header.h"
 #include "storage/tile_group_factory.h"
+#include "storage/tile_group_preallocator.h"
 #include "storage/abstract_table.h"
 #include "storage/database.h"
 #include "storage/data_table.h"
@@ -60,6 +64,13 @@ DataTable::DataTable(catalog::Schema *schema, const std::string &table_name,
     : AbstractTable(database_oid, table_oid, table_name, schema, own_schema),
       tuples_per_tilegroup_(tuples_per_tilegroup),
       adapt_table_(adapt_table) {
+  auto version_storage_type =
+      StringToVersionStorageType(FLAGS_version_storage);
+  if (version_storage_type != VERSION_STORAGE_TYPE_INVALID) {
+    version_storage_type_ = version_storage_type;
+  }
+  version_retention_ = FLAGS_version_retention;
+
   // Init default partition
   auto col_count = schema->GetColumnCount();
   for (oid_t col_itr = 0; col_itr < col_count; col_itr++) {
@@ -68,6 +79,8 @@ DataTable::DataTable(catalog::Schema *schema, const std::string &table_name,
 
   active_tile_groups_.resize(active_tilegroup_count_);
 
+  standby_tile_groups_.resize(active_tilegroup_count_);
+
   active_indirection_arrays_.resize(active_indirection_array_count_);
 
   // Create tile groups.
@@ -83,6 +96,9 @@ DataTable::DataTable(catalog::Schema *schema, const std::string &table_name,
 
 DataTable::~DataTable() {
 
+  // the preallocation thread must not build tile groups for this table
+  TileGroupPreallocator::GetInstance().CancelRequests(this);
+
   // clean up tile groups by dropping the references in the catalog
   auto &catalog_manager = catalog::Manager::GetInstance();
   auto tile_groups_size = tile_groups_.GetSize();
@@ -145,13 +161,66 @@ bool DataTable::CheckConstraints(const storage::Tuple *tuple) const {
   return true;
 }
 
+namespace {
+
+// the slots taken by the live threads. never freed, threads may still exit
+// while the process exits.
+struct ThreadSlots {
+  std::mutex lock;
+  std::vector<bool> taken;
+};
+
+ThreadSlots &GetThreadSlots() {
+  static auto thread_slots = new ThreadSlots();
+  return *thread_slots;
+}
+
+// the slot of a thread. the slots of the live threads stay dense, so they do
+// not share an active tile group as long as there are enough of them.
+class ThreadSlot {
+ public:
+  ThreadSlot() {
+    auto &thread_slots = GetThreadSlots();
+    std::lock_guard<std::mutex> lock(thread_slots.lock);
+    auto &taken = thread_slots.taken;
+    slot_ = std::find(taken.begin(), taken.end(), false) - taken.begin();
+    if (slot_ == taken.size()) {
+      taken.push_back(true);
+    } else {
+      taken[slot_] = true;
+    }
+  }
+
+  ~ThreadSlot() {
+    auto &thread_slots = GetThreadSlots();
+    std::lock_guard<std::mutex> lock(thread_slots.lock);
+    thread_slots.taken[slot_] = false;
+  }
+
+  size_t GetSlot() const { return slot_; }
+
+ private:
+  size_t slot_;
+};
+
+}  // namespace
+
+size_t DataTable::GetThreadSlot() {
+  static thread_local ThreadSlot thread_slot;
+  return thread_slot.GetSlot();
+}
+
 // this function is called when update/delete/insert is performed.
 // this function first checks whether there's available slot.
 // if yes, then directly return the available slot.
-// in particular, if this is the last slot, a new tile group is created.
-// if there's no available slot, then some other threads must be allocating a
+// every thread inserts into its own active tile group, so that concurrent
+// inserters do not contend on the same tile group header.
+// in particular, if this is the last slot, the preallocated tile group is
+// installed. a new tile group is only created synchronously if the background
+// preallocation could not keep up.
+// if there's no available slot, then some other threads must be installing a
 // new tile group.
-// we just wait until a new tuple slot in the newly allocated tile group is
+// we just wait until a new tuple slot in the newly installed tile group is
 // available.
 // when updating a tuple, we will invoke this function with the argument set to
 // nullptr.
@@ -176,12 +245,13 @@ ItemPointer DataTable::GetEmptyTupleSlot(const storage::Tuple *tuple) {
   }
   //====================================================
 
-  size_t active_tile_group_id = number_of_tuples_ % active_tilegroup_count_;
+  size_t active_tile_group_id = GetThreadSlot() % active_tilegroup_count_;
   std::shared_ptr<storage::TileGroup> tile_group;
   oid_t tuple_slot = INVALID_OID;
   oid_t tile_group_id = INVALID_OID;
 
   // get valid tuple.
+  std::unique_ptr<WaitEventTimer> wait;
   while (true) {
     // get the last tile group.
     tile_group = active_tile_groups_[active_tile_group_id];
@@ -193,7 +263,14 @@ ItemPointer DataTable::GetEmptyTupleSlot(const storage::Tuple *tuple) {
       tile_group_id = tile_group->GetTileGroupId();
       break;
     }
+
+    // the tile group is full, wait for the thread that took its last slot
+    // to add the next one
+    if (wait == nullptr) {
+      wait.reset(new WaitEventTimer(WAIT_CLASS_TUPLE_SLOT));
+    }
   }
+  wait.reset();
 
   // if this is the last tuple slot we can get
   // then create a new tile group
@@ -336,7 +413,7 @@ bool DataTable::InsertInIndexes(const storage::Tuple *tuple,
   int index_count = GetIndexCount();
 
   size_t active_indirection_array_id =
-      number_of_tuples_ % active_indirection_array_count_;
+      GetThreadSlot() % active_indirection_array_count_;
 
   size_t indirection_offset = INVALID_INDIRECTION_OFFSET;
 
@@ -560,6 +637,38 @@ void DataTable::SetTupleCount(const size_t &num_tuples) {
  */
 size_t DataTable::GetTupleCount() const { return number_of_tuples_; }
 
+/**
+ * @brief Set the order of the version chains of the table
+ * @param version_storage_type order of the version chains
+ * @return false if the table already holds versions
+ */
+bool DataTable::SetVersionStorageType(
+    const VersionStorageType &version_storage_type) {
+  // The existing chains would be traversed in the wrong order
+  auto tile_group_count = GetTileGroupCount();
+  for (size_t tile_group_offset = 0; tile_group_offset < tile_group_count;
+       tile_group_offset++) {
+    auto tile_group = GetTileGroup(tile_group_offset);
+    if (tile_group != nullptr && tile_group->GetAllocatedTupleCount() != 0) {
+      return false;
+    }
+  }
+
+  version_storage_type_ = version_storage_type;
+  return true;
+}
+
+/**
+ * @brief Raise the commit id up to which the versions may have been unlinked
+ * @param expired_cid commit id at which the unlinked versions expired
+ */
+void DataTable::RaiseExpiredCid(const cid_t &expired_cid) {
+  auto current_cid = expired_cid_.load();
+  while (current_cid < expired_cid &&
+         expired_cid_.compare_exchange_weak(current_cid, expired_cid) == false)
+    ;
+}
+
 /**
  * @brief return dirty flag
  * @return dirty flag
@@ -653,19 +762,26 @@ oid_t DataTable::AddDefaultIndirectionArray(
 }
 
 oid_t DataTable::AddDefaultTileGroup() {
-  size_t active_tile_group_id = number_of_tuples_ % active_tilegroup_count_;
+  size_t active_tile_group_id = GetThreadSlot() % active_tilegroup_count_;
   return AddDefaultTileGroup(active_tile_group_id);
 }
 
 oid_t DataTable::AddDefaultTileGroup(const size_t &active_tile_group_id) {
-  column_map_type column_map;
   oid_t tile_group_id = INVALID_OID;
 
-  // Figure out the partitioning for given tilegroup layout
-  column_map = GetTileGroupLayout((LayoutType)peloton_layout_mode);
+  // Take the preallocated tile group of this slot, if any
+  std::shared_ptr<TileGroup> tile_group = std::atomic_exchange(
+      &standby_tile_groups_[active_tile_group_id],
+      std::shared_ptr<TileGroup>());
 
-  // Create a tile group with that partitioning
-  std::shared_ptr<TileGroup> tile_group(GetTileGroupWithLayout(column_map));
+  if (tile_group == nullptr) {
+    // Figure out the partitioning for given tilegroup layout
+    column_map_type column_map =
+        GetTileGroupLayout((LayoutType)peloton_layout_mode);
+
+    // Create a tile group with that partitioning
+    tile_group.reset(GetTileGroupWithLayout(column_map));
+  }
   PL_ASSERT(tile_group.get());
 
   tile_group_id = tile_group->GetTileGroupId();
@@ -679,6 +795,9 @@ oid_t DataTable::AddDefaultTileGroup(const size_t &active_tile_group_id) {
 
   COMPILER_MEMORY_FENCE;
 
+  // only tables that have filled up a tile group are worth preallocating for
+  bool is_full = (active_tile_groups_[active_tile_group_id] != nullptr);
+
   active_tile_groups_[active_tile_group_id] = tile_group;
 
   // we must guarantee that the compiler always add tile group before adding
@@ -689,9 +808,30 @@ oid_t DataTable::AddDefaultTileGroup(const size_t &active_tile_group_id) {
 
   LOG_TRACE("Recording tile group : %u ", tile_group_id);
 
+  if (is_full == true) {
+    auto &preallocator = TileGroupPreallocator::GetInstance();
+    preallocator.RequestTileGroup(this, active_tile_group_id);
+  }
+
   return tile_group_id;
 }
 
+void DataTable::PreallocateTileGroup(const size_t &active_tile_group_id) {
+  if (std::atomic_load(&standby_tile_groups_[active_tile_group_id]) !=
+      nullptr) {
+    return;
+  }
+
+  column_map_type column_map =
+      GetTileGroupLayout((LayoutType)peloton_layout_mode);
+
+  std::shared_ptr<TileGroup> tile_group(GetTileGroupWithLayout(column_map));
+
+  std::atomic_store(&standby_tile_groups_[active_tile_group_id], tile_group);
+
+  LOG_TRACE("Preallocated tile group : %u ", tile_group->GetTileGroupId());
+}
+
 void DataTable::AddTileGroupWithOidForRecovery(const oid_t &tile_group_id) {
   PL_ASSERT(tile_group_id);
 
@@ -733,7 +873,7 @@ void DataTable::AddTileGroupWithOidForRecovery(const oid_t &tile_group_id) {
 // NOTE: This function is only used in test cases.
 void DataTable::AddTileGroup(const std::shared_ptr<TileGroup> &tile_group) {
 
-  size_t active_tile_group_id = number_of_tuples_ % active_tilegroup_count_;
+  size_t active_tile_group_id = GetThreadSlot() % active_tilegroup_count_;
 
   active_tile_groups_[active_tile_group_id] = tile_group;
 
@@ -883,8 +1023,10 @@ std::shared_ptr<index::Index> DataTable::GetIndexWithOid(
   auto index_count = indexes_.GetSize();
 
   for (std::size_t index_itr = 0; index_itr < index_count; index_itr++) {
-    ret_index = indexes_.Find(index_itr);
-    if (ret_index->GetOid() == index_oid) {
+    auto index = indexes_.Find(index_itr);
+    // dropped indexes leave an empty slot
+    if (index != nullptr && index->GetOid() == index_oid) {
+      ret_index = index;
       break;
     }
   }
@@ -1048,8 +1190,99 @@ void SetTransformedTileGroup(storage::TileGroup *orig_tile_group,
   *new_header = *header;
 }
 
-storage::TileGroup *DataTable::TransformTileGroup(
-    const oid_t &tile_group_offset, const double &theta) {
+// tile groups that are still being filled by inserters
+bool DataTable::IsActiveTileGroup(const storage::TileGroup *tile_group) const {
+  for (size_t active_tile_group_id = 0;
+       active_tile_group_id < active_tile_groups_.size();
+       active_tile_group_id++) {
+    if (active_tile_groups_[active_tile_group_id].get() == tile_group) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// lock all the versions in the tile group on behalf of txn. the versions are
+// locked by the ownership protocol of the transaction manager, so that no
+// concurrent transaction can write them while the tile group is being
+// rebuilt. if some version is being written, the versions locked so far are
+// released, txn is committed and false is returned.
+bool DataTable::LockTileGroup(concurrency::Transaction *txn,
+                              storage::TileGroup *tile_group) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto tile_group_header = tile_group->GetHeader();
+  auto tuple_count = tile_group->GetAllocatedTupleCount();
+
+  bool locked = true;
+  oid_t locked_tuple_count = 0;
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    if (txn_manager.IsOwnable(txn, tile_group_header, tuple_itr) == false ||
+        txn_manager.AcquireOwnership(txn, tile_group_header, tuple_itr) ==
+            false) {
+      locked = false;
+      break;
+    }
+    locked_tuple_count++;
+
+    // the version may have been updated before we locked it
+    if (tile_group_header->GetEndCommitId(tuple_itr) != MAX_CID) {
+      locked = false;
+      break;
+    }
+  }
+
+  if (locked == false) {
+    UnlockTileGroup(txn, tile_group, locked_tuple_count);
+  }
+
+  return locked;
+}
+
+void DataTable::UnlockTileGroup(concurrency::Transaction *txn,
+                                storage::TileGroup *tile_group,
+                                const oid_t &locked_tuple_count) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto tile_group_header = tile_group->GetHeader();
+  for (oid_t tuple_itr = 0; tuple_itr < locked_tuple_count; tuple_itr++) {
+    tile_group_header->SetTransactionId(tuple_itr, INITIAL_TXN_ID);
+  }
+  txn_manager.CommitTransaction(txn);
+}
+
+// swap the new tile group in the locator with the id of the locked tile
+// group. the catalog retires the latter to the epoch manager, which releases
+// it once no running transaction can reference it anymore. the original tile
+// group remains locked, so transactions that still hold it can read the old
+// versions, but will fail to write them or to register as readers.
+void DataTable::ReplaceTileGroup(
+    concurrency::Transaction *txn,
+    const std::shared_ptr<storage::TileGroup> &tile_group,
+    const std::shared_ptr<storage::TileGroup> &new_tile_group) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto &catalog_manager = catalog::Manager::GetInstance();
+
+  // Unlock the versions in the new tile group
+  auto new_tile_group_header = new_tile_group->GetHeader();
+  auto tuple_count = new_tile_group->GetAllocatedTupleCount();
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    new_tile_group_header->SetTransactionId(tuple_itr, INITIAL_TXN_ID);
+  }
+
+  // The values were copied tile-by-tile, build the zone map from scratch
+  new_tile_group->RebuildZoneMap();
+
+  COMPILER_MEMORY_FENCE;
+
+  // Set the location of the new tile group, which retires the orig one
+  catalog_manager.AddTileGroup(tile_group->GetTileGroupId(), new_tile_group);
+
+  txn_manager.CommitTransaction(txn);
+}
+
+// get the tile group at the given offset if it can be rebuilt online, i.e.,
+// it is not being filled anymore and all its versions are committed.
+std::shared_ptr<storage::TileGroup> DataTable::GetFrozenTileGroup(
+    const oid_t &tile_group_offset) {
   // First, check if the tile group is in this table
   if (tile_group_offset >= tile_groups_.GetSize()) {
     LOG_ERROR("Tile group offset not found in table : %u ", tile_group_offset);
@@ -1062,6 +1295,34 @@ storage::TileGroup *DataTable::TransformTileGroup(
   // Get orig tile group from catalog
   auto &catalog_manager = catalog::Manager::GetInstance();
   auto tile_group = catalog_manager.GetTileGroup(tile_group_id);
+  if (tile_group == nullptr) {
+    return nullptr;
+  }
+
+  // Tile groups that are still being filled are not rebuilt
+  if (IsActiveTileGroup(tile_group.get()) == true) {
+    return nullptr;
+  }
+
+  // Only tile groups whose versions are all committed are rebuilt
+  if (tile_group->GetHeader()->IsFrozen(MAX_CID) == false) {
+    return nullptr;
+  }
+
+  return tile_group;
+}
+
+// transform a tile group into the default partitioning of the table.
+// the transformation is performed online: the versions in the tile group are
+// locked by a transformer transaction while they are being copied, and the new
+// tile group then replaces the original one under the same tile group id.
+storage::TileGroup *DataTable::TransformTileGroup(
+    const oid_t &tile_group_offset, const double &theta) {
+  auto tile_group = GetFrozenTileGroup(tile_group_offset);
+  if (tile_group == nullptr) {
+    return nullptr;
+  }
+
   auto diff = tile_group->GetSchemaDifference(default_partition_);
 
   // Check threshold for transformation
@@ -1071,6 +1332,13 @@ storage::TileGroup *DataTable::TransformTileGroup(
 
   LOG_TRACE("Transforming tile group : %u", tile_group_offset);
 
+  // Lock all the versions in the tile group
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  if (LockTileGroup(txn, tile_group.get()) == false) {
+    return nullptr;
+  }
+
   // Get the schema for the new transformed tile group
   auto new_schema =
       TransformTileGroupSchema(tile_group.get(), default_partition_);
@@ -1086,9 +1354,46 @@ storage::TileGroup *DataTable::TransformTileGroup(
   // Set the transformed tile group column-at-a-time
   SetTransformedTileGroup(tile_group.get(), new_tile_group.get());
 
-  // Set the location of the new tile group
-  // and clean up the orig tile group
-  catalog_manager.AddTileGroup(tile_group_id, new_tile_group);
+  ReplaceTileGroup(txn, tile_group, new_tile_group);
+
+  return new_tile_group.get();
+}
+
+// compress a cold tile group into a read-only copy with the same layout. the
+// compression is performed online, the same way as the transformation.
+storage::TileGroup *DataTable::CompressTileGroup(
+    const oid_t &tile_group_offset) {
+  auto tile_group = GetFrozenTileGroup(tile_group_offset);
+  if (tile_group == nullptr || tile_group->IsCompressed() == true) {
+    return nullptr;
+  }
+
+  LOG_TRACE("Compressing tile group : %u", tile_group_offset);
+
+  // Lock all the versions in the tile group
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  if (LockTileGroup(txn, tile_group.get()) == false) {
+    return nullptr;
+  }
+
+  std::shared_ptr<storage::TileGroup> new_tile_group(
+      TileGroupFactory::GetTileGroup(
+          tile_group->GetDatabaseId(), tile_group->GetTableId(),
+          tile_group->GetTileGroupId(), tile_group->GetAbstractTable(),
+          tile_group->GetTileSchemas(), tile_group->GetColumnMap(),
+          tile_group->GetAllocatedTupleCount()));
+
+  SetTransformedTileGroup(tile_group.get(), new_tile_group.get());
+
+  // The data does not compress, keep the orig tile group
+  if (new_tile_group->Compress() == false) {
+    UnlockTileGroup(txn, tile_group.get(),
+                    tile_group->GetAllocatedTupleCount());
+    return nullptr;
+  }
+
+  ReplaceTileGroup(txn, tile_group, new_tile_group);
 
   return new_tile_group.get();
 }
@@ -27,7 +27,7 @@ Database::Database(const oid_t &database_oid) : database_oid(database_oid) {}
 Database::~Database() {
   // Clean up all the tables
   LOG_TRACE("Deleting tables from database");
-  for (auto table : tables) delete table;
+  for (auto table : tables.GetAll()) delete table;
 
   LOG_TRACE("Finish deleting tables from database");
 }
@@ -37,15 +37,12 @@ Database::~Database() {
 //===--------------------------------------------------------------------===//
 
 void Database::AddTable(storage::DataTable *table) {
-  {
-    std::lock_guard<std::mutex> lock(database_mutex);
-    tables.push_back(table);
-  }
+  tables.Add(table, table->GetName(), table->GetOid());
 }
 
 storage::DataTable *Database::GetTableWithOid(const oid_t table_oid) const {
-  for (auto table : tables)
-    if (table->GetOid() == table_oid) return table;
+  auto table = tables.GetWithOid(table_oid);
+  if (table != nullptr) return table;
   throw CatalogException("Table with oid = " + std::to_string(table_oid) +
                          " is not found");
   return nullptr;
@@ -53,37 +50,26 @@ storage::DataTable *Database::GetTableWithOid(const oid_t table_oid) const {
 
 storage::DataTable *Database::GetTableWithName(const std::string table_name)
     const {
-  for (auto table : tables)
-    if (table->GetName() == table_name) return table;
+  auto table = tables.GetWithName(table_name);
+  if (table != nullptr) return table;
   throw CatalogException("Table " + table_name + " is not found");
   return nullptr;
 }
 
 void Database::DropTableWithOid(const oid_t table_oid) {
-  {
-    std::lock_guard<std::mutex> lock(database_mutex);
-    oid_t table_offset = 0;
-    for (auto table : tables) {
-      if (table->GetOid() == table_oid) {
-        delete table;
-        break;
-      }
-      table_offset++;
-    }
-    PL_ASSERT(table_offset < tables.size());
-
-    // Drop the table
-    tables.erase(tables.begin() + table_offset);
-  }
+  // Drop the table
+  auto table = tables.Remove(table_oid);
+  PL_ASSERT(table != nullptr);
+  delete table;
 }
 
 storage::DataTable *Database::GetTable(const oid_t table_offset) const {
-  PL_ASSERT(table_offset < tables.size());
-  auto table = tables.at(table_offset);
+  PL_ASSERT(table_offset < tables.GetSize());
+  auto table = tables.GetWithOffset(table_offset);
   return table;
 }
 
-oid_t Database::GetTableCount() const { return tables.size(); }
+oid_t Database::GetTableCount() const { return tables.GetSize(); }
 
 //===--------------------------------------------------------------------===//
 // UTILITIES
@@ -100,7 +86,7 @@ const std::string Database::GetInfo() const {
   os << "Table Count : " << table_count << "\n";
 
   oid_t table_itr = 0;
-  for (auto table : tables) {
+  for (auto table : tables.GetAll()) {
     if (table != nullptr) {
       os << "(" << ++table_itr << "/" << table_count << ") "
          << "Table Name(" << table->GetOid() << ") : " << table->GetName()
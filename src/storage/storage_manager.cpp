@@ -458,7 +458,7 @@ void *StorageManager::Allocate(BackendType type, size_t size) {
         size_t cache_data_file_offset = 0;
 
         // Lock the file
-        data_file_spinlock.Lock();
+        data_file_spinlock.Lock(WAIT_CLASS_DATA_FILE_LOCK);
 
         // Check if within bounds
         if (data_file_offset < data_file_len) {
@@ -19,6 +19,7 @@
 #include "common/varlen_pool.h"
 #include "common/serializer.h"
 #include "common/types.h"
+#include "common/logger.h"
 #include "common/macros.h"
 #include "storage/tuple_iterator.h"
 #include "storage/tuple.h"
@@ -48,6 +49,7 @@ Tile::Tile(BackendType backend_type, TileGroupHeader *tile_header,
       uninlined_data_size(0),
       column_header(NULL),
       column_header_size(INVALID_OID),
+      compressed_size(0),
       tile_group_header(tile_header) {
   PL_ASSERT(tuple_count > 0);
 
@@ -95,6 +97,7 @@ Tile::~Tile() {
  */
 void Tile::InsertTuple(const oid_t tuple_offset, Tuple *tuple) {
   PL_ASSERT(tuple_offset < GetAllocatedTupleCount());
+  CheckUncompressed();
 
   // Find slot location
   char *location = tuple_offset * tuple_length + data;
@@ -111,6 +114,10 @@ common::Value Tile::GetValue(const oid_t tuple_offset, const oid_t column_id) {
   PL_ASSERT(tuple_offset < GetAllocatedTupleCount());
   PL_ASSERT(column_id < schema.GetColumnCount());
 
+  if (IsCompressed()) {
+    return compressed_columns[column_id]->GetValue(tuple_offset);
+  }
+
   const common::Type::TypeId column_type = schema.GetType(column_id);
 
   const char *tuple_location = GetTupleLocation(tuple_offset);
@@ -130,6 +137,15 @@ common::Value Tile::GetValueFast(const oid_t tuple_offset, const size_t column_o
   PL_ASSERT(tuple_offset < GetAllocatedTupleCount());
   PL_ASSERT(column_offset < schema.GetLength());
 
+  if (IsCompressed()) {
+    for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+      if (schema.GetOffset(column_itr) == column_offset) {
+        return compressed_columns[column_itr]->GetValue(tuple_offset);
+      }
+    }
+    PL_ASSERT(false);
+  }
+
   const char *tuple_location = GetTupleLocation(tuple_offset);
   const char *field_location = tuple_location + column_offset;
 
@@ -144,6 +160,7 @@ void Tile::SetValue(const common::Value &value, const oid_t tuple_offset,
                     const oid_t column_id) {
   PL_ASSERT(tuple_offset < num_tuple_slots);
   PL_ASSERT(column_id < schema.GetColumnCount());
+  CheckUncompressed();
 
   char *tuple_location = GetTupleLocation(tuple_offset);
   char *field_location = tuple_location + schema.GetOffset(column_id);
@@ -165,6 +182,7 @@ void Tile::SetValueFast(const common::Value &value, const oid_t tuple_offset,
                         UNUSED_ATTRIBUTE const size_t column_length) {
   PL_ASSERT(tuple_offset < num_tuple_slots);
   PL_ASSERT(column_offset < schema.GetLength());
+  CheckUncompressed();
 
   char *tuple_location = GetTupleLocation(tuple_offset);
   char *field_location = tuple_location + column_offset;
@@ -175,6 +193,8 @@ void Tile::SetValueFast(const common::Value &value, const oid_t tuple_offset,
 }
 
 Tile *Tile::CopyTile(BackendType backend_type) {
+  CheckUncompressed();
+
   auto schema = GetSchema();
   bool tile_columns_inlined = schema->IsInlined();
   auto allocated_tuple_count = GetAllocatedTupleCount();
@@ -210,6 +230,63 @@ Tile *Tile::CopyTile(BackendType backend_type) {
   return new_tile;
 }
 
+//===--------------------------------------------------------------------===//
+// Compression
+//===--------------------------------------------------------------------===//
+
+bool Tile::Compress() {
+  PL_ASSERT(IsCompressed() == false);
+
+  std::vector<std::unique_ptr<CompressedColumn>> columns;
+  size_t columns_size = 0;
+  size_t uncompressed_size = tile_size;
+
+  std::vector<common::Value> values;
+  values.reserve(num_tuple_slots);
+
+  for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+    values.clear();
+    bool is_inlined = schema.IsInlined(column_itr);
+    for (oid_t tuple_itr = 0; tuple_itr < num_tuple_slots; tuple_itr++) {
+      values.push_back(GetValue(tuple_itr, column_itr));
+      if (is_inlined == false && values.back().IsNull() == false) {
+        uncompressed_size += values.back().GetLength();
+      }
+    }
+
+    columns.emplace_back(
+        CompressedColumn::Compress(values, schema.GetType(column_itr)));
+    columns_size += columns.back()->GetSize();
+  }
+
+  if (columns_size >= uncompressed_size) {
+    return false;
+  }
+
+  compressed_columns = std::move(columns);
+  compressed_size = columns_size;
+
+  // the compressed columns own their values, so the tuple slots and the
+  // uninlined data can be reclaimed
+  auto &storage_manager = storage::StorageManager::GetInstance();
+  storage_manager.Release(backend_type, data);
+  data = NULL;
+
+  delete pool;
+  pool = new common::VarlenPool(backend_type);
+
+  LOG_TRACE("Compressed tile %u from %lu to %lu bytes", tile_id,
+            uncompressed_size, compressed_size);
+  return true;
+}
+
+void Tile::CheckUncompressed() const {
+  if (IsCompressed()) {
+    throw NotImplementedException("Tile " + std::to_string(tile_id) +
+                                  " is compressed and read-only");
+  }
+}
+
 //===--------------------------------------------------------------------===//
 // Utilities
 //===--------------------------------------------------------------------===//
@@ -228,6 +305,20 @@ const std::string Tile::GetInfo() const {
   os << "\t-----------------------------------------------------------\n";
   os << "\tDATA\n";
 
+  if (IsCompressed()) {
+    auto active_tuple_count = GetActiveTupleCount();
+    for (oid_t tuple_itr = 0; tuple_itr < active_tuple_count; tuple_itr++) {
+      os << "\t(";
+      for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+        if (column_itr != 0) os << ", ";
+        os << compressed_columns[column_itr]->GetValue(tuple_itr).ToString();
+      }
+      os << ")\n";
+    }
+    os << "\t-----------------------------------------------------------\n";
+    return os.str();
+  }
+
   TupleIterator tile_itr(this);
   Tuple tuple(&schema);
 
@@ -449,6 +540,7 @@ void Tile::DeserializeTuplesFromWithoutHeader(SerializeInput &input,
 
   // First, check if we have required space
   PL_ASSERT(tuple_count <= num_tuple_slots);
+  CheckUncompressed();
   storage::Tuple *temp_tuple = new storage::Tuple(&schema, true);
 
   for (oid_t tuple_itr = 0; tuple_itr < tuple_count; ++tuple_itr) {
@@ -22,6 +22,7 @@
 #include "storage/tile.h"
 #include "storage/tuple.h"
 #include "storage/tile_group_header.h"
+#include "storage/zone_map.h"
 #include "common/container_tuple.h"
 
 namespace peloton {
@@ -39,7 +40,8 @@ TileGroup::TileGroup(BackendType backend_type,
       tile_group_header(tile_group_header),
       table(table),
       num_tuple_slots(tuple_count),
-      column_map(column_map) {
+      column_map(column_map),
+      zone_map(new ZoneMap(this, column_map.size())) {
   tile_count = tile_schemas.size();
 
   for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
@@ -108,6 +110,7 @@ void TileGroup::CopyTuple(const Tuple *tuple, const oid_t &tuple_slot_id) {
 
     storage::Tile *tile = GetTile(tile_itr);
     PL_ASSERT(tile);
+    tile->CheckUncompressed();
     char *tile_tuple_location = tile->GetTupleLocation(tuple_slot_id);
     PL_ASSERT(tile_tuple_location);
 
@@ -121,6 +124,8 @@ void TileGroup::CopyTuple(const Tuple *tuple, const oid_t &tuple_slot_id) {
       column_itr++;
     }
   }
+
+  zone_map->MarkStale();
 }
 
 // This is commented out before merge
@@ -203,6 +208,7 @@ oid_t TileGroup::InsertTupleFromRecovery(cid_t commit_id, oid_t tuple_slot_id,
 
     storage::Tile *tile = GetTile(tile_itr);
     PL_ASSERT(tile);
+    tile->CheckUncompressed();
     char *tile_tuple_location = tile->GetTupleLocation(tuple_slot_id);
     PL_ASSERT(tile_tuple_location);
 
@@ -217,6 +223,8 @@ oid_t TileGroup::InsertTupleFromRecovery(cid_t commit_id, oid_t tuple_slot_id,
     }
   }
 
+  zone_map->MarkStale();
+
   // Set MVCC info
   tile_group_header->SetTransactionId(tuple_slot_id, INITIAL_TXN_ID);
   tile_group_header->SetBeginCommitId(tuple_slot_id, commit_id);
@@ -303,6 +311,7 @@ oid_t TileGroup::InsertTupleFromCheckpoint(oid_t tuple_slot_id,
 
     storage::Tile *tile = GetTile(tile_itr);
     PL_ASSERT(tile);
+    tile->CheckUncompressed();
     char *tile_tuple_location = tile->GetTupleLocation(tuple_slot_id);
     PL_ASSERT(tile_tuple_location);
 
@@ -317,6 +326,8 @@ oid_t TileGroup::InsertTupleFromCheckpoint(oid_t tuple_slot_id,
     }
   }
 
+  zone_map->MarkStale();
+
   // Set MVCC info
   tile_group_header->SetTransactionId(tuple_slot_id, INITIAL_TXN_ID);
   tile_group_header->SetBeginCommitId(tuple_slot_id, commit_id);
@@ -362,6 +373,7 @@ void TileGroup::SetValue(common::Value &value, oid_t tuple_id, oid_t column_id)
   oid_t tile_column_id, tile_offset;
   LocateTileAndColumn(column_id, tile_offset, tile_column_id);
   GetTile(tile_offset)->SetValue(value, tuple_id, tile_column_id);
+  zone_map->MarkStale();
 }
 
 
@@ -377,6 +389,37 @@ std::shared_ptr<Tile> TileGroup::GetTileReference(const oid_t tile_offset)
   return tiles[tile_offset];
 }
 
+void TileGroup::RebuildZoneMap() { zone_map->Rebuild(); }
+
+bool TileGroup::Compress() {
+  bool compressed = false;
+  for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+    if (GetTile(tile_itr)->Compress() == true) {
+      compressed = true;
+    }
+  }
+  return compressed;
+}
+
+bool TileGroup::IsCompressed() const {
+  for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+    if (GetTile(tile_itr)->IsCompressed() == true) {
+      return true;
+    }
+  }
+  return false;
+}
+
+const CompressedColumn *TileGroup::GetCompressedColumn(oid_t column_id) {
+  oid_t tile_column_id, tile_offset;
+  LocateTileAndColumn(column_id, tile_offset, tile_column_id);
+  auto tile = GetTile(tile_offset);
+  if (tile->IsCompressed() == false) {
+    return nullptr;
+  }
+  return tile->GetCompressedColumn(tile_column_id);
+}
+
 double TileGroup::GetSchemaDifference(
     const storage::column_map_type &new_column_map) {
   double theta = 0;
@@ -198,5 +198,30 @@ oid_t TileGroupHeader::GetActiveTupleCount() {
   return active_tuple_slots;
 }
 
+bool TileGroupHeader::IsFrozen(const cid_t &frozen_cid) const {
+  // the tile group is still being filled
+  if (GetCurrentNextTupleSlot() != num_tuple_slots) {
+    return false;
+  }
+
+  for (oid_t tuple_slot_id = START_OID; tuple_slot_id < num_tuple_slots;
+       tuple_slot_id++) {
+    // empty, recycled or owned by a transaction
+    if (GetTransactionId(tuple_slot_id) != INITIAL_TXN_ID) {
+      return false;
+    }
+    // not yet visible to all transactions
+    if (GetBeginCommitId(tuple_slot_id) >= frozen_cid) {
+      return false;
+    }
+    // an old or deleted version that is going to be garbage collected
+    if (GetEndCommitId(tuple_slot_id) != MAX_CID) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 }  // End storage namespace
 }  // End peloton namespace
@@ -0,0 +1,196 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_preallocator.cpp
+//
+// Identification: src/storage/tile_group_preallocator.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "common/logger.h"
+#include "storage/data_table.h"
+#include "storage/tile_group_preallocator.h"
+
+namespace peloton {
+namespace storage {
+
+// upper bound on the number of numa nodes we probe for
+#define MAX_NUMA_NODE_COUNT 64
+
+TileGroupPreallocator::TileGroupPreallocator()
+    : is_running_(false), serving_table_(nullptr), current_numa_node_(-1) {
+  LoadNumaTopology();
+}
+
+TileGroupPreallocator &TileGroupPreallocator::GetInstance() {
+  static TileGroupPreallocator preallocator;
+  return preallocator;
+}
+
+void TileGroupPreallocator::StartPreallocation() {
+  std::lock_guard<std::mutex> lock(preallocation_mutex_);
+  if (is_running_ == true) {
+    return;
+  }
+
+  LOG_TRACE("Starting tile group preallocation");
+  {
+    std::lock_guard<std::mutex> request_lock(request_mutex_);
+    is_running_ = true;
+  }
+  preallocation_thread_.reset(
+      new std::thread(&TileGroupPreallocator::Running, this));
+}
+
+void TileGroupPreallocator::StopPreallocation() {
+  std::lock_guard<std::mutex> lock(preallocation_mutex_);
+  if (is_running_ == false) {
+    return;
+  }
+
+  LOG_TRACE("Stopping tile group preallocation");
+  {
+    std::lock_guard<std::mutex> request_lock(request_mutex_);
+    is_running_ = false;
+    requests_.clear();
+  }
+  request_cv_.notify_all();
+  preallocation_thread_->join();
+  preallocation_thread_.reset();
+}
+
+bool TileGroupPreallocator::RequestTileGroup(
+    DataTable *table, const size_t &active_tile_group_id) {
+  auto numa_node = GetCurrentNumaNode();
+  {
+    std::lock_guard<std::mutex> lock(request_mutex_);
+    if (is_running_ == false ||
+        requests_.size() >= MAX_PREALLOCATION_QUEUE_LENGTH) {
+      return false;
+    }
+    requests_.emplace_back(table, active_tile_group_id, numa_node);
+  }
+  request_cv_.notify_one();
+
+  return true;
+}
+
+void TileGroupPreallocator::CancelRequests(DataTable *table) {
+  std::unique_lock<std::mutex> lock(request_mutex_);
+  requests_.erase(std::remove_if(requests_.begin(), requests_.end(),
+                                 [table](const PreallocationRequest &request) {
+                                   return request.table_ == table;
+                                 }),
+                  requests_.end());
+  served_cv_.wait(lock, [this, table] { return serving_table_ != table; });
+}
+
+int TileGroupPreallocator::GetCurrentNumaNode() {
+  unsigned int cpu = 0;
+  unsigned int node = 0;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) {
+    return -1;
+  }
+  return (int)node;
+}
+
+void TileGroupPreallocator::Running() {
+  std::unique_lock<std::mutex> lock(request_mutex_);
+  while (is_running_ == true) {
+    if (requests_.empty() == true) {
+      request_cv_.wait(lock);
+      continue;
+    }
+
+    // a table is not destroyed while it is being served
+    auto request = requests_.front();
+    requests_.pop_front();
+    serving_table_ = request.table_;
+    lock.unlock();
+
+    Preallocate(request);
+
+    lock.lock();
+    serving_table_ = nullptr;
+    served_cv_.notify_all();
+  }
+}
+
+void TileGroupPreallocator::Preallocate(const PreallocationRequest &request) {
+  BindToNumaNode(request.numa_node_);
+  request.table_->PreallocateTileGroup(request.active_tile_group_id_);
+}
+
+void TileGroupPreallocator::BindToNumaNode(const int &numa_node) {
+  // not a numa machine, or we do not know where the inserter runs.
+  if (numa_node < 0 || (size_t)numa_node >= numa_node_cpus_.size()) {
+    return;
+  }
+
+  if (numa_node == current_numa_node_) {
+    return;
+  }
+
+  if (sched_setaffinity(0, sizeof(cpu_set_t), &numa_node_cpus_[numa_node]) ==
+      0) {
+    current_numa_node_ = numa_node;
+  }
+}
+
+// read the cpu list of every numa node from sysfs, e.g., "0-7,16-23".
+void TileGroupPreallocator::LoadNumaTopology() {
+  std::vector<cpu_set_t> node_cpus;
+
+  for (int node_itr = 0; node_itr < MAX_NUMA_NODE_COUNT; node_itr++) {
+    std::ifstream cpu_list_file("/sys/devices/system/node/node" +
+                                std::to_string(node_itr) + "/cpulist");
+    if (cpu_list_file.good() == false) {
+      break;
+    }
+
+    std::string cpu_list;
+    std::getline(cpu_list_file, cpu_list);
+
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+
+    std::stringstream cpu_list_stream(cpu_list);
+    std::string cpu_range;
+    while (std::getline(cpu_list_stream, cpu_range, ',')) {
+      if (cpu_range.empty()) {
+        continue;
+      }
+      auto dash_pos = cpu_range.find('-');
+      int first_cpu = std::stoi(cpu_range.substr(0, dash_pos));
+      int last_cpu = (dash_pos == std::string::npos)
+                         ? first_cpu
+                         : std::stoi(cpu_range.substr(dash_pos + 1));
+      for (int cpu_itr = first_cpu; cpu_itr <= last_cpu; cpu_itr++) {
+        CPU_SET(cpu_itr, &cpu_set);
+      }
+    }
+
+    node_cpus.push_back(cpu_set);
+  }
+
+  // binding only pays off if there is more than one node
+  if (node_cpus.size() > 1) {
+    numa_node_cpus_ = node_cpus;
+  }
+
+  LOG_TRACE("Numa node count : %lu", node_cpus.size());
+}
+
+}  // End storage namespace
+}  // End peloton namespace
@@ -0,0 +1,162 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// zone_map.cpp
+//
+// Identification: src/storage/zone_map.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/zone_map.h"
+
+#include "common/logger.h"
+#include "common/macros.h"
+#include "storage/tile_group.h"
+
+namespace peloton {
+namespace storage {
+
+ZoneMap::ZoneMap(TileGroup *tile_group, const oid_t &column_count)
+    : tile_group_(tile_group), zones_(column_count), stale_(false) {}
+
+void ZoneMap::Widen(ColumnZone &zone, const common::Value &value) {
+  if (value.IsNull()) {
+    zone.null_count++;
+    return;
+  }
+
+  if (zone.has_values == false) {
+    zone.min = value;
+    zone.max = value;
+    zone.has_values = true;
+    return;
+  }
+
+  if (value.CompareLessThan(zone.min).IsTrue()) {
+    zone.min = value;
+  } else if (value.CompareGreaterThan(zone.max).IsTrue()) {
+    zone.max = value;
+  }
+}
+
+// the zone map is marked fresh before the slots are read. the values that
+// concurrent writers write after a slot has been read mark it stale again.
+// the slots that are allocated but not written yet only widen the zone map.
+void ZoneMap::Rebuild() {
+  PL_ASSERT(tile_group_->GetColumnMap().size() == zones_.size());
+
+  zone_map_lock_.Lock();
+
+  stale_.store(false, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  std::vector<ColumnZone> zones(zones_.size());
+  oid_t tuple_count = tile_group_->GetNextTupleSlot();
+  for (oid_t column_itr = 0; column_itr < zones.size(); column_itr++) {
+    for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+      Widen(zones[column_itr], tile_group_->GetValue(tuple_itr, column_itr));
+    }
+  }
+
+  zones_ = std::move(zones);
+
+  zone_map_lock_.Unlock();
+
+  LOG_TRACE("Rebuilt zone map of tile group %u",
+            tile_group_->GetTileGroupId());
+}
+
+bool ZoneMap::MightSatisfy(const oid_t &column_id,
+                           const ExpressionType &comparison_type,
+                           const common::Value &constant) {
+  PL_ASSERT(column_id < zones_.size());
+
+  // comparisons with null are never true
+  if (constant.IsNull()) {
+    return false;
+  }
+
+  bool might_satisfy = true;
+
+  Refresh();
+  zone_map_lock_.Lock();
+  auto &zone = zones_[column_id];
+  if (zone.has_values == false) {
+    might_satisfy = false;
+  } else {
+    try {
+      switch (comparison_type) {
+        case EXPRESSION_TYPE_COMPARE_EQUAL:
+          might_satisfy = zone.min.CompareLessThanEquals(constant).IsTrue() &&
+                          zone.max.CompareGreaterThanEquals(constant).IsTrue();
+          break;
+        case EXPRESSION_TYPE_COMPARE_NOTEQUAL:
+          might_satisfy = zone.min.CompareNotEquals(constant).IsTrue() ||
+                          zone.max.CompareNotEquals(constant).IsTrue();
+          break;
+        case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+          might_satisfy = zone.min.CompareLessThan(constant).IsTrue();
+          break;
+        case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+          might_satisfy = zone.min.CompareLessThanEquals(constant).IsTrue();
+          break;
+        case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+          might_satisfy = zone.max.CompareGreaterThan(constant).IsTrue();
+          break;
+        case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+          might_satisfy = zone.max.CompareGreaterThanEquals(constant).IsTrue();
+          break;
+        default:
+          break;
+      }
+    } catch (...) {
+      // the values are not comparable with the constant, do not skip
+      might_satisfy = true;
+    }
+  }
+  zone_map_lock_.Unlock();
+
+  return might_satisfy;
+}
+
+bool ZoneMap::HasValues(const oid_t &column_id) {
+  PL_ASSERT(column_id < zones_.size());
+  Refresh();
+  zone_map_lock_.Lock();
+  bool has_values = zones_[column_id].has_values;
+  zone_map_lock_.Unlock();
+  return has_values;
+}
+
+common::Value ZoneMap::GetMin(const oid_t &column_id) {
+  PL_ASSERT(column_id < zones_.size());
+  Refresh();
+  zone_map_lock_.Lock();
+  common::Value min = zones_[column_id].min;
+  zone_map_lock_.Unlock();
+  return min;
+}
+
+common::Value ZoneMap::GetMax(const oid_t &column_id) {
+  PL_ASSERT(column_id < zones_.size());
+  Refresh();
+  zone_map_lock_.Lock();
+  common::Value max = zones_[column_id].max;
+  zone_map_lock_.Unlock();
+  return max;
+}
+
+oid_t ZoneMap::GetNullCount(const oid_t &column_id) {
+  PL_ASSERT(column_id < zones_.size());
+  Refresh();
+  zone_map_lock_.Lock();
+  oid_t null_count = zones_[column_id].null_count;
+  zone_map_lock_.Unlock();
+  return null_count;
+}
+
+}  // End storage namespace
+}  // End peloton namespace
@@ -19,22 +19,101 @@
 #include "common/portal.h"
 #include "common/type.h"
 #include "common/types.h"
+#include "common/value_factory.h"
 
 #include "expression/aggregate_expression.h"
+#include "expression/constant_value_expression.h"
 #include "expression/expression_util.h"
 
 #include "parser/parser.h"
 #include "parser/statement_select.h"
 
 #include "catalog/catalog.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/compiled_pipeline.h"
+#include "executor/executor_tree_pool.h"
 #include "executor/plan_executor.h"
 #include "optimizer/simple_optimizer.h"
 
 #include <boost/algorithm/string.hpp>
+#include <chrono>
+#include <ctime>
+#include <regex>
+#include <sstream>
 
 namespace peloton {
 namespace tcop {
 
+// Name of the column of the plan returned by EXPLAIN ANALYZE
+#define EXPLAIN_ANALYZE_COLUMN_NAME "QUERY PLAN"
+
+// Strip the EXPLAIN ANALYZE in front of the query, if any
+static bool StripExplainAnalyze(std::string &query_string) {
+  static const std::regex explain_analyze(
+      "^\\s*EXPLAIN\\s+ANALYZE\\s+", std::regex_constants::icase);
+  std::smatch match;
+  if (std::regex_search(query_string, match, explain_analyze) == false) {
+    return false;
+  }
+  query_string = match.suffix().str();
+  return true;
+}
+
+// Microseconds since the unix epoch of a timestamp value
+static int64_t GetUnixTime(uint64_t timestamp) {
+  int64_t micro = timestamp % 1000000;
+  timestamp /= 1000000;
+  int64_t seconds = timestamp % 100000;
+  timestamp /= 100000;
+  int year = timestamp % 10000;
+  timestamp /= 10000;
+  int timezone = static_cast<int>(timestamp % 27) - 12;
+  timestamp /= 27;
+  int day = timestamp % 32;
+  timestamp /= 32;
+  int month = timestamp;
+
+  struct tm date = {};
+  date.tm_year = year - 1900;
+  date.tm_mon = month - 1;
+  date.tm_mday = day;
+  int64_t unix_seconds = timegm(&date) + seconds - timezone * 3600;
+  return unix_seconds * 1000000 + micro;
+}
+
+// The commit id of the snapshot of an AS OF clause, given as a commit id or as
+// a timestamp
+static cid_t GetSnapshotCid(const expression::AbstractExpression *as_of) {
+  auto value =
+      static_cast<const expression::ConstantValueExpression *>(as_of)
+          ->GetValue();
+  if (value.GetTypeId() != common::Type::VARCHAR) {
+    if (as_of->ival_ < static_cast<int64_t>(READ_ONLY_START_CID)) {
+      throw ParserException("Invalid AS OF commit id " +
+                            std::to_string(as_of->ival_));
+    }
+    return as_of->ival_;
+  }
+
+  auto time = GetUnixTime(
+      common::ValueFactory::CastAsTimestamp(value).GetAs<uint64_t>());
+  auto now = std::chrono::duration_cast<std::chrono::microseconds>(
+                 std::chrono::system_clock::now().time_since_epoch())
+                 .count();
+  if (time > now) {
+    throw ParserException("AS OF timestamp " + value.ToString() +
+                          " is in the future");
+  }
+
+  auto snapshot_cid =
+      concurrency::EpochManagerFactory::GetInstance().GetSnapshotCid(time);
+  if (snapshot_cid == INVALID_CID) {
+    throw ParserException("AS OF timestamp " + value.ToString() +
+                          " is older than the commit history");
+  }
+  return snapshot_cid;
+}
+
 // global singleton
 TrafficCop &TrafficCop::GetInstance(void) {
   static TrafficCop traffic_cop;
@@ -98,19 +177,148 @@ Result TrafficCop::ExecuteStatement(
             statement->GetStatementName().c_str());
   LOG_TRACE("Execute Statement of query: %s",
             statement->GetStatementName().c_str());
+
+  // An AS OF select reads its snapshot in a historical transaction
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  concurrency::Transaction *txn = nullptr;
+  if (statement->GetSnapshotCid() != INVALID_CID) {
+    txn = txn_manager.BeginHistoricalTransaction(statement->GetSnapshotCid());
+    if (txn == nullptr) {
+      error_message = "AS OF commit id " +
+                      std::to_string(statement->GetSnapshotCid()) +
+                      " is not committed yet";
+      return Result::RESULT_FAILURE;
+    }
+  }
+
   try {
     bridge::PlanExecutor::PrintPlan(statement->GetPlanTree().get(), "Plan");
-    bridge::peloton_status status = bridge::PlanExecutor::ExecutePlan(
-        statement->GetPlanTree().get(), params, result, result_format);
+
+    // The executors are only profiled for EXPLAIN ANALYZE, or to export the
+    // profile with the query metrics
+    std::string profile;
+    bool profiled = (statement->IsExplainAnalyze() == true ||
+                     FLAGS_stats_mode != STATS_TYPE_INVALID);
+
+    // A hot statement is compiled into a pipeline once, the profiled and the
+    // historical runs need the executors
+    std::shared_ptr<executor::CompiledPipeline> pipeline;
+    if (profiled == false && txn == nullptr &&
+        FLAGS_pipeline_compile_threshold > 0) {
+      if (statement->IncrementExecutionCount() >=
+              FLAGS_pipeline_compile_threshold &&
+          statement->IsPipelineCompiled() == false) {
+        statement->SetCompiledPipeline(
+            std::shared_ptr<executor::CompiledPipeline>(
+                executor::CompiledPipeline::Compile(
+                    statement->GetPlanTree().get())));
+      }
+      pipeline = statement->GetCompiledPipeline();
+    }
+
+    bridge::peloton_status status;
+    if (pipeline != nullptr) {
+      status = bridge::PlanExecutor::ExecutePipeline(
+          pipeline.get(), params, result, result_format);
+    } else {
+      status = bridge::PlanExecutor::ExecutePlan(
+          statement->GetPlanTree().get(), params, result, result_format, txn,
+          profiled ? &profile : nullptr,
+          statement->GetExecutorTreePool().get());
+    }
+    if (txn != nullptr) {
+      // a read-only transaction always commits
+      txn_manager.CommitTransaction(txn);
+      txn = nullptr;
+    }
     LOG_TRACE("Statement executed. Result: %d", status.m_result);
     rows_changed = status.m_processed;
+
+    // Return the annotated plan instead of the result, a row per line
+    if (statement->IsExplainAnalyze() == true) {
+      result.clear();
+      rows_changed = 0;
+      std::stringstream profile_stream(profile);
+      std::string line;
+      while (std::getline(profile_stream, line)) {
+        auto row = ResultType();
+        bridge::PlanExecutor::copyFromTo(EXPLAIN_ANALYZE_COLUMN_NAME,
+                                         row.first);
+        bridge::PlanExecutor::copyFromTo(line, row.second);
+        result.push_back(row);
+        rows_changed++;
+      }
+    }
     return status.m_result;
   } catch (Exception &e) {
+    if (txn != nullptr) {
+      txn_manager.CommitTransaction(txn);
+    }
     error_message = e.what();
     return Result::RESULT_FAILURE;
   }
 }
 
+Result TrafficCop::ExecuteStatementBatch(
+    const std::shared_ptr<Statement> &statement,
+    std::vector<std::vector<common::Value>> &params_batch,
+    std::vector<int> &rows_changed, std::string &error_message) {
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->InitQueryMetric(statement,
+                                                               nullptr);
+  }
+
+  LOG_TRACE("Execute batch of %lu for statement: %s", params_batch.size(),
+            statement->GetStatementName().c_str());
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  auto plan = statement->GetPlanTree().get();
+  auto tree_pool = statement->GetExecutorTreePool().get();
+  std::vector<ResultType> result;
+  std::vector<int> result_format;
+
+  rows_changed.clear();
+  try {
+    for (auto &params : params_batch) {
+      if (params.size() > 0) {
+        plan->SetParameterValues(&params);
+      }
+      bridge::peloton_status status = bridge::PlanExecutor::ExecutePlan(
+          plan, params, result, result_format, txn, nullptr, tree_pool);
+      if (status.m_result != Result::RESULT_SUCCESS) {
+        error_message = "Execution of batch entry " +
+                        std::to_string(rows_changed.size()) + " failed: " +
+                        ResultToString(status.m_result);
+        break;
+      }
+      rows_changed.push_back(status.m_processed);
+    }
+  } catch (Exception &e) {
+    error_message = e.what();
+    txn->SetResult(Result::RESULT_FAILURE);
+  }
+
+  if (txn->GetResult() == Result::RESULT_SUCCESS &&
+      rows_changed.size() == params_batch.size()) {
+    auto commit_result = txn_manager.CommitTransaction(txn);
+    if (commit_result != Result::RESULT_SUCCESS) {
+      error_message = "Commit of the batch failed: " +
+                      ResultToString(commit_result);
+    }
+    return commit_result;
+  }
+
+  if (error_message.empty() == true) {
+    error_message = "Execution of batch entry " +
+                    std::to_string(rows_changed.size()) + " failed: " +
+                    ResultToString(txn->GetResult());
+  }
+
+  txn_manager.AbortTransaction(txn);
+  return Result::RESULT_FAILURE;
+}
+
 std::shared_ptr<Statement> TrafficCop::PrepareStatement(
     const std::string &statement_name, const std::string &query_string,
     UNUSED_ATTRIBUTE std::string &error_message) {
@@ -120,21 +328,48 @@ std::shared_ptr<Statement> TrafficCop::PrepareStatement(
   LOG_DEBUG("Prepare Statement query: %s", query_string.c_str());
 
   statement.reset(new Statement(statement_name, query_string));
+
+  // EXPLAIN ANALYZE runs the statement, but returns its plan annotated with
+  // the runtime statistics of the executors
+  std::string plan_query_string = query_string;
+  statement->SetExplainAnalyze(StripExplainAnalyze(plan_query_string));
+
+  // read before planning, so that DDL while planning makes the plan stale
+  statement->SetCatalogVersion(catalog::Catalog::GetInstance()->GetVersion());
+
   try {
     auto &peloton_parser = parser::Parser::GetInstance();
-    auto sql_stmt = peloton_parser.BuildParseTree(query_string);
+    auto sql_stmt = peloton_parser.BuildParseTree(plan_query_string);
     if (sql_stmt->is_valid == false) {
       throw ParserException("Error parsing SQL statement");
     }
     statement->SetPlanTree(
         optimizer::SimpleOptimizer::BuildPelotonPlanTree(sql_stmt));
 
-    for (auto stmt : sql_stmt->GetStatements()) {
-      if (stmt->GetType() == STATEMENT_TYPE_SELECT) {
-        auto tuple_descriptor = GenerateTupleDescriptor(stmt);
-        statement->SetTupleDescriptor(tuple_descriptor);
+    // An AS OF select reads a past snapshot
+    if (sql_stmt->GetNumStatements() > 0 &&
+        sql_stmt->GetStatement(0)->GetType() == STATEMENT_TYPE_SELECT) {
+      auto select_stmt =
+          static_cast<parser::SelectStatement *>(sql_stmt->GetStatement(0));
+      if (select_stmt->as_of != nullptr) {
+        if (select_stmt->is_for_update == true) {
+          throw ParserException("AS OF can not be used with FOR UPDATE");
+        }
+        statement->SetSnapshotCid(GetSnapshotCid(select_stmt->as_of));
+      }
+    }
+
+    if (statement->IsExplainAnalyze() == true) {
+      statement->SetTupleDescriptor({GetColumnFieldForValueType(
+          EXPLAIN_ANALYZE_COLUMN_NAME, common::Type::VARCHAR)});
+    } else {
+      for (auto stmt : sql_stmt->GetStatements()) {
+        if (stmt->GetType() == STATEMENT_TYPE_SELECT) {
+          auto tuple_descriptor = GenerateTupleDescriptor(stmt);
+          statement->SetTupleDescriptor(tuple_descriptor);
+        }
+        break;
       }
-      break;
     }
 
     bridge::PlanExecutor::PrintPlan(statement->GetPlanTree().get(), "Plan");
@@ -14,52 +14,65 @@
 
 #include <unistd.h>
 #include "wire/libevent_server.h"
+#include "wire/query_execution_pool.h"
 #include "common/macros.h"
 
 namespace peloton {
 namespace wire {
 
-void WorkerHandleNewConn(evutil_socket_t new_conn_recv_fd,
-                         UNUSED_ATTRIBUTE short ev_flags, void *arg) {
-  // buffer used to receive messages from the main thread
-  char m_buf[1];
-  std::shared_ptr<NewConnQueueItem> item;
+/* Set up the connection object of a socket accepted for the worker thread */
+static void InitConn(LibeventWorkerThread *thread, int new_conn_fd,
+                     short event_flags) {
+  LibeventSocket *conn = LibeventServer::GetConn(new_conn_fd);
+  if (conn == nullptr) {
+    LOG_DEBUG("Creating new socket fd:%d", new_conn_fd);
+    /* create a new connection object */
+    LibeventServer::CreateNewConn(new_conn_fd, event_flags,
+                                  static_cast<LibeventThread *>(thread),
+                                  CONN_READ);
+  } else {
+    LOG_DEBUG("Reusing socket fd:%d", new_conn_fd);
+    /* otherwise reset and reuse the existing conn object */
+    conn->Reset();
+    conn->Init(event_flags, static_cast<LibeventThread *>(thread), CONN_READ);
+  }
+}
+
+void WorkerHandleNotify(evutil_socket_t notify_fd,
+                        UNUSED_ATTRIBUTE short ev_flags, void *arg) {
+  uint64_t notify_count;
+  NewConnQueueItem item;
   LibeventSocket *conn;
   LibeventWorkerThread *thread = static_cast<LibeventWorkerThread *>(arg);
 
-  // pipe fds should match
-  PL_ASSERT(new_conn_recv_fd == thread->new_conn_receive_fd);
+  // eventfds should match
+  PL_ASSERT(notify_fd == thread->notify_fd);
 
-  // read the operation that needs to be performed
-  if (read(new_conn_recv_fd, m_buf, 1) != 1) {
-    LOG_ERROR("Can't read from the libevent pipe");
+  // reset the eventfd counter. every notification is preceded by an enqueue,
+  // so draining both queues serves all the notifications read
+  if (read(notify_fd, &notify_count, sizeof(notify_count)) !=
+      sizeof(notify_count)) {
+    LOG_ERROR("Can't read from the libevent notify eventfd");
     return;
   }
 
-  switch (m_buf[0]) {
-    /* new connection case */
-    case 'c': {
-      // fetch the new connection fd from the queue
-      thread->new_conn_queue.Dequeue(item);
-      conn = LibeventServer::GetConn(item->new_conn_fd);
-      if (conn == nullptr) {
-        LOG_DEBUG("Creating new socket fd:%d", item->new_conn_fd);
-        /* create a new connection object */
-        LibeventServer::CreateNewConn(item->new_conn_fd, item->event_flags,
-                                      static_cast<LibeventThread *>(thread),
-                                      CONN_READ);
-      } else {
-        LOG_DEBUG("Reusing socket fd:%d", item->new_conn_fd);
-        /* otherwise reset and reuse the existing conn object */
-        conn->Reset();
-        conn->Init(item->event_flags, static_cast<LibeventThread *>(thread),
-                    CONN_READ);
-      }
-      break;
-    }
+  /* new connection case */
+  while (thread->new_conn_queue.Dequeue(item) == true) {
+    InitConn(thread, item.new_conn_fd, item.event_flags);
+  }
 
-    default:
-      LOG_ERROR("Unexpected message. Shouldn't reach here");
+  /* packet executed case */
+  while (thread->post_back_queue.Dequeue(conn) == true) {
+    // resume the connection whose packet has been processed
+    QueryExecutionPool::GetInstance().CompletePostBack(conn);
+    if (conn->exec_status == false) {
+      // packet processing can't proceed further
+      conn->TransitState(CONN_CLOSING);
+    } else {
+      // We should have responses ready to send
+      conn->TransitState(CONN_WRITE);
+    }
+    StateMachine(conn);
   }
 }
 
@@ -84,9 +97,18 @@ void StateMachine(LibeventSocket *conn) {
             accept(conn->sock_fd, (struct sockaddr *)&addr, &addrlen);
         if (new_conn_fd == -1) {
           LOG_ERROR("Failed to accept");
+          done = true;
+          break;
+        }
+        if (conn->thread->GetThreadID() == MASTER_THREAD_ID) {
+          (static_cast<LibeventMasterThread *>(conn->thread))
+              ->DispatchConnection(new_conn_fd, EV_READ | EV_PERSIST);
+        } else {
+          // accepted on the worker's own listening socket (SO_REUSEPORT)
+          auto thread = static_cast<LibeventWorkerThread *>(conn->thread);
+          thread->conn_count++;
+          InitConn(thread, new_conn_fd, EV_READ | EV_PERSIST);
         }
-        (static_cast<LibeventMasterThread *>(conn->thread))
-            ->DispatchConnection(new_conn_fd, EV_READ | EV_PERSIST);
         done = true;
         break;
       }
@@ -120,39 +142,66 @@ void StateMachine(LibeventSocket *conn) {
         }
 
         conn->TransitState(CONN_READ);
+        conn->UpdateQueuedBytes();
         done = true;
         break;
       }
 
       case CONN_PROCESS : {
         bool status;
-        if (conn->rpkt.header_parsed == false) {
-          // parse out the header first
-          if (conn->ReadPacketHeader() == false) {
-            // need more data
-            conn->TransitState(CONN_WAIT);
-            break;
+        if (conn->pkt_manager.is_started == false) {
+          if (conn->rpkt.header_parsed == false) {
+            // parse out the header first
+            if (conn->ReadPacketHeader() == false) {
+              // need more data
+              conn->TransitState(CONN_WAIT);
+              break;
+            }
           }
-        }
-        PL_ASSERT(conn->rpkt.header_parsed == true);
+          PL_ASSERT(conn->rpkt.header_parsed == true);
 
-        if (conn->rpkt.is_initialized == false) {
-          // packet needs to be initialized with rest of the contents
-          if (conn->ReadPacket() == false) {
-            // need more data
-            conn->TransitState(CONN_WAIT);
-            break;
+          if (conn->rpkt.is_initialized == false) {
+            // packet needs to be initialized with rest of the contents
+            if (conn->ReadPacket() == false) {
+              // need more data
+              conn->TransitState(CONN_WAIT);
+              break;
+            }
           }
-        }
-        PL_ASSERT(conn->rpkt.is_initialized == true);
+          PL_ASSERT(conn->rpkt.is_initialized == true);
 
-        if (conn->pkt_manager.is_started == false) {
           // We need to handle startup packet first
           status = conn->pkt_manager.ProcessStartupPacket(&conn->rpkt);
           conn->pkt_manager.is_started = true;
+          // Input Packet can now be reset, before we parse the next packet
+          conn->rpkt.Reset();
         } else {
+          // Gather all the packets received so far, they are processed in
+          // one round
+          if (conn->ReadPacketBatch() == false) {
+            // need more data
+            conn->TransitState(CONN_WAIT);
+            break;
+          }
+
+          if (QueryExecutionPool::GetInstance().IsRunning() == true) {
+            // Run the packets on the execution pool, and stop listening to
+            // the socket until the connection is posted back. The connection
+            // must not be touched once it is submitted.
+            if (conn->DisableEvent() == false) {
+              conn->TransitState(CONN_CLOSING);
+              break;
+            }
+            conn->TransitState(CONN_EXECUTING);
+            conn->UpdateQueuedBytes();
+            QueryExecutionPool::GetInstance().SubmitPackets(conn);
+            done = true;
+            break;
+          }
+
           // Process all other packets
-          status = conn->pkt_manager.ProcessPacket(&conn->rpkt);
+          status = conn->pkt_manager.ProcessPackets(conn->pkt_batch);
+          conn->pkt_batch.clear();
         }
 
         if (status == false) {
@@ -169,8 +218,7 @@ void StateMachine(LibeventSocket *conn) {
         // examine write packets result
         switch(conn->WritePackets()) {
           case WRITE_COMPLETE: {
-            // Input Packet can now be reset, before we parse the next packet
-            conn->rpkt.Reset();
+            // The read buffer may hold the start of the next packet
             conn->UpdateEvent(EV_READ | EV_PERSIST);
             conn->TransitState(CONN_PROCESS);
             break;
@@ -179,6 +227,7 @@ void StateMachine(LibeventSocket *conn) {
           case WRITE_NOT_READY: {
             // we can't write right now. Exit state machine
             // and wait for next callback
+            conn->UpdateQueuedBytes();
             done = true;
             break;
           }
@@ -198,6 +247,12 @@ void StateMachine(LibeventSocket *conn) {
         break;
       }
 
+      case CONN_EXECUTING: {
+        // the execution pool resumes the connection
+        done = true;
+        break;
+      }
+
       case CONN_CLOSED: {
         done = true;
         break;
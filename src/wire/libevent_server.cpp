@@ -18,6 +18,7 @@
 #include "common/init.h"
 #include "common/macros.h"
 #include "common/thread_pool.h"
+#include "wire/query_execution_pool.h"
 
 namespace peloton {
 namespace wire {
@@ -25,7 +26,8 @@ namespace wire {
 std::vector<std::unique_ptr<LibeventSocket>>
     &LibeventServer::GetGlobalSocketList() {
   static std::vector<std::unique_ptr<LibeventSocket>>
-      // 2 fd's per thread for pipe and 1 listening socket
+      // 2 fd's per thread for eventfd and listening socket, and 1 listening
+      // socket
       global_socket_list(FLAGS_max_connections + QUERY_THREAD_COUNT * 2 + 1);
   return global_socket_list;
 }
@@ -43,6 +45,47 @@ void LibeventServer::CreateNewConn(const int &connfd, short ev_flags,
       new LibeventSocket(connfd, ev_flags, thread, init_state));
 }
 
+int LibeventServer::CreateListenSocket(const uint64_t &port,
+                                       const bool &reuse_port) {
+  struct sockaddr_in sin;
+  PL_MEMSET(&sin, 0, sizeof(sin));
+  sin.sin_family = AF_INET;
+  sin.sin_addr.s_addr = INADDR_ANY;
+  sin.sin_port = htons(port);
+
+  int listen_fd;
+
+  listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+
+  if (listen_fd < 0) {
+    LOG_ERROR("Failed to create listen socket");
+    exit(EXIT_FAILURE);
+  }
+
+  int reuse = 1;
+  setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+  if (reuse_port == true &&
+      setsockopt(listen_fd, SOL_SOCKET, SO_REUSEPORT, &reuse, sizeof(reuse)) <
+          0) {
+    LOG_ERROR("Failed to set SO_REUSEPORT on listen socket");
+    exit(EXIT_FAILURE);
+  }
+
+  if (bind(listen_fd, (struct sockaddr *)&sin, sizeof(sin)) < 0) {
+    LOG_ERROR("Failed to bind socket to port %" PRIu64, port);
+    exit(EXIT_FAILURE);
+  }
+
+  int conn_backlog = 12;
+  if (listen(listen_fd, conn_backlog) < 0) {
+    LOG_ERROR("Failed to listen to socket");
+    exit(EXIT_FAILURE);
+  }
+
+  return listen_fd;
+}
+
 /**
  * Stop signal handling
  */
@@ -66,6 +109,13 @@ LibeventServer::LibeventServer() {
   evstop = evsignal_new(base, SIGHUP, Signal_Callback, base);
   evsignal_add(evstop, NULL);
 
+  // the network threads hand the parsed packets over to the execution threads
+  size_t execution_threads = FLAGS_execution_threads;
+  if (execution_threads == 0) {
+    execution_threads = std::thread::hardware_concurrency();
+  }
+  QueryExecutionPool::GetInstance().StartPool(execution_threads);
+
   // TODO: Make pool size a global
   std::shared_ptr<LibeventThread> master_thread(
       new LibeventMasterThread(QUERY_THREAD_COUNT, base));
@@ -86,42 +136,18 @@ LibeventServer::LibeventServer() {
   signal(SIGPIPE, SIG_IGN);
 
   if (FLAGS_socket_family == "AF_INET") {
-    struct sockaddr_in sin;
-    PL_MEMSET(&sin, 0, sizeof(sin));
-    sin.sin_family = AF_INET;
-    sin.sin_addr.s_addr = INADDR_ANY;
-    sin.sin_port = htons(port_);
-
-    int listen_fd;
-
-    listen_fd = socket(AF_INET, SOCK_STREAM, 0);
-
-    if (listen_fd < 0) {
-      LOG_ERROR("Failed to create listen socket");
-      exit(EXIT_FAILURE);
-    }
-
-    int reuse = 1;
-    setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
-
-    if (bind(listen_fd, (struct sockaddr *)&sin, sizeof(sin)) < 0) {
-      LOG_ERROR("Failed to bind socket to port %" PRIu64, port_);
-      exit(EXIT_FAILURE);
+    // With SO_REUSEPORT the workers listen on the port themselves
+    if (FLAGS_reuse_port == false) {
+      int listen_fd = CreateListenSocket(port_, false);
+      LibeventServer::CreateNewConn(listen_fd, EV_READ | EV_PERSIST,
+                                    master_thread.get(), CONN_LISTENING);
     }
 
-    int conn_backlog = 12;
-    if (listen(listen_fd, conn_backlog) < 0) {
-      LOG_ERROR("Failed to listen to socket");
-      exit(EXIT_FAILURE);
-    }
-
-    LibeventServer::CreateNewConn(listen_fd, EV_READ | EV_PERSIST,
-                                  master_thread.get(), CONN_LISTENING);
-
     LOG_INFO("Listening on port %" PRIu64, port_);
     event_base_dispatch(base);
     event_free(evstop);
     event_base_free(base);
+    QueryExecutionPool::GetInstance().StopPool();
   }
 
   // This socket family code is not implemented yet
@@ -79,6 +79,27 @@ bool LibeventSocket::UpdateEvent(short flags) {
   return true;
 }
 
+bool LibeventSocket::DisableEvent() {
+  if (event_del(event) == -1) {
+    LOG_ERROR("Failed to delete event");
+    return false;
+  }
+  return true;
+}
+
+void LibeventSocket::UpdateQueuedBytes() {
+  if (thread->GetThreadID() == MASTER_THREAD_ID) return;
+  size_t queued_bytes = (rbuf_.buf_size - rbuf_.buf_ptr) + wbuf_.buf_size;
+  auto &thread_queued_bytes =
+      static_cast<LibeventWorkerThread *>(thread)->queued_bytes;
+  if (queued_bytes > queued_bytes_) {
+    thread_queued_bytes += queued_bytes - queued_bytes_;
+  } else {
+    thread_queued_bytes -= queued_bytes_ - queued_bytes;
+  }
+  queued_bytes_ = queued_bytes;
+}
+
 void LibeventSocket::GetSizeFromPktHeader(size_t start_index) {
   rpkt.len = 0;
   // directly converts from network byte order to little-endian
@@ -167,6 +188,21 @@ bool LibeventSocket::ReadPacket() {
   return true;
 }
 
+bool LibeventSocket::ReadPacketBatch() {
+  while (true) {
+    if (rpkt.header_parsed == false && ReadPacketHeader() == false) break;
+    if (rpkt.is_initialized == false && ReadPacket() == false) break;
+
+    // the packets that fit in the read buffer keep pointing to it, it is
+    // not refilled before the batch is processed
+    auto msg_type = rpkt.msg_type;
+    pkt_batch.push_back(std::move(rpkt));
+    rpkt.Reset();
+    if (PacketManager::IsFlushPacket(msg_type) == true) break;
+  }
+  return pkt_batch.empty() == false;
+}
+
 /**
  * Public Functions
  */
@@ -484,6 +520,9 @@ void LibeventSocket::CloseSocket() {
 
   TransitState(CONN_CLOSED);
   Reset();
+  if (thread->GetThreadID() != MASTER_THREAD_ID) {
+    static_cast<LibeventWorkerThread *>(thread)->conn_count--;
+  }
   for (;;) {
     int status = close(sock_fd);
     if (status < 0) {
@@ -500,9 +539,11 @@ void LibeventSocket::CloseSocket() {
 void LibeventSocket::Reset() {
   rbuf_.Reset();
   wbuf_.Reset();
+  UpdateQueuedBytes();
   pkt_manager.Reset();
   state = CONN_INVALID;
   rpkt.Reset();
+  pkt_batch.clear();
   next_response_ = 0;
 }
 
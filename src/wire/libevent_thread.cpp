@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 #include "wire/libevent_thread.h"
+#include <sys/eventfd.h>
 #include <sys/file.h>
 #include <fstream>
 #include <vector>
@@ -37,7 +38,8 @@ std::vector<std::shared_ptr<LibeventWorkerThread>>
 LibeventMasterThread::LibeventMasterThread(const int num_threads,
                                            struct event_base *libevent_base)
     : LibeventThread(MASTER_THREAD_ID, libevent_base),
-      num_threads_(num_threads) {
+      num_threads_(num_threads),
+      load_aware_dispatch_(FLAGS_dispatch_mode == "least_loaded") {
   auto &threads = GetWorkerThreads();
   for (int thread_id = 0; thread_id < num_threads; thread_id++) {
     threads.push_back(std::shared_ptr<LibeventWorkerThread>(
@@ -58,56 +60,113 @@ void LibeventMasterThread::StartWorker(LibeventWorkerThread *worker_thread) {
 }
 
 /*
-* The worker thread creates a pipe for master-worker communication on
-* constructor.
+* The worker thread creates an eventfd for the notifications from the master
+* thread and the execution pool on constructor.
 */
 LibeventWorkerThread::LibeventWorkerThread(const int thread_id)
-    : LibeventThread(thread_id, event_base_new()), new_conn_queue(QUEUE_SIZE) {
-  int fds[2];
-  if (pipe(fds)) {
-    LOG_ERROR("Can't create notify pipe to accept connections");
+    : LibeventThread(thread_id, event_base_new()),
+      new_conn_queue(QUEUE_SIZE),
+      post_back_queue(QUEUE_SIZE),
+      conn_count(0),
+      queued_bytes(0) {
+  notify_fd = eventfd(0, EFD_NONBLOCK);
+  if (notify_fd < 0) {
+    LOG_ERROR("Can't create notify eventfd to accept connections");
     exit(1);
   }
-  // send_fd is used by the master thread, received_fd used by worker thread
-  new_conn_receive_fd = fds[0];
-  new_conn_send_fd = fds[1];
 
-  // Listen for notifications from the master thread
-  new_conn_event_ = event_new(libevent_base_, new_conn_receive_fd,
-                              EV_READ | EV_PERSIST, WorkerHandleNewConn, this);
+  // Listen for notifications from the master thread and the execution pool
+  notify_event_ = event_new(libevent_base_, notify_fd, EV_READ | EV_PERSIST,
+                            WorkerHandleNotify, this);
 
-  if (event_add(new_conn_event_, 0) == -1) {
-    LOG_ERROR("Can't monitor libevent notify pipe\n");
+  if (event_add(notify_event_, 0) == -1) {
+    LOG_ERROR("Can't monitor libevent notify eventfd\n");
     exit(1);
   }
+
+  // Accept connections on a listening socket of its own. The kernel spreads
+  // the connections among the sockets bound to the port
+  if (FLAGS_reuse_port == true) {
+    int listen_fd = LibeventServer::CreateListenSocket(FLAGS_port, true);
+    LibeventServer::CreateNewConn(listen_fd, EV_READ | EV_PERSIST, this,
+                                  CONN_LISTENING);
+  }
+}
+
+void LibeventWorkerThread::Notify() {
+  uint64_t value = 1;
+  if (write(notify_fd, &value, sizeof(value)) != sizeof(value)) {
+    LOG_ERROR("Failed to write to thread notify eventfd");
+  }
 }
 
 /*
-* Dispatch a new connection event to a random worker thread by
-* writing to the worker's pipe
+* Queue a new connection for the worker's event loop
 */
-void LibeventMasterThread::DispatchConnection(int new_conn_fd,
-                                              short event_flags) {
-  char buf[1];
-  buf[0] = 'c';
+void LibeventWorkerThread::AcceptConn(int new_conn_fd, short event_flags) {
+  // count the connection right away, so that a burst of connections is not
+  // dispatched to the same worker
+  conn_count++;
+  new_conn_queue.Enqueue(NewConnQueueItem(new_conn_fd, event_flags));
+  Notify();
+}
+
+/*
+* Post a connection back to the worker's event loop
+*/
+void LibeventWorkerThread::PostBackConn(LibeventSocket *conn) {
+  post_back_queue.Enqueue(conn);
+  Notify();
+}
+
+/*
+* Pick the worker thread of a new connection, either the next one or the
+* least loaded one
+*/
+int LibeventMasterThread::SelectWorker() {
   auto &threads = GetWorkerThreads();
+  if (load_aware_dispatch_ == false) {
+    int thread_id = next_thread_id_;
+    next_thread_id_ = (next_thread_id_ + 1) % num_threads_;
+    return thread_id;
+  }
 
-  // Dispatch by rand number
-  int thread_id = next_thread_id_;
+  // start the search after the last pick, so that ties are spread
+  int selected_id = GetLeastLoadedWorker(threads, next_thread_id_);
+  next_thread_id_ = (selected_id + 1) % num_threads_;
+  return selected_id;
+}
 
-  // update next threadID
-  next_thread_id_ = (next_thread_id_ + 1) % num_threads_;
+int LibeventMasterThread::GetLeastLoadedWorker(
+    const std::vector<std::shared_ptr<LibeventWorkerThread>> &threads,
+    const int &start_id) {
+  int thread_count = threads.size();
+  int selected_id = start_id;
+  size_t min_load = threads[selected_id]->GetLoad();
+  for (int thread_itr = 1; thread_itr < thread_count; thread_itr++) {
+    int thread_id = (start_id + thread_itr) % thread_count;
+    auto load = threads[thread_id]->GetLoad();
+    if (load < min_load) {
+      min_load = load;
+      selected_id = thread_id;
+    }
+  }
+  return selected_id;
+}
+
+/*
+* Dispatch a new connection event to a worker thread through its queue, and
+* wake the worker up
+*/
+void LibeventMasterThread::DispatchConnection(int new_conn_fd,
+                                              short event_flags) {
+  auto &threads = GetWorkerThreads();
+  int thread_id = SelectWorker();
 
   std::shared_ptr<LibeventWorkerThread> worker_thread = threads[thread_id];
   LOG_DEBUG("Dispatching connection to worker %d", thread_id);
 
-  std::shared_ptr<NewConnQueueItem> item(
-      new NewConnQueueItem(new_conn_fd, event_flags, CONN_READ));
-  worker_thread->new_conn_queue.Enqueue(item);
-
-  if (write(worker_thread->new_conn_send_fd, buf, 1) != 1) {
-    LOG_ERROR("Failed to write to thread notify pipe");
-  }
+  worker_thread->AcceptConn(new_conn_fd, event_flags);
 }
 }
 }
@@ -0,0 +1,199 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// query_execution_pool.cpp
+//
+// Identification: src/wire/query_execution_pool.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "wire/query_execution_pool.h"
+
+#include "common/logger.h"
+#include "wire/libevent_server.h"
+
+namespace peloton {
+namespace wire {
+
+QueryExecutionPool::QueryExecutionPool()
+    : is_running_(false),
+      queue_depth_(0),
+      executing_count_(0),
+      post_back_depth_(0),
+      pool_executed_count_(0) {
+  ResetStatistics();
+}
+
+QueryExecutionPool &QueryExecutionPool::GetInstance() {
+  static QueryExecutionPool execution_pool;
+  return execution_pool;
+}
+
+void QueryExecutionPool::StartPool(const size_t &thread_count) {
+  std::lock_guard<std::mutex> lock(pool_mutex_);
+  if (is_running_ == true || thread_count == 0) {
+    return;
+  }
+
+  LOG_TRACE("Starting query execution pool with %lu threads", thread_count);
+
+  is_running_ = true;
+  for (size_t thread_itr = 0; thread_itr < thread_count; thread_itr++) {
+    execution_threads_.emplace_back(
+        new std::thread(&QueryExecutionPool::Running, this));
+  }
+}
+
+void QueryExecutionPool::StopPool() {
+  std::lock_guard<std::mutex> lock(pool_mutex_);
+  if (is_running_ == false) {
+    return;
+  }
+
+  LOG_TRACE("Stopping query execution pool");
+  {
+    std::lock_guard<std::mutex> queue_lock(queue_mutex_);
+    is_running_ = false;
+  }
+  queue_cv_.notify_all();
+
+  for (auto &execution_thread : execution_threads_) {
+    execution_thread->join();
+  }
+  execution_threads_.clear();
+
+  // process the connections left in the queue on the calling thread
+  while (packet_queue_.empty() == false) {
+    auto conn = packet_queue_.front();
+    packet_queue_.pop_front();
+    queue_depth_--;
+    ProcessPackets(conn);
+  }
+}
+
+void QueryExecutionPool::SubmitPackets(LibeventSocket *conn) {
+  conn->exec_stage_start = std::chrono::steady_clock::now();
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    if (is_running_ == true) {
+      packet_queue_.push_back(conn);
+      queue_depth_++;
+      conn = nullptr;
+    }
+  }
+
+  if (conn == nullptr) {
+    queue_cv_.notify_one();
+  } else {
+    // the pool is stopped, process the packets on the calling thread
+    ProcessPackets(conn);
+  }
+}
+
+void QueryExecutionPool::Running() {
+  while (true) {
+    LibeventSocket *conn;
+    {
+      std::unique_lock<std::mutex> lock(queue_mutex_);
+      queue_cv_.wait(lock, [this] {
+        return is_running_ == false || packet_queue_.empty() == false;
+      });
+      if (is_running_ == false) {
+        return;
+      }
+      conn = packet_queue_.front();
+      packet_queue_.pop_front();
+      queue_depth_--;
+    }
+
+    pool_executed_count_++;
+    ProcessPackets(conn);
+  }
+}
+
+void QueryExecutionPool::ProcessPackets(LibeventSocket *conn) {
+  RecordLatency(conn, EXECUTION_STAGE_QUEUED);
+
+  executing_count_++;
+  conn->exec_status = conn->pkt_manager.ProcessPackets(conn->pkt_batch);
+  conn->pkt_batch.clear();
+  executing_count_--;
+
+  RecordLatency(conn, EXECUTION_STAGE_EXECUTING);
+
+  post_back_depth_++;
+  static_cast<LibeventWorkerThread *>(conn->thread)->PostBackConn(conn);
+}
+
+void QueryExecutionPool::CompletePostBack(LibeventSocket *conn) {
+  post_back_depth_--;
+  RecordLatency(conn, EXECUTION_STAGE_POST_BACK);
+}
+
+void QueryExecutionPool::RecordLatency(LibeventSocket *conn,
+                                       const ExecutionStage &stage) {
+  auto now = std::chrono::steady_clock::now();
+  uint64_t latency = std::chrono::duration_cast<std::chrono::microseconds>(
+                         now - conn->exec_stage_start).count();
+  conn->exec_stage_start = now;
+
+  auto &stage_latency = stage_latencies_[stage];
+  stage_latency.count++;
+  stage_latency.total += latency;
+  auto max_latency = stage_latency.max.load();
+  while (latency > max_latency &&
+         stage_latency.max.compare_exchange_weak(max_latency, latency) ==
+             false)
+    ;
+}
+
+uint64_t QueryExecutionPool::GetAverageLatency(
+    const ExecutionStage &stage) const {
+  auto count = stage_latencies_[stage].count.load();
+  if (count == 0) {
+    return 0;
+  }
+  return stage_latencies_[stage].total.load() / count;
+}
+
+size_t QueryExecutionPool::GetStageDepth(const ExecutionStage &stage) const {
+  switch (stage) {
+    case EXECUTION_STAGE_QUEUED:
+      return GetQueueDepth();
+    case EXECUTION_STAGE_EXECUTING:
+      return GetExecutingCount();
+    case EXECUTION_STAGE_POST_BACK:
+      return GetPostBackDepth();
+    default:
+      return 0;
+  }
+}
+
+std::string QueryExecutionPool::ExecutionStageToString(
+    const ExecutionStage &stage) {
+  switch (stage) {
+    case EXECUTION_STAGE_QUEUED:
+      return "QUEUED";
+    case EXECUTION_STAGE_EXECUTING:
+      return "EXECUTING";
+    case EXECUTION_STAGE_POST_BACK:
+      return "POST_BACK";
+    default:
+      return "INVALID";
+  }
+}
+
+void QueryExecutionPool::ResetStatistics() {
+  pool_executed_count_ = 0;
+  for (auto &stage_latency : stage_latencies_) {
+    stage_latency.count = 0;
+    stage_latency.total = 0;
+    stage_latency.max = 0;
+  }
+}
+
+}  // End wire namespace
+}  // End peloton namespace
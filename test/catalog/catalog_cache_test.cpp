@@ -0,0 +1,82 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// catalog_cache_test.cpp
+//
+// Identification: test/catalog/catalog_cache_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+
+#include "catalog/catalog_cache.h"
+#include "common/rcu.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Catalog Cache Tests
+//===--------------------------------------------------------------------===//
+
+class CatalogCacheTests : public PelotonTest {};
+
+TEST_F(CatalogCacheTests, LookupTest) {
+  int objects[3] = {0, 1, 2};
+  catalog::CatalogCache<int> cache;
+  auto catalog_version = catalog::GetCatalogVersion();
+
+  cache.Add(&objects[0], "a", 10);
+  cache.Add(&objects[1], "b", 11);
+  cache.Add(&objects[2], "a", 12);
+  EXPECT_EQ(3U, cache.GetSize());
+  EXPECT_EQ(3UL, cache.GetVersion());
+  EXPECT_EQ(catalog_version + 3, catalog::GetCatalogVersion());
+
+  // With duplicate names, the object added first wins
+  EXPECT_EQ(&objects[0], cache.GetWithName("a"));
+  EXPECT_EQ(&objects[1], cache.GetWithName("b"));
+  EXPECT_EQ(nullptr, cache.GetWithName("c"));
+  EXPECT_EQ(&objects[2], cache.GetWithOid(12));
+  EXPECT_EQ(nullptr, cache.GetWithOid(13));
+  EXPECT_EQ(&objects[1], cache.GetWithOffset(1));
+  EXPECT_EQ(nullptr, cache.GetWithOffset(3));
+
+  EXPECT_EQ(&objects[0], cache.Remove(10));
+  EXPECT_EQ(nullptr, cache.Remove(10));
+  EXPECT_EQ(4UL, cache.GetVersion());
+  EXPECT_EQ(&objects[2], cache.GetWithName("a"));
+  EXPECT_EQ(&objects[1], cache.GetWithOffset(0));
+
+  auto all_objects = cache.GetAll();
+  EXPECT_EQ(2U, all_objects.size());
+  EXPECT_EQ(&objects[1], all_objects[0]);
+  EXPECT_EQ(&objects[2], all_objects[1]);
+}
+
+TEST_F(CatalogCacheTests, ReclaimTest) {
+  auto &rcu = RCU::GetInstance();
+  rcu.Reclaim();
+  EXPECT_EQ(0U, rcu.GetRetiredCount());
+
+  int object = 0;
+  catalog::CatalogCache<int> cache;
+  {
+    // A reader keeps the snapshot it may see alive
+    RCUReadGuard guard;
+    cache.Add(&object, "a", 10);
+    EXPECT_EQ(1U, rcu.GetRetiredCount());
+    rcu.Reclaim();
+    EXPECT_EQ(1U, rcu.GetRetiredCount());
+    EXPECT_EQ(&object, cache.GetWithOid(10));
+  }
+
+  rcu.Reclaim();
+  EXPECT_EQ(0U, rcu.GetRetiredCount());
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -70,5 +70,45 @@ TEST_F(ManagerTests, TransactionTest) {
   // EXPECT_EQ(catalog::Manager::GetInstance().GetCurrentTileGroupId(), 800);
 }
 
+TEST_F(ManagerTests, TileGroupPtrTest) {
+  auto &manager = catalog::Manager::GetInstance();
+
+  std::vector<catalog::Column> columns;
+  columns.push_back(catalog::Column(
+      common::Type::INTEGER, common::Type::GetTypeSize(common::Type::INTEGER),
+      "A", true));
+  std::vector<catalog::Schema> schemas = {catalog::Schema(columns)};
+
+  std::map<oid_t, std::pair<oid_t, oid_t>> column_map;
+  column_map[0] = std::make_pair(0, 0);
+
+  auto tile_group_id = manager.GetNextTileGroupId();
+  std::shared_ptr<storage::TileGroup> tile_group(
+      storage::TileGroupFactory::GetTileGroup(INVALID_OID, INVALID_OID,
+                                              tile_group_id, nullptr, schemas,
+                                              column_map, 3));
+  manager.AddTileGroup(tile_group_id, tile_group);
+
+  EXPECT_EQ(tile_group.get(), manager.GetTileGroupPtr(tile_group_id));
+  EXPECT_EQ(tile_group->GetHeader(), manager.GetTileGroupHeader(tile_group_id));
+
+  // Replace the tile group under the same id
+  std::shared_ptr<storage::TileGroup> new_tile_group(
+      storage::TileGroupFactory::GetTileGroup(INVALID_OID, INVALID_OID,
+                                              tile_group_id, nullptr, schemas,
+                                              column_map, 3));
+  manager.AddTileGroup(tile_group_id, new_tile_group);
+
+  EXPECT_EQ(new_tile_group.get(), manager.GetTileGroupPtr(tile_group_id));
+  EXPECT_EQ(new_tile_group->GetHeader(),
+            manager.GetTileGroupHeader(tile_group_id));
+
+  manager.DropTileGroup(tile_group_id);
+
+  EXPECT_EQ(nullptr, manager.GetTileGroupPtr(tile_group_id));
+  EXPECT_EQ(nullptr, manager.GetTileGroupHeader(tile_group_id));
+  EXPECT_EQ(nullptr, manager.GetTileGroup(tile_group_id));
+}
+
 }  // End test namespace
 }  // End peloton namespace
@@ -0,0 +1,98 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// arena_test.cpp
+//
+// Identification: test/common/arena_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstdint>
+#include <cstring>
+
+#include "common/harness.h"
+
+#include "common/arena.h"
+#include "common/varlen_pool.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Arena Tests
+//===--------------------------------------------------------------------===//
+
+class ArenaTests : public PelotonTest {};
+
+TEST_F(ArenaTests, AllocateTest) {
+  common::Arena arena;
+  EXPECT_EQ(0U, arena.GetChunkCount());
+
+  // Small allocations share a chunk and stay aligned
+  char *previous = nullptr;
+  for (size_t size = 1; size <= 100; size++) {
+    auto location = static_cast<char *>(arena.Allocate(size));
+    EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(location) %
+                      common::ARENA_ALIGNMENT);
+    if (previous != nullptr) {
+      EXPECT_LT(previous, location);
+    }
+    memset(location, 'x', size);
+    previous = location;
+  }
+  EXPECT_EQ(1U, arena.GetChunkCount());
+
+  // A large allocation does not use up a chunk
+  auto large_size = common::ARENA_MAX_SMALL_SIZE + 1;
+  memset(arena.Allocate(large_size), 'y', large_size);
+  EXPECT_EQ(1U, arena.GetChunkCount());
+
+  // Fill the chunk, the next allocation is from another one
+  for (size_t allocation_itr = 0;
+       allocation_itr < common::ARENA_CHUNK_SIZE / common::ARENA_MAX_SMALL_SIZE;
+       allocation_itr++) {
+    arena.Allocate(common::ARENA_MAX_SMALL_SIZE);
+  }
+  EXPECT_EQ(2U, arena.GetChunkCount());
+}
+
+TEST_F(ArenaTests, RecycleTest) {
+  auto &chunk_cache = common::ArenaChunkCache::GetInstance();
+
+  common::Arena arena;
+  arena.Allocate(10);
+  EXPECT_EQ(1U, arena.GetChunkCount());
+  EXPECT_EQ(common::ARENA_ALIGNMENT, arena.GetAllocatedSize());
+
+  // The chunks go back to the cache and are handed out again
+  auto cached_chunk_count = chunk_cache.GetSize();
+  arena.Reset();
+  EXPECT_EQ(0U, arena.GetChunkCount());
+  EXPECT_EQ(0U, arena.GetAllocatedSize());
+  EXPECT_EQ(cached_chunk_count + 1, chunk_cache.GetSize());
+
+  common::Arena other_arena;
+  other_arena.Allocate(10);
+  EXPECT_EQ(cached_chunk_count, chunk_cache.GetSize());
+}
+
+TEST_F(ArenaTests, VarlenPoolTest) {
+  common::Arena arena;
+  common::VarlenPool pool(&arena);
+
+  auto location = pool.Allocate(40);
+  EXPECT_NE(nullptr, location);
+  EXPECT_EQ(48U, pool.GetTotalAllocatedSpace());
+
+  // Freed with the arena only
+  pool.Free(location);
+  EXPECT_EQ(48U, pool.GetTotalAllocatedSpace());
+  arena.Reset();
+  EXPECT_EQ(0U, pool.GetTotalAllocatedSpace());
+}
+
+}  // End test namespace
+}  // End peloton namespace
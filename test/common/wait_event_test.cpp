@@ -0,0 +1,78 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// wait_event_test.cpp
+//
+// Identification: test/common/wait_event_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <atomic>
+#include <thread>
+
+#include "common/harness.h"
+
+#include "common/platform.h"
+#include "common/wait_event.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Wait Event Tests
+//===--------------------------------------------------------------------===//
+
+class WaitEventTests : public PelotonTest {};
+
+TEST_F(WaitEventTests, RecordTest) {
+  auto wait_count = WaitEvents::GetWaitCount(WAIT_CLASS_EPOCH);
+  auto wait_time = WaitEvents::GetWaitTime(WAIT_CLASS_EPOCH);
+
+  WaitEvents::RecordWait(WAIT_CLASS_EPOCH, 0);
+  WaitEvents::RecordWait(WAIT_CLASS_EPOCH, 1000);
+  EXPECT_EQ(wait_count + 2, WaitEvents::GetWaitCount(WAIT_CLASS_EPOCH));
+  EXPECT_EQ(wait_time + 1000, WaitEvents::GetWaitTime(WAIT_CLASS_EPOCH));
+
+  // The waits of exited threads are kept
+  std::thread waiter([] {
+    WaitEventTimer timer(WAIT_CLASS_EPOCH);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  });
+  waiter.join();
+  EXPECT_EQ(wait_count + 3, WaitEvents::GetWaitCount(WAIT_CLASS_EPOCH));
+  EXPECT_LE(wait_time + 1000 + 1000000,
+            WaitEvents::GetWaitTime(WAIT_CLASS_EPOCH));
+}
+
+TEST_F(WaitEventTests, SpinlockTest) {
+  auto wait_count = WaitEvents::GetWaitCount(WAIT_CLASS_TUPLE_LOCK);
+
+  // An uncontended lock is not a wait
+  Spinlock lock;
+  lock.Lock(WAIT_CLASS_TUPLE_LOCK);
+  lock.Unlock();
+  EXPECT_EQ(wait_count, WaitEvents::GetWaitCount(WAIT_CLASS_TUPLE_LOCK));
+
+  // A contended lock is
+  lock.Lock();
+  std::atomic<bool> started(false);
+  std::thread waiter([&lock, &started] {
+    started = true;
+    lock.Lock(WAIT_CLASS_TUPLE_LOCK);
+    lock.Unlock();
+  });
+  while (started == false) {
+    std::this_thread::yield();
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  lock.Unlock();
+  waiter.join();
+  EXPECT_EQ(wait_count + 1, WaitEvents::GetWaitCount(WAIT_CLASS_TUPLE_LOCK));
+  EXPECT_LT(0U, WaitEvents::GetWaitTime(WAIT_CLASS_TUPLE_LOCK));
+}
+
+}  // End test namespace
+}  // End peloton namespace
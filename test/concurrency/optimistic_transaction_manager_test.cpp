@@ -0,0 +1,114 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// optimistic_transaction_manager_test.cpp
+//
+// Identification: test/concurrency/optimistic_transaction_manager_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+#include "concurrency/transaction_tests_util.h"
+
+namespace peloton {
+
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Optimistic Transaction Manager Tests
+//===--------------------------------------------------------------------===//
+
+class OptimisticTransactionManagerTests : public PelotonTest {};
+
+TEST_F(OptimisticTransactionManagerTests, ReadValidationTest) {
+  for (auto isolation_level :
+       {ISOLATION_LEVEL_TYPE_FULL, ISOLATION_LEVEL_TYPE_SNAPSHOT}) {
+    concurrency::TransactionManagerFactory::Configure(
+        CONCURRENCY_TYPE_OPTIMISTIC, isolation_level);
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+    std::unique_ptr<storage::DataTable> table(
+        TransactionTestsUtil::CreateTable());
+
+    TransactionScheduler scheduler(2, table.get(), &txn_manager);
+    // T0 reads (0, 0)
+    // T1 updates (0, 0) to (0, 1) and commits
+    // T0 updates (1, 0) to (1, 2) and commits
+    scheduler.Txn(0).Read(0);
+    scheduler.Txn(1).Update(0, 1);
+    scheduler.Txn(1).Commit();
+    scheduler.Txn(0).Update(1, 2);
+    scheduler.Txn(0).Commit();
+
+    scheduler.Run();
+    auto &schedules = scheduler.schedules;
+
+    EXPECT_EQ(RESULT_SUCCESS, schedules[1].txn_result);
+    // the read of T0 is stale when it commits, which is only allowed under
+    // snapshot isolation
+    if (isolation_level == ISOLATION_LEVEL_TYPE_SNAPSHOT) {
+      EXPECT_EQ(RESULT_SUCCESS, schedules[0].txn_result);
+    } else {
+      EXPECT_EQ(RESULT_ABORTED, schedules[0].txn_result);
+    }
+  }
+
+  concurrency::TransactionManagerFactory::Configure(
+      CONCURRENCY_TYPE_TIMESTAMP_ORDERING);
+}
+
+TEST_F(OptimisticTransactionManagerTests, SnapshotReadTest) {
+  concurrency::TransactionManagerFactory::Configure(
+      CONCURRENCY_TYPE_OPTIMISTIC);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  std::unique_ptr<storage::DataTable> table(
+      TransactionTestsUtil::CreateTable());
+
+  TransactionScheduler scheduler(2, table.get(), &txn_manager);
+  // the reads of T0 do not block T1, and T0 keeps reading its snapshot
+  scheduler.Txn(0).Read(0);
+  scheduler.Txn(1).Update(0, 1);
+  scheduler.Txn(1).Commit();
+  scheduler.Txn(0).Read(0);
+  scheduler.Txn(0).Commit();
+
+  scheduler.Run();
+  auto &schedules = scheduler.schedules;
+
+  EXPECT_EQ(RESULT_SUCCESS, schedules[0].txn_result);
+  EXPECT_EQ(RESULT_SUCCESS, schedules[1].txn_result);
+  EXPECT_EQ(2U, schedules[0].results.size());
+  EXPECT_EQ(0, schedules[0].results[0]);
+  EXPECT_EQ(0, schedules[0].results[1]);
+
+  concurrency::TransactionManagerFactory::Configure(
+      CONCURRENCY_TYPE_TIMESTAMP_ORDERING);
+}
+
+TEST_F(OptimisticTransactionManagerTests, FirstWriterWinsTest) {
+  concurrency::TransactionManagerFactory::Configure(
+      CONCURRENCY_TYPE_OPTIMISTIC);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  std::unique_ptr<storage::DataTable> table(
+      TransactionTestsUtil::CreateTable());
+
+  TransactionScheduler scheduler(2, table.get(), &txn_manager);
+  scheduler.Txn(0).Update(0, 1);
+  scheduler.Txn(1).Update(0, 2);
+  scheduler.Txn(0).Commit();
+  scheduler.Txn(1).Commit();
+
+  scheduler.Run();
+  auto &schedules = scheduler.schedules;
+
+  EXPECT_EQ(RESULT_SUCCESS, schedules[0].txn_result);
+  EXPECT_EQ(RESULT_ABORTED, schedules[1].txn_result);
+
+  concurrency::TransactionManagerFactory::Configure(
+      CONCURRENCY_TYPE_TIMESTAMP_ORDERING);
+}
+
+}  // End test namespace
+}  // End peloton namespace
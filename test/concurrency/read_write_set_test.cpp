@@ -0,0 +1,84 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// read_write_set_test.cpp
+//
+// Identification: test/concurrency/read_write_set_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+
+#include "concurrency/read_write_set.h"
+#include "concurrency/transaction.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Read Write Set Tests
+//===--------------------------------------------------------------------===//
+
+class ReadWriteSetTests : public PelotonTest {};
+
+TEST_F(ReadWriteSetTests, FindTest) {
+  // Large enough to index the entries
+  const oid_t entry_count = 100;
+  concurrency::ReadWriteSet rw_set;
+  EXPECT_TRUE(rw_set.empty());
+
+  for (oid_t entry_itr = 0; entry_itr < entry_count; entry_itr++) {
+    ItemPointer location(entry_itr / 10, entry_itr % 10);
+    EXPECT_EQ(nullptr, rw_set.Find(location));
+    rw_set.Insert(location, RW_TYPE_READ);
+  }
+  EXPECT_EQ(entry_count, rw_set.size());
+
+  // Update an entry in place
+  auto type = rw_set.Find(ItemPointer(5, 3));
+  EXPECT_NE(nullptr, type);
+  *type = RW_TYPE_UPDATE;
+  EXPECT_EQ(RW_TYPE_UPDATE, *rw_set.Find(ItemPointer(5, 3)));
+  EXPECT_EQ(nullptr, rw_set.Find(ItemPointer(10, 0)));
+
+  // The entries are kept in the order of their insertion
+  oid_t entry_itr = 0;
+  for (auto &entry : rw_set) {
+    EXPECT_EQ(entry_itr / 10, entry.location.block);
+    EXPECT_EQ(entry_itr % 10, entry.location.offset);
+    entry_itr++;
+  }
+
+  // Entries appended after the set is indexed can be found as well
+  rw_set.Insert(ItemPointer(10, 0), RW_TYPE_INSERT);
+  EXPECT_EQ(RW_TYPE_INSERT, *rw_set.Find(ItemPointer(10, 0)));
+}
+
+TEST_F(ReadWriteSetTests, RecordTest) {
+  concurrency::Transaction txn(1, 1);
+  ItemPointer location(1, 1);
+
+  txn.RecordRead(location);
+  EXPECT_EQ(RW_TYPE_READ, txn.GetRWType(location));
+  txn.RecordReadOwn(location);
+  EXPECT_EQ(RW_TYPE_READ_OWN, txn.GetRWType(location));
+  txn.RecordUpdate(location);
+  EXPECT_EQ(RW_TYPE_UPDATE, txn.GetRWType(location));
+  txn.RecordDelete(location);
+  EXPECT_EQ(RW_TYPE_DELETE, txn.GetRWType(location));
+
+  ItemPointer insert_location(1, 2);
+  txn.RecordInsert(insert_location);
+  EXPECT_FALSE(txn.IsReadOnly());
+  EXPECT_TRUE(txn.RecordDelete(insert_location));
+  EXPECT_EQ(RW_TYPE_INS_DEL, txn.GetRWType(insert_location));
+
+  EXPECT_EQ(2U, txn.GetReadWriteSet().size());
+  EXPECT_EQ(RW_TYPE_INVALID, txn.GetRWType(ItemPointer(2, 1)));
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -0,0 +1,134 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// time_travel_test.cpp
+//
+// Identification: test/concurrency/time_travel_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+#include "common/exception.h"
+#include "common/init.h"
+#include "concurrency/epoch_manager_factory.h"
+#include "concurrency/transaction_tests_util.h"
+#include "gc/gc_manager_factory.h"
+#include "gc/gc_manager_tests_util.h"
+
+namespace peloton {
+
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Time Travel Tests
+//===--------------------------------------------------------------------===//
+
+class TimeTravelTests : public PelotonTest {};
+
+TEST_F(TimeTravelTests, HistoricalTransactionTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  std::unique_ptr<storage::DataTable> table(
+      TransactionTestsUtil::CreateTable());
+
+  // Transactions may still commit before the current commit id
+  EXPECT_EQ(nullptr, txn_manager.BeginHistoricalTransaction(
+                         txn_manager.GetCurrentCommitId()));
+  EXPECT_EQ(MAX_CID, txn_manager.GetOldestSnapshotCid());
+
+  // The table was loaded after the snapshot
+  auto txn = txn_manager.BeginHistoricalTransaction(READ_ONLY_START_CID);
+  ASSERT_NE(nullptr, txn);
+  EXPECT_TRUE(txn->IsHistorical());
+  EXPECT_TRUE(txn->IsDeclaredReadOnly());
+  EXPECT_EQ(READ_ONLY_START_CID, txn_manager.GetOldestSnapshotCid());
+
+  int result;
+  TransactionTestsUtil::ExecuteRead(txn, table.get(), 0, result);
+  EXPECT_EQ(-1, result);
+
+  EXPECT_EQ(RESULT_SUCCESS, txn_manager.CommitTransaction(txn));
+  EXPECT_EQ(MAX_CID, txn_manager.GetOldestSnapshotCid());
+}
+
+TEST_F(TimeTravelTests, RetentionTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  std::unique_ptr<storage::DataTable> table(
+      TransactionTestsUtil::CreateTable());
+
+  EXPECT_EQ(0U, table->GetVersionRetention());
+  table->SetVersionRetention(60);
+  EXPECT_EQ(60U, table->GetVersionRetention());
+
+  EXPECT_TRUE(table->IsSnapshotRetained(READ_ONLY_START_CID));
+  table->RaiseExpiredCid(READ_ONLY_START_CID + 1);
+  EXPECT_FALSE(table->IsSnapshotRetained(READ_ONLY_START_CID));
+  EXPECT_TRUE(table->IsSnapshotRetained(READ_ONLY_START_CID + 1));
+
+  // The expired commit id never goes back
+  table->RaiseExpiredCid(READ_ONLY_START_CID);
+  EXPECT_FALSE(table->IsSnapshotRetained(READ_ONLY_START_CID));
+
+  // The versions of the snapshot may have been unlinked
+  auto txn = txn_manager.BeginHistoricalTransaction(READ_ONLY_START_CID);
+  ASSERT_NE(nullptr, txn);
+  int result;
+  EXPECT_THROW(
+      TransactionTestsUtil::ExecuteRead(txn, table.get(), 0, result),
+      ExecutorException);
+  txn_manager.CommitTransaction(txn);
+}
+
+// runs last, the garbage of the tests after it would never be collected
+TEST_F(TimeTravelTests, GarbageCollectionTest) {
+  // The snapshots need the epochs to advance. No gc thread is started, the
+  // garbage is unlinked below.
+  thread_pool.Initialize(0, 1);
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.StartEpoch();
+  gc::GCManagerFactory::Configure(1);
+  auto &gc_manager = gc::TransactionLevelGCManager::GetInstance();
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  for (size_t version_retention : {60, 0}) {
+    std::unique_ptr<storage::DataTable> table(
+        TransactionTestsUtil::CreateTable());
+    table->SetVersionRetention(version_retention);
+
+    auto txn = txn_manager.BeginTransaction();
+    EXPECT_TRUE(TransactionTestsUtil::ExecuteUpdate(txn, table.get(), 0, 1));
+    auto update_cid = txn->GetBeginCommitId();
+    EXPECT_EQ(RESULT_SUCCESS, txn_manager.CommitTransaction(txn));
+
+    // Wait until the update is older than the transactions the gc waits for
+    txn_manager.CommitTransaction(txn_manager.BeginTransaction());
+    while (txn_manager.GetMaxCommittedCid() <= update_cid) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(EPOCH_LENGTH));
+    }
+    GCManagerTestsUtil::Unlink(gc_manager, 0,
+                               txn_manager.GetMaxCommittedCid());
+
+    // The snapshot before the update
+    txn = txn_manager.BeginHistoricalTransaction(update_cid - 1);
+    ASSERT_NE(nullptr, txn);
+    int result;
+    if (version_retention > 0) {
+      EXPECT_TRUE(
+          TransactionTestsUtil::ExecuteRead(txn, table.get(), 0, result));
+      EXPECT_EQ(0, result);
+    } else {
+      EXPECT_THROW(
+          TransactionTestsUtil::ExecuteRead(txn, table.get(), 0, result),
+          ExecutorException);
+    }
+    txn_manager.CommitTransaction(txn);
+  }
+
+  epoch_manager.StopEpoch();
+  thread_pool.Shutdown();
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -0,0 +1,196 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// version_storage_test.cpp
+//
+// Identification: test/concurrency/version_storage_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+#include "common/config.h"
+#include "concurrency/transaction_tests_util.h"
+#include "gc/gc_manager_factory.h"
+#include "gc/gc_manager_tests_util.h"
+
+namespace peloton {
+
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Version Storage Tests
+//===--------------------------------------------------------------------===//
+
+class VersionStorageTests : public PelotonTest {};
+
+static const std::vector<VersionStorageType> version_storage_types = {
+    VERSION_STORAGE_TYPE_NEWEST_TO_OLDEST,
+    VERSION_STORAGE_TYPE_OLDEST_TO_NEWEST};
+
+// the test table with a primary key, its version chains in the given order
+static storage::DataTable *CreateTable(VersionStorageType version_storage,
+                                       int num_key = 10) {
+  auto default_version_storage = FLAGS_version_storage;
+  FLAGS_version_storage = VersionStorageTypeToString(version_storage);
+  auto table = TransactionTestsUtil::CreateTable(
+      num_key, "TEST_TABLE", INVALID_OID, INVALID_OID, 1234, true);
+  FLAGS_version_storage = default_version_storage;
+  return table;
+}
+
+TEST_F(VersionStorageTests, SetVersionStorageTypeTest) {
+  for (auto version_storage : version_storage_types) {
+    std::unique_ptr<storage::DataTable> table(CreateTable(version_storage));
+    EXPECT_EQ(version_storage, table->GetVersionStorageType());
+
+    // The table already holds versions
+    EXPECT_FALSE(
+        table->SetVersionStorageType(VERSION_STORAGE_TYPE_OLDEST_TO_NEWEST));
+    EXPECT_EQ(version_storage, table->GetVersionStorageType());
+
+    // The order of an empty table can still be changed
+    std::unique_ptr<storage::DataTable> empty_table(
+        CreateTable(version_storage, 0));
+    EXPECT_TRUE(empty_table->SetVersionStorageType(
+        VERSION_STORAGE_TYPE_OLDEST_TO_NEWEST));
+    EXPECT_EQ(VERSION_STORAGE_TYPE_OLDEST_TO_NEWEST,
+              empty_table->GetVersionStorageType());
+  }
+}
+
+TEST_F(VersionStorageTests, UpdateTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  for (auto version_storage : version_storage_types) {
+    std::unique_ptr<storage::DataTable> table(CreateTable(version_storage));
+
+    TransactionScheduler scheduler(5, table.get(), &txn_manager);
+    // T0 keeps reading the oldest version of the chain, T4 the newest one
+    scheduler.Txn(0).Read(0);
+    scheduler.Txn(1).Update(0, 1);
+    scheduler.Txn(1).Commit();
+    scheduler.Txn(2).Update(0, 2);
+    scheduler.Txn(2).Commit();
+    scheduler.Txn(0).Read(0);
+    scheduler.Txn(0).Commit();
+    scheduler.Txn(3).Update(0, 3);
+    scheduler.Txn(3).Abort();
+    scheduler.Txn(4).Read(0);
+    scheduler.Txn(4).Read(1);
+    scheduler.Txn(4).Commit();
+
+    scheduler.Run();
+    auto &schedules = scheduler.schedules;
+
+    EXPECT_EQ(RESULT_SUCCESS, schedules[0].txn_result);
+    EXPECT_EQ(RESULT_SUCCESS, schedules[1].txn_result);
+    EXPECT_EQ(RESULT_SUCCESS, schedules[2].txn_result);
+    EXPECT_EQ(RESULT_ABORTED, schedules[3].txn_result);
+    EXPECT_EQ(RESULT_SUCCESS, schedules[4].txn_result);
+
+    EXPECT_EQ(0, schedules[0].results[0]);
+    EXPECT_EQ(0, schedules[0].results[1]);
+    EXPECT_EQ(2, schedules[4].results[0]);
+    EXPECT_EQ(0, schedules[4].results[1]);
+  }
+}
+
+TEST_F(VersionStorageTests, DeleteInsertTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  for (auto version_storage : version_storage_types) {
+    std::unique_ptr<storage::DataTable> table(CreateTable(version_storage));
+
+    TransactionScheduler scheduler(4, table.get(), &txn_manager);
+    // The key is taken by the newest version, not by the one the index
+    // points to
+    scheduler.Txn(0).Update(0, 1);
+    scheduler.Txn(0).Commit();
+    scheduler.Txn(1).Insert(0, 5);
+    scheduler.Txn(1).Commit();
+    scheduler.Txn(2).Delete(0);
+    scheduler.Txn(2).Commit();
+    scheduler.Txn(3).Read(0);
+    scheduler.Txn(3).Insert(0, 6);
+    scheduler.Txn(3).Read(0);
+    scheduler.Txn(3).Commit();
+
+    scheduler.Run();
+    auto &schedules = scheduler.schedules;
+
+    EXPECT_EQ(RESULT_SUCCESS, schedules[0].txn_result);
+    EXPECT_EQ(RESULT_ABORTED, schedules[1].txn_result);
+    EXPECT_EQ(RESULT_SUCCESS, schedules[2].txn_result);
+    EXPECT_EQ(RESULT_SUCCESS, schedules[3].txn_result);
+
+    EXPECT_EQ(-1, schedules[3].results[0]);
+    EXPECT_EQ(6, schedules[3].results[1]);
+  }
+}
+
+// runs last, the garbage of the tests after it would never be collected
+TEST_F(VersionStorageTests, GarbageCollectionTest) {
+  // No gc thread is started, the garbage is collected below
+  gc::GCManagerFactory::Configure(1);
+  auto &gc_manager = gc::TransactionLevelGCManager::GetInstance();
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto &manager = catalog::Manager::GetInstance();
+
+  std::unique_ptr<storage::DataTable> table(
+      CreateTable(VERSION_STORAGE_TYPE_OLDEST_TO_NEWEST));
+
+  TransactionScheduler scheduler(3, table.get(), &txn_manager);
+  scheduler.Txn(0).Update(0, 1);
+  scheduler.Txn(0).Commit();
+  scheduler.Txn(1).Update(0, 2);
+  scheduler.Txn(1).Commit();
+  scheduler.Txn(2).Update(0, 3);
+  scheduler.Txn(2).Commit();
+
+  scheduler.Run();
+  auto &schedules = scheduler.schedules;
+
+  EXPECT_EQ(RESULT_SUCCESS, schedules[0].txn_result);
+  EXPECT_EQ(RESULT_SUCCESS, schedules[1].txn_result);
+  EXPECT_EQ(RESULT_SUCCESS, schedules[2].txn_result);
+
+  // The indirection still points to the inserted version
+  auto index = table->GetIndex(0);
+  std::unique_ptr<storage::Tuple> key(
+      new storage::Tuple(index->GetKeySchema(), true));
+  key->SetValue(0, common::ValueFactory::GetIntegerValue(0), nullptr);
+  std::vector<ItemPointer *> indirections;
+  index->ScanKey(key.get(), indirections);
+  EXPECT_EQ(1U, indirections.size());
+
+  auto oldest_location = *indirections[0];
+  auto oldest_header = manager.GetTileGroupHeader(oldest_location.block);
+  EXPECT_NE(MAX_CID, oldest_header->GetEndCommitId(oldest_location.offset));
+
+  GCManagerTestsUtil::ClearGarbage(gc_manager, 0);
+
+  // The indirection moved past the expired versions, which are reclaimed
+  auto newest_location = *indirections[0];
+  auto newest_header = manager.GetTileGroupHeader(newest_location.block);
+  EXPECT_EQ(INITIAL_TXN_ID,
+            newest_header->GetTransactionId(newest_location.offset));
+  EXPECT_EQ(MAX_CID, newest_header->GetEndCommitId(newest_location.offset));
+  EXPECT_EQ(INVALID_TXN_ID,
+            oldest_header->GetTransactionId(oldest_location.offset));
+
+  // The index reads start from the newest version
+  TransactionScheduler read_scheduler(1, table.get(), &txn_manager);
+  read_scheduler.Txn(0).Read(0);
+  read_scheduler.Txn(0).Commit();
+
+  read_scheduler.Run();
+
+  EXPECT_EQ(RESULT_SUCCESS, read_scheduler.schedules[0].txn_result);
+  EXPECT_EQ(3, read_scheduler.schedules[0].results[0]);
+}
+
+}  // End test namespace
+}  // End peloton namespace
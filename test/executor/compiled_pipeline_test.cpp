@@ -0,0 +1,232 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compiled_pipeline_test.cpp
+//
+// Identification: test/executor/compiled_pipeline_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "common/exception.h"
+#include "common/value_factory.h"
+#include "executor/compiled_pipeline.h"
+#include "executor/executor_tests_util.h"
+#include "executor/plan_executor.h"
+#include "expression/expression_util.h"
+#include "expression/parameter_value_expression.h"
+#include "planner/aggregate_plan.h"
+#include "planner/projection_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
+#include "storage/shared_scan.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Compiled Pipeline Tests
+//===--------------------------------------------------------------------===//
+
+class CompiledPipelineTests : public PelotonTest {};
+
+// SELECT a, b FROM table WHERE a < $1
+static std::unique_ptr<planner::AbstractPlan> GetScanPlan(
+    storage::DataTable *table) {
+  auto predicate = expression::ExpressionUtil::ComparisonFactory(
+      EXPRESSION_TYPE_COMPARE_LESSTHAN,
+      expression::ExpressionUtil::TupleValueFactory(common::Type::INTEGER, 0,
+                                                    0),
+      new expression::ParameterValueExpression(0));
+  std::vector<oid_t> column_ids({0, 1});
+  return std::unique_ptr<planner::AbstractPlan>(
+      new planner::SeqScanPlan(table, predicate, column_ids));
+}
+
+// Compare the results of the executors and of the pipeline of the plan
+static void RunPlan(const planner::AbstractPlan *plan, size_t column_count,
+                    size_t expected_row_count) {
+  std::vector<common::Value> params(
+      {common::ValueFactory::GetIntegerValue(101)});
+  std::vector<int> result_format(column_count, 0);
+
+  std::vector<ResultType> plan_result;
+  auto plan_status = bridge::PlanExecutor::ExecutePlan(plan, params,
+                                                       plan_result,
+                                                       result_format);
+  EXPECT_EQ(Result::RESULT_SUCCESS, plan_status.m_result);
+
+  auto pipeline = executor::CompiledPipeline::Compile(plan);
+  EXPECT_NE(nullptr, pipeline.get());
+
+  std::vector<ResultType> pipeline_result;
+  auto pipeline_status = bridge::PlanExecutor::ExecutePipeline(
+      pipeline.get(), params, pipeline_result, result_format);
+  EXPECT_EQ(Result::RESULT_SUCCESS, pipeline_status.m_result);
+
+  EXPECT_EQ(expected_row_count * column_count, plan_result.size());
+  EXPECT_EQ(plan_result, pipeline_result);
+}
+
+TEST_F(CompiledPipelineTests, ScanProjectionTest) {
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateAndPopulateTable());
+
+  // The populated values of the first column are multiples of ten
+  RunPlan(GetScanPlan(data_table.get()).get(), 2, 11);
+
+  // SELECT a, a + b FROM table WHERE a < $1
+  std::vector<catalog::Column> columns;
+  auto table_schema = data_table->GetSchema();
+  columns.push_back(table_schema->GetColumn(0));
+  columns.push_back(table_schema->GetColumn(0));
+  std::shared_ptr<const catalog::Schema> schema(new catalog::Schema(columns));
+
+  DirectMapList direct_map_list;
+  direct_map_list.push_back(std::make_pair(0, std::make_pair(0, 0)));
+  TargetList target_list;
+  target_list.push_back(std::make_pair(
+      1, expression::ExpressionUtil::OperatorFactory(
+             EXPRESSION_TYPE_OPERATOR_PLUS, common::Type::INTEGER,
+             expression::ExpressionUtil::TupleValueFactory(
+                 common::Type::INTEGER, 0, 0),
+             expression::ExpressionUtil::TupleValueFactory(
+                 common::Type::INTEGER, 0, 1))));
+  std::unique_ptr<const planner::ProjectInfo> project_info(
+      new planner::ProjectInfo(std::move(target_list),
+                               std::move(direct_map_list)));
+
+  std::unique_ptr<planner::AbstractPlan> projection_plan(
+      new planner::ProjectionPlan(std::move(project_info), schema));
+  projection_plan->AddChild(GetScanPlan(data_table.get()));
+  RunPlan(projection_plan.get(), 2, 11);
+}
+
+TEST_F(CompiledPipelineTests, AggregateTest) {
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateAndPopulateTable());
+
+  // SELECT COUNT(b) FROM table WHERE a < $1
+  DirectMapList direct_map_list = {{0, {1, 0}}};
+  std::unique_ptr<const planner::ProjectInfo> project_info(
+      new planner::ProjectInfo(TargetList(), std::move(direct_map_list)));
+
+  std::vector<planner::AggregatePlan::AggTerm> agg_terms;
+  agg_terms.push_back(planner::AggregatePlan::AggTerm(
+      EXPRESSION_TYPE_AGGREGATE_COUNT,
+      expression::ExpressionUtil::TupleValueFactory(common::Type::INTEGER, 0,
+                                                    1)));
+  std::vector<oid_t> group_by_columns;
+  std::unique_ptr<const expression::AbstractExpression> predicate(nullptr);
+
+  std::vector<catalog::Column> columns(
+      {data_table->GetSchema()->GetColumn(1)});
+  std::shared_ptr<const catalog::Schema> output_schema(
+      new catalog::Schema(columns));
+
+  std::unique_ptr<planner::AbstractPlan> aggregate_plan(
+      new planner::AggregatePlan(
+          std::move(project_info), std::move(predicate), std::move(agg_terms),
+          std::move(group_by_columns), output_schema, AGGREGATE_TYPE_PLAIN));
+  aggregate_plan->AddChild(GetScanPlan(data_table.get()));
+  RunPlan(aggregate_plan.get(), 1, 1);
+}
+
+TEST_F(CompiledPipelineTests, ColumnPredicateTest) {
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateAndPopulateTable());
+
+  // Compress the first tile group as a column store
+  storage::column_map_type column_map;
+  for (oid_t column_itr = 0; column_itr < 4; column_itr++) {
+    column_map[column_itr] = std::make_pair(column_itr, 0);
+  }
+  data_table->SetDefaultLayout(column_map);
+  EXPECT_NE(nullptr, data_table->TransformTileGroup(0, 0.0));
+  EXPECT_NE(nullptr, data_table->CompressTileGroup(0));
+
+  // SELECT a, b FROM table WHERE a > 15 AND a < 65. The first tile group is
+  // prefiltered on its compressed column, the zone map of the last one rules
+  // it out.
+  auto predicate = expression::ExpressionUtil::ConjunctionFactory(
+      EXPRESSION_TYPE_CONJUNCTION_AND,
+      expression::ExpressionUtil::ComparisonFactory(
+          EXPRESSION_TYPE_COMPARE_GREATERTHAN,
+          expression::ExpressionUtil::TupleValueFactory(common::Type::INTEGER,
+                                                        0, 0),
+          expression::ExpressionUtil::ConstantValueFactory(
+              common::ValueFactory::GetIntegerValue(15))),
+      expression::ExpressionUtil::ComparisonFactory(
+          EXPRESSION_TYPE_COMPARE_LESSTHAN,
+          expression::ExpressionUtil::TupleValueFactory(common::Type::INTEGER,
+                                                        0, 0),
+          expression::ExpressionUtil::ConstantValueFactory(
+              common::ValueFactory::GetIntegerValue(65))));
+  std::vector<oid_t> column_ids({0, 1});
+  planner::SeqScanPlan scan_plan(data_table.get(), predicate, column_ids);
+  RunPlan(&scan_plan, 2, 5);
+
+  // The scans are detached from the shared cursor of the table
+  EXPECT_EQ(0U, data_table->GetSharedScan().GetScanCount());
+}
+
+TEST_F(CompiledPipelineTests, SharedScanGuardTest) {
+  storage::SharedScan shared_scan;
+
+  // A pipeline left by an exception is detached as well
+  try {
+    storage::SharedScanGuard shared_scan_guard;
+    EXPECT_EQ(START_OID, shared_scan_guard.Attach(&shared_scan, 4));
+    EXPECT_EQ(1U, shared_scan.GetScanCount());
+    throw ExecutorException("pipeline failed");
+  } catch (ExecutorException &e) {
+  }
+  EXPECT_EQ(0U, shared_scan.GetScanCount());
+
+  // Detaching is done once
+  {
+    storage::SharedScanGuard shared_scan_guard;
+    shared_scan_guard.Attach(&shared_scan, 4);
+    shared_scan_guard.Detach();
+    EXPECT_EQ(0U, shared_scan.GetScanCount());
+  }
+  EXPECT_EQ(0U, shared_scan.GetScanCount());
+}
+
+TEST_F(CompiledPipelineTests, UnsupportedPlanTest) {
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateAndPopulateTable());
+
+  // A sorted aggregation needs its input in order
+  DirectMapList direct_map_list = {{0, {0, 0}}};
+  std::unique_ptr<const planner::ProjectInfo> project_info(
+      new planner::ProjectInfo(TargetList(), std::move(direct_map_list)));
+  std::vector<planner::AggregatePlan::AggTerm> agg_terms;
+  std::vector<oid_t> group_by_columns({0});
+  std::unique_ptr<const expression::AbstractExpression> predicate(nullptr);
+  std::vector<catalog::Column> columns(
+      {data_table->GetSchema()->GetColumn(0)});
+  std::shared_ptr<const catalog::Schema> output_schema(
+      new catalog::Schema(columns));
+
+  std::unique_ptr<planner::AbstractPlan> aggregate_plan(
+      new planner::AggregatePlan(
+          std::move(project_info), std::move(predicate), std::move(agg_terms),
+          std::move(group_by_columns), output_schema, AGGREGATE_TYPE_SORTED));
+  aggregate_plan->AddChild(GetScanPlan(data_table.get()));
+  EXPECT_EQ(nullptr, executor::CompiledPipeline::Compile(aggregate_plan.get()));
+
+  // Nor is a scan without its table
+  planner::SeqScanPlan scan_plan;
+  EXPECT_EQ(nullptr, executor::CompiledPipeline::Compile(&scan_plan));
+}
+
+}  // End test namespace
+}  // End peloton namespace
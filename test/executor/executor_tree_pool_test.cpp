@@ -0,0 +1,138 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// executor_tree_pool_test.cpp
+//
+// Identification: test/executor/executor_tree_pool_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "common/value_factory.h"
+#include "executor/executor_tests_util.h"
+#include "executor/executor_tree_pool.h"
+#include "executor/plan_executor.h"
+#include "expression/expression_util.h"
+#include "expression/parameter_value_expression.h"
+#include "planner/aggregate_plan.h"
+#include "planner/limit_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Executor Tree Pool Tests
+//===--------------------------------------------------------------------===//
+
+class ExecutorTreePoolTests : public PelotonTest {};
+
+TEST_F(ExecutorTreePoolTests, ReuseTest) {
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateAndPopulateTable());
+
+  // SELECT a, b FROM table WHERE a < $1 LIMIT 100
+  auto predicate = expression::ExpressionUtil::ComparisonFactory(
+      EXPRESSION_TYPE_COMPARE_LESSTHAN,
+      expression::ExpressionUtil::TupleValueFactory(common::Type::INTEGER, 0,
+                                                    0),
+      new expression::ParameterValueExpression(0));
+  std::vector<oid_t> column_ids({0, 1});
+  std::unique_ptr<planner::AbstractPlan> plan(new planner::LimitPlan(100, 0));
+  plan->AddChild(std::unique_ptr<planner::AbstractPlan>(
+      new planner::SeqScanPlan(data_table.get(), predicate, column_ids)));
+  EXPECT_TRUE(executor::ExecutorTreePool::IsReusable(plan.get()));
+
+  executor::ExecutorTreePool tree_pool(1);
+  std::vector<int> result_format(2, 0);
+
+  // The populated values of the first column are multiples of ten
+  for (int32_t bound : {101, 31, 101, 1000}) {
+    std::vector<common::Value> params(
+        {common::ValueFactory::GetIntegerValue(bound)});
+
+    std::vector<ResultType> pooled_result;
+    auto status = bridge::PlanExecutor::ExecutePlan(
+        plan.get(), params, pooled_result, result_format, nullptr, nullptr,
+        &tree_pool);
+    EXPECT_EQ(Result::RESULT_SUCCESS, status.m_result);
+    EXPECT_EQ(1U, tree_pool.GetSize());
+
+    std::vector<ResultType> result;
+    bridge::PlanExecutor::ExecutePlan(plan.get(), params, result,
+                                      result_format);
+    EXPECT_EQ(result, pooled_result);
+    EXPECT_EQ(2U * std::min((bound + 9) / 10, 15), pooled_result.size());
+  }
+
+  // Only a single tree is kept
+  auto tree = tree_pool.Acquire();
+  EXPECT_NE(nullptr, tree.get());
+  EXPECT_EQ(nullptr, tree_pool.Acquire().get());
+  tree_pool.Release(std::move(tree));
+  EXPECT_EQ(1U, tree_pool.GetSize());
+}
+
+TEST_F(ExecutorTreePoolTests, LimitTest) {
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateAndPopulateTable());
+  executor::ExecutorTreePool tree_pool(1);
+
+  // SELECT a, b FROM table LIMIT 1
+  std::vector<oid_t> column_ids({0, 1});
+  std::unique_ptr<planner::AbstractPlan> plan(new planner::LimitPlan(1, 0));
+  plan->AddChild(std::unique_ptr<planner::AbstractPlan>(
+      new planner::SeqScanPlan(data_table.get(), nullptr, column_ids)));
+
+  std::vector<int> result_format(2, 0);
+  std::vector<common::Value> params;
+  std::vector<ResultType> result;
+  auto status = bridge::PlanExecutor::ExecutePlan(
+      plan.get(), params, result, result_format, nullptr, nullptr, &tree_pool);
+  EXPECT_EQ(Result::RESULT_SUCCESS, status.m_result);
+  EXPECT_EQ(2U, result.size());
+  EXPECT_EQ(1U, tree_pool.GetSize());
+
+  // The scan stopped by the limit is detached from the shared scan, although
+  // its tree is kept
+  EXPECT_EQ(0U, data_table->GetSharedScan().GetScanCount());
+
+  // The pooled tree does not touch the table once it is dropped
+  data_table.reset();
+}
+
+TEST_F(ExecutorTreePoolTests, NotReusableTest) {
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateAndPopulateTable());
+
+  // Only the executors meant for short statements are reused
+  DirectMapList direct_map_list = {{0, {0, 0}}};
+  std::unique_ptr<const planner::ProjectInfo> project_info(
+      new planner::ProjectInfo(TargetList(), std::move(direct_map_list)));
+  std::vector<planner::AggregatePlan::AggTerm> agg_terms;
+  std::vector<oid_t> group_by_columns({0});
+  std::unique_ptr<const expression::AbstractExpression> predicate(nullptr);
+  std::vector<catalog::Column> columns(
+      {data_table->GetSchema()->GetColumn(0)});
+  std::shared_ptr<const catalog::Schema> output_schema(
+      new catalog::Schema(columns));
+
+  std::unique_ptr<planner::AbstractPlan> plan(new planner::AggregatePlan(
+      std::move(project_info), std::move(predicate), std::move(agg_terms),
+      std::move(group_by_columns), output_schema, AGGREGATE_TYPE_HASH));
+  plan->AddChild(std::unique_ptr<planner::AbstractPlan>(
+      new planner::SeqScanPlan(data_table.get(), nullptr, {0})));
+  EXPECT_FALSE(executor::ExecutorTreePool::IsReusable(plan.get()));
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -0,0 +1,113 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// explain_analyze_test.cpp
+//
+// Identification: test/executor/explain_analyze_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "catalog/catalog.h"
+#include "common/harness.h"
+#include "common/logger.h"
+#include "common/statement.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/create_executor.h"
+#include "executor/executor_context.h"
+#include "planner/create_plan.h"
+#include "tcop/tcop.h"
+
+#include "gtest/gtest.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Explain Analyze Tests
+//===--------------------------------------------------------------------===//
+
+class ExplainAnalyzeTests : public PelotonTest {};
+
+static Result ExecuteQuery(const std::string &query,
+                           std::shared_ptr<Statement> &statement,
+                           std::vector<ResultType> &result) {
+  auto &traffic_cop = tcop::TrafficCop::GetInstance();
+  std::string error_message;
+  statement = traffic_cop.PrepareStatement("test", query, error_message);
+  EXPECT_NE(nullptr, statement.get());
+
+  std::vector<common::Value> params;
+  std::vector<int> result_format(statement->GetTupleDescriptor().size(), 0);
+  int rows_changed;
+  return traffic_cop.ExecuteStatement(statement, params, true, nullptr,
+                                      result_format, result, rows_changed,
+                                      error_message);
+}
+
+TEST_F(ExplainAnalyzeTests, SeqScanTest) {
+  catalog::Catalog::GetInstance()->CreateDatabase(DEFAULT_DB_NAME, nullptr);
+
+  // Create a table first
+  auto id_column = catalog::Column(
+      common::Type::INTEGER, common::Type::GetTypeSize(common::Type::INTEGER),
+      "dept_id", true);
+  auto name_column =
+      catalog::Column(common::Type::VARCHAR, 32, "dept_name", false);
+  std::unique_ptr<catalog::Schema> table_schema(
+      new catalog::Schema({id_column, name_column}));
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+  planner::CreatePlan node("department_table", DEFAULT_DB_NAME,
+                           std::move(table_schema),
+                           CreateType::CREATE_TYPE_TABLE);
+  executor::CreateExecutor create_executor(&node, context.get());
+  create_executor.Init();
+  create_executor.Execute();
+  txn_manager.CommitTransaction(txn);
+
+  std::shared_ptr<Statement> statement;
+  std::vector<ResultType> result;
+  EXPECT_EQ(Result::RESULT_SUCCESS,
+            ExecuteQuery("INSERT INTO department_table(dept_id,dept_name) "
+                         "VALUES (1,'hello_1');",
+                         statement, result));
+  EXPECT_EQ(Result::RESULT_SUCCESS,
+            ExecuteQuery("INSERT INTO department_table(dept_id,dept_name) "
+                         "VALUES (2,'hello_2');",
+                         statement, result));
+
+  // The plan is returned instead of the tuples, a row per executor
+  EXPECT_EQ(Result::RESULT_SUCCESS,
+            ExecuteQuery("explain  analyze SELECT * FROM department_table;",
+                         statement, result));
+  EXPECT_TRUE(statement->IsExplainAnalyze());
+  auto tuple_descriptor = statement->GetTupleDescriptor();
+  EXPECT_EQ(1U, tuple_descriptor.size());
+  EXPECT_EQ("QUERY PLAN", std::get<0>(tuple_descriptor[0]));
+
+  EXPECT_FALSE(result.empty());
+  std::string plan(result[0].second.begin(), result[0].second.end());
+  LOG_INFO("%s", plan.c_str());
+  EXPECT_EQ(0U, plan.find("SEQSCAN"));
+  EXPECT_NE(std::string::npos, plan.find("out=2"));
+  EXPECT_NE(std::string::npos, plan.find("time="));
+
+  // Plain statements are not affected
+  EXPECT_EQ(Result::RESULT_SUCCESS,
+            ExecuteQuery("SELECT * FROM department_table;", statement, result));
+  EXPECT_FALSE(statement->IsExplainAnalyze());
+  EXPECT_EQ(4U, result.size());
+
+  // free the database just created
+  txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->DropDatabaseWithName(DEFAULT_DB_NAME, txn);
+  txn_manager.CommitTransaction(txn);
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -0,0 +1,131 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_nested_loop_join_test.cpp
+//
+// Identification: test/executor/index_nested_loop_join_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+
+#include "common/harness.h"
+
+#include "catalog/schema.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/executor_context.h"
+#include "executor/index_nested_loop_join_executor.h"
+#include "executor/logical_tile.h"
+#include "executor/seq_scan_executor.h"
+#include "planner/index_nested_loop_join_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Index Nested Loop Join Tests
+//===--------------------------------------------------------------------===//
+
+class IndexNestedLoopJoinTests : public PelotonTest {};
+
+// Joins a scan of the outer table with the primary index of the inner table
+// on the given outer column, returns the number of joined tuples
+static size_t ExecuteIndexNestedLoopJoin(storage::DataTable *outer_table,
+                                         storage::DataTable *inner_table,
+                                         PelotonJoinType join_type,
+                                         oid_t outer_key_column_id) {
+  std::vector<oid_t> outer_column_ids({0, 1});
+  std::vector<oid_t> inner_column_ids({0, 1});
+
+  // the outer columns followed by the inner columns
+  std::vector<catalog::Column> columns;
+  for (auto column_id : outer_column_ids) {
+    columns.push_back(outer_table->GetSchema()->GetColumn(column_id));
+  }
+  for (auto column_id : inner_column_ids) {
+    columns.push_back(inner_table->GetSchema()->GetColumn(column_id));
+  }
+  std::shared_ptr<const catalog::Schema> schema(new catalog::Schema(columns));
+
+  planner::SeqScanPlan outer_node(outer_table, nullptr, outer_column_ids);
+  planner::IndexNestedLoopJoinPlan join_node(
+      join_type, nullptr, nullptr, schema, inner_table,
+      inner_table->GetIndex(0), {outer_key_column_id}, inner_column_ids);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  executor::SeqScanExecutor outer_executor(&outer_node, context.get());
+  executor::IndexNestedLoopJoinExecutor join_executor(&join_node,
+                                                      context.get());
+  join_executor.AddChild(&outer_executor);
+
+  EXPECT_TRUE(join_executor.Init());
+
+  size_t tuple_count = 0;
+  while (join_executor.Execute()) {
+    std::unique_ptr<executor::LogicalTile> result_tile(
+        join_executor.GetOutput());
+    EXPECT_EQ(4U, result_tile->GetColumnCount());
+
+    for (auto tuple_id : *result_tile) {
+      // the outer key and the inner key are equal
+      if (join_type == JOIN_TYPE_INNER) {
+        EXPECT_EQ(
+            result_tile->GetValue(tuple_id, outer_key_column_id)
+                .GetAs<int32_t>(),
+            result_tile->GetValue(tuple_id, 2).GetAs<int32_t>());
+      }
+      tuple_count++;
+    }
+  }
+
+  txn_manager.CommitTransaction(txn);
+
+  return tuple_count;
+}
+
+TEST_F(IndexNestedLoopJoinTests, InnerJoinTest) {
+  std::unique_ptr<storage::DataTable> outer_table(
+      ExecutorTestsUtil::CreateAndPopulateTable());
+  std::unique_ptr<storage::DataTable> inner_table(
+      ExecutorTestsUtil::CreateAndPopulateTable());
+  size_t table_size = TESTS_TUPLES_PER_TILEGROUP * DEFAULT_TILEGROUP_COUNT;
+
+  // Every outer tuple finds its inner tuple
+  EXPECT_EQ(table_size,
+            ExecuteIndexNestedLoopJoin(outer_table.get(), inner_table.get(),
+                                       JOIN_TYPE_INNER, 0));
+
+  // Column 1 of the outer table is never a key of the inner table
+  EXPECT_EQ(0U, ExecuteIndexNestedLoopJoin(outer_table.get(), inner_table.get(),
+                                           JOIN_TYPE_INNER, 1));
+}
+
+TEST_F(IndexNestedLoopJoinTests, LeftJoinTest) {
+  std::unique_ptr<storage::DataTable> outer_table(
+      ExecutorTestsUtil::CreateAndPopulateTable());
+  std::unique_ptr<storage::DataTable> inner_table(
+      ExecutorTestsUtil::CreateAndPopulateTable());
+  size_t table_size = TESTS_TUPLES_PER_TILEGROUP * DEFAULT_TILEGROUP_COUNT;
+
+  // Outer tuples without a match are still returned
+  EXPECT_EQ(table_size,
+            ExecuteIndexNestedLoopJoin(outer_table.get(), inner_table.get(),
+                                       JOIN_TYPE_LEFT, 0));
+  EXPECT_EQ(table_size,
+            ExecuteIndexNestedLoopJoin(outer_table.get(), inner_table.get(),
+                                       JOIN_TYPE_LEFT, 1));
+}
+
+}  // End test namespace
+}  // End peloton namespace
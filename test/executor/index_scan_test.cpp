@@ -173,6 +173,86 @@ TEST_F(IndexScanTests, MultiColumnPredicateTest) {
   txn_manager.CommitTransaction(txn);
 }
 
+// Index scan of a list of keys, e.g. ATTR 0 IN (...)
+TEST_F(IndexScanTests, KeyListTest) {
+  // First, generate the table with index
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateAndPopulateTable());
+
+  // Column ids to be added to logical tile after scan.
+  std::vector<oid_t> column_ids({0, 1, 3});
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  //===--------------------------------------------------------------------===//
+  // ATTR 0 IN (140, 20, 70, 20, 0, 999) on the primary index
+  //===--------------------------------------------------------------------===//
+
+  std::vector<std::vector<common::Value>> key_list;
+  for (auto key : {140, 20, 70, 20, 0, 999}) {
+    key_list.push_back({common::ValueFactory::GetIntegerValue(key)});
+  }
+
+  planner::IndexScanPlan::IndexScanDesc index_scan_desc(
+      data_table->GetIndex(0), key_list);
+  planner::IndexScanPlan node(data_table.get(), nullptr, column_ids,
+                              index_scan_desc);
+
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  // Duplicate keys are only returned once, one tile per tile group
+  executor::IndexScanExecutor executor(&node, context.get());
+  EXPECT_TRUE(executor.Init());
+
+  std::vector<std::unique_ptr<executor::LogicalTile>> result_tiles;
+  while (executor.Execute()) {
+    result_tiles.emplace_back(executor.GetOutput());
+  }
+  EXPECT_EQ(3U, result_tiles.size());
+  EXPECT_EQ(2U, result_tiles[0]->GetTupleCount());
+  EXPECT_EQ(1U, result_tiles[1]->GetTupleCount());
+  EXPECT_EQ(1U, result_tiles[2]->GetTupleCount());
+  EXPECT_EQ(140, result_tiles[2]->GetValue(0, 0).GetAs<int32_t>());
+
+  txn_manager.CommitTransaction(txn);
+
+  //===--------------------------------------------------------------------===//
+  // (ATTR 0, ATTR 1) IN ((70, 71), (20, 21), (70, 72)) on the secondary index
+  //===--------------------------------------------------------------------===//
+
+  key_list.clear();
+  key_list.push_back({common::ValueFactory::GetIntegerValue(70),
+                      common::ValueFactory::GetIntegerValue(71)});
+  key_list.push_back({common::ValueFactory::GetIntegerValue(20),
+                      common::ValueFactory::GetIntegerValue(21)});
+  key_list.push_back({common::ValueFactory::GetIntegerValue(70),
+                      common::ValueFactory::GetIntegerValue(72)});
+
+  planner::IndexScanPlan::IndexScanDesc secondary_scan_desc(
+      data_table->GetIndex(1), key_list);
+  planner::IndexScanPlan secondary_node(data_table.get(), nullptr, column_ids,
+                                        secondary_scan_desc);
+
+  txn = txn_manager.BeginTransaction();
+  context.reset(new executor::ExecutorContext(txn));
+
+  executor::IndexScanExecutor secondary_executor(&secondary_node,
+                                                 context.get());
+  EXPECT_TRUE(secondary_executor.Init());
+
+  size_t tuple_count = 0;
+  while (secondary_executor.Execute()) {
+    std::unique_ptr<executor::LogicalTile> result_tile(
+        secondary_executor.GetOutput());
+    tuple_count += result_tile->GetTupleCount();
+  }
+  EXPECT_EQ(2U, tuple_count);
+
+  txn_manager.CommitTransaction(txn);
+}
+
 void ShowTable(std::string database_name, std::string table_name) {
   auto table = catalog::Catalog::GetInstance()->GetTableWithName(database_name,
                                                                  table_name);
@@ -0,0 +1,113 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// parallel_scan_test.cpp
+//
+// Identification: test/executor/parallel_scan_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/executor_context.h"
+#include "executor/executor_tests_util.h"
+#include "executor/gather_executor.h"
+#include "executor/logical_tile.h"
+#include "executor/morsel_queue.h"
+#include "executor/pipeline.h"
+#include "executor/task_scheduler.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Parallel Scan Tests
+//===--------------------------------------------------------------------===//
+
+class ParallelScanTests : public PelotonTest {};
+
+TEST_F(ParallelScanTests, MorselQueueTest) {
+  const oid_t tile_group_count = 10;
+  executor::MorselQueue morsel_queue(tile_group_count, 3);
+
+  // The first worker scans its own range, then steals all the other morsels
+  std::vector<int> scan_counts(tile_group_count, 0);
+  executor::Morsel morsel;
+  oid_t morsel_count = 0;
+  while (morsel_queue.GetNextMorsel(0, morsel) == true) {
+    EXPECT_EQ(1U, morsel.tile_group_count);
+    if (morsel_count == 0) {
+      EXPECT_EQ(0U, morsel.tile_group_offset);
+    }
+    scan_counts[morsel.tile_group_offset]++;
+    morsel_count++;
+  }
+
+  EXPECT_EQ(tile_group_count, morsel_count);
+  for (auto scan_count : scan_counts) {
+    EXPECT_EQ(1, scan_count);
+  }
+  EXPECT_FALSE(morsel_queue.GetNextMorsel(1, morsel));
+}
+
+TEST_F(ParallelScanTests, ParallelSeqScanTest) {
+  const int tuple_count = 1000;
+
+  auto &task_scheduler = executor::TaskScheduler::GetInstance();
+  task_scheduler.StartScheduler(3);
+  EXPECT_EQ(4UL, task_scheduler.GetParallelism(8));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(10, false));
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count, false, false,
+                                   false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // The whole scan is a single pipeline
+  planner::SeqScanPlan scan_node(table.get(), nullptr, {0, 1});
+  EXPECT_TRUE(executor::Pipeline::IsParallelizable(&scan_node));
+
+  txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+  context->SetDegreeOfParallelism(4);
+
+  executor::GatherExecutor executor(&scan_node, context.get());
+  EXPECT_TRUE(executor.Init());
+
+  // Every tuple is returned exactly once
+  std::set<int> values;
+  int result_tuple_count = 0;
+  while (executor.Execute() == true) {
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    for (oid_t tuple_id : *result_tile) {
+      values.insert(result_tile->GetValue(tuple_id, 0).GetAs<int32_t>());
+      result_tuple_count++;
+    }
+  }
+  txn_manager.CommitTransaction(txn);
+
+  EXPECT_EQ(tuple_count, result_tuple_count);
+  EXPECT_EQ(tuple_count, (int)values.size());
+  EXPECT_EQ(0, *values.begin());
+  EXPECT_EQ(ExecutorTestsUtil::PopulatedValue(tuple_count - 1, 0),
+            *values.rbegin());
+
+  task_scheduler.StopScheduler();
+  EXPECT_EQ(1UL, task_scheduler.GetParallelism(8));
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -270,6 +270,41 @@ TEST_F(SeqScanTests, TwoTileGroupsWithPredicateTest) {
   txn_manager.CommitTransaction(txn);
 }
 
+// A scan that starts while another one is running joins it at its tile group
+// and wraps around to the ones it missed.
+TEST_F(SeqScanTests, SharedScanTest) {
+  std::unique_ptr<storage::DataTable> table(CreateTable());
+  std::vector<oid_t> column_ids({0, 1, 3});
+  planner::SeqScanPlan node(table.get(), CreatePredicate(g_tuple_ids),
+                            column_ids);
+  auto &shared_scan = table->GetSharedScan();
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  std::unique_ptr<executor::SeqScanExecutor> leader(
+      new executor::SeqScanExecutor(&node, context.get()));
+  EXPECT_TRUE(leader->Init());
+  EXPECT_EQ(1U, shared_scan.GetScanCount());
+  delete GetNextTile(*leader);
+  delete GetNextTile(*leader);
+  EXPECT_EQ(1U, shared_scan.GetPosition());
+
+  executor::SeqScanExecutor executor(&node, context.get());
+  RunTest(executor, table->GetTileGroupCount(), column_ids.size());
+
+  // The scan started at the tile group of the leader
+  EXPECT_EQ(0U, shared_scan.GetPosition());
+  EXPECT_EQ(1U, shared_scan.GetScanCount());
+
+  leader.reset();
+  EXPECT_EQ(0U, shared_scan.GetScanCount());
+
+  txn_manager.CommitTransaction(txn);
+}
+
 // Sequential scan of logical tile with predicate.
 TEST_F(SeqScanTests, NonLeafNodePredicateTest) {
   // No table for this case as seq scan is not a leaf node.
@@ -0,0 +1,218 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compiled_expression_test.cpp
+//
+// Identification: test/expression/compiled_expression_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "common/container_tuple.h"
+#include "common/exception.h"
+#include "common/value_factory.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/executor_context.h"
+#include "executor/executor_tests_util.h"
+#include "expression/compiled_expression.h"
+#include "expression/expression_util.h"
+#include "expression/operator_expression.h"
+#include "expression/parameter_value_expression.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Compiled Expression Tests
+//===--------------------------------------------------------------------===//
+
+class CompiledExpressionTests : public PelotonTest {};
+
+static const int compiled_tuple_count = 100;
+
+static expression::AbstractExpression *GetColumn(const int column_id) {
+  auto type_id = ExecutorTestsUtil::GetColumnInfo(column_id).GetType();
+  return expression::ExpressionUtil::TupleValueFactory(type_id, 0, column_id);
+}
+
+static expression::AbstractExpression *GetConstant(const common::Value &value) {
+  return expression::ExpressionUtil::ConstantValueFactory(value);
+}
+
+static expression::AbstractExpression *GetNot(
+    expression::AbstractExpression *child) {
+  auto expression = new expression::OperatorExpression(
+      EXPRESSION_TYPE_OPERATOR_NOT, common::Type::BOOLEAN);
+  expression->SetChild(0, child);
+  return expression;
+}
+
+// the tuples of the tile group that satisfy the predicate, once compiled and
+// once interpreted
+static void CheckFilter(storage::DataTable *table,
+                        expression::AbstractExpression *predicate,
+                        executor::ExecutorContext *context,
+                        const size_t &expected_count) {
+  std::unique_ptr<expression::AbstractExpression> predicate_ptr(predicate);
+  std::vector<common::Type::TypeId> param_types;
+  for (auto &param : context->GetParams()) {
+    param_types.push_back(param.GetTypeId());
+  }
+  auto compiled_predicate = expression::CompiledExpression::Compile(
+      predicate, table->GetSchema(), param_types);
+  EXPECT_NE(nullptr, compiled_predicate.get());
+
+  auto tile_group = table->GetTileGroup(0);
+  std::vector<oid_t> expected_tuple_ids;
+  std::vector<oid_t> tuple_ids;
+  for (oid_t tuple_id = 0; tuple_id < compiled_tuple_count; tuple_id++) {
+    expression::ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
+                                                         tuple_id);
+    if (predicate->Evaluate(&tuple, nullptr, context).IsTrue()) {
+      expected_tuple_ids.push_back(tuple_id);
+    }
+    tuple_ids.push_back(tuple_id);
+  }
+
+  expression::CompiledExpressionEvaluator evaluator(compiled_predicate.get(),
+                                                    context);
+  EXPECT_TRUE(evaluator.SetTileGroup(tile_group.get()));
+  evaluator.Filter(tuple_ids);
+  EXPECT_EQ(expected_count, expected_tuple_ids.size());
+  EXPECT_EQ(expected_tuple_ids, tuple_ids);
+}
+
+TEST_F(CompiledExpressionTests, FilterTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(compiled_tuple_count, false));
+  ExecutorTestsUtil::PopulateTable(table.get(), compiled_tuple_count, false,
+                                   false, false, txn);
+  std::vector<common::Value> params(
+      {common::ValueFactory::GetIntegerValue(101)});
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn, params));
+
+  // COL_A > 500, a column compared with a constant
+  CheckFilter(table.get(),
+              expression::ExpressionUtil::ComparisonFactory(
+                  EXPRESSION_TYPE_COMPARE_GREATERTHAN, GetColumn(0),
+                  GetConstant(common::ValueFactory::GetIntegerValue(500))),
+              context.get(), 49);
+
+  // 250.5 >= COL_C, the constant first
+  CheckFilter(table.get(),
+              expression::ExpressionUtil::ComparisonFactory(
+                  EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO,
+                  GetConstant(common::ValueFactory::GetDoubleValue(250.5)),
+                  GetColumn(2)),
+              context.get(), 25);
+
+  // COL_A + COL_B < 401 AND NOT COL_B = $0
+  CheckFilter(
+      table.get(),
+      expression::ExpressionUtil::ConjunctionFactory(
+          EXPRESSION_TYPE_CONJUNCTION_AND,
+          expression::ExpressionUtil::ComparisonFactory(
+              EXPRESSION_TYPE_COMPARE_LESSTHAN,
+              expression::ExpressionUtil::OperatorFactory(
+                  EXPRESSION_TYPE_OPERATOR_PLUS, common::Type::INTEGER,
+                  GetColumn(0), GetColumn(1)),
+              GetConstant(common::ValueFactory::GetIntegerValue(401))),
+          GetNot(expression::ExpressionUtil::ComparisonFactory(
+              EXPRESSION_TYPE_COMPARE_EQUAL, GetColumn(1),
+              new expression::ParameterValueExpression(0)))),
+      context.get(), 19);
+
+  // COL_A = NULL OR COL_C * 2 <= 100, nulls are never true
+  CheckFilter(
+      table.get(),
+      expression::ExpressionUtil::ConjunctionFactory(
+          EXPRESSION_TYPE_CONJUNCTION_OR,
+          expression::ExpressionUtil::ComparisonFactory(
+              EXPRESSION_TYPE_COMPARE_EQUAL, GetColumn(0),
+              GetConstant(common::ValueFactory::GetNullValueByType(
+                  common::Type::INTEGER))),
+          expression::ExpressionUtil::ComparisonFactory(
+              EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO,
+              expression::ExpressionUtil::OperatorFactory(
+                  EXPRESSION_TYPE_OPERATOR_MULTIPLY, common::Type::DECIMAL,
+                  GetColumn(2),
+                  GetConstant(common::ValueFactory::GetIntegerValue(2))),
+              GetConstant(common::ValueFactory::GetIntegerValue(100)))),
+      context.get(), 5);
+
+  txn_manager.CommitTransaction(txn);
+}
+
+TEST_F(CompiledExpressionTests, EvaluateTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(compiled_tuple_count, false));
+  ExecutorTestsUtil::PopulateTable(table.get(), compiled_tuple_count, false,
+                                   false, false, txn);
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+  auto tile_group = table->GetTileGroup(0);
+  std::vector<oid_t> tuple_ids({0, 3, 7});
+  std::vector<common::Value> values;
+
+  // COL_B - COL_A * 3
+  std::unique_ptr<expression::AbstractExpression> expression(
+      expression::ExpressionUtil::OperatorFactory(
+          EXPRESSION_TYPE_OPERATOR_MINUS, common::Type::INTEGER, GetColumn(1),
+          expression::ExpressionUtil::OperatorFactory(
+              EXPRESSION_TYPE_OPERATOR_MULTIPLY, common::Type::INTEGER,
+              GetColumn(0),
+              GetConstant(common::ValueFactory::GetIntegerValue(3)))));
+  auto compiled_expression = expression::CompiledExpression::Compile(
+      expression.get(), table->GetSchema(), {});
+  EXPECT_NE(nullptr, compiled_expression.get());
+  EXPECT_EQ(common::Type::INTEGER, compiled_expression->GetValueType());
+
+  expression::CompiledExpressionEvaluator evaluator(compiled_expression.get(),
+                                                    context.get());
+  EXPECT_TRUE(evaluator.SetTileGroup(tile_group.get()));
+  evaluator.Evaluate(tuple_ids, values);
+  EXPECT_EQ(3U, values.size());
+  for (size_t value_itr = 0; value_itr < values.size(); value_itr++) {
+    int expected = ExecutorTestsUtil::PopulatedValue(tuple_ids[value_itr], 1) -
+                   ExecutorTestsUtil::PopulatedValue(tuple_ids[value_itr], 0) * 3;
+    EXPECT_EQ(expected, values[value_itr].GetAs<int32_t>());
+  }
+
+  // COL_A / 0 throws for every tuple, even the first one
+  expression.reset(expression::ExpressionUtil::OperatorFactory(
+      EXPRESSION_TYPE_OPERATOR_DIVIDE, common::Type::INTEGER, GetColumn(0),
+      GetConstant(common::ValueFactory::GetIntegerValue(0))));
+  compiled_expression = expression::CompiledExpression::Compile(
+      expression.get(), table->GetSchema(), {});
+  EXPECT_NE(nullptr, compiled_expression.get());
+  expression::CompiledExpressionEvaluator divide_evaluator(
+      compiled_expression.get(), context.get());
+  EXPECT_TRUE(divide_evaluator.SetTileGroup(tile_group.get()));
+  EXPECT_THROW(divide_evaluator.Evaluate(tuple_ids, values), Exception);
+
+  // Varlen columns are interpreted
+  expression.reset(expression::ExpressionUtil::ComparisonFactory(
+      EXPRESSION_TYPE_COMPARE_EQUAL, GetColumn(3),
+      GetConstant(common::ValueFactory::GetVarcharValue("3"))));
+  EXPECT_EQ(nullptr, expression::CompiledExpression::Compile(
+                         expression.get(), table->GetSchema(), {}).get());
+
+  txn_manager.CommitTransaction(txn);
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -0,0 +1,40 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// gc_manager_tests_util.h
+//
+// Identification: test/include/gc/gc_manager_tests_util.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "gc/transaction_level_gc_manager.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// GC Manager Tests Util
+//===--------------------------------------------------------------------===//
+
+// collects the garbage of a gc thread on the calling thread, so that the
+// tests do not depend on the timing of the gc threads
+class GCManagerTestsUtil {
+ public:
+  static void ClearGarbage(gc::TransactionLevelGCManager &gc_manager,
+                           const int &thread_id) {
+    gc_manager.ClearGarbage(thread_id);
+  }
+
+  static void Unlink(gc::TransactionLevelGCManager &gc_manager,
+                     const int &thread_id, const cid_t &max_cid) {
+    gc_manager.Unlink(thread_id, max_cid);
+  }
+};
+
+}  // End test namespace
+}  // End peloton namespace
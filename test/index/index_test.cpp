@@ -10,7 +10,10 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <set>
+
 #include "gtest/gtest.h"
+
 #include "common/harness.h"
 
 #include "common/logger.h"
@@ -157,6 +160,73 @@ TEST_F(IndexTests, BasicTest) {
   delete tuple_schema;
 }
 
+TEST_F(IndexTests, ScanKeysTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  std::vector<ItemPointer *> location_ptrs;
+
+  // INDEX
+  std::unique_ptr<index::Index> index(BuildIndex(false));
+
+  // Enough keys to fill several leaf nodes; the even keys have two entries
+  const int key_count = 2000;
+  std::vector<std::unique_ptr<storage::Tuple>> keys;
+  for (int key_itr = 0; key_itr < key_count; key_itr++) {
+    std::unique_ptr<storage::Tuple> key(new storage::Tuple(key_schema, true));
+    key->SetValue(0, common::ValueFactory::GetIntegerValue(key_itr), pool);
+    key->SetValue(1, common::ValueFactory::GetVarcharValue("a"), pool);
+    index->InsertEntry(key.get(), item0.get());
+    if (key_itr % 2 == 0) {
+      index->InsertEntry(key.get(), item1.get());
+    }
+    keys.push_back(std::move(key));
+  }
+
+  std::unique_ptr<storage::Tuple> keynonce(
+      new storage::Tuple(key_schema, true));
+  keynonce->SetValue(0, common::ValueFactory::GetIntegerValue(key_count), pool);
+  keynonce->SetValue(1, common::ValueFactory::GetVarcharValue("a"), pool);
+
+  // Sorted keys with gaps, a repeated key and a missing key
+  std::vector<const storage::Tuple *> probe_keys;
+  for (int key_itr = 0; key_itr < key_count; key_itr += 3) {
+    probe_keys.push_back(keys[key_itr].get());
+  }
+  probe_keys.push_back(keys[key_count - 1].get());
+  probe_keys.push_back(keys[key_count - 1].get());
+  probe_keys.push_back(keynonce.get());
+
+  // Followed by the same keys in reverse order
+  std::vector<const storage::Tuple *> reverse_keys(probe_keys.rbegin(),
+                                                   probe_keys.rend());
+  probe_keys.insert(probe_keys.end(), reverse_keys.begin(),
+                    reverse_keys.end());
+
+  std::vector<size_t> key_offsets;
+  index->ScanKeys(probe_keys, location_ptrs, key_offsets);
+  EXPECT_EQ(probe_keys.size() + 1, key_offsets.size());
+  EXPECT_EQ(0U, key_offsets.front());
+  EXPECT_EQ(location_ptrs.size(), key_offsets.back());
+
+  // Same result as looking up the keys one by one
+  for (size_t key_itr = 0; key_itr < probe_keys.size(); key_itr++) {
+    std::vector<ItemPointer *> key_location_ptrs;
+    index->ScanKey(probe_keys[key_itr], key_location_ptrs);
+    EXPECT_EQ(key_location_ptrs.size(),
+              key_offsets[key_itr + 1] - key_offsets[key_itr]);
+
+    std::multiset<ItemPointer *> batch_locations(
+        location_ptrs.begin() + key_offsets[key_itr],
+        location_ptrs.begin() + key_offsets[key_itr + 1]);
+    std::multiset<ItemPointer *> key_locations(key_location_ptrs.begin(),
+                                               key_location_ptrs.end());
+    EXPECT_TRUE(batch_locations == key_locations);
+  }
+  EXPECT_EQ(0U, key_offsets[probe_keys.size() / 2] -
+                    key_offsets[probe_keys.size() / 2 - 1]);
+
+  delete tuple_schema;
+}
+
 // INSERT HELPER FUNCTION
 void InsertTest(index::Index *index, common::VarlenPool *pool, size_t scale_factor,
                 UNUSED_ATTRIBUTE uint64_t thread_itr) {
@@ -0,0 +1,238 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// fast_path_parser_test.cpp
+//
+// Identification: test/parser/fast_path_parser_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "expression/constant_value_expression.h"
+#include "expression/parameter_value_expression.h"
+#include "expression/tuple_value_expression.h"
+#include "parser/fast_path_parser.h"
+#include "parser/parser.h"
+#include "parser/statements.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Fast Path Parser Tests
+//===--------------------------------------------------------------------===//
+
+class FastPathParserTests : public PelotonTest {};
+
+void ExpectSameString(const char *expected, const char *actual) {
+  if (expected == nullptr || actual == nullptr) {
+    EXPECT_EQ(expected, actual);
+  } else {
+    EXPECT_STREQ(expected, actual);
+  }
+}
+
+void ExpectSameTable(parser::TableInfo *expected, parser::TableInfo *actual) {
+  ASSERT_NE(nullptr, expected);
+  ASSERT_NE(nullptr, actual);
+  ExpectSameString(expected->table_name, actual->table_name);
+  ExpectSameString(expected->database_name, actual->database_name);
+}
+
+void ExpectSameExpression(const expression::AbstractExpression *expected,
+                          const expression::AbstractExpression *actual) {
+  if (expected == nullptr || actual == nullptr) {
+    EXPECT_EQ(expected, actual);
+    return;
+  }
+
+  ASSERT_EQ(expected->GetExpressionType(), actual->GetExpressionType());
+  ASSERT_EQ(expected->GetChildrenSize(), actual->GetChildrenSize());
+  EXPECT_EQ(expected->ival_, actual->ival_);
+
+  switch (expected->GetExpressionType()) {
+    case EXPRESSION_TYPE_VALUE_CONSTANT: {
+      auto expected_value =
+          static_cast<const expression::ConstantValueExpression *>(expected)
+              ->GetValue();
+      auto actual_value =
+          static_cast<const expression::ConstantValueExpression *>(actual)
+              ->GetValue();
+      EXPECT_EQ(expected_value.GetTypeId(), actual_value.GetTypeId());
+      EXPECT_TRUE(expected_value.CompareEquals(actual_value).IsTrue());
+      break;
+    }
+    case EXPRESSION_TYPE_VALUE_PARAMETER:
+      EXPECT_EQ(
+          static_cast<const expression::ParameterValueExpression *>(expected)
+              ->GetValueIdx(),
+          static_cast<const expression::ParameterValueExpression *>(actual)
+              ->GetValueIdx());
+      break;
+    case EXPRESSION_TYPE_VALUE_TUPLE:
+      EXPECT_EQ(
+          static_cast<const expression::TupleValueExpression *>(expected)
+              ->GetColumnName(),
+          static_cast<const expression::TupleValueExpression *>(actual)
+              ->GetColumnName());
+      break;
+    default:
+      break;
+  }
+
+  for (size_t child_itr = 0; child_itr < expected->GetChildrenSize();
+       child_itr++) {
+    ExpectSameExpression(expected->GetChild(child_itr),
+                         actual->GetChild(child_itr));
+  }
+}
+
+// Parse the query with both parsers
+void ParseBoth(const std::string &query,
+               std::unique_ptr<parser::SQLStatementList> &expected,
+               std::unique_ptr<parser::SQLStatementList> &actual) {
+  expected.reset(parser::Parser::ParseSQLString(query));
+  actual = parser::FastPathParser::Parse(query);
+
+  ASSERT_TRUE(expected->is_valid);
+  ASSERT_NE(nullptr, actual);
+  ASSERT_TRUE(actual->is_valid);
+  ASSERT_EQ(1U, expected->GetStatements().size());
+  ASSERT_EQ(1U, actual->GetStatements().size());
+  ASSERT_EQ(expected->GetStatement(0)->GetType(),
+            actual->GetStatement(0)->GetType());
+}
+
+TEST_F(FastPathParserTests, SelectTest) {
+  std::vector<std::string> queries = {
+      "SELECT * FROM foo;",
+      "select A, b FROM db.foo WHERE a = 1 AND b = 'x' AND c = 2.5",
+      "SELECT b FROM foo WHERE a = $1 FOR UPDATE;"};
+
+  for (auto &query : queries) {
+    std::unique_ptr<parser::SQLStatementList> expected, actual;
+    ParseBoth(query, expected, actual);
+    if (HasFatalFailure()) return;
+
+    auto expected_select =
+        static_cast<parser::SelectStatement *>(expected->GetStatement(0));
+    auto actual_select =
+        static_cast<parser::SelectStatement *>(actual->GetStatement(0));
+
+    ASSERT_EQ(expected_select->select_list->size(),
+              actual_select->select_list->size());
+    for (size_t column_itr = 0; column_itr < expected_select->select_list->size();
+         column_itr++) {
+      ExpectSameExpression(expected_select->select_list->at(column_itr),
+                           actual_select->select_list->at(column_itr));
+    }
+    EXPECT_EQ(expected_select->from_table->type, actual_select->from_table->type);
+    ExpectSameTable(expected_select->from_table->table_info_,
+                    actual_select->from_table->table_info_);
+    ExpectSameExpression(expected_select->where_clause,
+                         actual_select->where_clause);
+    EXPECT_EQ(expected_select->is_for_update, actual_select->is_for_update);
+  }
+}
+
+TEST_F(FastPathParserTests, UpdateTest) {
+  std::unique_ptr<parser::SQLStatementList> expected, actual;
+  ParseBoth("UPDATE foo SET b = 'y', c = $2 WHERE a = $1;", expected, actual);
+  if (HasFatalFailure()) return;
+
+  auto expected_update =
+      static_cast<parser::UpdateStatement *>(expected->GetStatement(0));
+  auto actual_update =
+      static_cast<parser::UpdateStatement *>(actual->GetStatement(0));
+
+  ExpectSameTable(expected_update->table->table_info_,
+                  actual_update->table->table_info_);
+  ASSERT_EQ(expected_update->updates->size(), actual_update->updates->size());
+  for (size_t update_itr = 0; update_itr < expected_update->updates->size();
+       update_itr++) {
+    ExpectSameString(expected_update->updates->at(update_itr)->column,
+                     actual_update->updates->at(update_itr)->column);
+    ExpectSameExpression(expected_update->updates->at(update_itr)->value,
+                         actual_update->updates->at(update_itr)->value);
+  }
+  ExpectSameExpression(expected_update->where, actual_update->where);
+}
+
+TEST_F(FastPathParserTests, InsertTest) {
+  std::vector<std::string> queries = {
+      "INSERT INTO foo VALUES (1, 'x', 2.5);",
+      "insert into db.foo (a, b) values ($1, $2)"};
+
+  for (auto &query : queries) {
+    std::unique_ptr<parser::SQLStatementList> expected, actual;
+    ParseBoth(query, expected, actual);
+    if (HasFatalFailure()) return;
+
+    auto expected_insert =
+        static_cast<parser::InsertStatement *>(expected->GetStatement(0));
+    auto actual_insert =
+        static_cast<parser::InsertStatement *>(actual->GetStatement(0));
+
+    EXPECT_EQ(expected_insert->type, actual_insert->type);
+    ExpectSameTable(expected_insert->table_info_, actual_insert->table_info_);
+    if (expected_insert->columns == nullptr) {
+      EXPECT_EQ(nullptr, actual_insert->columns);
+    } else {
+      ASSERT_NE(nullptr, actual_insert->columns);
+      ASSERT_EQ(expected_insert->columns->size(),
+                actual_insert->columns->size());
+      for (size_t column_itr = 0; column_itr < expected_insert->columns->size();
+           column_itr++) {
+        ExpectSameString(expected_insert->columns->at(column_itr),
+                         actual_insert->columns->at(column_itr));
+      }
+    }
+
+    ASSERT_EQ(1U, expected_insert->insert_values->size());
+    ASSERT_EQ(1U, actual_insert->insert_values->size());
+    auto expected_row = expected_insert->insert_values->at(0);
+    auto actual_row = actual_insert->insert_values->at(0);
+    ASSERT_EQ(expected_row->size(), actual_row->size());
+    for (size_t value_itr = 0; value_itr < expected_row->size(); value_itr++) {
+      ExpectSameExpression(expected_row->at(value_itr),
+                           actual_row->at(value_itr));
+    }
+  }
+}
+
+TEST_F(FastPathParserTests, FallbackTest) {
+  // Left to the full parser
+  std::vector<std::string> queries = {
+      "SELECT * FROM foo JOIN bar ON foo.a = bar.a;",
+      "SELECT a FROM foo WHERE a = 1 LIMIT 10;",
+      "SELECT a FROM foo WHERE a > 1;",
+      "SELECT a FROM foo WHERE a = ?;",
+      "SELECT a FROM foo WHERE a = -1;",
+      "SELECT a AS b FROM foo;",
+      "SELECT count FROM foo;",
+      "SELECT a FROM \"foo\";",
+      "SELECT * FROM foo; SELECT * FROM bar;",
+      "UPDATE foo SET a = a + 1;",
+      "INSERT INTO foo VALUES (1), (2);",
+      "INSERT INTO foo SELECT * FROM bar;",
+      "DELETE FROM foo WHERE a = 1;",
+      "SELECT a FROM foo WHERE a = 'x -- comment;",
+      "SELECT a FROM foo WHERE a = 99999999999;",
+      "SELECT a FROM foo AS OF 10;"};
+
+  for (auto &query : queries) {
+    EXPECT_EQ(nullptr, parser::FastPathParser::Parse(query)) << query;
+  }
+}
+
+}  // End test namespace
+}  // End peloton namespace
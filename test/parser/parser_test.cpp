@@ -16,6 +16,7 @@
 #include "common/harness.h"
 #include "common/macros.h"
 #include "common/logger.h"
+#include "expression/constant_value_expression.h"
 #include "parser/parser.h"
 
 namespace peloton {
@@ -377,6 +378,35 @@ TEST_F(ParserTest, IndexTest) {
   }
 }
 
+TEST_F(ParserTest, AsOfTest) {
+  parser::SQLStatementList* list = parser::Parser::ParseSQLString(
+      "SELECT a AS office FROM foo AS OF 1234;");
+  ASSERT_TRUE(list->is_valid);
+  auto stmt = static_cast<parser::SelectStatement*>(list->GetStatement(0));
+  EXPECT_EQ("office", stmt->select_list->at(0)->alias);
+  ASSERT_NE(nullptr, stmt->as_of);
+  EXPECT_EQ(1234, stmt->as_of->ival_);
+  delete list;
+
+  list = parser::Parser::ParseSQLString(
+      "SELECT * FROM foo WHERE a = 1 AS OF '2016-11-01 12:00:00+00';");
+  ASSERT_TRUE(list->is_valid);
+  stmt = static_cast<parser::SelectStatement*>(list->GetStatement(0));
+  ASSERT_NE(nullptr, stmt->as_of);
+  EXPECT_EQ("2016-11-01 12:00:00+00",
+            static_cast<expression::ConstantValueExpression*>(stmt->as_of)
+                ->GetValue()
+                .ToString());
+  delete list;
+
+  // The current snapshot
+  list = parser::Parser::ParseSQLString("SELECT * FROM foo AS bar;");
+  ASSERT_TRUE(list->is_valid);
+  stmt = static_cast<parser::SelectStatement*>(list->GetStatement(0));
+  EXPECT_EQ(nullptr, stmt->as_of);
+  delete list;
+}
+
 TEST_F(ParserTest, CopyTest) {
 
   std::vector<std::string> queries;
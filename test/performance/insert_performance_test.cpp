@@ -12,6 +12,7 @@
 
 
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -35,6 +36,7 @@
 #include "storage/tile.h"
 #include "storage/tile_group.h"
 #include "storage/table_factory.h"
+#include "storage/tile_group_preallocator.h"
 
 #include "executor/executor_tests_util.h"
 #include "executor/mock_executor.h"
@@ -148,5 +150,81 @@ TEST_F(InsertTests, LoadingTest) {
                bytes_to_megabytes_converter);
 }
 
+TEST_F(InsertTests, ScalabilityTest) {
+  // Every loader inserts into its own tile group, and the next tile groups are
+  // preallocated in the background
+  oid_t tuples_per_tilegroup = TEST_TUPLES_PER_TILEGROUP;
+  bool build_indexes = false;
+  oid_t tilegroup_count_per_loader = 10;
+
+  auto testing_pool = TestingHarness::GetInstance().GetTestingPool();
+  auto original_active_tilegroup_count =
+      storage::DataTable::active_tilegroup_count_;
+
+  auto &preallocator = storage::TileGroupPreallocator::GetInstance();
+  preallocator.StartPreallocation();
+
+  std::vector<oid_t> loader_threads_counts = {1, 2, 4, 8, 16, 32, 64};
+
+  for (auto loader_threads_count : loader_threads_counts) {
+    storage::DataTable::SetActiveTileGroupCount(loader_threads_count);
+
+    std::unique_ptr<storage::DataTable> data_table(
+        ExecutorTestsUtil::CreateTable(tuples_per_tilegroup, build_indexes));
+
+    Timer<> timer;
+
+    timer.Start();
+
+    LaunchParallelTest(loader_threads_count, InsertTuple, data_table.get(),
+                       testing_pool, tilegroup_count_per_loader);
+
+    timer.Stop();
+    auto duration = timer.GetDuration();
+
+    size_t total_tuple_count = loader_threads_count *
+                               tilegroup_count_per_loader *
+                               TEST_TUPLES_PER_TILEGROUP;
+
+    LOG_INFO("Threads: %u Duration: %.2lf Throughput: %.2lf tuples/s",
+             loader_threads_count, duration, total_tuple_count / duration);
+
+    EXPECT_EQ(data_table->GetTupleCount(), total_tuple_count);
+
+    // every loader filled up its own tile groups
+    EXPECT_GE(data_table->GetTileGroupCount(),
+              loader_threads_count * tilegroup_count_per_loader);
+
+    // each loader inserts its own value, a tile group only holds the tuples
+    // of one loader
+    size_t loaded_tuple_count = 0;
+    std::set<int32_t> loader_values;
+    auto tile_group_count = data_table->GetTileGroupCount();
+    for (oid_t tile_group_itr = 0; tile_group_itr < tile_group_count;
+         tile_group_itr++) {
+      auto tile_group = data_table->GetTileGroup(tile_group_itr);
+      auto tuple_count = tile_group->GetNextTupleSlot();
+      if (tuple_count == 0) {
+        continue;
+      }
+
+      auto loader_value = tile_group->GetValue(0, 0).GetAs<int32_t>();
+      for (oid_t tuple_itr = 1; tuple_itr < tuple_count; tuple_itr++) {
+        EXPECT_EQ(loader_value,
+                  tile_group->GetValue(tuple_itr, 0).GetAs<int32_t>());
+      }
+      loader_values.insert(loader_value);
+      loaded_tuple_count += tuple_count;
+    }
+
+    EXPECT_EQ(total_tuple_count, loaded_tuple_count);
+    EXPECT_EQ(loader_threads_count, loader_values.size());
+  }
+
+  preallocator.StopPreallocation();
+
+  storage::DataTable::SetActiveTileGroupCount(original_active_tilegroup_count);
+}
+
 }  // namespace test
 }  // namespace peloton
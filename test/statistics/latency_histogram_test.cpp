@@ -0,0 +1,120 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// latency_histogram_test.cpp
+//
+// Identification: test/statistics/latency_histogram_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+
+#include "statistics/latency_histogram.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Latency Histogram Tests
+//===--------------------------------------------------------------------===//
+
+class LatencyHistogramTests : public PelotonTest {};
+
+TEST_F(LatencyHistogramTests, BucketTest) {
+  // Every value falls within the bounds of its bucket, and the buckets are
+  // at most ~3% wide
+  for (uint64_t latency = 1; latency < (1UL << 30); latency = latency * 3 + 1) {
+    auto bucket = stats::LatencyHistogram::GetBucket(latency);
+    auto upper_bound = stats::LatencyHistogram::GetBucketUpperBound(bucket);
+    EXPECT_LE(latency, upper_bound);
+    EXPECT_LE(upper_bound - latency, latency / 32);
+    if (bucket > 0) {
+      EXPECT_GT(latency,
+                stats::LatencyHistogram::GetBucketUpperBound(bucket - 1));
+    }
+  }
+
+  // Huge latencies share the last bucket
+  EXPECT_EQ(stats::LatencyHistogram::BUCKET_COUNT - 1,
+            stats::LatencyHistogram::GetBucket(UINT64_MAX));
+}
+
+TEST_F(LatencyHistogramTests, PercentileTest) {
+  stats::LatencyHistogram histogram;
+  EXPECT_EQ(0UL, histogram.GetPercentile(0.5));
+
+  for (uint64_t latency = 1; latency <= 1000; latency++) {
+    histogram.Record(latency);
+  }
+  EXPECT_EQ(1000UL, histogram.GetCount());
+  EXPECT_EQ(1UL, histogram.GetMin());
+  EXPECT_EQ(1000UL, histogram.GetMax());
+  EXPECT_DOUBLE_EQ(500.5, histogram.GetAverage());
+
+  // Percentiles are accurate up to the width of a bucket
+  EXPECT_NEAR(500, histogram.GetPercentile(0.5), 500 / 32);
+  EXPECT_NEAR(990, histogram.GetPercentile(0.99), 990 / 32);
+  EXPECT_EQ(1000UL, histogram.GetPercentile(0.999));
+  EXPECT_EQ(1000UL, histogram.GetPercentile(1));
+}
+
+TEST_F(LatencyHistogramTests, MergeTest) {
+  stats::LatencyHistogram fast;
+  stats::LatencyHistogram slow;
+  for (int itr = 0; itr < 99; itr++) {
+    fast.Record(10);
+  }
+  slow.Record(100000);
+
+  stats::LatencyHistogram merged;
+  merged.Merge(fast);
+  merged.Merge(slow);
+  EXPECT_EQ(100UL, merged.GetCount());
+  EXPECT_EQ(10UL, merged.GetMin());
+  EXPECT_EQ(100000UL, merged.GetMax());
+  EXPECT_EQ(10UL, merged.GetPercentile(0.5));
+  EXPECT_EQ(10UL, merged.GetPercentile(0.99));
+  EXPECT_EQ(100000UL, merged.GetPercentile(0.999));
+
+  merged.Reset();
+  EXPECT_EQ(0UL, merged.GetCount());
+  EXPECT_EQ(0UL, merged.GetMax());
+}
+
+TEST_F(LatencyHistogramTests, MergeSinceTest) {
+  stats::LatencyHistogram source;
+  stats::LatencyHistogram collected;
+  for (int itr = 0; itr < 99; itr++) {
+    source.Record(10);
+  }
+  source.Record(100000);
+
+  stats::LatencyHistogram interval;
+  interval.MergeSince(source, collected);
+  EXPECT_EQ(100UL, interval.GetCount());
+  EXPECT_EQ(10UL, interval.GetMin());
+  EXPECT_EQ(100000UL, interval.GetMax());
+
+  // Nothing was recorded since
+  interval.Reset();
+  interval.MergeSince(source, collected);
+  EXPECT_EQ(0UL, interval.GetCount());
+
+  // Only the latencies of the next interval are merged
+  for (int itr = 0; itr < 50; itr++) {
+    source.Record(20);
+  }
+  interval.MergeSince(source, collected);
+  EXPECT_EQ(50UL, interval.GetCount());
+  EXPECT_EQ(20UL, interval.GetMin());
+  EXPECT_EQ(20UL, interval.GetMax());
+  EXPECT_DOUBLE_EQ(20, interval.GetAverage());
+  EXPECT_EQ(20UL, interval.GetPercentile(0.99));
+  EXPECT_EQ(150UL, source.GetCount());
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -0,0 +1,111 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// metric_series_test.cpp
+//
+// Identification: test/statistics/metric_series_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+
+#include "catalog/catalog.h"
+#include "common/value_factory.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/executor_context.h"
+#include "executor/logical_tile.h"
+#include "executor/seq_scan_executor.h"
+#include "expression/expression_util.h"
+#include "planner/seq_scan_plan.h"
+#include "statistics/metric_series.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Metric Series Tests
+//===--------------------------------------------------------------------===//
+
+class MetricSeriesTests : public PelotonTest {};
+
+static stats::MetricRow GetDatabaseMetricRow(int32_t database_id,
+                                             int32_t time_stamp) {
+  return stats::MetricRow({common::ValueFactory::GetIntegerValue(database_id),
+                           common::ValueFactory::GetIntegerValue(10),
+                           common::ValueFactory::GetIntegerValue(1),
+                           common::ValueFactory::GetIntegerValue(time_stamp)});
+}
+
+TEST_F(MetricSeriesTests, RingBufferTest) {
+  stats::MetricSeries series(3);
+  EXPECT_EQ(0U, series.GetSize());
+  EXPECT_TRUE(series.GetRows().empty());
+
+  // The oldest rows are dropped once the series is full
+  for (int32_t time_stamp = 1; time_stamp <= 5; time_stamp++) {
+    series.Append(GetDatabaseMetricRow(0, time_stamp));
+  }
+  EXPECT_EQ(3U, series.GetSize());
+  EXPECT_EQ(5UL, series.GetAppendCount());
+
+  auto rows = series.GetRows();
+  EXPECT_EQ(3U, rows.size());
+  for (int32_t row_itr = 0; row_itr < 3; row_itr++) {
+    EXPECT_EQ(row_itr + 3, rows[row_itr][3].GetAs<int32_t>());
+  }
+
+  series.Clear();
+  EXPECT_EQ(0U, series.GetSize());
+}
+
+TEST_F(MetricSeriesTests, VirtualTableScanTest) {
+  auto metric_table = catalog::Catalog::GetInstance()->GetTableWithName(
+      CATALOG_DATABASE_NAME, DATABASE_METRIC_NAME);
+  auto metric_series = stats::MetricSeries::GetInstance(metric_table);
+  EXPECT_NE(nullptr, metric_series);
+  EXPECT_EQ(metric_series,
+            stats::MetricSeries::GetInstance(DATABASE_METRIC_NAME));
+  metric_series->Clear();
+
+  metric_series->Append(GetDatabaseMetricRow(1, 100));
+  metric_series->Append(GetDatabaseMetricRow(2, 100));
+  metric_series->Append(GetDatabaseMetricRow(1, 200));
+
+  // SELECT database_id, time_stamp FROM database_metric WHERE database_id = 1
+  auto predicate = expression::ExpressionUtil::ComparisonFactory(
+      EXPRESSION_TYPE_COMPARE_EQUAL,
+      expression::ExpressionUtil::TupleValueFactory(common::Type::INTEGER, 0,
+                                                    0),
+      expression::ExpressionUtil::ConstantValueFactory(
+          common::ValueFactory::GetIntegerValue(1)));
+  std::vector<oid_t> column_ids({0, 3});
+  planner::SeqScanPlan node(metric_table, predicate, column_ids);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+  executor::SeqScanExecutor executor(&node, context.get());
+
+  EXPECT_TRUE(executor.Init());
+  EXPECT_TRUE(executor.Execute());
+  std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+  EXPECT_FALSE(executor.Execute());
+  txn_manager.CommitTransaction(txn);
+
+  EXPECT_EQ(2U, result_tile->GetColumnCount());
+  EXPECT_EQ(2U, result_tile->GetTupleCount());
+  EXPECT_EQ(1, result_tile->GetValue(0, 0).GetAs<int32_t>());
+  EXPECT_EQ(100, result_tile->GetValue(0, 1).GetAs<int32_t>());
+  EXPECT_EQ(200, result_tile->GetValue(1, 1).GetAs<int32_t>());
+
+  // Nothing is stored in the table itself
+  EXPECT_EQ(0U, metric_table->GetTupleCount());
+  metric_series->Clear();
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -361,11 +361,11 @@ TEST_F(StatsTest, PerQueryStatsTest) {
   catalog->CreateDatabase("emp_db", nullptr);
   StatsTestsUtil::CreateTable();
 
-  // Default database should include 4 metrics tables and the test table
+  // Default database should include 6 metrics tables and the test table
   EXPECT_EQ(catalog::Catalog::GetInstance()
                 ->GetDatabaseWithName(CATALOG_DATABASE_NAME)
                 ->GetTableCount(),
-            6);
+            8);
   LOG_INFO("Table created!");
 
   auto backend_context = stats::BackendStatsContext::GetInstance();
@@ -0,0 +1,190 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compression_test.cpp
+//
+// Identification: test/storage/compression_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+
+#include "catalog/manager.h"
+#include "common/exception.h"
+#include "common/value_factory.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/executor_tests_util.h"
+#include "storage/compressed_column.h"
+#include "storage/data_table.h"
+#include "storage/tile.h"
+#include "storage/tile_group.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Compression Tests
+//===--------------------------------------------------------------------===//
+
+class CompressionTests : public PelotonTest {};
+
+// the compressed column must return the same values, and evaluate predicates
+// the same way as the uncompressed values
+void CheckCompressedColumn(const std::vector<common::Value> &values,
+                           const storage::CompressedColumn *column,
+                           const std::vector<common::Value> &constants) {
+  EXPECT_EQ(values.size(), column->GetTupleCount());
+  for (oid_t tuple_itr = 0; tuple_itr < values.size(); tuple_itr++) {
+    auto value = column->GetValue(tuple_itr);
+    if (values[tuple_itr].IsNull()) {
+      EXPECT_TRUE(value.IsNull());
+    } else {
+      EXPECT_TRUE(value.CompareEquals(values[tuple_itr]).IsTrue());
+    }
+  }
+
+  std::vector<ExpressionType> comparison_types = {
+      EXPRESSION_TYPE_COMPARE_EQUAL,
+      EXPRESSION_TYPE_COMPARE_NOTEQUAL,
+      EXPRESSION_TYPE_COMPARE_LESSTHAN,
+      EXPRESSION_TYPE_COMPARE_GREATERTHAN,
+      EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO,
+      EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO};
+
+  for (auto comparison_type : comparison_types) {
+    for (auto &constant : constants) {
+      std::vector<bool> matches(values.size(), true);
+      column->Evaluate(comparison_type, constant, matches);
+      for (oid_t tuple_itr = 0; tuple_itr < values.size(); tuple_itr++) {
+        EXPECT_EQ(storage::CompressedColumn::Compare(values[tuple_itr],
+                                                     comparison_type, constant),
+                  matches[tuple_itr]);
+      }
+    }
+  }
+}
+
+TEST_F(CompressionTests, EncodingTest) {
+  const oid_t tuple_count = 1000;
+
+  // Low-cardinality strings
+  std::vector<common::Value> strings;
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    if (tuple_itr % 100 == 0) {
+      strings.push_back(
+          common::ValueFactory::GetNullValueByType(common::Type::VARCHAR));
+    } else {
+      strings.push_back(common::ValueFactory::GetVarcharValue(
+          "category_" + std::to_string(tuple_itr % 7)));
+    }
+  }
+  std::unique_ptr<storage::CompressedColumn> string_column(
+      storage::CompressedColumn::Compress(strings, common::Type::VARCHAR));
+  EXPECT_EQ(COMPRESSION_TYPE_DICTIONARY, string_column->GetCompressionType());
+  CheckCompressedColumn(strings, string_column.get(),
+                        {common::ValueFactory::GetVarcharValue("category_3"),
+                         common::ValueFactory::GetVarcharValue("missing")});
+
+  // Sorted column with long runs
+  std::vector<common::Value> runs;
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    runs.push_back(common::ValueFactory::GetIntegerValue(tuple_itr / 250));
+  }
+  std::unique_ptr<storage::CompressedColumn> run_column(
+      storage::CompressedColumn::Compress(runs, common::Type::INTEGER));
+  EXPECT_EQ(COMPRESSION_TYPE_RUN_LENGTH, run_column->GetCompressionType());
+  CheckCompressedColumn(runs, run_column.get(),
+                        {common::ValueFactory::GetIntegerValue(2),
+                         common::ValueFactory::GetBigIntValue(-1)});
+
+  // Distinct integers in a narrow range
+  std::vector<common::Value> integers;
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    integers.push_back(common::ValueFactory::GetBigIntValue(
+        1000000007 + (tuple_itr * 7919) % tuple_count));
+  }
+  std::unique_ptr<storage::CompressedColumn> integer_column(
+      storage::CompressedColumn::Compress(integers, common::Type::BIGINT));
+  EXPECT_EQ(COMPRESSION_TYPE_FRAME_OF_REFERENCE,
+            integer_column->GetCompressionType());
+  EXPECT_LT(integer_column->GetSize(), tuple_count * sizeof(int64_t) / 4);
+  CheckCompressedColumn(integers, integer_column.get(),
+                        {common::ValueFactory::GetBigIntValue(1000000500),
+                         common::ValueFactory::GetIntegerValue(7),
+                         common::ValueFactory::GetDoubleValue(1000000500.5)});
+}
+
+TEST_F(CompressionTests, CompressTileGroupTest) {
+  const int tuple_count = 1000;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(tuple_count, false));
+  ExecutorTestsUtil::PopulateTable(data_table.get(), tuple_count, false, true,
+                                   true, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // Switch the tile group to a column store
+  storage::column_map_type column_map;
+  column_map[0] = std::make_pair(0, 0);
+  column_map[1] = std::make_pair(1, 0);
+  column_map[2] = std::make_pair(2, 0);
+  column_map[3] = std::make_pair(3, 0);
+  data_table->SetDefaultLayout(column_map);
+  EXPECT_NE(nullptr, data_table->TransformTileGroup(0, 0.0));
+
+  auto tile_group = data_table->GetTileGroup(0);
+  auto tile_group_id = tile_group->GetTileGroupId();
+  EXPECT_FALSE(tile_group->IsCompressed());
+
+  // A concurrent writer prevents the compression
+  auto writer_txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(
+      txn_manager.AcquireOwnership(writer_txn, tile_group->GetHeader(), 0));
+  EXPECT_EQ(nullptr, data_table->CompressTileGroup(0));
+  txn_manager.YieldOwnership(writer_txn, tile_group_id, 0);
+  txn_manager.CommitTransaction(writer_txn);
+
+  // Compress the tile group
+  auto new_tile_group = data_table->CompressTileGroup(0);
+  EXPECT_NE(nullptr, new_tile_group);
+  EXPECT_TRUE(new_tile_group->IsCompressed());
+  EXPECT_EQ(tile_group_id, new_tile_group->GetTileGroupId());
+
+  auto &manager = catalog::Manager::GetInstance();
+  EXPECT_EQ(new_tile_group, manager.GetTileGroup(tile_group_id).get());
+
+  // Compressed tile groups are not compressed again
+  EXPECT_EQ(nullptr, data_table->CompressTileGroup(0));
+
+  // The first column only has two distinct values
+  auto compressed_column = new_tile_group->GetCompressedColumn(0);
+  EXPECT_NE(nullptr, compressed_column);
+  EXPECT_EQ(COMPRESSION_TYPE_RUN_LENGTH,
+            compressed_column->GetCompressionType());
+
+  // The compressed tile group holds the same versions
+  for (int tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    for (oid_t column_itr = 0; column_itr < 4; column_itr++) {
+      common::Value cmp =
+          tile_group->GetValue(tuple_itr, column_itr)
+              .CompareEquals(new_tile_group->GetValue(tuple_itr, column_itr));
+      EXPECT_TRUE(cmp.IsTrue());
+    }
+    EXPECT_EQ(INITIAL_TXN_ID,
+              new_tile_group->GetHeader()->GetTransactionId(tuple_itr));
+  }
+
+  // The tuple slots of the compressed tiles are released
+  auto tile = new_tile_group->GetTile(0);
+  EXPECT_THROW(tile->SetValue(common::ValueFactory::GetIntegerValue(0), 0, 0),
+               NotImplementedException);
+  EXPECT_THROW(tile->CopyTile(BACKEND_TYPE_MM), NotImplementedException);
+}
+
+}  // End test namespace
+}  // End peloton namespace
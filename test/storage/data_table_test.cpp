@@ -12,6 +12,7 @@
 
 #include "common/harness.h"
 
+#include "catalog/manager.h"
 #include "storage/data_table.h"
 #include "storage/tile_group.h"
 #include "concurrency/transaction_manager_factory.h"
@@ -69,6 +70,56 @@ TEST_F(DataTableTests, TransformTileGroupTest) {
   data_table->TransformTileGroup(0, theta);
 }
 
+TEST_F(DataTableTests, OnlineTransformTileGroupTest) {
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(tuple_count, false));
+  ExecutorTestsUtil::PopulateTable(data_table.get(), tuple_count, false, false,
+                                   true, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // Switch the default layout to a column store
+  storage::column_map_type column_map;
+  column_map[0] = std::make_pair(0, 0);
+  column_map[1] = std::make_pair(1, 0);
+  column_map[2] = std::make_pair(2, 0);
+  column_map[3] = std::make_pair(3, 0);
+  data_table->SetDefaultLayout(column_map);
+
+  auto tile_group = data_table->GetTileGroup(0);
+  auto tile_group_id = tile_group->GetTileGroupId();
+
+  // A concurrent writer prevents the transformation
+  auto writer_txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(
+      txn_manager.AcquireOwnership(writer_txn, tile_group->GetHeader(), 0));
+  EXPECT_EQ(nullptr, data_table->TransformTileGroup(0, 0.0));
+  txn_manager.YieldOwnership(writer_txn, tile_group_id, 0);
+  txn_manager.CommitTransaction(writer_txn);
+
+  // Transform the tile group
+  auto new_tile_group = data_table->TransformTileGroup(0, 0.0);
+  EXPECT_NE(nullptr, new_tile_group);
+  EXPECT_EQ(tile_group_id, new_tile_group->GetTileGroupId());
+  EXPECT_EQ(4U, new_tile_group->GetTileCount());
+
+  // The new tile group is installed in the locator
+  auto &manager = catalog::Manager::GetInstance();
+  EXPECT_EQ(new_tile_group, manager.GetTileGroup(tile_group_id).get());
+
+  // The transformed tile group holds the same versions
+  for (int tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    common::Value cmp = tile_group->GetValue(tuple_itr, 1).CompareEquals(
+        new_tile_group->GetValue(tuple_itr, 1));
+    EXPECT_TRUE(cmp.IsTrue());
+    EXPECT_EQ(INITIAL_TXN_ID,
+              new_tile_group->GetHeader()->GetTransactionId(tuple_itr));
+  }
+}
+
 std::unique_ptr<storage::DataTable> data_table_test_table;
 
 TEST_F(DataTableTests, GlobalTableTest) {
@@ -0,0 +1,92 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// zone_map_test.cpp
+//
+// Identification: test/storage/zone_map_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+
+#include "common/value_factory.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/executor_tests_util.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/zone_map.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Zone Map Tests
+//===--------------------------------------------------------------------===//
+
+class ZoneMapTests : public PelotonTest {};
+
+TEST_F(ZoneMapTests, MinMaxTest) {
+  const int tuples_per_tile_group = 100;
+  const int tuple_count = 250;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(tuples_per_tile_group, false));
+  ExecutorTestsUtil::PopulateTable(data_table.get(), tuple_count, false, false,
+                                   false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // The first column holds 10 * rowid
+  auto zone_map = data_table->GetTileGroup(0)->GetZoneMap();
+  EXPECT_TRUE(zone_map->HasValues(0));
+  EXPECT_EQ(0, zone_map->GetMin(0).GetAs<int32_t>());
+  EXPECT_EQ(990, zone_map->GetMax(0).GetAs<int32_t>());
+  EXPECT_EQ(0U, zone_map->GetNullCount(0));
+
+  auto last_zone_map = data_table->GetTileGroup(2)->GetZoneMap();
+  EXPECT_EQ(2000, last_zone_map->GetMin(0).GetAs<int32_t>());
+  EXPECT_EQ(2490, last_zone_map->GetMax(0).GetAs<int32_t>());
+
+  EXPECT_FALSE(zone_map->MightSatisfy(0, EXPRESSION_TYPE_COMPARE_GREATERTHAN,
+                                      common::ValueFactory::GetIntegerValue(
+                                          990)));
+  EXPECT_TRUE(zone_map->MightSatisfy(
+      0, EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO,
+      common::ValueFactory::GetIntegerValue(990)));
+  EXPECT_TRUE(zone_map->MightSatisfy(0, EXPRESSION_TYPE_COMPARE_EQUAL,
+                                     common::ValueFactory::GetIntegerValue(
+                                         500)));
+  EXPECT_FALSE(zone_map->MightSatisfy(0, EXPRESSION_TYPE_COMPARE_EQUAL,
+                                      common::ValueFactory::GetIntegerValue(
+                                          1500)));
+  EXPECT_FALSE(zone_map->MightSatisfy(0, EXPRESSION_TYPE_COMPARE_LESSTHAN,
+                                      common::ValueFactory::GetBigIntValue(0)));
+  EXPECT_TRUE(zone_map->MightSatisfy(0, EXPRESSION_TYPE_COMPARE_NOTEQUAL,
+                                     common::ValueFactory::GetIntegerValue(0)));
+
+  // Comparisons with null are never true
+  EXPECT_FALSE(zone_map->MightSatisfy(
+      0, EXPRESSION_TYPE_COMPARE_NOTEQUAL,
+      common::ValueFactory::GetNullValueByType(common::Type::INTEGER)));
+
+  // A write only marks the zone map stale, the next read rebuilds it
+  auto value = common::ValueFactory::GetIntegerValue(5000);
+  data_table->GetTileGroup(0)->SetValue(value, 0, 0);
+  EXPECT_TRUE(zone_map->IsStale());
+  EXPECT_EQ(10, zone_map->GetMin(0).GetAs<int32_t>());
+  EXPECT_EQ(5000, zone_map->GetMax(0).GetAs<int32_t>());
+  EXPECT_FALSE(zone_map->IsStale());
+
+  // The tile groups that are still being filled are rebuilt as well
+  last_zone_map->MarkStale();
+  data_table->GetTileGroup(2)->RebuildZoneMap();
+  EXPECT_FALSE(last_zone_map->IsStale());
+  EXPECT_EQ(2490, last_zone_map->GetMax(0).GetAs<int32_t>());
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -0,0 +1,83 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// libevent_thread_test.cpp
+//
+// Identification: test/wire/libevent_thread_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "common/harness.h"
+#include "wire/libevent_server.h"
+#include "wire/libevent_thread.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Libevent Thread Tests
+//===--------------------------------------------------------------------===//
+
+class LibeventThreadTests : public PelotonTest {};
+
+TEST_F(LibeventThreadTests, LeastLoadedWorkerTest) {
+  std::vector<std::shared_ptr<wire::LibeventWorkerThread>> threads;
+  for (int thread_id = 0; thread_id < 3; thread_id++) {
+    threads.emplace_back(new wire::LibeventWorkerThread(thread_id));
+  }
+  threads[0]->conn_count = 2;
+  threads[1]->conn_count = 1;
+  threads[2]->conn_count = 1;
+
+  // Ties go to the first worker from the start on
+  EXPECT_EQ(1, wire::LibeventMasterThread::GetLeastLoadedWorker(threads, 0));
+  EXPECT_EQ(1, wire::LibeventMasterThread::GetLeastLoadedWorker(threads, 1));
+  EXPECT_EQ(2, wire::LibeventMasterThread::GetLeastLoadedWorker(threads, 2));
+
+  // The bytes queued on a worker add to its load
+  threads[1]->queued_bytes = 100;
+  EXPECT_EQ(2, wire::LibeventMasterThread::GetLeastLoadedWorker(threads, 0));
+
+  // A connection weighs more than a partly filled buffer
+  threads[0]->conn_count = 1;
+  threads[2]->queued_bytes = SOCKET_BUFFER_SIZE - 1;
+  EXPECT_EQ(0, wire::LibeventMasterThread::GetLeastLoadedWorker(threads, 1));
+}
+
+TEST_F(LibeventThreadTests, ConnCountTest) {
+  wire::LibeventWorkerThread worker(0);
+  int fds[2];
+  ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+
+  // The connection is counted once it is dispatched
+  worker.AcceptConn(fds[0], EV_READ | EV_PERSIST);
+  EXPECT_EQ(1U, worker.conn_count.load());
+
+  wire::NewConnQueueItem item;
+  ASSERT_TRUE(worker.new_conn_queue.Dequeue(item));
+  EXPECT_EQ(fds[0], item.new_conn_fd);
+
+  // The worker was notified through its eventfd
+  uint64_t notify_count = 0;
+  EXPECT_EQ(static_cast<ssize_t>(sizeof(notify_count)),
+            read(worker.notify_fd, &notify_count, sizeof(notify_count)));
+  EXPECT_EQ(1U, notify_count);
+
+  // Closing the connection takes it off the load of the worker
+  wire::LibeventSocket conn(item.new_conn_fd, item.event_flags, &worker,
+                            wire::CONN_READ);
+  EXPECT_EQ(1U, worker.conn_count.load());
+  conn.CloseSocket();
+  EXPECT_EQ(0U, worker.conn_count.load());
+
+  close(fds[1]);
+}
+
+}  // End test namespace
+}  // End peloton namespace
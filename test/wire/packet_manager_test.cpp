@@ -0,0 +1,317 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// packet_manager_test.cpp
+//
+// Identification: test/wire/packet_manager_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "catalog/catalog.h"
+#include "common/harness.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/create_executor.h"
+#include "executor/executor_context.h"
+#include "planner/create_plan.h"
+#include "tcop/tcop.h"
+#include "wire/wire.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Packet Manager Tests
+//===--------------------------------------------------------------------===//
+
+class PacketManagerTests : public PelotonTest {};
+
+// batch_table(id INTEGER PRIMARY KEY, value INTEGER)
+static void CreateTable() {
+  auto catalog = catalog::Catalog::GetInstance();
+  catalog->CreateDatabase(DEFAULT_DB_NAME, nullptr);
+
+  auto id_column = catalog::Column(
+      common::Type::INTEGER, common::Type::GetTypeSize(common::Type::INTEGER),
+      "id", true);
+  id_column.AddConstraint(
+      catalog::Constraint(CONSTRAINT_TYPE_PRIMARY, "con_primary"));
+  auto value_column = catalog::Column(
+      common::Type::INTEGER, common::Type::GetTypeSize(common::Type::INTEGER),
+      "value", true);
+  std::unique_ptr<catalog::Schema> table_schema(
+      new catalog::Schema({id_column, value_column}));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+  planner::CreatePlan node("batch_table", DEFAULT_DB_NAME,
+                           std::move(table_schema),
+                           CreateType::CREATE_TYPE_TABLE);
+  executor::CreateExecutor create_executor(&node, context.get());
+  create_executor.Init();
+  create_executor.Execute();
+  txn_manager.CommitTransaction(txn);
+}
+
+static void DropTable() {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->DropDatabaseWithName(DEFAULT_DB_NAME, txn);
+  txn_manager.CommitTransaction(txn);
+}
+
+// the ids of the rows of the table, read in a transaction of their own
+static std::multiset<int> GetIds() {
+  auto &traffic_cop = tcop::TrafficCop::GetInstance();
+  std::string error_message;
+  auto statement = traffic_cop.PrepareStatement(
+      "", "SELECT id FROM batch_table;", error_message);
+  EXPECT_NE(nullptr, statement.get());
+
+  std::vector<common::Value> params;
+  std::vector<ResultType> result;
+  std::vector<int> result_format(statement->GetTupleDescriptor().size(), 0);
+  int rows_changed;
+  EXPECT_EQ(Result::RESULT_SUCCESS,
+            traffic_cop.ExecuteStatement(statement, params, true, nullptr,
+                                         result_format, result, rows_changed,
+                                         error_message));
+  std::multiset<int> ids;
+  for (auto &row : result) {
+    ids.insert(std::stoi(std::string(row.second.begin(), row.second.end())));
+  }
+  return ids;
+}
+
+//===--------------------------------------------------------------------===//
+// Packets
+//===--------------------------------------------------------------------===//
+
+static void PutInt(std::string &contents, int value, int size) {
+  for (int byte_itr = size - 1; byte_itr >= 0; byte_itr--) {
+    contents.push_back(static_cast<char>((value >> (8 * byte_itr)) & 0xff));
+  }
+}
+
+static void PutString(std::string &contents, const std::string &str) {
+  contents += str;
+  contents.push_back('\0');
+}
+
+// the packets keep their contents, the vector must not reallocate them
+static void AddPacket(std::vector<wire::InputPacket> &pkts, uchar msg_type,
+                      std::string contents) {
+  pkts.emplace_back(contents.size(), contents);
+  pkts.back().msg_type = msg_type;
+}
+
+// prepare a statement whose parameters are integers
+static void AddParse(std::vector<wire::InputPacket> &pkts,
+                     const std::string &statement_name,
+                     const std::string &query, const int &param_count) {
+  std::string contents;
+  PutString(contents, statement_name);
+  PutString(contents, query);
+  PutInt(contents, param_count, 2);
+  for (int param_itr = 0; param_itr < param_count; param_itr++) {
+    PutInt(contents, POSTGRES_VALUE_TYPE_INTEGER, 4);
+  }
+  AddPacket(pkts, PARSE_COMMAND, contents);
+}
+
+// bind the parameters in text format
+static void AddBind(std::vector<wire::InputPacket> &pkts,
+                    const std::string &portal_name,
+                    const std::string &statement_name,
+                    const std::vector<int> &params) {
+  std::string contents;
+  PutString(contents, portal_name);
+  PutString(contents, statement_name);
+  PutInt(contents, params.size(), 2);
+  for (size_t param_itr = 0; param_itr < params.size(); param_itr++) {
+    PutInt(contents, 0, 2);
+  }
+  PutInt(contents, params.size(), 2);
+  for (auto param : params) {
+    auto param_str = std::to_string(param);
+    PutInt(contents, param_str.size(), 4);
+    contents += param_str;
+  }
+  PutInt(contents, 0, 2);
+  AddPacket(pkts, BIND_COMMAND, contents);
+}
+
+static void AddExecute(std::vector<wire::InputPacket> &pkts,
+                       const std::string &portal_name) {
+  std::string contents;
+  PutString(contents, portal_name);
+  PutInt(contents, 0, 4);
+  AddPacket(pkts, EXECUTE_COMMAND, contents);
+}
+
+// the tags of the COMMAND_COMPLETE responses, and the count of the other ones
+static std::vector<std::string> GetCommandTags(
+    wire::PacketManager &packet_manager, std::map<uchar, size_t> &counts) {
+  std::vector<std::string> tags;
+  for (auto &response : packet_manager.responses) {
+    counts[response->msg_type]++;
+    if (response->msg_type == COMMAND_COMPLETE) {
+      // without the null character
+      tags.emplace_back(response->buf.begin(), response->buf.end() - 1);
+    }
+  }
+  packet_manager.responses.clear();
+  return tags;
+}
+
+static const std::string insert_query =
+    "INSERT INTO batch_table VALUES ($1, $2);";
+
+TEST_F(PacketManagerTests, ExecuteBatchSizeTest) {
+  CreateTable();
+  wire::PacketManager packet_manager;
+  std::vector<wire::InputPacket> pkts;
+  pkts.reserve(16);
+  AddParse(pkts, "insert", insert_query, 2);
+  AddParse(pkts, "insert_other", insert_query, 2);
+  AddParse(pkts, "select", "SELECT value FROM batch_table WHERE id = $1;", 1);
+  EXPECT_TRUE(packet_manager.ProcessPackets(pkts));
+  packet_manager.responses.clear();
+
+  // A single pair is not a batch
+  pkts.clear();
+  AddBind(pkts, "", "insert", {1, 1});
+  AddExecute(pkts, "");
+  EXPECT_EQ(0U, packet_manager.GetExecuteBatchSize(pkts, 0));
+
+  // The pairs of the same write statement and portal are, up to the sync
+  pkts.clear();
+  AddPacket(pkts, SYNC_COMMAND, "");
+  for (int pair_itr = 0; pair_itr < 3; pair_itr++) {
+    AddBind(pkts, "", "insert", {pair_itr, pair_itr});
+    AddExecute(pkts, "");
+  }
+  AddPacket(pkts, SYNC_COMMAND, "");
+  EXPECT_EQ(0U, packet_manager.GetExecuteBatchSize(pkts, 0));
+  EXPECT_EQ(3U, packet_manager.GetExecuteBatchSize(pkts, 1));
+  EXPECT_EQ(2U, packet_manager.GetExecuteBatchSize(pkts, 3));
+
+  // The batch ends at another statement
+  pkts.clear();
+  AddBind(pkts, "", "insert", {1, 1});
+  AddExecute(pkts, "");
+  AddBind(pkts, "", "insert_other", {2, 2});
+  AddExecute(pkts, "");
+  EXPECT_EQ(0U, packet_manager.GetExecuteBatchSize(pkts, 0));
+
+  // and at an execution of another portal than the bound one
+  pkts.clear();
+  AddBind(pkts, "", "insert", {1, 1});
+  AddExecute(pkts, "");
+  AddBind(pkts, "", "insert", {2, 2});
+  AddExecute(pkts, "other");
+  EXPECT_EQ(0U, packet_manager.GetExecuteBatchSize(pkts, 0));
+
+  // Reads send rows back, they are not batched
+  pkts.clear();
+  AddBind(pkts, "", "select", {1});
+  AddExecute(pkts, "");
+  AddBind(pkts, "", "select", {2});
+  AddExecute(pkts, "");
+  EXPECT_EQ(0U, packet_manager.GetExecuteBatchSize(pkts, 0));
+
+  DropTable();
+}
+
+TEST_F(PacketManagerTests, ExecuteBatchTest) {
+  CreateTable();
+  wire::PacketManager packet_manager;
+  std::vector<wire::InputPacket> pkts;
+  pkts.reserve(16);
+  std::map<uchar, size_t> counts;
+
+  AddParse(pkts, "insert", insert_query, 2);
+  AddParse(pkts, "delete", "DELETE FROM batch_table WHERE value = $1;", 1);
+  EXPECT_TRUE(packet_manager.ProcessPackets(pkts));
+  GetCommandTags(packet_manager, counts);
+  EXPECT_EQ(2U, counts[PARSE_COMPLETE]);
+
+  pkts.clear();
+  counts.clear();
+  for (int id = 1; id <= 3; id++) {
+    AddBind(pkts, "", "insert", {id, (id < 3) ? 10 : 20});
+    AddExecute(pkts, "");
+  }
+  AddPacket(pkts, SYNC_COMMAND, "");
+  EXPECT_EQ(3U, packet_manager.GetExecuteBatchSize(pkts, 0));
+  EXPECT_TRUE(packet_manager.ProcessPackets(pkts));
+
+  auto tags = GetCommandTags(packet_manager, counts);
+  EXPECT_EQ(3U, counts[BIND_COMPLETE]);
+  EXPECT_EQ(std::vector<std::string>(3, "INSERT 0 1"), tags);
+  EXPECT_EQ(std::multiset<int>({1, 2, 3}), GetIds());
+
+  // Every execution of the batch reports the rows it changed
+  pkts.clear();
+  counts.clear();
+  for (auto value : {10, 20, 30}) {
+    AddBind(pkts, "", "delete", {value});
+    AddExecute(pkts, "");
+  }
+  AddPacket(pkts, SYNC_COMMAND, "");
+  EXPECT_EQ(3U, packet_manager.GetExecuteBatchSize(pkts, 0));
+  EXPECT_TRUE(packet_manager.ProcessPackets(pkts));
+
+  tags = GetCommandTags(packet_manager, counts);
+  EXPECT_EQ(std::vector<std::string>({"DELETE 2", "DELETE 1", "DELETE 0"}),
+            tags);
+  EXPECT_EQ(0U, counts[ERROR_RESPONSE]);
+  EXPECT_TRUE(GetIds().empty());
+
+  DropTable();
+}
+
+TEST_F(PacketManagerTests, ExecuteBatchAbortTest) {
+  CreateTable();
+  wire::PacketManager packet_manager;
+  std::vector<wire::InputPacket> pkts;
+  pkts.reserve(16);
+  std::map<uchar, size_t> counts;
+
+  AddParse(pkts, "insert", insert_query, 2);
+  AddBind(pkts, "", "insert", {1, 1});
+  AddExecute(pkts, "");
+  AddPacket(pkts, SYNC_COMMAND, "");
+  EXPECT_TRUE(packet_manager.ProcessPackets(pkts));
+  packet_manager.responses.clear();
+  EXPECT_EQ(std::multiset<int>({1}), GetIds());
+
+  // The second execution violates the primary key. The batch runs in one
+  // transaction, so the first one is rolled back with it, and the third one
+  // is dropped
+  pkts.clear();
+  AddBind(pkts, "", "insert", {2, 2});
+  AddExecute(pkts, "");
+  AddBind(pkts, "", "insert", {1, 3});
+  AddExecute(pkts, "");
+  AddBind(pkts, "", "insert", {4, 4});
+  AddExecute(pkts, "");
+  AddPacket(pkts, SYNC_COMMAND, "");
+  EXPECT_EQ(3U, packet_manager.GetExecuteBatchSize(pkts, 0));
+  EXPECT_TRUE(packet_manager.ProcessPackets(pkts));
+
+  auto tags = GetCommandTags(packet_manager, counts);
+  EXPECT_EQ(2U, counts[BIND_COMPLETE]);
+  EXPECT_EQ(std::vector<std::string>({"INSERT 0 1"}), tags);
+  EXPECT_EQ(1U, counts[ERROR_RESPONSE]);
+  EXPECT_EQ(std::multiset<int>({1}), GetIds());
+
+  DropTable();
+}
+
+}  // End test namespace
+}  // End peloton namespace
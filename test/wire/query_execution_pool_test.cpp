@@ -0,0 +1,104 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// query_execution_pool_test.cpp
+//
+// Identification: test/wire/query_execution_pool_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <set>
+#include <thread>
+
+#include "common/harness.h"
+#include "wire/libevent_server.h"
+#include "wire/query_execution_pool.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Query Execution Pool Tests
+//===--------------------------------------------------------------------===//
+
+class QueryExecutionPoolTests : public PelotonTest {};
+
+TEST_F(QueryExecutionPoolTests, SubmitPacketsTest) {
+  auto &execution_pool = wire::QueryExecutionPool::GetInstance();
+  execution_pool.StartPool(2);
+  execution_pool.ResetStatistics();
+  EXPECT_TRUE(execution_pool.IsRunning());
+
+  wire::LibeventWorkerThread worker(0);
+
+  // Connection i sends i + 1 sync packets, each answered by a ReadyForQuery
+  const size_t conn_count = 4;
+  std::vector<std::unique_ptr<wire::LibeventSocket>> conns;
+  std::vector<int> peer_fds;
+  for (size_t conn_itr = 0; conn_itr < conn_count; conn_itr++) {
+    int fds[2];
+    ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+    peer_fds.push_back(fds[1]);
+    conns.emplace_back(new wire::LibeventSocket(
+        fds[0], EV_READ | EV_PERSIST, &worker, wire::CONN_EXECUTING));
+
+    for (size_t pkt_itr = 0; pkt_itr <= conn_itr; pkt_itr++) {
+      wire::InputPacket pkt;
+      pkt.msg_type = SYNC_COMMAND;
+      conns.back()->pkt_batch.push_back(pkt);
+    }
+  }
+
+  for (auto &conn : conns) {
+    execution_pool.SubmitPackets(conn.get());
+  }
+
+  // Every connection is posted back once to its network thread
+  std::set<wire::LibeventSocket *> posted_back_conns;
+  while (posted_back_conns.size() < conn_count) {
+    wire::LibeventSocket *conn;
+    if (worker.post_back_queue.Dequeue(conn) == false) {
+      std::this_thread::yield();
+      continue;
+    }
+    EXPECT_TRUE(posted_back_conns.insert(conn).second);
+    execution_pool.CompletePostBack(conn);
+  }
+
+  for (size_t conn_itr = 0; conn_itr < conn_count; conn_itr++) {
+    auto &conn = conns[conn_itr];
+    EXPECT_EQ(1U, posted_back_conns.count(conn.get()));
+    EXPECT_TRUE(conn->exec_status);
+    EXPECT_TRUE(conn->pkt_batch.empty());
+
+    // The responses are left for the connection that sent the packets
+    EXPECT_EQ(conn_itr + 1, conn->pkt_manager.responses.size());
+  }
+
+  // The packets are run by the execution threads, not by this thread
+  EXPECT_EQ(conn_count, execution_pool.GetPoolExecutedCount());
+  EXPECT_EQ(conn_count,
+            execution_pool.GetStageCount(wire::EXECUTION_STAGE_EXECUTING));
+  EXPECT_EQ(conn_count,
+            execution_pool.GetStageCount(wire::EXECUTION_STAGE_POST_BACK));
+  EXPECT_EQ(0U, execution_pool.GetQueueDepth());
+  EXPECT_EQ(0U, execution_pool.GetExecutingCount());
+  EXPECT_EQ(0U, execution_pool.GetPostBackDepth());
+
+  execution_pool.StopPool();
+  EXPECT_FALSE(execution_pool.IsRunning());
+
+  for (size_t conn_itr = 0; conn_itr < conn_count; conn_itr++) {
+    close(conns[conn_itr]->sock_fd);
+    close(peer_fds[conn_itr]);
+  }
+}
+
+}  // End test namespace
+}  // End peloton namespace